@@ -0,0 +1,46 @@
+#ifndef BENCHMARKS_TEMPORARYDIRECTORY_HPP
+#define BENCHMARKS_TEMPORARYDIRECTORY_HPP
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace benchmarks {
+/**
+ * A uniquely named directory in the system's temporary directory which is removed (along with its
+ * contents) when the object is destroyed.
+ */
+class TemporaryDirectory {
+public:
+    // Constructors
+    TemporaryDirectory() {
+        std::random_device random_device;
+        do {
+            m_path = std::filesystem::temp_directory_path()
+                     / ("clp-benchmarks-" + std::to_string(random_device()));
+        } while (false == std::filesystem::create_directory(m_path));
+    }
+
+    // Delete copy & move constructors and assignment operators
+    TemporaryDirectory(TemporaryDirectory const&) = delete;
+    TemporaryDirectory(TemporaryDirectory&&) = delete;
+    auto operator=(TemporaryDirectory const&) -> TemporaryDirectory& = delete;
+    auto operator=(TemporaryDirectory&&) -> TemporaryDirectory& = delete;
+
+    // Destructor
+    ~TemporaryDirectory() {
+        std::error_code error_code;
+        std::filesystem::remove_all(m_path, error_code);
+    }
+
+    // Methods
+    [[nodiscard]] auto get_path() const -> std::filesystem::path const& { return m_path; }
+
+private:
+    // Variables
+    std::filesystem::path m_path;
+};
+}  // namespace benchmarks
+
+#endif  // BENCHMARKS_TEMPORARYDIRECTORY_HPP
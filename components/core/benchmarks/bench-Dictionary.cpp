@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <unordered_set>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/VariableDictionaryEntry.hpp"
+#include "../src/clp/VariableDictionaryReader.hpp"
+#include "../src/clp/VariableDictionaryWriter.hpp"
+#include "synthetic_data.hpp"
+#include "TemporaryDirectory.hpp"
+
+using clp::cVariableDictionaryIdMax;
+using clp::variable_dictionary_id_t;
+using clp::VariableDictionaryEntry;
+using clp::VariableDictionaryReader;
+using clp::VariableDictionaryWriter;
+
+namespace {
+constexpr size_t cNumValues{1 << 16};
+
+/**
+ * Benchmarks adding variables to a dictionary, most of which are already in the dictionary.
+ * @param state The state's first argument is the number of unique values.
+ */
+void BM_VariableDictionaryWriter_add_entry(benchmark::State& state) {
+    auto const num_unique_values = static_cast<size_t>(state.range(0));
+    auto const values = benchmarks::generate_dictionary_values(cNumValues, num_unique_values);
+    benchmarks::TemporaryDirectory const temp_dir;
+    auto const dict_path = (temp_dir.get_path() / "var.dict").string();
+    auto const segment_index_path = (temp_dir.get_path() / "var.segindex").string();
+
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        VariableDictionaryWriter writer;
+        writer.open(dict_path, segment_index_path, cVariableDictionaryIdMax);
+        state.ResumeTiming();
+
+        variable_dictionary_id_t id{0};
+        for (auto const& value : values) {
+            writer.add_entry(value, id);
+        }
+        benchmark::DoNotOptimize(id);
+
+        state.PauseTiming();
+        writer.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+
+/**
+ * Benchmarks looking up the dictionary entries of variables which are in the dictionary.
+ * @param state The state's first argument is the number of unique values and its second argument
+ * is whether to ignore case.
+ */
+void BM_VariableDictionaryReader_get_entry_matching_value(benchmark::State& state) {
+    auto const num_unique_values = static_cast<size_t>(state.range(0));
+    bool const ignore_case = 0 != state.range(1);
+    auto const values = benchmarks::generate_dictionary_values(cNumValues, num_unique_values);
+    benchmarks::TemporaryDirectory const temp_dir;
+    auto const dict_path = (temp_dir.get_path() / "var.dict").string();
+    auto const segment_index_path = (temp_dir.get_path() / "var.segindex").string();
+
+    VariableDictionaryWriter writer;
+    writer.open(dict_path, segment_index_path, cVariableDictionaryIdMax);
+    variable_dictionary_id_t id{0};
+    for (auto const& value : values) {
+        writer.add_entry(value, id);
+    }
+    writer.close();
+
+    VariableDictionaryReader reader;
+    reader.open(dict_path, segment_index_path);
+    reader.read_new_entries();
+
+    size_t num_matches{0};
+    for ([[maybe_unused]] auto _ : state) {
+        num_matches = 0;
+        for (auto const& value : values) {
+            if (nullptr != reader.get_entry_matching_value(value, ignore_case)) {
+                ++num_matches;
+            }
+        }
+        benchmark::DoNotOptimize(num_matches);
+    }
+    state.counters["matches"] = static_cast<double>(num_matches);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+
+/**
+ * Benchmarks finding every variable in a dictionary which matches a wildcard string.
+ * @param state The state's first argument is the number of unique values.
+ */
+void BM_VariableDictionaryReader_get_entries_matching_wildcard_string(benchmark::State& state) {
+    auto const num_unique_values = static_cast<size_t>(state.range(0));
+    auto const values = benchmarks::generate_dictionary_values(cNumValues, num_unique_values);
+    benchmarks::TemporaryDirectory const temp_dir;
+    auto const dict_path = (temp_dir.get_path() / "var.dict").string();
+    auto const segment_index_path = (temp_dir.get_path() / "var.segindex").string();
+
+    VariableDictionaryWriter writer;
+    writer.open(dict_path, segment_index_path, cVariableDictionaryIdMax);
+    variable_dictionary_id_t id{0};
+    for (auto const& value : values) {
+        writer.add_entry(value, id);
+    }
+    writer.close();
+
+    VariableDictionaryReader reader;
+    reader.open(dict_path, segment_index_path);
+    reader.read_new_entries();
+
+    std::unordered_set<VariableDictionaryEntry const*> entries;
+    for ([[maybe_unused]] auto _ : state) {
+        entries.clear();
+        reader.get_entries_matching_wildcard_string("*part-1?3*", false, entries);
+        benchmark::DoNotOptimize(entries.size());
+    }
+    state.counters["matches"] = static_cast<double>(entries.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_unique_values));
+}
+}  // namespace
+
+BENCHMARK(BM_VariableDictionaryWriter_add_entry)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_VariableDictionaryReader_get_entry_matching_value)
+        ->ArgsProduct({{1 << 10, 1 << 16}, {0, 1}})
+        ->ArgNames({"unique_values", "ignore_case"});
+BENCHMARK(BM_VariableDictionaryReader_get_entries_matching_wildcard_string)
+        ->Arg(1 << 10)
+        ->Arg(1 << 16);
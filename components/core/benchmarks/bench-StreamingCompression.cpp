@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/clp/ErrorCode.hpp"
+#include "../src/clp/FileWriter.hpp"
+#include "../src/clp/streaming_compression/zstd/Compressor.hpp"
+#include "../src/clp/streaming_compression/zstd/Decompressor.hpp"
+#include "synthetic_data.hpp"
+#include "TemporaryDirectory.hpp"
+
+using clp::ErrorCode_EndOfFile;
+using clp::ErrorCode_Success;
+using clp::FileWriter;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr size_t cNumMessages{1 << 16};
+constexpr size_t cWriteSize{4096};
+constexpr size_t cReadBufferSize{64 * 1024};
+
+/**
+ * Compresses the given data into the given file, in chunks of `cWriteSize` bytes.
+ * @param data
+ * @param path
+ * @param compression_level
+ */
+void compress(string const& data, string const& path, int compression_level) {
+    FileWriter file_writer;
+    file_writer.open(path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+    clp::streaming_compression::zstd::Compressor compressor;
+    compressor.open(file_writer, compression_level);
+    for (size_t pos = 0; pos < data.size(); pos += cWriteSize) {
+        compressor.write(data.data() + pos, std::min(cWriteSize, data.size() - pos));
+    }
+    compressor.close();
+    file_writer.close();
+}
+
+/**
+ * Benchmarks compressing log messages with the zstd compressor.
+ * @param state The state's first argument is the compression level.
+ */
+void BM_zstd_Compressor(benchmark::State& state) {
+    auto const data = benchmarks::concatenate(benchmarks::generate_log_messages(cNumMessages));
+    auto const compression_level = static_cast<int>(state.range(0));
+    benchmarks::TemporaryDirectory const temp_dir;
+    auto const path = (temp_dir.get_path() / "compressed.zst").string();
+
+    for ([[maybe_unused]] auto _ : state) {
+        compress(data, path, compression_level);
+    }
+    state.counters["compression_ratio"] = static_cast<double>(data.size())
+                                          / static_cast<double>(std::filesystem::file_size(path));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+/**
+ * Benchmarks decompressing log messages with the zstd decompressor.
+ * @param state The state's first argument is the compression level the data was compressed with.
+ */
+void BM_zstd_Decompressor(benchmark::State& state) {
+    auto const data = benchmarks::concatenate(benchmarks::generate_log_messages(cNumMessages));
+    benchmarks::TemporaryDirectory const temp_dir;
+    auto const path = (temp_dir.get_path() / "compressed.zst").string();
+    compress(data, path, static_cast<int>(state.range(0)));
+
+    vector<char> buf(cReadBufferSize);
+    for ([[maybe_unused]] auto _ : state) {
+        clp::streaming_compression::zstd::Decompressor decompressor;
+        if (ErrorCode_Success != decompressor.open(path)) {
+            state.SkipWithError("Failed to open decompressor.");
+            return;
+        }
+        size_t num_bytes_decompressed{0};
+        while (true) {
+            size_t num_bytes_read{0};
+            auto const error_code = decompressor.try_read(buf.data(), buf.size(), num_bytes_read);
+            num_bytes_decompressed += num_bytes_read;
+            if (ErrorCode_EndOfFile == error_code) {
+                break;
+            }
+            if (ErrorCode_Success != error_code) {
+                state.SkipWithError("Failed to decompress.");
+                return;
+            }
+        }
+        if (num_bytes_decompressed != data.size()) {
+            state.SkipWithError("Decompressed data has an unexpected size.");
+            return;
+        }
+        decompressor.close();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+}  // namespace
+
+BENCHMARK(BM_zstd_Compressor)->Arg(1)->Arg(3)->Arg(9);
+BENCHMARK(BM_zstd_Decompressor)->Arg(3);
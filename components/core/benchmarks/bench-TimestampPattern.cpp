@@ -0,0 +1,190 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/clp/Defs.h"
+#include "../src/clp/TimestampFormatter.hpp"
+#include "../src/clp/TimestampPattern.hpp"
+#include "synthetic_data.hpp"
+
+using clp::epochtime_t;
+using clp::TimestampFormatter;
+using clp::TimestampPattern;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr size_t cNumMessages{4096};
+
+/**
+ * Benchmarks searching for the pattern of each message's timestamp, which is what happens for the
+ * first message of a file and whenever a file's timestamp pattern changes.
+ * @param state
+ */
+void BM_TimestampPattern_search_known_ts_patterns(benchmark::State& state) {
+    TimestampPattern::init();
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+
+    epochtime_t timestamp{0};
+    size_t timestamp_begin_pos{0};
+    size_t timestamp_end_pos{0};
+    for ([[maybe_unused]] auto _ : state) {
+        for (auto const& message : messages) {
+            auto const* pattern = TimestampPattern::search_known_ts_patterns(
+                    message,
+                    timestamp,
+                    timestamp_begin_pos,
+                    timestamp_end_pos
+            );
+            benchmark::DoNotOptimize(pattern);
+            benchmark::DoNotOptimize(timestamp);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+}
+
+/**
+ * Benchmarks parsing the timestamp of messages whose timestamp pattern is already known, which is
+ * the common case during compression.
+ * @param state
+ */
+void BM_TimestampPattern_parse_timestamp(benchmark::State& state) {
+    TimestampPattern::init();
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+
+    epochtime_t timestamp{0};
+    size_t timestamp_begin_pos{0};
+    size_t timestamp_end_pos{0};
+    vector<TimestampPattern const*> patterns;
+    patterns.reserve(messages.size());
+    for (auto const& message : messages) {
+        patterns.push_back(TimestampPattern::search_known_ts_patterns(
+                message,
+                timestamp,
+                timestamp_begin_pos,
+                timestamp_end_pos
+        ));
+        if (nullptr == patterns.back()) {
+            state.SkipWithError("Failed to find the timestamp pattern of a message.");
+            return;
+        }
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i = 0; i < messages.size(); ++i) {
+            auto const parsed = patterns[i]->parse_timestamp(
+                    messages[i],
+                    timestamp,
+                    timestamp_begin_pos,
+                    timestamp_end_pos
+            );
+            benchmark::DoNotOptimize(parsed);
+            benchmark::DoNotOptimize(timestamp);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+}
+
+/**
+ * Strips the timestamp from each message like compression does
+ * @param messages
+ * @param patterns Returns the timestamp pattern of each message
+ * @param timestamps Returns the timestamp of each message
+ * @param stripped_messages Returns each message without its timestamp
+ * @return Whether the timestamp pattern of every message was found
+ */
+bool strip_timestamps(
+        vector<string> const& messages,
+        vector<TimestampPattern const*>& patterns,
+        vector<epochtime_t>& timestamps,
+        vector<string>& stripped_messages
+) {
+    for (auto const& message : messages) {
+        epochtime_t timestamp{0};
+        size_t timestamp_begin_pos{0};
+        size_t timestamp_end_pos{0};
+        auto const* pattern = TimestampPattern::search_known_ts_patterns(
+                message,
+                timestamp,
+                timestamp_begin_pos,
+                timestamp_end_pos
+        );
+        if (nullptr == pattern) {
+            return false;
+        }
+        patterns.push_back(pattern);
+        timestamps.push_back(timestamp);
+        stripped_messages.emplace_back(message);
+        stripped_messages.back().erase(
+                timestamp_begin_pos,
+                timestamp_end_pos - timestamp_begin_pos
+        );
+    }
+    return true;
+}
+
+/**
+ * Benchmarks reinserting timestamps into messages by interpreting each message's timestamp
+ * pattern.
+ * @param state
+ */
+void BM_TimestampPattern_insert_formatted_timestamp(benchmark::State& state) {
+    TimestampPattern::init();
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+
+    vector<TimestampPattern const*> patterns;
+    vector<epochtime_t> timestamps;
+    vector<string> stripped_messages;
+    if (false == strip_timestamps(messages, patterns, timestamps, stripped_messages)) {
+        state.SkipWithError("Failed to find the timestamp pattern of a message.");
+        return;
+    }
+
+    string decompressed_message;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i = 0; i < stripped_messages.size(); ++i) {
+            decompressed_message = stripped_messages[i];
+            patterns[i]->insert_formatted_timestamp(timestamps[i], decompressed_message);
+            benchmark::DoNotOptimize(decompressed_message.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * stripped_messages.size()));
+}
+
+/**
+ * Benchmarks reinserting timestamps into messages with a compiled formatter, which is what happens
+ * during decompression.
+ * @param state
+ */
+void BM_TimestampFormatter_insert_formatted_timestamp(benchmark::State& state) {
+    TimestampPattern::init();
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+
+    vector<TimestampPattern const*> patterns;
+    vector<epochtime_t> timestamps;
+    vector<string> stripped_messages;
+    if (false == strip_timestamps(messages, patterns, timestamps, stripped_messages)) {
+        state.SkipWithError("Failed to find the timestamp pattern of a message.");
+        return;
+    }
+
+    TimestampFormatter formatter;
+    string decompressed_message;
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t i = 0; i < stripped_messages.size(); ++i) {
+            decompressed_message = stripped_messages[i];
+            formatter.set_pattern(*patterns[i]);
+            formatter.insert_formatted_timestamp(timestamps[i], decompressed_message);
+            benchmark::DoNotOptimize(decompressed_message.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * stripped_messages.size()));
+}
+}  // namespace
+
+BENCHMARK(BM_TimestampPattern_search_known_ts_patterns);
+BENCHMARK(BM_TimestampPattern_parse_timestamp);
+BENCHMARK(BM_TimestampPattern_insert_formatted_timestamp);
+BENCHMARK(BM_TimestampFormatter_insert_formatted_timestamp);
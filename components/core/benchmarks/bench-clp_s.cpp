@@ -0,0 +1,290 @@
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/clp_s/ArchiveReader.hpp"
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/FileWriter.hpp"
+#include "../src/clp_s/JsonParser.hpp"
+#include "../src/clp_s/SchemaReader.hpp"
+#include "../src/clp_s/TimestampPattern.hpp"
+#include "../src/clp_s/search/ConvertToExists.hpp"
+#include "../src/clp_s/search/EmptyExpr.hpp"
+#include "../src/clp_s/search/kql/kql.hpp"
+#include "../src/clp_s/search/NarrowTypes.hpp"
+#include "../src/clp_s/search/OrOfAndForm.hpp"
+#include "../src/clp_s/search/Output.hpp"
+#include "../src/clp_s/search/OutputHandler.hpp"
+#include "../src/clp_s/search/SchemaMatch.hpp"
+#include "synthetic_data.hpp"
+#include "TemporaryDirectory.hpp"
+
+using clp_s::ArchiveReader;
+using clp_s::epochtime_t;
+using clp_s::JsonParser;
+using clp_s::JsonParserOption;
+using clp_s::search::ConvertToExists;
+using clp_s::search::EmptyExpr;
+using clp_s::search::NarrowTypes;
+using clp_s::search::OrOfAndForm;
+using clp_s::search::Output;
+using clp_s::search::OutputHandler;
+using clp_s::search::SchemaMatch;
+using std::string;
+using std::string_view;
+
+namespace {
+constexpr size_t cNumRecords{1 << 16};
+
+constexpr std::array<string_view, 8> cQueries{
+        R"(level: "ERROR")",
+        R"(msg: "*Receiving block*")",
+        R"(task.duration > 50 AND task.success: false)",
+        R"(user: "alice" AND session: "0x1*")",
+        // A single filter on an unstructured array, which can stop parsing it at the first element
+        R"(tags: "auth")",
+        // A single filter on an unstructured array, which has to parse every element
+        R"(tags: 42)",
+        // A wildcard filter, which also searches each unstructured array with a single filter
+        R"(*: "auth")",
+        // Several filters on the same unstructured array, which share a pre-parsed tape of it
+        R"(tags: 42 OR tags: "a*")"
+};
+
+/**
+ * An output handler which only counts results so that benchmarks measure the cost of searching
+ * rather than the cost of writing results.
+ */
+class CountingOutputHandler : public OutputHandler {
+public:
+    // Constructors
+    explicit CountingOutputHandler(size_t& num_results)
+            : OutputHandler(false, true),
+              m_num_results(num_results) {}
+
+    // Methods inherited from OutputHandler
+    void write(
+            string_view message,
+            [[maybe_unused]] epochtime_t timestamp,
+            [[maybe_unused]] string_view archive_id
+    ) override {
+        write(message);
+    }
+
+    void write(string_view message) override {
+        benchmark::DoNotOptimize(message.data());
+        ++m_num_results;
+    }
+
+private:
+    // Variables
+    size_t& m_num_results;
+};
+
+/**
+ * Synthetic JSON records written to a file, along with a clp-s archive compressed from them. Both
+ * are removed when the object is destroyed.
+ */
+class SyntheticArchive {
+public:
+    // Constructors
+    SyntheticArchive() {
+        clp_s::TimestampPattern::init();
+
+        auto const records = benchmarks::generate_json_records(cNumRecords);
+        m_input_size = benchmarks::get_total_size(records);
+        m_input_path = (m_temp_dir.get_path() / "records.jsonl").string();
+        clp_s::FileWriter writer;
+        writer.open(m_input_path, clp_s::FileWriter::OpenMode::CreateForWriting);
+        for (auto const& record : records) {
+            writer.write(record.data(), record.size());
+        }
+        writer.close();
+
+        m_archives_dir = (m_temp_dir.get_path() / "archives").string();
+        compress(m_input_path, m_archives_dir);
+        for (auto const& entry : std::filesystem::directory_iterator(m_archives_dir)) {
+            m_archive_id = entry.path().filename().string();
+        }
+    }
+
+    // Methods
+    /**
+     * Compresses the given JSON file into an archive in the given directory.
+     * @param input_path
+     * @param archives_dir
+     * @throw JsonParser::OperationFailed if parsing fails
+     */
+    static void compress(string const& input_path, string const& archives_dir) {
+        std::filesystem::create_directory(archives_dir);
+
+        JsonParserOption option{};
+        option.file_paths = {input_path};
+        option.archives_dir = archives_dir;
+        option.timestamp_key = "ts";
+        option.target_encoded_size = 8ULL * 1024 * 1024 * 1024;
+        option.max_document_size = 512ULL * 1024 * 1024;
+        option.compression_level = 3;
+        option.print_archive_stats = false;
+        option.structurize_arrays = false;
+        option.build_dictionary_index = false;
+
+        JsonParser parser(option);
+        if (false == parser.parse()) {
+            throw JsonParser::OperationFailed(clp_s::ErrorCodeFailure, __FILENAME__, __LINE__);
+        }
+        parser.store();
+    }
+
+    [[nodiscard]] auto get_temp_dir() const -> benchmarks::TemporaryDirectory const& {
+        return m_temp_dir;
+    }
+
+    [[nodiscard]] auto get_input_path() const -> string const& { return m_input_path; }
+
+    [[nodiscard]] auto get_input_size() const -> size_t { return m_input_size; }
+
+    [[nodiscard]] auto get_archives_dir() const -> string const& { return m_archives_dir; }
+
+    [[nodiscard]] auto get_archive_id() const -> string const& { return m_archive_id; }
+
+private:
+    // Variables
+    benchmarks::TemporaryDirectory m_temp_dir;
+    string m_input_path;
+    size_t m_input_size{0};
+    string m_archives_dir;
+    string m_archive_id;
+};
+
+/**
+ * @return The archive shared by all benchmarks, which is created the first time it's needed.
+ */
+auto get_synthetic_archive() -> SyntheticArchive const& {
+    static SyntheticArchive const archive;
+    return archive;
+}
+
+/**
+ * Benchmarks ingesting JSON records into an archive, end to end.
+ * @param state
+ */
+void BM_JsonParser(benchmark::State& state) {
+    auto const& archive = get_synthetic_archive();
+    auto const archives_dir = (archive.get_temp_dir().get_path() / "ingestion-archives").string();
+
+    for ([[maybe_unused]] auto _ : state) {
+        SyntheticArchive::compress(archive.get_input_path(), archives_dir);
+
+        state.PauseTiming();
+        std::filesystem::remove_all(archives_dir);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cNumRecords));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * archive.get_input_size()));
+}
+
+/**
+ * Benchmarks marshalling every record of an archive back into JSON. Reading and decompressing the
+ * tables isn't measured.
+ * @param state
+ */
+void BM_SchemaReader_get_next_message(benchmark::State& state) {
+    auto const& archive = get_synthetic_archive();
+
+    string message;
+    size_t num_records{0};
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        ArchiveReader archive_reader;
+        archive_reader.open(archive.get_archives_dir(), archive.get_archive_id());
+        archive_reader.read_dictionaries_and_metadata();
+        state.ResumeTiming();
+
+        num_records = 0;
+        for (auto const schema_id : archive_reader.get_schema_ids()) {
+            state.PauseTiming();
+            auto& schema_reader = archive_reader.read_table(schema_id, false, true);
+            state.ResumeTiming();
+
+            while (schema_reader.get_next_message(message)) {
+                benchmark::DoNotOptimize(message.data());
+                ++num_records;
+            }
+        }
+
+        state.PauseTiming();
+        archive_reader.close();
+        state.ResumeTiming();
+    }
+    if (num_records != cNumRecords) {
+        state.SkipWithError("Archive contains an unexpected number of records.");
+        return;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_records));
+}
+
+/**
+ * Benchmarks searching an archive, end to end, in the same way that clp-s does.
+ * @param state The state's first argument is the index of the query in `cQueries`.
+ */
+void BM_Output_filter(benchmark::State& state) {
+    auto const& archive = get_synthetic_archive();
+    auto const query = cQueries.at(static_cast<size_t>(state.range(0)));
+    std::istringstream query_stream{string{query}};
+    auto const parsed_expr = clp_s::search::kql::parse_kql_expression(query_stream);
+    if (nullptr == parsed_expr) {
+        state.SkipWithError("Failed to parse query.");
+        return;
+    }
+
+    size_t num_results{0};
+    for ([[maybe_unused]] auto _ : state) {
+        num_results = 0;
+        auto archive_reader = std::make_shared<ArchiveReader>();
+        archive_reader->open(archive.get_archives_dir(), archive.get_archive_id());
+        auto timestamp_dict = archive_reader->read_timestamp_dictionary();
+
+        auto expr = parsed_expr->copy();
+        OrOfAndForm standardize_pass;
+        expr = standardize_pass.run(expr);
+        NarrowTypes narrow_pass;
+        expr = narrow_pass.run(expr);
+        ConvertToExists convert_pass;
+        expr = convert_pass.run(expr);
+        SchemaMatch match_pass(archive_reader->get_schema_tree(), archive_reader->get_schema_map());
+        expr = match_pass.run(expr);
+        if (nullptr == std::dynamic_pointer_cast<EmptyExpr>(expr)) {
+            Output output(
+                    match_pass,
+                    expr,
+                    archive_reader,
+                    timestamp_dict,
+                    std::make_unique<CountingOutputHandler>(num_results),
+                    false
+            );
+            if (false == output.filter()) {
+                state.SkipWithError("Failed to search archive.");
+                return;
+            }
+        }
+        archive_reader->close();
+    }
+    state.SetLabel(string{query});
+    state.counters["results"] = static_cast<double>(num_results);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cNumRecords));
+}
+}  // namespace
+
+BENCHMARK(BM_JsonParser)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SchemaReader_get_next_message)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Output_filter)
+        ->DenseRange(0, cQueries.size() - 1, 1)
+        ->ArgName("query")
+        ->Unit(benchmark::kMillisecond);
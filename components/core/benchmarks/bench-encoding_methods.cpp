@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/clp/ffi/encoding_methods.hpp"
+#include "../src/clp/ir/types.hpp"
+#include "synthetic_data.hpp"
+
+using clp::ffi::decode_message;
+using clp::ffi::encode_message;
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::four_byte_encoded_variable_t;
+using std::string;
+using std::vector;
+
+namespace {
+constexpr size_t cNumMessages{4096};
+
+/**
+ * A message encoded in the form that `decode_message` expects.
+ */
+template <typename encoded_variable_t>
+struct EncodedMessage {
+    string logtype;
+    vector<encoded_variable_t> encoded_vars;
+    string all_dictionary_vars;
+    vector<int32_t> dictionary_var_end_offsets;
+};
+
+/**
+ * Benchmarks encoding messages into a logtype, encoded variables, and dictionary variables.
+ * @tparam encoded_variable_t
+ * @param state
+ */
+template <typename encoded_variable_t>
+void BM_encode_message(benchmark::State& state) {
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+
+    string logtype;
+    vector<encoded_variable_t> encoded_vars;
+    vector<int32_t> dictionary_var_bounds;
+    for ([[maybe_unused]] auto _ : state) {
+        for (auto const& message : messages) {
+            logtype.clear();
+            encoded_vars.clear();
+            dictionary_var_bounds.clear();
+            auto const encoded
+                    = encode_message(message, logtype, encoded_vars, dictionary_var_bounds);
+            benchmark::DoNotOptimize(encoded);
+            benchmark::DoNotOptimize(logtype.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+    state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations() * benchmarks::get_total_size(messages))
+    );
+}
+
+/**
+ * Benchmarks decoding messages from their logtype, encoded variables, and dictionary variables.
+ * @tparam encoded_variable_t
+ * @param state
+ */
+template <typename encoded_variable_t>
+void BM_decode_message(benchmark::State& state) {
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+
+    vector<EncodedMessage<encoded_variable_t>> encoded_messages;
+    encoded_messages.reserve(messages.size());
+    vector<int32_t> dictionary_var_bounds;
+    for (auto const& message : messages) {
+        auto& encoded_message = encoded_messages.emplace_back();
+        dictionary_var_bounds.clear();
+        if (false
+            == encode_message(
+                    message,
+                    encoded_message.logtype,
+                    encoded_message.encoded_vars,
+                    dictionary_var_bounds
+            ))
+        {
+            state.SkipWithError("Failed to encode message.");
+            return;
+        }
+        for (size_t i = 0; i < dictionary_var_bounds.size(); i += 2) {
+            auto const begin_pos = static_cast<size_t>(dictionary_var_bounds[i]);
+            auto const end_pos = static_cast<size_t>(dictionary_var_bounds[i + 1]);
+            encoded_message.all_dictionary_vars.append(message, begin_pos, end_pos - begin_pos);
+            encoded_message.dictionary_var_end_offsets.push_back(
+                    static_cast<int32_t>(encoded_message.all_dictionary_vars.size())
+            );
+        }
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        for (auto& encoded_message : encoded_messages) {
+            auto decoded_message = decode_message(
+                    encoded_message.logtype,
+                    encoded_message.encoded_vars.data(),
+                    encoded_message.encoded_vars.size(),
+                    encoded_message.all_dictionary_vars,
+                    encoded_message.dictionary_var_end_offsets.data(),
+                    encoded_message.dictionary_var_end_offsets.size()
+            );
+            benchmark::DoNotOptimize(decoded_message.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+    state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations() * benchmarks::get_total_size(messages))
+    );
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_encode_message, eight_byte_encoded_variable_t);
+BENCHMARK_TEMPLATE(BM_encode_message, four_byte_encoded_variable_t);
+BENCHMARK_TEMPLATE(BM_decode_message, eight_byte_encoded_variable_t);
+BENCHMARK_TEMPLATE(BM_decode_message, four_byte_encoded_variable_t);
@@ -0,0 +1,130 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <json/single_include/nlohmann/json.hpp>
+#include <msgpack.hpp>
+
+#include "../src/clp/BufferReader.hpp"
+#include "../src/clp/ffi/ir_stream/Deserializer.hpp"
+#include "../src/clp/ffi/ir_stream/Serializer.hpp"
+#include "../src/clp/ir/types.hpp"
+#include "../src/clp/type_utils.hpp"
+#include "synthetic_data.hpp"
+
+using clp::BufferReader;
+using clp::ffi::ir_stream::Deserializer;
+using clp::ffi::ir_stream::Serializer;
+using clp::ir::eight_byte_encoded_variable_t;
+using clp::ir::four_byte_encoded_variable_t;
+using clp::size_checked_pointer_cast;
+using std::vector;
+
+namespace {
+constexpr size_t cNumRecords{4096};
+
+/**
+ * Converts the synthetic JSON records into msgpack objects, which is the form the serializer
+ * accepts.
+ * @return The msgpack objects, along with the handles which own their memory
+ */
+auto generate_msgpack_records() -> vector<msgpack::object_handle> {
+    vector<msgpack::object_handle> msgpack_records;
+    for (auto const& record : benchmarks::generate_json_records(cNumRecords)) {
+        auto const msgpack_bytes = nlohmann::json::to_msgpack(nlohmann::json::parse(record));
+        msgpack_records.emplace_back(msgpack::unpack(
+                size_checked_pointer_cast<char const>(msgpack_bytes.data()),
+                msgpack_bytes.size()
+        ));
+    }
+    return msgpack_records;
+}
+
+/**
+ * Serializes the given records into a key-value pair IR stream.
+ * @tparam encoded_variable_t
+ * @param msgpack_records
+ * @param ir_buf Returns the IR stream
+ * @return Whether serialization succeeded
+ */
+template <typename encoded_variable_t>
+auto serialize(vector<msgpack::object_handle> const& msgpack_records, vector<int8_t>& ir_buf)
+        -> bool {
+    auto result{Serializer<encoded_variable_t>::create()};
+    if (result.has_error()) {
+        return false;
+    }
+    auto& serializer{result.value()};
+    for (auto const& msgpack_record : msgpack_records) {
+        if (false == serializer.serialize_msgpack_map(msgpack_record.get().via.map)) {
+            return false;
+        }
+    }
+    auto const ir_buf_view{serializer.get_ir_buf_view()};
+    ir_buf.assign(ir_buf_view.begin(), ir_buf_view.end());
+    return true;
+}
+
+/**
+ * Benchmarks serializing structured records into a key-value pair IR stream.
+ * @tparam encoded_variable_t
+ * @param state
+ */
+template <typename encoded_variable_t>
+void BM_ir_stream_Serializer(benchmark::State& state) {
+    auto const msgpack_records = generate_msgpack_records();
+
+    vector<int8_t> ir_buf;
+    for ([[maybe_unused]] auto _ : state) {
+        if (false == serialize<encoded_variable_t>(msgpack_records, ir_buf)) {
+            state.SkipWithError("Failed to serialize records.");
+            return;
+        }
+        benchmark::DoNotOptimize(ir_buf.data());
+    }
+    state.counters["ir_bytes_per_record"]
+            = static_cast<double>(ir_buf.size()) / static_cast<double>(msgpack_records.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * msgpack_records.size()));
+}
+
+/**
+ * Benchmarks deserializing a key-value pair IR stream into log events.
+ * @tparam encoded_variable_t
+ * @param state
+ */
+template <typename encoded_variable_t>
+void BM_ir_stream_Deserializer(benchmark::State& state) {
+    auto const msgpack_records = generate_msgpack_records();
+    vector<int8_t> ir_buf;
+    if (false == serialize<encoded_variable_t>(msgpack_records, ir_buf)) {
+        state.SkipWithError("Failed to serialize records.");
+        return;
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        BufferReader reader{size_checked_pointer_cast<char const>(ir_buf.data()), ir_buf.size()};
+        auto deserializer_result{Deserializer::create(reader)};
+        if (deserializer_result.has_error()) {
+            state.SkipWithError("Failed to create deserializer.");
+            return;
+        }
+        auto& deserializer{deserializer_result.value()};
+        for (size_t i = 0; i < msgpack_records.size(); ++i) {
+            auto const log_event_result{deserializer.deserialize_to_next_log_event(reader)};
+            if (log_event_result.has_error()) {
+                state.SkipWithError("Failed to deserialize log event.");
+                return;
+            }
+            benchmark::DoNotOptimize(log_event_result.value());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * msgpack_records.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * ir_buf.size()));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ir_stream_Serializer, eight_byte_encoded_variable_t);
+BENCHMARK_TEMPLATE(BM_ir_stream_Serializer, four_byte_encoded_variable_t);
+BENCHMARK_TEMPLATE(BM_ir_stream_Deserializer, eight_byte_encoded_variable_t);
+BENCHMARK_TEMPLATE(BM_ir_stream_Deserializer, four_byte_encoded_variable_t);
@@ -0,0 +1,92 @@
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+#include <string_utils/string_utils.hpp>
+#include <string_utils/WildcardMatcher.hpp>
+
+#include "synthetic_data.hpp"
+
+using clp::string_utils::wildcard_match_unsafe;
+using clp::string_utils::WildcardMatcher;
+
+namespace {
+constexpr size_t cNumMessages{4096};
+
+/**
+ * Wildcard queries ranging from ones that reject most messages after a few characters to ones that
+ * require backtracking through most of each message.
+ */
+constexpr std::array<std::string_view, 5> cWildcardQueries{
+        "*Receiving block*",
+        "*user=alice*session=0x*",
+        "*ERROR*failed with error code 1?,*",
+        "*task-1?2?-attempt*finished in *",
+        "*org.apache.*.DataNode*src: /10.0.*:*"
+};
+
+/**
+ * Benchmarks matching every message against a wildcard query.
+ * @param state The state's first argument is the index of the query in `cWildcardQueries` and its
+ * second argument is whether the match is case-sensitive.
+ */
+void BM_wildcard_match_unsafe(benchmark::State& state) {
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+    auto const query = cWildcardQueries.at(static_cast<size_t>(state.range(0)));
+    bool const case_sensitive_match = 0 != state.range(1);
+
+    size_t num_matches{0};
+    for ([[maybe_unused]] auto _ : state) {
+        num_matches = 0;
+        for (auto const& message : messages) {
+            if (wildcard_match_unsafe(message, query, case_sensitive_match)) {
+                ++num_matches;
+            }
+        }
+        benchmark::DoNotOptimize(num_matches);
+    }
+    state.SetLabel(std::string{query});
+    state.counters["matches"] = static_cast<double>(num_matches);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+    state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations() * benchmarks::get_total_size(messages))
+    );
+}
+
+/**
+ * Benchmarks matching every message against a wildcard query that's compiled once.
+ * @param state Same as for `BM_wildcard_match_unsafe`
+ */
+void BM_WildcardMatcher(benchmark::State& state) {
+    auto const messages = benchmarks::generate_log_messages(cNumMessages);
+    auto const query = cWildcardQueries.at(static_cast<size_t>(state.range(0)));
+    WildcardMatcher const matcher{query, 0 != state.range(1)};
+
+    size_t num_matches{0};
+    for ([[maybe_unused]] auto _ : state) {
+        num_matches = 0;
+        for (auto const& message : messages) {
+            if (matcher.matches(message)) {
+                ++num_matches;
+            }
+        }
+        benchmark::DoNotOptimize(num_matches);
+    }
+    state.SetLabel(std::string{query});
+    state.counters["matches"] = static_cast<double>(num_matches);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+    state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations() * benchmarks::get_total_size(messages))
+    );
+}
+}  // namespace
+
+BENCHMARK(BM_wildcard_match_unsafe)
+        ->ArgsProduct({benchmark::CreateDenseRange(0, cWildcardQueries.size() - 1, 1), {1, 0}})
+        ->ArgNames({"query", "case_sensitive"});
+
+BENCHMARK(BM_WildcardMatcher)
+        ->ArgsProduct({benchmark::CreateDenseRange(0, cWildcardQueries.size() - 1, 1), {1, 0}})
+        ->ArgNames({"query", "case_sensitive"});
@@ -0,0 +1,336 @@
+#include "synthetic_data.hpp"
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <string_view>
+
+namespace benchmarks {
+namespace {
+// Jan 1, 2024 00:00:00 UTC
+constexpr int64_t cBaseTimestampInMs{1'704'067'200'000};
+
+constexpr std::array<std::string_view, 12> cMonthNames{
+        "Jan",
+        "Feb",
+        "Mar",
+        "Apr",
+        "May",
+        "Jun",
+        "Jul",
+        "Aug",
+        "Sep",
+        "Oct",
+        "Nov",
+        "Dec"
+};
+constexpr std::array<std::string_view, 4> cLevels{"INFO", "DEBUG", "WARN", "ERROR"};
+constexpr std::array<std::string_view, 6> cComponents{
+        "org.apache.hadoop.hdfs.DataNode",
+        "org.apache.hadoop.yarn.ResourceManager",
+        "com.example.api.RequestHandler",
+        "com.example.storage.BlockCache",
+        "kernel",
+        "sshd"
+};
+constexpr std::array<std::string_view, 5> cUsers{"alice", "bob", "carol", "dave", "eve"};
+
+/**
+ * Calendar date and time of day in UTC.
+ */
+struct DateTime {
+    int64_t year;
+    unsigned month;
+    unsigned day;
+    unsigned hour;
+    unsigned minute;
+    unsigned second;
+    unsigned millisecond;
+};
+
+/**
+ * Converts an epoch timestamp to a UTC calendar date and time without depending on the platform's
+ * time zone database.
+ * @param timestamp_in_ms
+ * @return The date and time
+ */
+auto to_date_time(int64_t timestamp_in_ms) -> DateTime {
+    constexpr int64_t cMsPerDay{86'400'000};
+    auto days = timestamp_in_ms / cMsPerDay;
+    auto ms_of_day = timestamp_in_ms % cMsPerDay;
+
+    // See http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+    days += 719'468;
+    auto const era = days / 146'097;
+    auto const day_of_era = days - era * 146'097;
+    auto const year_of_era
+            = (day_of_era - day_of_era / 1460 + day_of_era / 36'524 - day_of_era / 146'096) / 365;
+    auto const day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    auto const shifted_month = (5 * day_of_year + 2) / 153;
+
+    DateTime date_time{};
+    date_time.day = static_cast<unsigned>(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+    date_time.month
+            = static_cast<unsigned>(shifted_month < 10 ? shifted_month + 3 : shifted_month - 9);
+    date_time.year = year_of_era + era * 400 + (date_time.month <= 2 ? 1 : 0);
+    date_time.millisecond = static_cast<unsigned>(ms_of_day % 1000);
+    ms_of_day /= 1000;
+    date_time.second = static_cast<unsigned>(ms_of_day % 60);
+    ms_of_day /= 60;
+    date_time.minute = static_cast<unsigned>(ms_of_day % 60);
+    date_time.hour = static_cast<unsigned>(ms_of_day / 60);
+    return date_time;
+}
+
+/**
+ * Formats the given timestamp using one of several common timestamp formats.
+ * @param timestamp_in_ms
+ * @param format_ix
+ * @return The formatted timestamp
+ */
+auto format_timestamp(int64_t timestamp_in_ms, size_t format_ix) -> std::string {
+    auto const dt = to_date_time(timestamp_in_ms);
+    std::array<char, 64> buf{};
+    int length{0};
+    switch (format_ix % 4) {
+        case 0:
+            // %Y-%m-%dT%H:%M:%S.%3
+            length = std::snprintf(
+                    buf.data(),
+                    buf.size(),
+                    "%04lld-%02u-%02uT%02u:%02u:%02u.%03u",
+                    static_cast<long long>(dt.year),
+                    dt.month,
+                    dt.day,
+                    dt.hour,
+                    dt.minute,
+                    dt.second,
+                    dt.millisecond
+            );
+            break;
+        case 1:
+            // %Y-%m-%d %H:%M:%S,%3
+            length = std::snprintf(
+                    buf.data(),
+                    buf.size(),
+                    "%04lld-%02u-%02u %02u:%02u:%02u,%03u",
+                    static_cast<long long>(dt.year),
+                    dt.month,
+                    dt.day,
+                    dt.hour,
+                    dt.minute,
+                    dt.second,
+                    dt.millisecond
+            );
+            break;
+        case 2:
+            // [%Y%m%d-%H:%M:%S]
+            length = std::snprintf(
+                    buf.data(),
+                    buf.size(),
+                    "[%04lld%02u%02u-%02u:%02u:%02u]",
+                    static_cast<long long>(dt.year),
+                    dt.month,
+                    dt.day,
+                    dt.hour,
+                    dt.minute,
+                    dt.second
+            );
+            break;
+        default:
+            // %b %d %H:%M:%S
+            length = std::snprintf(
+                    buf.data(),
+                    buf.size(),
+                    "%s %02u %02u:%02u:%02u",
+                    cMonthNames[dt.month - 1].data(),
+                    dt.day,
+                    dt.hour,
+                    dt.minute,
+                    dt.second
+            );
+            break;
+    }
+    return {buf.data(), static_cast<size_t>(length)};
+}
+
+/**
+ * @param rng
+ * @param bound
+ * @return A pseudo-random number in [0, bound). Unlike std::uniform_int_distribution, the result
+ * doesn't depend on the standard library's implementation.
+ */
+auto get_random(std::mt19937_64& rng, uint64_t bound) -> uint64_t {
+    return rng() % bound;
+}
+
+/**
+ * @param rng
+ * @param num_digits
+ * @return A random lowercase hex string with the given number of digits
+ */
+auto generate_hex_string(std::mt19937_64& rng, size_t num_digits) -> std::string {
+    constexpr std::string_view cHexDigits{"0123456789abcdef"};
+    std::string hex;
+    hex.reserve(num_digits);
+    for (size_t i = 0; i < num_digits; ++i) {
+        hex += cHexDigits[get_random(rng, cHexDigits.size())];
+    }
+    return hex;
+}
+
+/**
+ * @param rng
+ * @return A random float with two decimal digits, formatted as a string
+ */
+auto generate_float_string(std::mt19937_64& rng) -> std::string {
+    return std::to_string(get_random(rng, 100)) + "." + std::to_string(10 + get_random(rng, 90));
+}
+
+/**
+ * @param index
+ * @return The dictionary variable (e.g., an ID or path) with the given index. Different indices
+ * map to different values.
+ */
+auto generate_dictionary_value(uint64_t index) -> std::string {
+    switch (index % 4) {
+        case 0:
+            return "blk_" + std::to_string(index * 7919 + 1'073'741'825);
+        case 1:
+            return "container_" + std::to_string(index % 97) + "_" + std::to_string(index);
+        case 2:
+            return "/var/lib/app/data/part-" + std::to_string(index) + ".parquet";
+        default:
+            return "task-" + std::to_string(index) + "-attempt" + std::to_string(index % 3);
+    }
+}
+}  // namespace
+
+auto generate_log_messages(size_t num_messages, uint64_t seed) -> std::vector<std::string> {
+    std::mt19937_64 rng{seed};
+    std::vector<std::string> messages;
+    messages.reserve(num_messages);
+
+    auto timestamp = cBaseTimestampInMs;
+    // Most log files use a single timestamp format, so only vary it between blocks of messages
+    constexpr size_t cNumMessagesPerFormat{1024};
+    for (size_t i = 0; i < num_messages; ++i) {
+        timestamp += static_cast<int64_t>(get_random(rng, 250));
+
+        std::string message = format_timestamp(timestamp, i / cNumMessagesPerFormat);
+        message += ' ';
+        message += cLevels[get_random(rng, cLevels.size())];
+        message += ' ';
+        message += cComponents[get_random(rng, cComponents.size())];
+        message += ": ";
+        switch (get_random(rng, 5)) {
+            case 0:
+                message += "Receiving block " + generate_dictionary_value(get_random(rng, 4096))
+                           + " src: /10.0." + std::to_string(get_random(rng, 256)) + "."
+                           + std::to_string(get_random(rng, 256)) + ":"
+                           + std::to_string(1024 + get_random(rng, 60'000));
+                break;
+            case 1:
+                message += "Task " + generate_dictionary_value(get_random(rng, 4096))
+                           + " finished in " + generate_float_string(rng) + " s, read "
+                           + std::to_string(get_random(rng, 1'000'000)) + " bytes";
+                break;
+            case 2:
+                message += "user=" + std::string{cUsers[get_random(rng, cUsers.size())]}
+                           + " session=0x" + generate_hex_string(rng, 8)
+                           + " action=login status=" + std::to_string(200 + get_random(rng, 4));
+                break;
+            case 3:
+                message += "CPU usage: " + generate_float_string(rng)
+                           + "%, memory usage: " + std::to_string(get_random(rng, 65'536))
+                           + " MiB, threads: " + std::to_string(get_random(rng, 512));
+                break;
+            default:
+                message += "Request " + generate_hex_string(rng, 16) + " failed with error code "
+                           + std::to_string(get_random(rng, 128))
+                           + ", retrying in " + std::to_string(get_random(rng, 30)) + " ms";
+                break;
+        }
+        message += '\n';
+        messages.emplace_back(std::move(message));
+    }
+    return messages;
+}
+
+auto generate_json_records(size_t num_records, uint64_t seed) -> std::vector<std::string> {
+    std::mt19937_64 rng{seed};
+    std::vector<std::string> records;
+    records.reserve(num_records);
+
+    auto timestamp = cBaseTimestampInMs;
+    for (size_t i = 0; i < num_records; ++i) {
+        timestamp += static_cast<int64_t>(get_random(rng, 250));
+
+        std::string record = "{\"ts\":" + std::to_string(timestamp);
+        record += ",\"level\":\"";
+        record += cLevels[get_random(rng, cLevels.size())];
+        record += "\",\"logger\":\"";
+        record += cComponents[get_random(rng, cComponents.size())];
+        record += '"';
+        switch (get_random(rng, 4)) {
+            case 0:
+                record += ",\"msg\":\"Receiving block "
+                          + generate_dictionary_value(get_random(rng, 4096)) + " of size "
+                          + std::to_string(get_random(rng, 1 << 20)) + "\"";
+                record += ",\"block\":{\"id\":" + std::to_string(get_random(rng, 1 << 30))
+                          + ",\"replicas\":" + std::to_string(1 + get_random(rng, 3)) + "}";
+                break;
+            case 1:
+                record += ",\"msg\":\"Task finished\",\"task\":{\"id\":\""
+                          + generate_dictionary_value(get_random(rng, 4096))
+                          + "\",\"duration\":" + generate_float_string(rng)
+                          + ",\"success\":" + (0 == get_random(rng, 10) ? "false" : "true") + "}";
+                break;
+            case 2:
+                record += ",\"msg\":\"User logged in\",\"user\":\""
+                          + std::string{cUsers[get_random(rng, cUsers.size())]}
+                          + "\",\"session\":\"0x" + generate_hex_string(rng, 8)
+                          + "\",\"tags\":[\"auth\",\"" + generate_hex_string(rng, 4) + "\","
+                          + std::to_string(get_random(rng, 100)) + "]";
+                break;
+            default:
+                record += ",\"msg\":\"Request failed with error code "
+                          + std::to_string(get_random(rng, 128)) + "\",\"request\":{\"id\":\""
+                          + generate_hex_string(rng, 16) + "\",\"latency_ms\":"
+                          + generate_float_string(rng) + ",\"retry\":null}";
+                break;
+        }
+        record += "}\n";
+        records.emplace_back(std::move(record));
+    }
+    return records;
+}
+
+auto generate_dictionary_values(size_t num_values, size_t num_unique_values, uint64_t seed)
+        -> std::vector<std::string> {
+    std::mt19937_64 rng{seed};
+    std::vector<std::string> values;
+    values.reserve(num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        values.emplace_back(generate_dictionary_value(get_random(rng, num_unique_values)));
+    }
+    return values;
+}
+
+auto concatenate(std::vector<std::string> const& strings) -> std::string {
+    std::string concatenated;
+    concatenated.reserve(get_total_size(strings));
+    for (auto const& str : strings) {
+        concatenated += str;
+    }
+    return concatenated;
+}
+
+auto get_total_size(std::vector<std::string> const& strings) -> size_t {
+    size_t total_size{0};
+    for (auto const& str : strings) {
+        total_size += str.size();
+    }
+    return total_size;
+}
+}  // namespace benchmarks
@@ -0,0 +1,67 @@
+#ifndef BENCHMARKS_SYNTHETIC_DATA_HPP
+#define BENCHMARKS_SYNTHETIC_DATA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+/**
+ * Seed used by every generator unless the caller specifies one, so that results are comparable
+ * across runs and releases.
+ */
+constexpr uint64_t cDefaultSeed{0x636c'7062'656e'6368ULL};
+
+/**
+ * Generates unstructured log messages which resemble typical application logs. Each message starts
+ * with a timestamp (in one of several common formats) and contains a mix of static text, integer
+ * variables, float variables, and dictionary variables (IDs, paths, hex values, etc.).
+ *
+ * The output only depends on the arguments (i.e., it's the same on every platform and compiler)
+ * so that benchmark results can be tracked across releases.
+ * @param num_messages
+ * @param seed
+ * @return The messages, each terminated with a newline
+ */
+auto generate_log_messages(size_t num_messages, uint64_t seed = cDefaultSeed)
+        -> std::vector<std::string>;
+
+/**
+ * Generates JSON records (one per line) which resemble typical structured logs. The records use a
+ * handful of schemas, contain nested objects and occasionally arrays, and each contain a "ts"
+ * field with an epoch timestamp in milliseconds.
+ * @param num_records
+ * @param seed
+ * @return The records, each terminated with a newline
+ */
+auto generate_json_records(size_t num_records, uint64_t seed = cDefaultSeed)
+        -> std::vector<std::string>;
+
+/**
+ * Generates values that resemble the dictionary variables of typical logs.
+ * @param num_values
+ * @param num_unique_values The number of distinct values to draw the values from
+ * @param seed
+ * @return The values
+ */
+auto generate_dictionary_values(
+        size_t num_values,
+        size_t num_unique_values,
+        uint64_t seed = cDefaultSeed
+) -> std::vector<std::string>;
+
+/**
+ * @param strings
+ * @return The concatenation of the given strings
+ */
+auto concatenate(std::vector<std::string> const& strings) -> std::string;
+
+/**
+ * @param strings
+ * @return The total size of the given strings
+ */
+auto get_total_size(std::vector<std::string> const& strings) -> size_t;
+}  // namespace benchmarks
+
+#endif  // BENCHMARKS_SYNTHETIC_DATA_HPP
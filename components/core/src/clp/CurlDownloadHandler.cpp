@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -19,7 +20,8 @@ CurlDownloadHandler::CurlDownloadHandler(
         size_t offset,
         bool disable_caching,
         std::chrono::seconds connection_timeout,
-        std::chrono::seconds overall_timeout
+        std::chrono::seconds overall_timeout,
+        std::optional<size_t> end_offset
 )
         : m_error_msg_buf{std::move(error_msg_buf)} {
     if (nullptr != m_error_msg_buf) {
@@ -47,11 +49,17 @@ CurlDownloadHandler::CurlDownloadHandler(
     m_easy_handle.set_option(CURLOPT_CONNECTTIMEOUT, static_cast<long>(connection_timeout.count()));
     m_easy_handle.set_option(CURLOPT_TIMEOUT, static_cast<long>(overall_timeout.count()));
 
-    // Set up http headers
-    if (0 != offset) {
-        std::string const range{"Range: bytes=" + std::to_string(offset) + "-"};
-        m_http_headers.append(range);
+    // Set up the byte range. `CURLOPT_RANGE` is used rather than an explicit HTTP header so that
+    // ranges also apply to other protocols (e.g., `file://`). libcurl copies the string.
+    if (0 != offset || end_offset.has_value()) {
+        std::string range{std::to_string(offset) + "-"};
+        if (end_offset.has_value()) {
+            range += std::to_string(end_offset.value());
+        }
+        m_easy_handle.set_option(CURLOPT_RANGE, range.c_str());
     }
+
+    // Set up http headers
     if (disable_caching) {
         m_http_headers.append("Cache-Control: no-cache");
         m_http_headers.append("Pragma: no-cache");
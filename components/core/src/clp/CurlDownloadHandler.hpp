@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 #include <curl/curl.h>
@@ -53,6 +54,8 @@ public:
      * Doc: https://curl.se/libcurl/c/CURLOPT_CONNECTTIMEOUT.html
      * @param overall_timeout Maximum time that the transfer may take. Note that this includes
      * `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
+     * @param end_offset Index of the last byte (inclusive) to download, or `std::nullopt` to
+     * download until the end of the data.
      */
     explicit CurlDownloadHandler(
             std::shared_ptr<ErrorMsgBuf> error_msg_buf,
@@ -63,7 +66,8 @@ public:
             size_t offset = 0,
             bool disable_caching = false,
             std::chrono::seconds connection_timeout = cDefaultConnectionTimeout,
-            std::chrono::seconds overall_timeout = cDefaultOverallTimeout
+            std::chrono::seconds overall_timeout = cDefaultOverallTimeout,
+            std::optional<size_t> end_offset = std::nullopt
     );
 
     // Disable copy/move constructors/assignment operators
@@ -82,6 +86,31 @@ public:
      */
     [[nodiscard]] auto perform() -> CURLcode { return m_easy_handle.perform(); }
 
+    /**
+     * @return The last response code received (e.g., the HTTP status code), or 0 if no response
+     * has been received.
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    [[nodiscard]] auto get_response_code() -> long {
+        long response_code{0};
+        m_easy_handle.get_info(CURLINFO_RESPONSE_CODE, response_code);
+        return response_code;
+    }
+
+    /**
+     * @return The size of the data being downloaded, as reported by the server (e.g., the HTTP
+     * `Content-Length` header), or `std::nullopt` if it's unknown.
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    [[nodiscard]] auto get_content_length() -> std::optional<size_t> {
+        curl_off_t content_length{-1};
+        m_easy_handle.get_info(CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, content_length);
+        if (content_length < 0) {
+            return std::nullopt;
+        }
+        return static_cast<size_t>(content_length);
+    }
+
 private:
     CurlEasyHandle m_easy_handle;
     CurlStringList m_http_headers;
@@ -66,6 +66,26 @@ public:
         }
     }
 
+    /**
+     * Gets the given CURL info from this handle.
+     * @tparam ValueType
+     * @param info
+     * @param value Returns the info's value.
+     * @throw CurlOperationFailed if an error occurs.
+     */
+    template <typename ValueType>
+    auto get_info(CURLINFO info, ValueType& value) -> void {
+        if (auto const err{curl_easy_getinfo(m_handle, info, &value)}; CURLE_OK != err) {
+            throw CurlOperationFailed(
+                    ErrorCode_Failure,
+                    __FILE__,
+                    __LINE__,
+                    err,
+                    "`curl_easy_getinfo` failed."
+            );
+        }
+    }
+
 private:
     CURL* m_handle{nullptr};
 };
@@ -6,10 +6,12 @@
 
 #include <boost/algorithm/string.hpp>
 #include <string_utils/string_utils.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
 #include "FileReader.hpp"
+#include "Metrics.hpp"
 #include "streaming_compression/passthrough/Decompressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
 #include "Utils.hpp"
@@ -173,6 +175,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
+    Metrics::ScopedTimer const load_timer{Metrics::Stage::DictionaryLoad};
 
     // Read dictionary header
     auto num_dictionary_entries = read_dictionary_header(*m_dictionary_file_reader);
@@ -261,13 +264,9 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
+    string_utils::WildcardMatcher const matcher{wildcard_string, false == ignore_case};
     for (auto const& entry : m_entries) {
-        if (string_utils::wildcard_match_unsafe(
-                    entry.get_value(),
-                    wildcard_string,
-                    false == ignore_case
-            ))
-        {
+        if (matcher.matches(entry.get_value())) {
             entries.insert(&entry);
         }
     }
@@ -1,10 +1,12 @@
 #ifndef CLP_DICTIONARYWRITER_HPP
 #define CLP_DICTIONARYWRITER_HPP
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
 #include "ArrayBackedPosIntSet.hpp"
+#include "BloomFilter.hpp"
 #include "Defs.h"
 #include "FileWriter.hpp"
 #include "spdlog_with_specializations.hpp"
@@ -13,6 +15,7 @@
 #include "streaming_compression/zstd/Compressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
 #include "TraceableException.hpp"
+#include "TransparentStringHash.hpp"
 
 namespace clp {
 /**
@@ -81,9 +84,28 @@ public:
      */
     size_t get_data_size() const { return m_data_size; }
 
+    /**
+     * Builds a Bloom filter over the values in the dictionary, so that searches can check whether
+     * a value may be in the dictionary without reading it
+     * @param false_positive_rate
+     * @return The filter
+     */
+    BloomFilter build_bloom_filter(double false_positive_rate) const {
+        BloomFilter filter{m_value_to_id.size(), false_positive_rate};
+        for (auto const& [value, id] : m_value_to_id) {
+            filter.add(value);
+        }
+        return filter;
+    }
+
 protected:
     // Types
-    using value_to_id_t = std::unordered_map<std::string, DictionaryIdType>;
+    // Values can be looked up without copying them into a `std::string`
+    using value_to_id_t = std::unordered_map<
+            std::string,
+            DictionaryIdType,
+            TransparentStringHash,
+            std::equal_to<>>;
 
     // Variables
     bool m_is_open;
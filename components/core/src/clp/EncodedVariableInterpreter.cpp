@@ -6,6 +6,7 @@
 #include <string_utils/string_utils.hpp>
 
 #include "Defs.h"
+#include "ffi/encoding_methods.hpp"
 #include "ffi/ir_stream/decoding_methods.hpp"
 #include "ir/LogEvent.hpp"
 #include "ir/types.hpp"
@@ -18,6 +19,7 @@ using clp::ir::four_byte_encoded_variable_t;
 using clp::ir::LogEvent;
 using clp::ir::VariablePlaceholder;
 using std::string;
+using std::string_view;
 using std::unordered_set;
 using std::vector;
 
@@ -366,6 +368,101 @@ bool EncodedVariableInterpreter::decode_variables_into_message(
     return true;
 }
 
+bool EncodedVariableInterpreter::transcode_to_four_byte_ir(
+        LogTypeDictionaryEntry const& logtype_dict_entry,
+        VariableDictionaryReader const& var_dict,
+        vector<encoded_variable_t> const& encoded_vars,
+        string& ir_logtype,
+        vector<four_byte_encoded_variable_t>& ir_encoded_vars,
+        vector<string_view>& ir_dict_vars,
+        string& converted_vars
+) {
+    // Ensure the number of variables in the logtype matches the number of encoded variables given
+    auto const& logtype_value = logtype_dict_entry.get_value();
+    size_t const num_vars = logtype_dict_entry.get_num_variables();
+    if (num_vars != encoded_vars.size()) {
+        SPDLOG_ERROR(
+                "EncodedVariableInterpreter: Logtype '{}' contains {} variables, but {} were given "
+                "for transcoding.",
+                logtype_value.c_str(),
+                num_vars,
+                encoded_vars.size()
+        );
+        return false;
+    }
+
+    // Both formats use the same placeholders and escaping, so only the placeholders of converted
+    // variables need to be rewritten
+    ir_logtype.assign(logtype_value);
+    ir_encoded_vars.clear();
+    ir_dict_vars.clear();
+    converted_vars.clear();
+    // Reserve enough space for every variable to be converted, so that appending a converted
+    // variable never invalidates the views of previously converted ones. 20 characters is enough
+    // for any integer or float.
+    constexpr size_t cMaxConvertedVarLength = 20;
+    converted_vars.reserve(num_vars * cMaxConvertedVarLength);
+    auto add_converted_var = [&](string_view var) {
+        auto const begin_pos = converted_vars.length();
+        converted_vars.append(var);
+        ir_dict_vars.emplace_back(converted_vars.data() + begin_pos, var.length());
+    };
+
+    VariablePlaceholder var_placeholder;
+    four_byte_encoded_variable_t four_byte_encoded_var{};
+    string float_str;
+    size_t const num_placeholders_in_logtype = logtype_dict_entry.get_num_placeholders();
+    for (size_t placeholder_ix = 0, var_ix = 0; placeholder_ix < num_placeholders_in_logtype;
+         ++placeholder_ix)
+    {
+        size_t const placeholder_position
+                = logtype_dict_entry.get_placeholder_info(placeholder_ix, var_placeholder);
+        switch (var_placeholder) {
+            case VariablePlaceholder::Integer: {
+                auto const encoded_var = encoded_vars[var_ix++];
+                if (ffi::encode_eight_byte_integer_as_four_byte(encoded_var, four_byte_encoded_var))
+                {
+                    ir_encoded_vars.push_back(four_byte_encoded_var);
+                } else {
+                    ir_logtype[placeholder_position]
+                            = enum_to_underlying_type(VariablePlaceholder::Dictionary);
+                    add_converted_var(std::to_string(encoded_var));
+                }
+                break;
+            }
+            case VariablePlaceholder::Float: {
+                auto const encoded_var = encoded_vars[var_ix++];
+                if (ffi::encode_eight_byte_float_as_four_byte(encoded_var, four_byte_encoded_var)) {
+                    ir_encoded_vars.push_back(four_byte_encoded_var);
+                } else {
+                    ir_logtype[placeholder_position]
+                            = enum_to_underlying_type(VariablePlaceholder::Dictionary);
+                    convert_encoded_float_to_string(encoded_var, float_str);
+                    add_converted_var(float_str);
+                }
+                break;
+            }
+            case VariablePlaceholder::Dictionary:
+                ir_dict_vars.emplace_back(
+                        var_dict.get_value(decode_var_dict_id(encoded_vars[var_ix++]))
+                );
+                break;
+            case VariablePlaceholder::Escape:
+                break;
+            default:
+                SPDLOG_ERROR(
+                        "EncodedVariableInterpreter: Logtype '{}' contains unexpected variable "
+                        "placeholder 0x{:x}",
+                        logtype_value,
+                        enum_to_underlying_type(var_placeholder)
+                );
+                return false;
+        }
+    }
+
+    return true;
+}
+
 bool EncodedVariableInterpreter::encode_and_search_dictionary(
         string const& var_str,
         VariableDictionaryReader const& var_dict,
@@ -2,6 +2,7 @@
 #define CLP_ENCODEDVARIABLEINTERPRETER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ir/LogEvent.hpp"
@@ -129,6 +130,32 @@ public:
             std::string& decompressed_msg
     );
 
+    /**
+     * Transcodes a message's logtype and encoded variables into the form used by four-byte encoding
+     * IR streams, without decoding the message into text. Each variable keeps its placeholder
+     * unless it isn't representable using the four-byte encoding, in which case it's converted into
+     * a dictionary variable, just as it would be if the decoded message was re-encoded.
+     * @param logtype_dict_entry
+     * @param var_dict
+     * @param encoded_vars
+     * @param ir_logtype Returns the message's logtype
+     * @param ir_encoded_vars Returns the message's four-byte encoded variables
+     * @param ir_dict_vars Returns the message's dictionary variables, which reference entries in
+     * `var_dict` or `converted_vars`
+     * @param converted_vars Returns the text of the variables that were converted into dictionary
+     * variables
+     * @return true if successful, false otherwise
+     */
+    static bool transcode_to_four_byte_ir(
+            LogTypeDictionaryEntry const& logtype_dict_entry,
+            VariableDictionaryReader const& var_dict,
+            std::vector<encoded_variable_t> const& encoded_vars,
+            std::string& ir_logtype,
+            std::vector<ir::four_byte_encoded_variable_t>& ir_encoded_vars,
+            std::vector<std::string_view>& ir_dict_vars,
+            std::string& converted_vars
+    );
+
     /**
      * Encodes a string-form variable, and if it is dictionary variable, searches for its ID in the
      * given variable dictionary
@@ -1,14 +1,19 @@
 #include "Grep.hpp"
 
 #include <algorithm>
+#include <filesystem>
 
 #include <log_surgeon/Constants.hpp>
 #include <string_utils/string_utils.hpp>
 
+#include "BloomFilter.hpp"
 #include "EncodedVariableInterpreter.hpp"
 #include "ir/parsing.hpp"
 #include "ir/types.hpp"
 #include "LogSurgeonReader.hpp"
+#include "Metrics.hpp"
+#include "spdlog_with_specializations.hpp"
+#include "streaming_archive/Constants.hpp"
 #include "StringReader.hpp"
 #include "Utils.hpp"
 
@@ -19,7 +24,6 @@ using clp::streaming_archive::reader::Message;
 using clp::string_utils::clean_up_wildcard_search_string;
 using clp::string_utils::is_alphabet;
 using clp::string_utils::is_wildcard;
-using clp::string_utils::wildcard_match_unsafe;
 using std::string;
 using std::vector;
 
@@ -379,6 +383,7 @@ bool find_matching_message(
         File& compressed_file,
         Message& compressed_msg
 ) {
+    Metrics::ScopedTimer const filter_timer{Metrics::Stage::FilterEvaluation};
     if (query.contains_sub_queries()) {
         matching_sub_query
                 = archive.find_message_matching_query(compressed_file, query, compressed_msg);
@@ -627,6 +632,79 @@ std::optional<Query> Grep::process_raw_query(
     };
 }
 
+vector<string> Grep::get_dictionary_vars_required_by_query(string const& search_string) {
+    // Tokenize the search string the same way as `process_raw_query`
+    string processed_search_string = "*";
+    processed_search_string += search_string;
+    processed_search_string += '*';
+    processed_search_string = clean_up_wildcard_search_string(processed_search_string);
+
+    vector<string> dict_vars;
+    size_t begin_pos = 0;
+    size_t end_pos = 0;
+    bool is_var;
+    while (get_bounds_of_next_potential_var(processed_search_string, begin_pos, end_pos, is_var)) {
+        if (false == is_var) {
+            continue;
+        }
+        auto const token = processed_search_string.substr(begin_pos, end_pos - begin_pos);
+        // Skip tokens with wildcards since they may match many dictionary variables, and tokens
+        // with escape characters since their dictionary value differs from the token
+        if (token.find_first_of("*?\\") != string::npos) {
+            continue;
+        }
+        encoded_variable_t encoded_var;
+        if (EncodedVariableInterpreter::convert_string_to_representable_integer_var(
+                    token,
+                    encoded_var
+            )
+            || EncodedVariableInterpreter::convert_string_to_representable_float_var(
+                    token,
+                    encoded_var
+            ))
+        {
+            continue;
+        }
+        dict_vars.push_back(token);
+    }
+    return dict_vars;
+}
+
+bool Grep::archive_may_contain_match(
+        string const& archive_path,
+        vector<string> const& search_strings,
+        bool ignore_case
+) {
+    // The filter is case-sensitive, and archives compressed with a schema file don't tokenize
+    // messages using the heuristic
+    if (ignore_case
+        || std::filesystem::exists(archive_path + '/' + streaming_archive::cSchemaFileName))
+    {
+        return true;
+    }
+
+    auto const filter_path = archive_path + '/' + streaming_archive::cVarDictBloomFilterFilename;
+    std::optional<BloomFilter> filter;
+    try {
+        filter = BloomFilter::try_read_from_file(filter_path);
+    } catch (TraceableException& e) {
+        SPDLOG_WARN("Failed to read Bloom filter '{}' - {}", filter_path, e.what());
+        return true;
+    }
+    if (false == filter.has_value()) {
+        return true;
+    }
+    return std::any_of(
+            search_strings.cbegin(),
+            search_strings.cend(),
+            [&](string const& search_string) {
+                return filter->possibly_contains_all(
+                        get_dictionary_vars_required_by_query(search_string)
+                );
+            }
+    );
+}
+
 bool Grep::get_bounds_of_next_potential_var(
         string const& value,
         size_t& begin_pos,
@@ -942,18 +1020,18 @@ size_t Grep::search_and_output(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
         }
 
         // Print match
-        output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+        {
+            Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+        }
+        Metrics::increment(Metrics::Counter::NumMessagesOutput);
         ++num_matches;
     }
 
@@ -999,11 +1077,7 @@ bool Grep::search_and_decompress(
             || (query.contains_sub_queries() == false && query.search_string_matches_all() == false
             ))
         {
-            matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            matched = query.search_string_matches(decompressed_msg);
         } else {
             matched = true;
         }
@@ -1048,11 +1122,7 @@ size_t Grep::search(Query const& query, size_t limit, Archive& archive, File& co
                 break;
             }
 
-            bool matched = wildcard_match_unsafe(
-                    decompressed_msg,
-                    query.get_search_string(),
-                    query.get_ignore_case() == false
-            );
+            bool matched = query.search_string_matches(decompressed_msg);
             if (!matched) {
                 continue;
             }
@@ -3,6 +3,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <log_surgeon/Lexer.hpp>
 
@@ -53,6 +54,37 @@ public:
             bool use_heuristic
     );
 
+    /**
+     * Gets the dictionary variables that every message matching the given search string must
+     * contain, i.e., the search string's variable tokens that contain no wildcards and can't be
+     * encoded as integer or float variables.
+     *
+     * NOTE: The search string is tokenized using the heuristic, so the result doesn't apply to
+     * archives compressed with a schema file.
+     * @param search_string
+     * @return The dictionary variables
+     */
+    static std::vector<std::string> get_dictionary_vars_required_by_query(
+            std::string const& search_string
+    );
+
+    /**
+     * Checks whether an archive may contain a message matching any of the given search strings,
+     * using the archive's variable dictionary Bloom filter. Only the filter is read, so archives
+     * that can't contain a match can be skipped without reading their dictionaries.
+     * @param archive_path
+     * @param search_strings
+     * @param ignore_case
+     * @return false if the archive definitely doesn't contain a match
+     * @return true otherwise, including if the archive has no filter, the archive was compressed
+     * with a schema file, the search is case-insensitive, or the filter couldn't be read
+     */
+    static bool archive_may_contain_match(
+            std::string const& archive_path,
+            std::vector<std::string> const& search_strings,
+            bool ignore_case
+    );
+
     /**
      * Returns bounds of next potential variable (either a definite variable or a token with
      * wildcards)
@@ -0,0 +1,318 @@
+#include "ParallelNetworkReader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "CurlDownloadHandler.hpp"
+#include "CurlOperationFailed.hpp"
+#include "ErrorCode.hpp"
+
+namespace clp {
+/**
+ * To understand the implementation, we first define several terms:
+ *
+ * - reader_thread: The thread that creates and uses the public API of a ParallelNetworkReader
+ *   instance (can be the main thread).
+ * - downloader_threads: The `num_concurrent_requests` threads that each repeatedly claim the next
+ *   chunk of the data and download it using a ranged request.
+ * - chunks: The chunks that have been claimed by a downloader thread but not yet consumed by the
+ *   reader thread, indexed by their offset. Since chunks are claimed in order, the chunk with the
+ *   lowest offset is always the next one that the reader thread should consume.
+ *
+ * A downloader thread operates as follows:
+ * - It waits until fewer than `max_num_resident_chunks` chunks exist, and then claims the next
+ *   chunk, using the current chunk size.
+ * - It downloads the chunk, aborting the transfer if the server sends more data than requested.
+ * - It marks the chunk as complete, recording the end of the data if the chunk was short or began
+ *   past the end of the data, and doubling the chunk size if the chunk was downloaded quickly.
+ * - It stops once the end of the data is known to have been claimed, a download fails, or the
+ *   reader is destroyed.
+ *
+ * The reader thread operates as follows:
+ * - It waits until the chunk with the lowest offset is complete, and then moves the chunk's data
+ *   out of `chunks`, allowing another chunk to be claimed.
+ * - It performs any reads using the data of the current chunk.
+ */
+
+namespace {
+/**
+ * The state of a single chunk's transfer, passed to the libcurl callbacks.
+ */
+struct ChunkTransfer {
+    ParallelNetworkReader const* reader;
+    std::vector<char>* data;
+    size_t size_requested;
+    bool exceeded_size_requested{false};
+};
+
+/**
+ * libcurl progress callback used to cause libcurl to abort the download if requested by the caller.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param transfer_ptr A pointer to a `ChunkTransfer`.
+ * @param dltotal Unused
+ * @param dlnow Unused
+ * @param ultotal Unused
+ * @param ulnow Unused
+ * @return 1 if the download should be aborted, 0 otherwise.
+ */
+extern "C" auto curl_progress_callback(
+        void* transfer_ptr,
+        [[maybe_unused]] curl_off_t dltotal,
+        [[maybe_unused]] curl_off_t dlnow,
+        [[maybe_unused]] curl_off_t ultotal,
+        [[maybe_unused]] curl_off_t ulnow
+) -> int {
+    auto const* transfer{static_cast<ChunkTransfer*>(transfer_ptr)};
+    return transfer->reader->is_abort_download_requested() ? 1 : 0;
+}
+
+/**
+ * libcurl write callback that appends downloaded data to the chunk.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param ptr A pointer to the downloaded data
+ * @param size Always 1.
+ * @param nmemb The number of bytes downloaded.
+ * @param transfer_ptr A pointer to a `ChunkTransfer`.
+ * @return On success, the number of bytes processed. If this is less than `nmemb`, the download
+ * will be aborted.
+ */
+extern "C" auto
+curl_write_callback(char* ptr, size_t size, size_t nmemb, void* transfer_ptr) -> size_t {
+    auto* transfer{static_cast<ChunkTransfer*>(transfer_ptr)};
+    auto const num_bytes{size * nmemb};
+    if (transfer->data->size() + num_bytes > transfer->size_requested) {
+        // The server must have ignored the requested range
+        transfer->exceeded_size_requested = true;
+        return 0;
+    }
+    transfer->data->insert(transfer->data->end(), ptr, ptr + num_bytes);
+    return num_bytes;
+}
+}  // namespace
+
+ParallelNetworkReader::ParallelNetworkReader(
+        std::string_view src_url,
+        size_t offset,
+        bool disable_caching,
+        std::chrono::seconds overall_timeout,
+        std::chrono::seconds connection_timeout,
+        size_t num_concurrent_requests,
+        size_t initial_chunk_size,
+        size_t max_chunk_size
+)
+        : m_src_url{src_url},
+          m_disable_caching{disable_caching},
+          m_overall_timeout{overall_timeout},
+          m_connection_timeout{connection_timeout},
+          m_max_num_resident_chunks{2 * std::max<size_t>(num_concurrent_requests, 1)},
+          m_max_chunk_size{std::max({cMinChunkSize, initial_chunk_size, max_chunk_size})},
+          m_file_pos{offset},
+          m_next_chunk_offset{offset},
+          m_chunk_size{std::max(cMinChunkSize, initial_chunk_size)} {
+    auto const num_downloader_threads{std::max<size_t>(num_concurrent_requests, 1)};
+    for (size_t i = 0; i < num_downloader_threads; ++i) {
+        auto& downloader_thread{
+                m_downloader_threads.emplace_back(std::make_unique<DownloaderThread>(*this))
+        };
+        downloader_thread->start();
+    }
+}
+
+ParallelNetworkReader::~ParallelNetworkReader() {
+    // Abort any ongoing downloads so the downloader threads can destroy their CURL resources and
+    // exit.
+    m_abort_download_requested.store(true);
+    {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        m_downloader_cv.notify_all();
+    }
+    for (auto& downloader_thread : m_downloader_threads) {
+        downloader_thread->join();
+    }
+}
+
+auto ParallelNetworkReader::try_seek_from_begin(size_t pos) -> ErrorCode {
+    if (pos < m_file_pos) {
+        return ErrorCode_Unsupported;
+    }
+    if (pos == m_file_pos) {
+        return ErrorCode_Success;
+    }
+    size_t num_bytes_read{};
+    auto const num_bytes_to_read{pos - m_file_pos};
+    auto const err{read_from_chunks(num_bytes_to_read, num_bytes_read, nullptr)};
+    if (ErrorCode_EndOfFile == err
+        || (ErrorCode_Success == err && num_bytes_read < num_bytes_to_read))
+    {
+        return ErrorCode_OutOfBounds;
+    }
+    return err;
+}
+
+auto ParallelNetworkReader::download_chunks() -> void {
+    while (true) {
+        size_t offset{};
+        Chunk* chunk{nullptr};
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            auto const should_stop{[&] {
+                return is_abort_download_requested() || m_failure.has_value()
+                       || (m_end_offset.has_value() && m_next_chunk_offset >= m_end_offset.value());
+            }};
+            m_downloader_cv.wait(lock, [&] {
+                return should_stop() || m_chunks.size() < m_max_num_resident_chunks;
+            });
+            if (should_stop()) {
+                return;
+            }
+            offset = m_next_chunk_offset;
+            chunk = &m_chunks[offset];
+            chunk->size_requested = m_chunk_size;
+            m_next_chunk_offset += m_chunk_size;
+        }
+
+        // NOTE: Nodes in `m_chunks` are stable and the reader thread doesn't access a chunk until
+        // it's complete, so the chunk can be filled without holding the lock.
+        download_chunk(offset, *chunk);
+    }
+}
+
+auto ParallelNetworkReader::download_chunk(size_t offset, Chunk& chunk) -> void {
+    chunk.data.reserve(chunk.size_requested);
+    ChunkTransfer transfer{this, &chunk.data, chunk.size_requested};
+    auto const error_msg_buf{std::make_shared<CurlDownloadHandler::ErrorMsgBuf>()};
+    CURLcode ret_code{CURLE_OK};
+    long response_code{0};
+    std::string error_msg;
+    auto const start_time{std::chrono::steady_clock::now()};
+    try {
+        CurlDownloadHandler curl_handler{
+                error_msg_buf,
+                curl_progress_callback,
+                curl_write_callback,
+                static_cast<void*>(&transfer),
+                m_src_url,
+                offset,
+                m_disable_caching,
+                m_connection_timeout,
+                m_overall_timeout,
+                offset + chunk.size_requested - 1
+        };
+        ret_code = curl_handler.perform();
+        response_code = curl_handler.get_response_code();
+        error_msg = error_msg_buf->data();
+    } catch (CurlOperationFailed const& ex) {
+        ret_code = ex.get_curl_err();
+        error_msg = ex.what();
+    }
+    auto const download_duration{std::chrono::steady_clock::now() - start_time};
+
+    // A server that doesn't support range requests either responds with more data than requested
+    // or responds to a request with a non-zero offset with the entire data (status 200).
+    constexpr long cHttpOk{200};
+    constexpr long cHttpRangeNotSatisfiable{416};
+    if (transfer.exceeded_size_requested
+        || (CURLE_OK == ret_code && cHttpOk == response_code && 0 != offset))
+    {
+        ret_code = CURLE_RANGE_ERROR;
+        error_msg = "The server doesn't support range requests.";
+    }
+
+    std::lock_guard<std::mutex> const lock{m_mutex};
+    chunk.is_complete = true;
+    auto const set_end_offset{[&](size_t end_offset) {
+        if (false == m_end_offset.has_value() || end_offset < m_end_offset.value()) {
+            m_end_offset = end_offset;
+        }
+    }};
+    if (CURLE_OK == ret_code) {
+        if (chunk.data.size() < chunk.size_requested) {
+            set_end_offset(offset + chunk.data.size());
+        } else if (download_duration < cChunkSizeIncreaseThreshold) {
+            m_chunk_size = std::min(2 * m_chunk_size, m_max_chunk_size);
+        }
+    } else if (cHttpRangeNotSatisfiable == response_code || CURLE_BAD_DOWNLOAD_RESUME == ret_code)
+    {
+        // The chunk begins at or past the end of the data
+        chunk.data.clear();
+        set_end_offset(offset);
+    } else {
+        chunk.has_failed = true;
+        if (false == is_abort_download_requested()
+            && (false == m_failure.has_value() || offset < m_failure->offset))
+        {
+            m_failure = Failure{offset, ret_code, std::move(error_msg)};
+        }
+    }
+    m_reader_cv.notify_all();
+    m_downloader_cv.notify_all();
+}
+
+auto ParallelNetworkReader::get_next_chunk() -> ErrorCode {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true) {
+        // NOTE: The end of the data must be checked first since chunks past the end may fail.
+        if (m_end_offset.has_value() && m_file_pos >= m_end_offset.value()) {
+            return ErrorCode_EndOfFile;
+        }
+        if (false == m_chunks.empty()) {
+            auto const next_chunk_it{m_chunks.begin()};
+            auto& next_chunk{next_chunk_it->second};
+            if (next_chunk.is_complete) {
+                if (next_chunk.has_failed) {
+                    return ErrorCode_Failure;
+                }
+                m_curr_reader_chunk = std::move(next_chunk.data);
+                m_curr_reader_chunk_pos = 0;
+                m_chunks.erase(next_chunk_it);
+                m_downloader_cv.notify_all();
+                return ErrorCode_Success;
+            }
+        }
+        m_reader_cv.wait(lock);
+    }
+}
+
+auto ParallelNetworkReader::read_from_chunks(
+        size_t num_bytes_to_read,
+        size_t& num_bytes_read,
+        char* dst
+) -> ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_to_read > 0) {
+        if (m_curr_reader_chunk.size() == m_curr_reader_chunk_pos) {
+            if (auto const err{get_next_chunk()}; ErrorCode_Success != err) {
+                return num_bytes_read > 0 ? ErrorCode_Success : err;
+            }
+            continue;
+        }
+
+        auto const num_bytes_to_copy{
+                std::min(num_bytes_to_read, m_curr_reader_chunk.size() - m_curr_reader_chunk_pos)
+        };
+        if (nullptr != dst) {
+            std::memcpy(
+                    dst + num_bytes_read,
+                    m_curr_reader_chunk.data() + m_curr_reader_chunk_pos,
+                    num_bytes_to_copy
+            );
+        }
+        m_curr_reader_chunk_pos += num_bytes_to_copy;
+        num_bytes_to_read -= num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+        m_file_pos += num_bytes_to_copy;
+    }
+    return ErrorCode_Success;
+}
+}  // namespace clp
@@ -0,0 +1,281 @@
+#ifndef CLP_PARALLELNETWORKREADER_HPP
+#define CLP_PARALLELNETWORKREADER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "CurlDownloadHandler.hpp"
+#include "CurlGlobalInstance.hpp"
+#include "ErrorCode.hpp"
+#include "ReaderInterface.hpp"
+#include "Thread.hpp"
+#include "TraceableException.hpp"
+
+namespace clp {
+/**
+ * This class implements the ReaderInterface to stream data from a given URL (e.g., a pre-signed S3
+ * URL) using several concurrent range requests. Unlike `NetworkReader`, which downloads the data
+ * using a single transfer, this class splits the data into consecutive chunks, downloads up to
+ * `num_concurrent_requests` chunks at once (each using a ranged GET), and reassembles them in
+ * order. This can significantly improve throughput when a single stream from an object store is
+ * far slower than the available bandwidth.
+ *
+ * Chunk sizes adapt to the download speed: starting at `initial_chunk_size`, the chunk size is
+ * doubled (up to `max_chunk_size`) whenever a full chunk is downloaded in less than
+ * `cChunkSizeIncreaseThreshold`, so that fast connections aren't dominated by per-request latency.
+ *
+ * To bound memory usage, at most `2 * num_concurrent_requests` chunks can be downloading or
+ * waiting to be read at any time. When the limit is reached, downloader threads block until the
+ * reader consumes a chunk.
+ *
+ * The end of the data is detected when a chunk is shorter than requested, or when a range starts
+ * at or past the end of the data (e.g., HTTP 416).
+ */
+class ParallelNetworkReader : public ReaderInterface {
+public:
+    // Types
+    /**
+     * The exception thrown by this class.
+     */
+    class OperationFailed : public TraceableException {
+    public:
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "clp::ParallelNetworkReader operation failed.";
+        }
+    };
+
+    // Constants
+    static constexpr size_t cDefaultNumConcurrentRequests{4};
+    static constexpr size_t cDefaultInitialChunkSize{1024 * 1024};
+    static constexpr size_t cDefaultMaxChunkSize{16 * 1024 * 1024};
+
+    static constexpr size_t cMinChunkSize{512};
+    static constexpr std::chrono::milliseconds cChunkSizeIncreaseThreshold{500};
+
+    // Constructors
+    /**
+     * Constructs a reader to stream data from the given URL, starting at the given offset.
+     * NOTE: This class depends on `libcurl`, so an instance of `clp::CurlGlobalInstance` must
+     * remain alive for the entire lifespan of any instance of this class. See `NetworkReader` for
+     * details.
+     *
+     * @param src_url
+     * @param offset Index of the byte at which to start the download
+     * @param disable_caching Whether to disable the caching.
+     * @param overall_timeout Maximum time that the download of each chunk may take. Note that this
+     * includes `connection_timeout`. Doc: https://curl.se/libcurl/c/CURLOPT_TIMEOUT.html
+     * @param connection_timeout Maximum time that the connection phase of each chunk's download
+     * may take. Doc: https://curl.se/libcurl/c/CURLOPT_CONNECTTIMEOUT.html
+     * @param num_concurrent_requests The maximum number of chunks to download concurrently.
+     * @param initial_chunk_size The size of the first chunks to download.
+     * @param max_chunk_size The maximum size that chunks can grow to.
+     */
+    explicit ParallelNetworkReader(
+            std::string_view src_url,
+            size_t offset = 0,
+            bool disable_caching = false,
+            std::chrono::seconds overall_timeout = CurlDownloadHandler::cDefaultOverallTimeout,
+            std::chrono::seconds connection_timeout
+            = CurlDownloadHandler::cDefaultConnectionTimeout,
+            size_t num_concurrent_requests = cDefaultNumConcurrentRequests,
+            size_t initial_chunk_size = cDefaultInitialChunkSize,
+            size_t max_chunk_size = cDefaultMaxChunkSize
+    );
+
+    // Destructor
+    ~ParallelNetworkReader() override;
+
+    // Copy/Move Constructors
+    // These are disabled since this class' synchronization primitives are non-copyable and
+    // non-moveable.
+    ParallelNetworkReader(ParallelNetworkReader const&) = delete;
+    ParallelNetworkReader(ParallelNetworkReader&&) = delete;
+    auto operator=(ParallelNetworkReader const&) -> ParallelNetworkReader& = delete;
+    auto operator=(ParallelNetworkReader&&) -> ParallelNetworkReader& = delete;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * Tries to read up to a given number of bytes from the downloaded chunks.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if there is no more data.
+     * @return ErrorCode_Failure if the download of the next chunk failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto
+    try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read) -> ErrorCode override {
+        return read_from_chunks(num_bytes_to_read, num_bytes_read, buf);
+    }
+
+    /**
+     * Tries to seek to the given position, relative to the beginning of the data.
+     * @param pos
+     * @return ErrorCode_Unsupported if the given position is lower than the current position.
+     * Since this class only supports streaming, it cannot seek backwards.
+     * @return ErrorCode_OutOfBounds if the given pos is past the end of the data.
+     * @return ErrorCode_Failure if the download of a chunk failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> ErrorCode override;
+
+    /**
+     * @param pos Returns the position of the read head.
+     * @return ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> ErrorCode override {
+        pos = m_file_pos;
+        return ErrorCode_Success;
+    }
+
+    // Methods
+    /**
+     * @return The curl return code of the first failed chunk download.
+     * @return std::nullopt if no chunk download has failed.
+     */
+    [[nodiscard]] auto get_curl_ret_code() const -> std::optional<CURLcode> {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        if (false == m_failure.has_value()) {
+            return std::nullopt;
+        }
+        return m_failure->curl_ret_code;
+    }
+
+    /**
+     * @return The error message of the first failed chunk download.
+     * @return std::nullopt if no chunk download has failed.
+     */
+    [[nodiscard]] auto get_curl_error_msg() const -> std::optional<std::string> {
+        std::lock_guard<std::mutex> const lock{m_mutex};
+        if (false == m_failure.has_value()) {
+            return std::nullopt;
+        }
+        return m_failure->error_msg;
+    }
+
+    /**
+     * @return Whether the caller requested that all downloads be aborted.
+     */
+    [[nodiscard]] auto is_abort_download_requested() const -> bool {
+        return m_abort_download_requested.load();
+    }
+
+private:
+    // Types
+    /**
+     * A consecutive range of the data that's being downloaded or waiting to be read.
+     */
+    struct Chunk {
+        std::vector<char> data;
+        size_t size_requested{0};
+        bool is_complete{false};
+        bool has_failed{false};
+    };
+
+    /**
+     * Details of a failed chunk download.
+     */
+    struct Failure {
+        size_t offset{0};
+        CURLcode curl_ret_code{CURLE_OK};
+        std::string error_msg;
+    };
+
+    /**
+     * This class implements clp::Thread to download chunks using CURL.
+     */
+    class DownloaderThread : public Thread {
+    public:
+        // Constructor
+        explicit DownloaderThread(ParallelNetworkReader& reader) : m_reader{reader} {}
+
+    private:
+        // Methods implementing `clp::Thread`
+        auto thread_method() -> void final { m_reader.download_chunks(); }
+
+        ParallelNetworkReader& m_reader;
+    };
+
+    // Methods
+    /**
+     * Repeatedly claims and downloads the next chunk until the end of the data is reached, a
+     * download fails, or the reader is destroyed.
+     * NOTE: This function should be called by the downloader threads only.
+     */
+    auto download_chunks() -> void;
+
+    /**
+     * Downloads the given chunk and records the outcome.
+     * @param offset
+     * @param chunk
+     */
+    auto download_chunk(size_t offset, Chunk& chunk) -> void;
+
+    /**
+     * Waits for the next chunk to be downloaded and makes it the current reader chunk.
+     * @return ErrorCode_EndOfFile if there are no more chunks.
+     * @return ErrorCode_Failure if the download of the next chunk failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto get_next_chunk() -> ErrorCode;
+
+    /**
+     * Reads data from the downloaded chunks with a given amount of bytes.
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @param dst A pointer to a destination buffer. If the pointer is not null, data will be
+     * copied to the destination.
+     * @return ErrorCode_EndOfFile if there is no more data.
+     * @return ErrorCode_Failure if the download of the next chunk failed.
+     * @return ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto
+    read_from_chunks(size_t num_bytes_to_read, size_t& num_bytes_read, char* dst) -> ErrorCode;
+
+    CurlGlobalInstance m_curl_global_instance;
+
+    std::string m_src_url;
+    bool m_disable_caching{false};
+
+    std::chrono::seconds m_overall_timeout;
+    std::chrono::seconds m_connection_timeout;
+
+    size_t m_max_num_resident_chunks;
+    size_t m_max_chunk_size;
+
+    // Only accessed by the reader thread
+    size_t m_file_pos{0};
+    std::vector<char> m_curr_reader_chunk;
+    size_t m_curr_reader_chunk_pos{0};
+
+    // State shared with the downloader threads
+    mutable std::mutex m_mutex;
+    std::condition_variable m_downloader_cv;
+    std::condition_variable m_reader_cv;
+    size_t m_next_chunk_offset;
+    size_t m_chunk_size;
+    // Chunks that are downloading or waiting to be read, indexed by their offset
+    std::map<size_t, Chunk> m_chunks;
+    std::optional<size_t> m_end_offset;
+    std::optional<Failure> m_failure;
+
+    std::atomic<bool> m_abort_download_requested{false};
+    std::vector<std::unique_ptr<DownloaderThread>> m_downloader_threads;
+};
+}  // namespace clp
+
+#endif  // CLP_PARALLELNETWORKREADER_HPP
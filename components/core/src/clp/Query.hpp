@@ -3,9 +3,12 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
+#include <string_utils/WildcardMatcher.hpp>
+
 #include "Defs.h"
 #include "LogTypeDictionaryEntry.hpp"
 #include "VariableDictionaryEntry.hpp"
@@ -196,6 +199,14 @@ public:
      */
     bool search_string_matches_all() const { return m_search_string_matches_all; }
 
+    /**
+     * @param message
+     * @return Whether the given message matches the search string
+     */
+    [[nodiscard]] bool search_string_matches(std::string_view message) const {
+        return m_search_string_matcher.matches(message);
+    }
+
     std::vector<SubQuery> const& get_sub_queries() const { return m_sub_queries; }
 
     bool contains_sub_queries() const { return m_sub_queries.empty() == false; }
@@ -212,6 +223,7 @@ private:
     epochtime_t m_search_end_timestamp{cEpochTimeMax};
     bool m_ignore_case{false};
     std::string m_search_string;
+    string_utils::WildcardMatcher m_search_string_matcher;
     bool m_search_string_matches_all{true};
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
@@ -0,0 +1,50 @@
+#ifndef CLP_THREADJOINER_HPP
+#define CLP_THREADJOINER_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace clp {
+/**
+ * Stops and joins a pool of worker threads when destroyed, so that the workers are joined even if
+ * the thread that owns them throws. The workers are expected to return soon after the given stop
+ * flag is set.
+ */
+class ThreadJoiner {
+public:
+    // Constructors
+    ThreadJoiner(std::vector<std::thread>& threads, std::atomic_bool& stop_requested)
+            : m_threads{threads},
+              m_stop_requested{stop_requested} {}
+
+    // Delete copy & move constructors and assignment operators
+    ThreadJoiner(ThreadJoiner const&) = delete;
+    ThreadJoiner(ThreadJoiner&&) = delete;
+    auto operator=(ThreadJoiner const&) -> ThreadJoiner& = delete;
+    auto operator=(ThreadJoiner&&) -> ThreadJoiner& = delete;
+
+    // Destructor
+    ~ThreadJoiner() { join(); }
+
+    // Methods
+    /**
+     * Requests that the threads stop and joins every thread that hasn't already been joined
+     */
+    void join() {
+        m_stop_requested = true;
+        for (auto& thread : m_threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+private:
+    // Variables
+    std::vector<std::thread>& m_threads;
+    std::atomic_bool& m_stop_requested;
+};
+}  // namespace clp
+
+#endif  // CLP_THREADJOINER_HPP
@@ -7,9 +7,9 @@
 #include <date/include/date/date.h>
 
 #include "spdlog_with_specializations.hpp"
+#include "TimestampFormatter.hpp"
 
 using std::string;
-using std::to_string;
 using std::vector;
 
 // Static member default initialization
@@ -46,14 +46,6 @@ static char const* cMonthNames[cNumMonths]
            "December"};
 
 // File-scope functions
-/**
- * Converts a value to a padded string with the given length and appends it to the given string
- * @param value
- * @param padding_character
- * @param length
- * @param str
- */
-static void append_padded_value(int value, char padding_character, size_t length, string& str);
 /**
  * Converts a padded decimal integer string (from a larger string) to an integer
  * @param str String containing the numeric string
@@ -71,17 +63,6 @@ static bool convert_string_to_number(
         int& value
 );
 
-static void append_padded_value(
-        int const value,
-        char const padding_character,
-        size_t const length,
-        string& str
-) {
-    string value_str = to_string(value);
-    str.append(length - value_str.length(), padding_character);
-    str += value_str;
-}
-
 static bool convert_string_to_number(
         string const& str,
         size_t const begin_ix,
@@ -749,191 +730,8 @@ bool TimestampPattern::parse_timestamp(
 }
 
 void TimestampPattern::insert_formatted_timestamp(epochtime_t const timestamp, string& msg) const {
-    size_t msg_length = msg.length();
-
-    string new_msg;
-    // We add 50 as an estimate of the timestamp's length
-    new_msg.reserve(msg_length + 50);
-
-    // Find where timestamp should go
-    size_t ts_begin_ix = 0;
-    int num_spaces_found;
-    for (num_spaces_found = 0;
-         num_spaces_found < m_num_spaces_before_ts && ts_begin_ix < msg_length;
-         ++ts_begin_ix)
-    {
-        if (' ' == msg[ts_begin_ix]) {
-            ++num_spaces_found;
-        }
-    }
-    if (num_spaces_found < m_num_spaces_before_ts) {
-        SPDLOG_ERROR(
-                "{} has {} spaces, but pattern has {}",
-                msg.c_str(),
-                num_spaces_found,
-                m_num_spaces_before_ts
-        );
-        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
-    }
-
-    // Copy text before timestamp
-    new_msg.assign(msg, 0, ts_begin_ix);
-
-    // Separate parts of timestamp
-    auto timestamp_point
-            = date::sys_days(date::year(1970) / 1 / 1) + std::chrono::milliseconds(timestamp);
-    auto timestamp_date = date::floor<date::days>(timestamp_point);
-    int day_of_week_ix
-            = (date::year_month_weekday(timestamp_date).weekday_indexed().weekday() - date::Sunday)
-                      .count();
-    auto year_month_date = date::year_month_day(timestamp_date);
-    unsigned date = (unsigned)year_month_date.day();
-    unsigned month = (unsigned)year_month_date.month();
-    int year = (int)year_month_date.year();
-
-    auto time_of_day_duration = timestamp_point - timestamp_date;
-    auto time_of_day = date::make_time(time_of_day_duration);
-    int hour = time_of_day.hours().count();
-    int minute = time_of_day.minutes().count();
-    long second = time_of_day.seconds().count();
-    long millisecond = time_of_day.subseconds().count();
-
-    size_t const format_length = m_format.length();
-    ParserState state = ParserState::Literal;
-    for (size_t format_ix = 0; format_ix < format_length; ++format_ix) {
-        switch (state) {
-            case (ParserState::Literal):
-                if ('%' == m_format[format_ix]) {
-                    state = ParserState::FormatSpecifier;
-                } else {
-                    new_msg += m_format[format_ix];
-                }
-                break;
-            case (ParserState::FormatSpecifier): {
-                state = ParserState::Literal;
-                // Parse fields
-                switch (m_format[format_ix]) {
-                    case '%':
-                        new_msg += m_format[format_ix];
-                        break;
-                    case 'y': {  // Zero-padded year in century
-                        int value = year;
-                        if (year >= 2000) {
-                            // year must be in range [2000,2068]
-                            value -= 2000;
-                        } else {
-                            // year must be in range [1969,1999]
-                            value -= 1900;
-                        }
-                        append_padded_value(value, '0', 2, new_msg);
-                        break;
-                    }
-                    case 'Y':  // Zero-padded year with century
-                        append_padded_value(year, '0', 4, new_msg);
-                        break;
-                    case 'B':  // Month name
-                        new_msg += cMonthNames[month - 1];
-                        break;
-                    case 'b':  // Abbreviated month name
-                        new_msg += cAbbrevMonthNames[month - 1];
-                        break;
-                    case 'm':  // Zero-padded month
-                        append_padded_value(month, '0', 2, new_msg);
-                        break;
-                    case 'd':  // Zero-padded day in month
-                        append_padded_value(date, '0', 2, new_msg);
-                        break;
-                    case 'e':  // Space-padded day in month
-                        append_padded_value(date, ' ', 2, new_msg);
-                        break;
-                    case 'a':  // Abbreviated day of week
-                        new_msg += cAbbrevDaysOfWeek[day_of_week_ix];
-                        break;
-                    case 'p':  // Part of day
-                        if (hour > 11) {
-                            new_msg += "PM";
-                        } else {
-                            new_msg += "AM";
-                        }
-                        break;
-                    case 'H':  // Zero-padded hour on 24-hour clock
-                        append_padded_value(hour, '0', 2, new_msg);
-                        break;
-                    case 'k':  // Space-padded hour on 24-hour clock
-                        append_padded_value(hour, ' ', 2, new_msg);
-                        break;
-                    case 'I': {  // Zero-padded hour on 12-hour clock
-                        int value = hour;
-                        if (0 == value) {
-                            value = 12;
-                        } else if (value > 13) {
-                            value -= 12;
-                        }
-                        append_padded_value(value, '0', 2, new_msg);
-                        break;
-                    }
-                    case 'l': {  // Space-padded hour on 12-hour clock
-                        int value = hour;
-                        if (0 == value) {
-                            value = 12;
-                        } else if (value > 13) {
-                            value -= 12;
-                        }
-                        append_padded_value(value, ' ', 2, new_msg);
-                        break;
-                    }
-                    case 'M':  // Zero-padded minute
-                        append_padded_value(minute, '0', 2, new_msg);
-                        break;
-                    case 'S':  // Zero-padded second
-                        append_padded_value(second, '0', 2, new_msg);
-                        break;
-                    case '3':  // Zero-padded millisecond
-                        append_padded_value(millisecond, '0', 3, new_msg);
-                        break;
-                    case '#':  // Relative timestamp
-                        state = ParserState::RelativeTimestampUnit;
-                        break;
-                    default:
-                        throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
-                }
-                break;
-            }
-            case (ParserState::RelativeTimestampUnit):
-                switch (m_format[format_ix]) {
-                    case '3':  // Relative timestamp in milliseconds
-                        new_msg += std::to_string(timestamp);
-                        break;
-                    case '6': {  // Relative timestamp in microseconds
-                        auto millisecond_duration = std::chrono::milliseconds{timestamp};
-                        auto microsecond_duration
-                                = std::chrono::duration_cast<std::chrono::microseconds>(
-                                        millisecond_duration
-                                );
-                        new_msg += std::to_string(microsecond_duration.count());
-                        break;
-                    }
-                    case '9': {  // Relative timestamp in nanoseconds
-                        auto millisecond_duration = std::chrono::milliseconds{timestamp};
-                        auto nanosecond_duration
-                                = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                        millisecond_duration
-                                );
-                        new_msg += std::to_string(nanosecond_duration.count());
-                        break;
-                    }
-                    default:
-                        throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
-                }
-                state = ParserState::Literal;
-                break;
-            default:
-                throw OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
-        }
-    }
-    // Copy text after timestamp
-    new_msg.append(msg, ts_begin_ix, string::npos);
-    msg = new_msg;
+    TimestampFormatter formatter{*this};
+    formatter.insert_formatted_timestamp(timestamp, msg);
 }
 
 bool operator==(TimestampPattern const& lhs, TimestampPattern const& rhs) {
@@ -0,0 +1,23 @@
+#ifndef CLP_TRANSPARENTSTRINGHASH_HPP
+#define CLP_TRANSPARENTSTRINGHASH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace clp {
+/**
+ * A string hash that allows containers keyed by `std::string` to be probed with any value
+ * convertible to `std::string_view` (when paired with `std::equal_to<>`), so that lookups don't
+ * need to materialize a `std::string`.
+ */
+struct TransparentStringHash {
+    using is_transparent = void;
+
+    [[nodiscard]] auto operator()(std::string_view value) const noexcept -> size_t {
+        return std::hash<std::string_view>{}(value);
+    }
+};
+}  // namespace clp
+
+#endif  // CLP_TRANSPARENTSTRINGHASH_HPP
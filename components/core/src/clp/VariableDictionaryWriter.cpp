@@ -4,7 +4,7 @@
 #include "spdlog_with_specializations.hpp"
 
 namespace clp {
-bool VariableDictionaryWriter::add_entry(std::string const& value, variable_dictionary_id_t& id) {
+bool VariableDictionaryWriter::add_entry(std::string_view value, variable_dictionary_id_t& id) {
     bool new_entry = false;
 
     auto const ix = m_value_to_id.find(value);
@@ -23,8 +23,8 @@ bool VariableDictionaryWriter::add_entry(std::string const& value, variable_dict
         ++m_next_id;
 
         // Insert the ID obtained from the database into the dictionary
-        auto entry = VariableDictionaryEntry(value, id);
-        m_value_to_id[value] = id;
+        auto entry = VariableDictionaryEntry(std::string{value}, id);
+        m_value_to_id.emplace(value, id);
 
         new_entry = true;
 
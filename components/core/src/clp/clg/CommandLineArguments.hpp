@@ -48,6 +48,10 @@ public:
 
     GlobalMetadataDBConfig const& get_metadata_db_config() const { return m_metadata_db_config; }
 
+    std::string const& get_metrics_file_path() const { return m_metrics_file_path; }
+
+    size_t get_metrics_interval() const { return m_metrics_interval; }
+
 private:
     // Methods
     void print_basic_usage() const override;
@@ -61,6 +65,8 @@ private:
     OutputMethod m_output_method;
     epochtime_t m_search_begin_ts, m_search_end_ts;
     GlobalMetadataDBConfig m_metadata_db_config;
+    std::string m_metrics_file_path;
+    size_t m_metrics_interval{0};
 };
 }  // namespace clp::clg
 
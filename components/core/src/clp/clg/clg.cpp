@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <iostream>
+#include <optional>
 
 #include <log_surgeon/Lexer.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
@@ -10,6 +11,7 @@
 #include "../GlobalMySQLMetadataDB.hpp"
 #include "../GlobalSQLiteMetadataDB.hpp"
 #include "../Grep.hpp"
+#include "../Metrics.hpp"
 #include "../Profiler.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/Constants.hpp"
@@ -26,6 +28,7 @@ using clp::GlobalMetadataDB;
 using clp::GlobalMetadataDBConfig;
 using clp::Grep;
 using clp::load_lexer_from_file;
+using clp::Metrics;
 using clp::Profiler;
 using clp::Query;
 using clp::segment_id_t;
@@ -487,6 +490,15 @@ int main(int argc, char const* argv[]) {
             break;
     }
 
+    std::optional<Metrics::Exporter> metrics_exporter;
+    if (false == command_line_args.get_metrics_file_path().empty()) {
+        metrics_exporter.emplace(
+                command_line_args.get_program_name(),
+                command_line_args.get_metrics_file_path(),
+                command_line_args.get_metrics_interval()
+        );
+    }
+
     Profiler::start_continuous_measurement<Profiler::ContinuousMeasurementIndex::Search>();
 
     // Create vector of search strings
@@ -575,6 +587,19 @@ int main(int argc, char const* argv[]) {
             continue;
         }
 
+        // Skip the archive without opening it if its variable dictionary filter shows that it
+        // can't contain a match
+        if (false
+            == Grep::archive_may_contain_match(
+                    archive_path.string(),
+                    search_strings,
+                    command_line_args.ignore_case()
+            ))
+        {
+            SPDLOG_DEBUG("Skipping archive {} since it can't contain a match.", archive_id);
+            continue;
+        }
+
         // Open archive
         if (!open_archive(archive_path.string(), archive_reader)) {
             return -1;
@@ -12,6 +12,7 @@
 #include "../reducer/types.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../version.hpp"
+#include "constants.hpp"
 
 namespace po = boost::program_options;
 using std::cerr;
@@ -55,6 +56,20 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("FILE")
                             ->default_value(config_file_path),
                     "Use configuration options from FILE"
+            )
+            (
+                    "metrics-file",
+                    po::value<string>(&m_metrics_file_path)
+                            ->value_name("FILE")
+                            ->default_value(m_metrics_file_path),
+                    "Collect metrics and write them to FILE as a JSON document when the run ends"
+            )
+            (
+                    "metrics-interval",
+                    po::value<size_t>(&m_metrics_interval)
+                            ->value_name("SECONDS")
+                            ->default_value(m_metrics_interval),
+                    "Also write metrics to the metrics file every SECONDS (0 = disabled)"
             );
     // clang-format on
 
@@ -342,6 +357,11 @@ auto CommandLineArguments::parse_search_arguments(
             "count-by-time",
             po::value<int64_t>(&m_count_by_time_bucket_size)->value_name("SIZE"),
             "Count the number of results in each time span of the given size (ms)"
+    )(
+            "group-by",
+            po::value<vector<string>>(&m_group_by_keys)->value_name("KEY"),
+            "Count the number of results grouped by the value of KEY (orig_file_path or"
+            " orig_file_id). May be specified multiple times."
     );
     // clang-format on
 
@@ -595,15 +615,16 @@ auto CommandLineArguments::parse_search_arguments(
         throw invalid_argument("Unknown OUTPUT_HANDLER: " + output_handler_name);
     }
 
-    bool const aggregation_was_specified
-            = m_do_count_by_time_aggregation || m_do_count_results_aggregation;
+    bool const aggregation_was_specified = m_do_count_by_time_aggregation
+                                           || m_do_count_results_aggregation
+                                           || do_group_by_aggregation();
     if (aggregation_was_specified && OutputHandlerType::Reducer != m_output_handler_type) {
         throw invalid_argument("Aggregations are only supported with the reducer output handler.");
     }
     if ((false == aggregation_was_specified && OutputHandlerType::Reducer == m_output_handler_type))
     {
-        throw invalid_argument("The reducer output handler currently only supports count and "
-                               "count-by-time aggregations.");
+        throw invalid_argument("The reducer output handler currently only supports count, "
+                               "count-by-time, and group-by aggregations.");
     }
 
     if (m_do_count_by_time_aggregation && m_do_count_results_aggregation) {
@@ -611,6 +632,20 @@ auto CommandLineArguments::parse_search_arguments(
                 "The --count-by-time and --count options are mutually exclusive."
         );
     }
+
+    if (do_group_by_aggregation()) {
+        if (m_do_count_by_time_aggregation || m_do_count_results_aggregation) {
+            throw invalid_argument("The --group-by option is mutually exclusive with the --count "
+                                   "and --count-by-time options.");
+        }
+        for (auto const& key : m_group_by_keys) {
+            if (cResultsCacheKeys::SearchOutput::OrigFilePath != key
+                && cResultsCacheKeys::OrigFileId != key)
+            {
+                throw invalid_argument("Unsupported group-by key: " + key);
+            }
+        }
+    }
     return ParsingResult::Success;
 }
 
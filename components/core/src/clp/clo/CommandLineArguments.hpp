@@ -64,6 +64,10 @@ public:
         return m_ir_mongodb_collection;
     }
 
+    std::string const& get_metrics_file_path() const { return m_metrics_file_path; }
+
+    size_t get_metrics_interval() const { return m_metrics_interval; }
+
     // Search arguments
     bool ignore_case() const { return m_ignore_case; }
 
@@ -99,6 +103,10 @@ public:
 
     int64_t get_count_by_time_bucket_size() const { return m_count_by_time_bucket_size; }
 
+    bool do_group_by_aggregation() const { return false == m_group_by_keys.empty(); }
+
+    std::vector<std::string> const& get_group_by_keys() const { return m_group_by_keys; }
+
     OutputHandlerType get_output_handler_type() const { return m_output_handler_type; }
 
 private:
@@ -182,6 +190,8 @@ private:
 
     Command m_command;
     std::string m_archive_path;
+    std::string m_metrics_file_path;
+    size_t m_metrics_interval{0};
 
     // Variables for IR extraction
     std::string m_file_split_id;
@@ -214,6 +224,7 @@ private:
     bool m_do_count_results_aggregation{false};
     bool m_do_count_by_time_aggregation{false};
     int64_t m_count_by_time_bucket_size{0};  // Milliseconds
+    std::vector<std::string> m_group_by_keys;
 
     OutputHandlerType m_output_handler_type{OutputHandlerType::ResultsCache};
 };
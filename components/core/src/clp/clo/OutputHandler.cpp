@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <msgpack.hpp>
 #include <spdlog/spdlog.h>
@@ -182,4 +183,54 @@ ErrorCode CountByTimeOutputHandler::flush() {
     }
     return ErrorCode::ErrorCode_Success;
 }
+
+GroupByCountOutputHandler::GroupByCountOutputHandler(
+        int reducer_socket_fd,
+        std::vector<string> const& group_by_keys
+)
+        : m_reducer_socket_fd{reducer_socket_fd} {
+    for (auto const& key : group_by_keys) {
+        if (cResultsCacheKeys::SearchOutput::OrigFilePath == key) {
+            m_group_by_fields.push_back(GroupByField::OrigFilePath);
+        } else if (cResultsCacheKeys::OrigFileId == key) {
+            m_group_by_fields.push_back(GroupByField::OrigFileId);
+        } else {
+            SPDLOG_ERROR("Unsupported group-by key {}", key);
+            throw OperationFailed(ErrorCode_BadParam, __FILE__, __LINE__);
+        }
+    }
+}
+
+ErrorCode GroupByCountOutputHandler::add_result(
+        string_view orig_file_path,
+        string_view orig_file_id,
+        [[maybe_unused]] Message const& encoded_message,
+        [[maybe_unused]] string_view decompressed_message
+) {
+    m_packed_group_key.clear();
+    for (auto const field : m_group_by_fields) {
+        switch (field) {
+            case GroupByField::OrigFilePath:
+                reducer::GroupByCountTable::append_tag(m_packed_group_key, orig_file_path);
+                break;
+            case GroupByField::OrigFileId:
+                reducer::GroupByCountTable::append_tag(m_packed_group_key, orig_file_id);
+                break;
+        }
+    }
+    m_group_counts.increment(m_packed_group_key);
+    return ErrorCode_Success;
+}
+
+ErrorCode GroupByCountOutputHandler::flush() {
+    if (false
+        == reducer::send_pipeline_results(
+                m_reducer_socket_fd,
+                m_group_counts.get_record_group_iterator(reducer::CountOperator::cRecordElementKey)
+        ))
+    {
+        return ErrorCode::ErrorCode_Failure_Network;
+    }
+    return ErrorCode::ErrorCode_Success;
+}
 }  // namespace clp::clo
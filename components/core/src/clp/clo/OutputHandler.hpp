@@ -6,12 +6,14 @@
 #include <queue>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
 #include <mongocxx/exception/exception.hpp>
 #include <mongocxx/uri.hpp>
 
+#include "../../reducer/GroupByCountTable.hpp"
 #include "../../reducer/Pipeline.hpp"
 #include "../Defs.h"
 #include "../streaming_archive/MetadataDB.hpp"
@@ -284,6 +286,59 @@ private:
     std::map<int64_t, int64_t> m_bucket_counts;
     int64_t m_count_by_time_bucket_size;
 };
+
+/**
+ * Output handler that performs a count aggregation grouped by the values of a set of result fields
+ * and sends the partial results to a reducer.
+ *
+ * Only fields which are available without decompressing the result (the original file's path and
+ * ID) can be grouped on.
+ */
+class GroupByCountOutputHandler : public OutputHandler {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        char const* what() const noexcept override {
+            return "GroupByCountOutputHandler operation failed";
+        }
+    };
+
+    // Constructors
+    GroupByCountOutputHandler(int reducer_socket_fd, std::vector<std::string> const& group_by_keys);
+
+    // Methods inherited from OutputHandler
+    ErrorCode add_result(
+            std::string_view orig_file_path,
+            std::string_view orig_file_id,
+            streaming_archive::reader::Message const& encoded_message,
+            std::string_view decompressed_message
+    ) override;
+
+    /**
+     * Flushes the counts.
+     * @return ErrorCode_Success on success
+     * @return ErrorCode_Failure_Network on network error
+     */
+    ErrorCode flush() override;
+
+private:
+    // Types
+    enum class GroupByField : uint8_t {
+        OrigFilePath,
+        OrigFileId
+    };
+
+    int m_reducer_socket_fd;
+    std::vector<GroupByField> m_group_by_fields;
+    std::string m_packed_group_key;
+    reducer::GroupByCountTable m_group_counts;
+};
 }  // namespace clp::clo
 
 #endif  // CLP_CLO_OUTPUTHANDLER_HPP
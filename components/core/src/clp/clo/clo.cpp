@@ -1,6 +1,7 @@
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <mongocxx/instance.hpp>
@@ -11,6 +12,7 @@
 #include "../Defs.h"
 #include "../Grep.hpp"
 #include "../ir/constants.hpp"
+#include "../Metrics.hpp"
 #include "../Profiler.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../Utils.hpp"
@@ -21,6 +23,7 @@
 using clp::clo::CommandLineArguments;
 using clp::clo::CountByTimeOutputHandler;
 using clp::clo::CountOutputHandler;
+using clp::clo::GroupByCountOutputHandler;
 using clp::clo::NetworkOutputHandler;
 using clp::clo::OutputHandler;
 using clp::clo::ResultsCacheOutputHandler;
@@ -36,6 +39,7 @@ using clp::ErrorCode_Success;
 using clp::Grep;
 using clp::ir::cIrFileExtension;
 using clp::load_lexer_from_file;
+using clp::Metrics;
 using clp::Query;
 using clp::streaming_archive::MetadataDB;
 using clp::streaming_archive::reader::Archive;
@@ -298,6 +302,11 @@ bool search(CommandLineArguments const& command_line_args) {
                             reducer_socket_fd,
                             command_line_args.get_count_by_time_bucket_size()
                     );
+                } else if (command_line_args.do_group_by_aggregation()) {
+                    output_handler = std::make_unique<GroupByCountOutputHandler>(
+                            reducer_socket_fd,
+                            command_line_args.get_group_by_keys()
+                    );
                 } else {
                     SPDLOG_ERROR("Unhandled aggregation type.");
                     return false;
@@ -397,6 +406,8 @@ static SearchFilesResult search_file(
             decompressed_message
     ))
     {
+        Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+        Metrics::increment(Metrics::Counter::NumMessagesOutput);
         if (ErrorCode_Success
             != output_handler->add_result(
                     compressed_file.get_orig_path(),
@@ -465,6 +476,18 @@ static bool search_archive(
         return false;
     }
 
+    // Skip the archive without opening it if its variable dictionary filter shows that it can't
+    // contain a match
+    if (false
+        == Grep::archive_may_contain_match(
+                archive_path.string(),
+                {command_line_args.get_search_string()},
+                command_line_args.ignore_case()
+        ))
+    {
+        return true;
+    }
+
     // Load lexers from schema file if it exists
     auto schema_file_path = archive_path / clp::streaming_archive::cSchemaFileName;
     unique_ptr<log_surgeon::lexers::ByteLexer> forward_lexer, reverse_lexer;
@@ -566,6 +589,15 @@ int main(int argc, char const* argv[]) {
             break;
     }
 
+    std::optional<Metrics::Exporter> metrics_exporter;
+    if (false == command_line_args.get_metrics_file_path().empty()) {
+        metrics_exporter.emplace(
+                command_line_args.get_program_name(),
+                command_line_args.get_metrics_file_path(),
+                command_line_args.get_metrics_interval()
+        );
+    }
+
     // mongocxx static init
     mongocxx::instance mongocxx_instance{};
     auto const& command = command_line_args.get_command();
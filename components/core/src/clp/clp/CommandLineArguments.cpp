@@ -58,6 +58,20 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("FILE")
                             ->default_value(global_metadata_db_config_file_path),
                     "Global metadata DB YAML config"
+            )
+            (
+                    "metrics-file",
+                    po::value<string>(&m_metrics_file_path)
+                            ->value_name("FILE")
+                            ->default_value(m_metrics_file_path),
+                    "Collect metrics and write them to FILE as a JSON document when the run ends"
+            )
+            (
+                    "metrics-interval",
+                    po::value<size_t>(&m_metrics_interval)
+                            ->value_name("SECONDS")
+                            ->default_value(m_metrics_interval),
+                    "Also write metrics to the metrics file every SECONDS (0 = disabled)"
             );
 
     // Define functional options
@@ -186,8 +200,18 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             extraction_positional_options_description.add("output-dir", 1);
             extraction_positional_options_description.add("paths", -1);
 
+            po::options_description options_extraction("Extraction Options");
+            options_extraction.add_options()(
+                    "num-threads",
+                    po::value<size_t>(&m_num_decompression_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_decompression_threads),
+                    "Number of archives to decompress concurrently"
+            );
+
             po::options_description all_extraction_options;
             all_extraction_options.add(extraction_positional_options);
+            all_extraction_options.add(options_extraction);
 
             // Parse extraction options
             vector<string> unrecognized_options
@@ -216,8 +240,14 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                      << endl;
                 cerr << endl;
 
+                cerr << "  # Extract all files using 8 threads" << endl;
+                cerr << "  " << get_program_name() << " x --num-threads 8 archives-dir output-dir"
+                     << endl;
+                cerr << endl;
+
                 po::options_description visible_options;
                 visible_options.add(options_general);
+                visible_options.add(options_extraction);
                 cerr << visible_options << endl;
                 return ParsingResult::InfoCommand;
             }
@@ -226,6 +256,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             if (m_archives_dir.empty()) {
                 throw invalid_argument("ARCHIVES_DIR cannot be empty.");
             }
+
+            if (0 == m_num_decompression_threads) {
+                throw invalid_argument("num-threads cannot be 0.");
+            }
         } else if (Command::ExtractIr == m_command) {
             // Define IR extraction hidden positional options
             po::options_description ir_positional_options;
@@ -75,6 +75,12 @@ public:
 
     size_t get_ir_target_size() const { return m_ir_target_size; }
 
+    size_t get_num_decompression_threads() const { return m_num_decompression_threads; }
+
+    std::string const& get_metrics_file_path() const { return m_metrics_file_path; }
+
+    size_t get_metrics_interval() const { return m_metrics_interval; }
+
     GlobalMetadataDBConfig const& get_metadata_db_config() const { return m_metadata_db_config; }
 
 private:
@@ -90,6 +96,7 @@ private:
     std::string m_orig_file_id;
     size_t m_ir_msg_ix{0};
     size_t m_ir_target_size{128ULL * 1024 * 1024};
+    size_t m_num_decompression_threads{1};
     bool m_sort_input_files;
     std::string m_ir_temp_output_dir;
     std::string m_output_dir;
@@ -104,6 +111,8 @@ private:
     std::string m_archives_dir;
     std::vector<std::string> m_input_paths;
     GlobalMetadataDBConfig m_metadata_db_config;
+    std::string m_metrics_file_path;
+    size_t m_metrics_interval{0};
 };
 }  // namespace clp::clp
 
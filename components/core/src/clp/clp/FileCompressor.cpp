@@ -14,6 +14,7 @@
 #include "../ir/types.hpp"
 #include "../ir/utils.hpp"
 #include "../LogSurgeonReader.hpp"
+#include "../Metrics.hpp"
 #include "../Profiler.hpp"
 #include "../streaming_archive/writer/utils.hpp"
 #include "../utf8_utils.hpp"
@@ -105,6 +106,7 @@ static void write_message_to_encoded_file(
     }
 
     archive.write_msg(msg.get_ts(), msg.get_content(), msg.get_orig_num_bytes());
+    clp::Metrics::increment(clp::Metrics::Counter::NumMessagesParsed);
 }
 
 namespace clp::clp {
@@ -120,6 +122,7 @@ bool FileCompressor::compress_file(
 
     PROFILER_SPDLOG_INFO("Start parsing {}", file_name)
     Profiler::start_continuous_measurement<Profiler::ContinuousMeasurementIndex::ParseLogFile>();
+    Metrics::ScopedTimer const parse_timer{Metrics::Stage::Parse};
 
     m_file_reader.open(file_to_compress.get_path());
 
@@ -184,6 +187,7 @@ bool FileCompressor::compress_file(
         }
     }
 
+    Metrics::increment(Metrics::Counter::BytesRead, m_file_reader.get_pos());
     m_file_reader.close();
 
     Profiler::stop_continuous_measurement<Profiler::ContinuousMeasurementIndex::ParseLogFile>();
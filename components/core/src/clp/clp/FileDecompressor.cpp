@@ -12,14 +12,7 @@ bool FileDecompressor::decompress_file(
         streaming_archive::reader::Archive& archive_reader,
         std::unordered_map<string, string>& temp_path_to_final_path
 ) {
-    // Open compressed file
-    auto error_code = archive_reader.open_file(m_encoded_file, file_metadata_ix);
-    if (ErrorCode_Success != error_code) {
-        if (ErrorCode_errno == error_code) {
-            SPDLOG_ERROR("Failed to open encoded file, errno={}", errno);
-        } else {
-            SPDLOG_ERROR("Failed to open encoded file, error_code={}", error_code);
-        }
+    if (false == open_encoded_file(file_metadata_ix, archive_reader)) {
         return false;
     }
 
@@ -43,7 +36,7 @@ bool FileDecompressor::decompress_file(
     }
 
     // Generate output directory
-    error_code = create_directory_structure(final_output_path.parent_path().string(), 0700);
+    auto error_code = create_directory_structure(final_output_path.parent_path().string(), 0700);
     if (ErrorCode_Success != error_code) {
         SPDLOG_ERROR(
                 "Failed to create directory structure {}, errno={}",
@@ -53,8 +46,52 @@ bool FileDecompressor::decompress_file(
         return false;
     }
 
+    decompress_encoded_file(temp_output_path.string(), open_mode, archive_reader);
+    return true;
+}
+
+bool FileDecompressor::decompress_file_to_path(
+        streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+        string const& output_path,
+        streaming_archive::reader::Archive& archive_reader,
+        string& orig_path,
+        string& orig_file_id,
+        bool& is_split
+) {
+    if (false == open_encoded_file(file_metadata_ix, archive_reader)) {
+        return false;
+    }
+    orig_path = m_encoded_file.get_orig_path();
+    orig_file_id = m_encoded_file.get_orig_file_id_as_string();
+    is_split = m_encoded_file.is_split();
+
+    decompress_encoded_file(output_path, FileWriter::OpenMode::CREATE_FOR_WRITING, archive_reader);
+    return true;
+}
+
+bool FileDecompressor::open_encoded_file(
+        streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+        streaming_archive::reader::Archive& archive_reader
+) {
+    auto error_code = archive_reader.open_file(m_encoded_file, file_metadata_ix);
+    if (ErrorCode_Success != error_code) {
+        if (ErrorCode_errno == error_code) {
+            SPDLOG_ERROR("Failed to open encoded file, errno={}", errno);
+        } else {
+            SPDLOG_ERROR("Failed to open encoded file, error_code={}", error_code);
+        }
+        return false;
+    }
+    return true;
+}
+
+void FileDecompressor::decompress_encoded_file(
+        string const& output_path,
+        FileWriter::OpenMode open_mode,
+        streaming_archive::reader::Archive& archive_reader
+) {
     // Open output file
-    m_decompressed_file_writer.open(temp_output_path.string(), open_mode);
+    m_decompressed_file_writer.open(output_path, open_mode);
 
     // Decompress
     archive_reader.reset_file_indices(m_encoded_file);
@@ -71,7 +108,5 @@ bool FileDecompressor::decompress_file(
     // Close files
     m_decompressed_file_writer.close();
     archive_reader.close_file(m_encoded_file);
-
-    return true;
 }
 }  // namespace clp::clp
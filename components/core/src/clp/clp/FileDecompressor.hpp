@@ -5,6 +5,8 @@
 #include <cstddef>
 #include <filesystem>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "../FileWriter.hpp"
 #include "../ir/constants.hpp"
@@ -33,6 +35,27 @@ public:
             std::unordered_map<std::string, std::string>& temp_path_to_final_path
     );
 
+    /**
+     * Decompresses the given file into a new file at the given path, rather than at its original
+     * path in an output directory. This allows files to be decompressed concurrently and moved to
+     * their original paths afterwards.
+     * @param file_metadata_ix
+     * @param output_path
+     * @param archive_reader
+     * @param orig_path Returns the original path of the file
+     * @param orig_file_id Returns the ID of the original file that the file is a split of
+     * @param is_split Returns whether the file is one of several splits of the original file
+     * @return Whether decompression was successful
+     */
+    bool decompress_file_to_path(
+            streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+            std::string const& output_path,
+            streaming_archive::reader::Archive& archive_reader,
+            std::string& orig_path,
+            std::string& orig_file_id,
+            bool& is_split
+    );
+
     /**
      * Decompresses the given file split into one or more IR files (chunks). The function creates a
      * new IR chunk when the current IR chunk exceeds ir_target_size.
@@ -58,11 +81,41 @@ public:
     ) -> bool;
 
 private:
+    // Methods
+    /**
+     * Opens the given file in the archive as m_encoded_file
+     * @param file_metadata_ix
+     * @param archive_reader
+     * @return Whether the file was opened successfully
+     */
+    bool open_encoded_file(
+            streaming_archive::MetadataDB::FileIterator const& file_metadata_ix,
+            streaming_archive::reader::Archive& archive_reader
+    );
+
+    /**
+     * Decompresses m_encoded_file into the file at the given path, and then closes m_encoded_file
+     * @param output_path
+     * @param open_mode
+     * @param archive_reader
+     */
+    void decompress_encoded_file(
+            std::string const& output_path,
+            FileWriter::OpenMode open_mode,
+            streaming_archive::reader::Archive& archive_reader
+    );
+
     // Variables
     FileWriter m_decompressed_file_writer;
     streaming_archive::reader::File m_encoded_file;
     streaming_archive::reader::Message m_encoded_message;
     std::string m_decompressed_message;
+
+    // Buffers for transcoding messages into IR
+    std::string m_ir_logtype;
+    std::vector<ir::four_byte_encoded_variable_t> m_ir_encoded_vars;
+    std::vector<std::string_view> m_ir_dict_vars;
+    std::string m_converted_ir_vars;
 };
 
 // Templated methods
@@ -114,11 +167,18 @@ auto FileDecompressor::decompress_to_ir(
     }
 
     while (archive_reader.get_next_message(m_encoded_file, m_encoded_message)) {
+        // Transcode the message directly rather than decompressing it into text, since the archive
+        // has already parsed it into a logtype and variables
         if (false
-            == archive_reader
-                       .decompress_message_without_ts(m_encoded_message, m_decompressed_message))
+            == archive_reader.transcode_message_to_four_byte_ir(
+                    m_encoded_message,
+                    m_ir_logtype,
+                    m_ir_encoded_vars,
+                    m_ir_dict_vars,
+                    m_converted_ir_vars
+            ))
         {
-            SPDLOG_ERROR("Failed to decompress message");
+            SPDLOG_ERROR("Failed to transcode message");
             return false;
         }
 
@@ -148,12 +208,14 @@ auto FileDecompressor::decompress_to_ir(
         if (false
             == ir_serializer.serialize_log_event(
                     m_encoded_message.get_ts_in_milli(),
-                    m_decompressed_message
+                    m_ir_logtype,
+                    m_ir_encoded_vars,
+                    m_ir_dict_vars
             ))
         {
             SPDLOG_ERROR(
-                    "Failed to serialize log event: {} with ts {}",
-                    m_decompressed_message.c_str(),
+                    "Failed to serialize log event with logtype id {} and ts {}",
+                    m_encoded_message.get_logtype_id(),
                     m_encoded_message.get_ts_in_milli()
             );
             return false;
@@ -1,14 +1,24 @@
 #include "decompression.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "../ErrorCode.hpp"
+#include "../FileReader.hpp"
 #include "../FileWriter.hpp"
 #include "../GlobalMySQLMetadataDB.hpp"
 #include "../GlobalSQLiteMetadataDB.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../streaming_archive/reader/Archive.hpp"
+#include "../ThreadJoiner.hpp"
 #include "../TraceableException.hpp"
 #include "../Utils.hpp"
 #include "FileDecompressor.hpp"
@@ -19,7 +29,410 @@ using std::cerr;
 using std::make_unique;
 using std::string;
 using std::unique_ptr;
+using std::unordered_map;
 using std::unordered_set;
+using std::vector;
+
+namespace {
+// Extension of the temporary files that files are decompressed into when archives are decompressed
+// concurrently
+constexpr std::string_view cDecompressedFilePartExtension{".part"};
+
+/**
+ * A file that was decompressed into a temporary path, and which still needs to be moved to its
+ * original path in the output directory
+ */
+struct DecompressedFilePart {
+    std::filesystem::path path;
+    string orig_path;
+    string orig_file_id;
+    bool is_split;
+};
+
+/**
+ * The files decompressed from an archive by a decompression worker, in the order they were
+ * decompressed
+ */
+struct ArchiveDecompressionResult {
+    vector<DecompressedFilePart> file_parts;
+    bool is_done{false};
+    bool is_successful{false};
+};
+}  // namespace
+
+// Local prototypes
+/**
+ * Gets the IDs of the archives that may contain any of the files to decompress, in the order that
+ * the archives should be decompressed
+ * @param global_metadata_db
+ * @param files_to_decompress
+ * @return The archive IDs
+ */
+static vector<string> get_archive_ids(
+        clp::GlobalMetadataDB& global_metadata_db,
+        unordered_set<string> const& files_to_decompress
+);
+
+/**
+ * Decompresses the files to decompress from the given archive, writing each file into a temporary
+ * path in the output directory
+ * @param command_line_args
+ * @param archive_id
+ * @param files_to_decompress
+ * @param result Returns the decompressed files
+ * @return Whether decompression was successful
+ */
+static bool decompress_archive_into_file_parts(
+        clp::clp::CommandLineArguments const& command_line_args,
+        string const& archive_id,
+        unordered_set<string> const& files_to_decompress,
+        ArchiveDecompressionResult& result
+);
+
+/**
+ * Moves a decompressed file into the output directory, in the same way that
+ * `FileDecompressor::decompress_file` would have written it. File parts must be committed in the
+ * order that they would have been decompressed serially.
+ * @param file_part
+ * @param output_dir
+ * @param temp_path_to_final_path
+ * @return Whether the file was committed successfully
+ */
+static bool commit_file_part(
+        DecompressedFilePart const& file_part,
+        std::filesystem::path const& output_dir,
+        unordered_map<string, string>& temp_path_to_final_path
+);
+
+/**
+ * Appends the content of one file to another
+ * @param src_path
+ * @param dest_path
+ */
+static void append_file(string const& src_path, string const& dest_path);
+
+/**
+ * Decompresses the given archives using a pool of workers, where each worker decompresses one
+ * archive at a time with its own archive reader. The decompressed files are committed to the
+ * output directory in archive order, so the output is the same as if the archives were
+ * decompressed serially.
+ * @param command_line_args
+ * @param archive_ids
+ * @param files_to_decompress
+ * @param decompressed_files Returns the original paths of the decompressed files
+ * @param temp_path_to_final_path Returns the temporary paths that must be renamed once
+ * decompression completes
+ * @return Whether decompression was successful
+ */
+static bool decompress_archives_concurrently(
+        clp::clp::CommandLineArguments const& command_line_args,
+        vector<string> const& archive_ids,
+        unordered_set<string> const& files_to_decompress,
+        unordered_set<string>& decompressed_files,
+        unordered_map<string, string>& temp_path_to_final_path
+);
+
+static vector<string> get_archive_ids(
+        clp::GlobalMetadataDB& global_metadata_db,
+        unordered_set<string> const& files_to_decompress
+) {
+    unique_ptr<clp::GlobalMetadataDB::ArchiveIterator> archive_ix;
+    if (files_to_decompress.size() == 1) {
+        archive_ix.reset(
+                global_metadata_db.get_archive_iterator_for_file_path(*files_to_decompress.begin())
+        );
+    } else {
+        archive_ix.reset(global_metadata_db.get_archive_iterator());
+    }
+
+    vector<string> archive_ids;
+    string archive_id;
+    for (; archive_ix->contains_element(); archive_ix->get_next()) {
+        archive_ix->get_id(archive_id);
+        archive_ids.push_back(archive_id);
+    }
+    return archive_ids;
+}
+
+static bool decompress_archive_into_file_parts(
+        clp::clp::CommandLineArguments const& command_line_args,
+        string const& archive_id,
+        unordered_set<string> const& files_to_decompress,
+        ArchiveDecompressionResult& result
+) {
+    auto const archive_path = std::filesystem::path(command_line_args.get_archives_dir())
+                              / archive_id;
+    if (files_to_decompress.empty() && false == std::filesystem::exists(archive_path)) {
+        SPDLOG_WARN(
+                "Archive {} does not exist in '{}'.",
+                archive_id,
+                command_line_args.get_archives_dir()
+        );
+        return true;
+    }
+
+    clp::streaming_archive::reader::Archive archive_reader;
+    archive_reader.open(archive_path.string());
+    archive_reader.refresh_dictionaries();
+
+    unique_ptr<clp::streaming_archive::MetadataDB::FileIterator> file_metadata_ix_ptr;
+    if (files_to_decompress.empty()) {
+        archive_reader.decompress_empty_directories(command_line_args.get_output_dir());
+        file_metadata_ix_ptr = archive_reader.get_file_iterator();
+    } else if (files_to_decompress.size() == 1) {
+        file_metadata_ix_ptr
+                = archive_reader.get_file_iterator_by_path(*files_to_decompress.begin());
+    } else {
+        file_metadata_ix_ptr = archive_reader.get_file_iterator();
+    }
+
+    clp::clp::FileDecompressor file_decompressor;
+    std::filesystem::path const output_dir{command_line_args.get_output_dir()};
+    string file_id;
+    string orig_path;
+    for (auto& file_metadata_ix = *file_metadata_ix_ptr; file_metadata_ix.has_next();
+         file_metadata_ix.next())
+    {
+        if (files_to_decompress.size() > 1) {
+            file_metadata_ix.get_path(orig_path);
+            if (files_to_decompress.count(orig_path) == 0) {
+                // Skip files that aren't in the list of files to decompress
+                continue;
+            }
+        }
+
+        // Add the part before decompressing so that it's cleaned up if decompression fails
+        file_metadata_ix.get_id(file_id);
+        auto& file_part = result.file_parts.emplace_back();
+        file_part.path = output_dir / file_id;
+        file_part.path += cDecompressedFilePartExtension;
+        if (false
+            == file_decompressor.decompress_file_to_path(
+                    file_metadata_ix,
+                    file_part.path.string(),
+                    archive_reader,
+                    file_part.orig_path,
+                    file_part.orig_file_id,
+                    file_part.is_split
+            ))
+        {
+            return false;
+        }
+    }
+    file_metadata_ix_ptr.reset(nullptr);
+
+    archive_reader.close();
+    return true;
+}
+
+static bool commit_file_part(
+        DecompressedFilePart const& file_part,
+        std::filesystem::path const& output_dir,
+        unordered_map<string, string>& temp_path_to_final_path
+) {
+    auto const final_output_path = output_dir / file_part.orig_path;
+
+    // Generate output directory
+    auto error_code = clp::create_directory_structure(
+            final_output_path.parent_path().string(),
+            0700
+    );
+    if (clp::ErrorCode_Success != error_code) {
+        SPDLOG_ERROR(
+                "Failed to create directory structure {}, errno={}",
+                final_output_path.parent_path().c_str(),
+                errno
+        );
+        return false;
+    }
+
+    std::error_code std_error_code;
+    if (false == file_part.is_split
+        && false == std::filesystem::exists(final_output_path, std_error_code))
+    {
+        std::filesystem::rename(file_part.path, final_output_path, std_error_code);
+        if (std_error_code) {
+            SPDLOG_ERROR(
+                    "Failed to rename {} to {} - {}",
+                    file_part.path.c_str(),
+                    final_output_path.c_str(),
+                    std_error_code.message()
+            );
+            return false;
+        }
+        return true;
+    }
+
+    // Like FileDecompressor::decompress_file, append the file to a temporary file that's renamed
+    // once decompression completes
+    auto const temp_output_path = (output_dir / file_part.orig_file_id).string();
+    if (0 == temp_path_to_final_path.count(temp_output_path)) {
+        temp_path_to_final_path[temp_output_path] = final_output_path.string();
+        std::filesystem::rename(file_part.path, temp_output_path, std_error_code);
+        if (std_error_code) {
+            SPDLOG_ERROR(
+                    "Failed to rename {} to {} - {}",
+                    file_part.path.c_str(),
+                    temp_output_path,
+                    std_error_code.message()
+            );
+            return false;
+        }
+    } else {
+        append_file(file_part.path.string(), temp_output_path);
+        std::filesystem::remove(file_part.path, std_error_code);
+    }
+    return true;
+}
+
+static void append_file(string const& src_path, string const& dest_path) {
+    constexpr size_t cBufferSize{64 * 1024};
+    auto buffer = std::make_unique<char[]>(cBufferSize);
+
+    clp::FileReader reader{src_path};
+    clp::FileWriter writer;
+    writer.open(dest_path, clp::FileWriter::OpenMode::CREATE_IF_NONEXISTENT_FOR_APPENDING);
+    size_t num_bytes_read{0};
+    while (clp::ErrorCode_Success == reader.try_read(buffer.get(), cBufferSize, num_bytes_read)) {
+        writer.write(buffer.get(), num_bytes_read);
+    }
+    writer.close();
+}
+
+static bool decompress_archives_concurrently(
+        clp::clp::CommandLineArguments const& command_line_args,
+        vector<string> const& archive_ids,
+        unordered_set<string> const& files_to_decompress,
+        unordered_set<string>& decompressed_files,
+        unordered_map<string, string>& temp_path_to_final_path
+) {
+    std::filesystem::path const output_dir{command_line_args.get_output_dir()};
+    auto error_code = clp::create_directory_structure(output_dir.string(), 0700);
+    if (clp::ErrorCode_Success != error_code) {
+        SPDLOG_ERROR("Failed to create {} - {}", output_dir.c_str(), strerror(errno));
+        return false;
+    }
+
+    vector<ArchiveDecompressionResult> results(archive_ids.size());
+    std::mutex results_mutex;
+    std::condition_variable result_done_cv;
+    std::atomic_size_t next_archive_ix{0};
+    std::atomic_bool stop_requested{false};
+
+    auto worker = [&]() {
+        while (false == stop_requested.load(std::memory_order_relaxed)) {
+            auto const archive_ix = next_archive_ix.fetch_add(1, std::memory_order_relaxed);
+            if (archive_ix >= archive_ids.size()) {
+                break;
+            }
+
+            ArchiveDecompressionResult result;
+            try {
+                result.is_successful = decompress_archive_into_file_parts(
+                        command_line_args,
+                        archive_ids[archive_ix],
+                        files_to_decompress,
+                        result
+                );
+            } catch (clp::TraceableException& e) {
+                SPDLOG_ERROR(
+                        "Failed to decompress archive {}: {}:{} {}, error_code={}, errno={}",
+                        archive_ids[archive_ix],
+                        e.get_filename(),
+                        e.get_line_number(),
+                        e.what(),
+                        e.get_error_code(),
+                        errno
+                );
+                result.is_successful = false;
+            } catch (std::exception const& e) {
+                SPDLOG_ERROR(
+                        "Failed to decompress archive {}: {}",
+                        archive_ids[archive_ix],
+                        e.what()
+                );
+                result.is_successful = false;
+            }
+            result.is_done = true;
+            if (false == result.is_successful) {
+                stop_requested = true;
+            }
+
+            std::lock_guard lock{results_mutex};
+            results[archive_ix] = std::move(result);
+            result_done_cv.notify_all();
+        }
+    };
+
+    auto const num_workers = std::min(
+            command_line_args.get_num_decompression_threads(),
+            archive_ids.size()
+    );
+    vector<std::thread> workers;
+    workers.reserve(num_workers);
+    clp::ThreadJoiner workers_joiner{workers, stop_requested};
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back(worker);
+    }
+
+    // Commit each archive's files as soon as the archive and all archives before it are done, so
+    // that files with the same path are written in the same order as serial decompression
+    bool is_successful{true};
+    size_t archive_ix{0};
+    try {
+        for (; archive_ix < archive_ids.size(); ++archive_ix) {
+            {
+                std::unique_lock lock{results_mutex};
+                result_done_cv.wait(lock, [&]() { return results[archive_ix].is_done; });
+            }
+            // Workers never modify a result after it's done, so it can be read without the lock
+            auto& result = results[archive_ix];
+
+            if (false == result.is_successful) {
+                is_successful = false;
+                break;
+            }
+            for (auto const& file_part : result.file_parts) {
+                if (false == commit_file_part(file_part, output_dir, temp_path_to_final_path)) {
+                    is_successful = false;
+                    break;
+                }
+                decompressed_files.insert(file_part.orig_path);
+            }
+            if (false == is_successful) {
+                break;
+            }
+            result.file_parts.clear();
+        }
+    } catch (clp::TraceableException& e) {
+        SPDLOG_ERROR(
+                "Failed to commit decompressed files: {}:{} {}, error_code={}, errno={}",
+                e.get_filename(),
+                e.get_line_number(),
+                e.what(),
+                e.get_error_code(),
+                errno
+        );
+        is_successful = false;
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to commit decompressed files: {}", e.what());
+        is_successful = false;
+    }
+
+    workers_joiner.join();
+
+    if (false == is_successful) {
+        // Clean up the parts that weren't committed. NOTE: Removing a part that was already
+        // committed fails harmlessly since it no longer exists.
+        std::error_code std_error_code;
+        for (; archive_ix < archive_ids.size(); ++archive_ix) {
+            for (auto const& file_part : results[archive_ix].file_parts) {
+                std::filesystem::remove(file_part.path, std_error_code);
+            }
+        }
+    }
+    return is_successful;
+}
 
 namespace clp::clp {
 bool decompress(
@@ -53,7 +466,20 @@ bool decompress(
         string orig_path;
         std::unordered_map<string, string> temp_path_to_final_path;
         global_metadata_db->open();
-        if (files_to_decompress.empty()) {
+        if (command_line_args.get_num_decompression_threads() > 1) {
+            auto const archive_ids = get_archive_ids(*global_metadata_db, files_to_decompress);
+            if (false
+                == decompress_archives_concurrently(
+                        command_line_args,
+                        archive_ids,
+                        files_to_decompress,
+                        decompressed_files,
+                        temp_path_to_final_path
+                ))
+            {
+                return false;
+            }
+        } else if (files_to_decompress.empty()) {
             for (auto archive_ix = std::unique_ptr<GlobalMetadataDB::ArchiveIterator>(
                          global_metadata_db->get_archive_iterator()
                  );
@@ -1,10 +1,12 @@
 #include "run.hpp"
 
+#include <optional>
 #include <unordered_set>
 
 #include <log_surgeon/LogParser.hpp>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include "../Metrics.hpp"
 #include "../Profiler.hpp"
 #include "../spdlog_with_specializations.hpp"
 #include "../Utils.hpp"
@@ -43,6 +45,15 @@ int run(int argc, char const* argv[]) {
             break;
     }
 
+    std::optional<Metrics::Exporter> metrics_exporter;
+    if (false == command_line_args.get_metrics_file_path().empty()) {
+        metrics_exporter.emplace(
+                command_line_args.get_program_name(),
+                command_line_args.get_metrics_file_path(),
+                command_line_args.get_metrics_interval()
+        );
+    }
+
     vector<string> input_paths = command_line_args.get_input_paths();
 
     Profiler::start_continuous_measurement<Profiler::ContinuousMeasurementIndex::Compression>();
@@ -1,6 +1,7 @@
 #include "encoding_methods.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <string_view>
 
 #include "../ir/types.hpp"
@@ -33,9 +34,54 @@ eight_byte_encoded_variable_t encode_four_byte_float_as_eight_byte(
     );
 }
 
+bool encode_eight_byte_float_as_four_byte(
+        eight_byte_encoded_variable_t eight_byte_encoded_var,
+        four_byte_encoded_variable_t& four_byte_encoded_var
+) {
+    uint8_t decimal_point_pos{};
+    uint8_t num_digits{};
+    uint64_t digits{};
+    bool is_negative{};
+    decode_float_properties(
+            eight_byte_encoded_var,
+            is_negative,
+            digits,
+            num_digits,
+            decimal_point_pos
+    );
+
+    // These are the same limits that encode_float_string applies to four-byte encoded floats
+    if (num_digits > cMaxDigitsInRepresentableFourByteFloatVar
+        || digits > cFourByteEncodedFloatDigitsBitMask)
+    {
+        return false;
+    }
+
+    four_byte_encoded_var = encode_float_properties<four_byte_encoded_variable_t>(
+            is_negative,
+            static_cast<uint32_t>(digits),
+            num_digits,
+            decimal_point_pos
+    );
+    return true;
+}
+
 eight_byte_encoded_variable_t encode_four_byte_integer_as_eight_byte(
         four_byte_encoded_variable_t four_byte_encoded_var
 ) {
     return static_cast<eight_byte_encoded_variable_t>(four_byte_encoded_var);
 }
+
+bool encode_eight_byte_integer_as_four_byte(
+        eight_byte_encoded_variable_t eight_byte_encoded_var,
+        four_byte_encoded_variable_t& four_byte_encoded_var
+) {
+    if (eight_byte_encoded_var < std::numeric_limits<four_byte_encoded_variable_t>::min()
+        || std::numeric_limits<four_byte_encoded_variable_t>::max() < eight_byte_encoded_var)
+    {
+        return false;
+    }
+    four_byte_encoded_var = static_cast<four_byte_encoded_variable_t>(eight_byte_encoded_var);
+    return true;
+}
 }  // namespace clp::ffi
@@ -76,6 +76,18 @@ ir::eight_byte_encoded_variable_t encode_four_byte_float_as_eight_byte(
         ir::four_byte_encoded_variable_t four_byte_encoded_var
 );
 
+/**
+ * Encodes the given eight-byte encoded float using the four-byte encoding, if it's representable
+ * using the four-byte encoding
+ * @param eight_byte_encoded_var
+ * @param four_byte_encoded_var Returns the float using the four-byte encoding
+ * @return true on success, false if the float isn't representable using the four-byte encoding
+ */
+bool encode_eight_byte_float_as_four_byte(
+        ir::eight_byte_encoded_variable_t eight_byte_encoded_var,
+        ir::four_byte_encoded_variable_t& four_byte_encoded_var
+);
+
 /**
  * Encodes a float value with the given properties into an encoded variable.
  * NOTE: It's the caller's responsibility to validate that the input is a representable float.
@@ -146,6 +158,18 @@ ir::eight_byte_encoded_variable_t encode_four_byte_integer_as_eight_byte(
         ir::four_byte_encoded_variable_t four_byte_encoded_var
 );
 
+/**
+ * Encodes the given eight-byte encoded integer using the four-byte encoding, if it's representable
+ * using the four-byte encoding
+ * @param eight_byte_encoded_var
+ * @param four_byte_encoded_var Returns the integer using the four-byte encoding
+ * @return true on success, false if the integer isn't representable using the four-byte encoding
+ */
+bool encode_eight_byte_integer_as_four_byte(
+        ir::eight_byte_encoded_variable_t eight_byte_encoded_var,
+        ir::four_byte_encoded_variable_t& four_byte_encoded_var
+);
+
 /**
  * Decodes the given encoded integer variable into a string
  * @tparam encoded_variable_t Type of the encoded variable
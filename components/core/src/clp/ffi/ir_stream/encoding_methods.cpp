@@ -1,16 +1,21 @@
 #include "encoding_methods.hpp"
 
+#include <span>
+#include <type_traits>
+
 #include <json/single_include/nlohmann/json.hpp>
 
 #include "../../ir/parsing.hpp"
 #include "../../ir/types.hpp"
 #include "../../time_types.hpp"
+#include "../../type_utils.hpp"
 #include "protocol_constants.hpp"
 #include "utils.hpp"
 
 using clp::ir::eight_byte_encoded_variable_t;
 using clp::ir::epoch_time_ms_t;
 using clp::ir::four_byte_encoded_variable_t;
+using std::span;
 using std::string;
 using std::string_view;
 using std::vector;
@@ -25,6 +30,25 @@ namespace clp::ffi::ir_stream {
  */
 static bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf);
 
+/**
+ * Serializes the given message, which has already been parsed into a logtype and variables, into
+ * the IR stream
+ * @tparam encoded_variable_t Type of the encoded variables
+ * @param logtype
+ * @param encoded_vars
+ * @param dict_vars
+ * @param ir_buf
+ * @return true on success, false if the variables don't match the logtype's placeholders or the
+ * message can't be encoded
+ */
+template <typename encoded_variable_t>
+static bool serialize_parsed_message(
+        string_view logtype,
+        span<encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars,
+        vector<int8_t>& ir_buf
+);
+
 /**
  * Adds the basic metadata fields to the given JSON object
  * @param timestamp_pattern
@@ -92,6 +116,52 @@ static bool serialize_logtype(string_view logtype, vector<int8_t>& ir_buf) {
     return true;
 }
 
+template <typename encoded_variable_t>
+static bool serialize_parsed_message(
+        string_view logtype,
+        span<encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars,
+        vector<int8_t>& ir_buf
+) {
+    // Variables are serialized in the order of their placeholders in the logtype
+    DictionaryVariableHandler dictionary_variable_handler(ir_buf);
+    size_t encoded_var_ix{0};
+    size_t dict_var_ix{0};
+    auto const logtype_length = logtype.length();
+    for (size_t i = 0; i < logtype_length; ++i) {
+        auto const c = logtype[i];
+        if (enum_to_underlying_type(ir::VariablePlaceholder::Escape) == c) {
+            // Skip the escaped character
+            ++i;
+        } else if (enum_to_underlying_type(ir::VariablePlaceholder::Integer) == c
+                   || enum_to_underlying_type(ir::VariablePlaceholder::Float) == c)
+        {
+            if (encoded_var_ix >= encoded_vars.size()) {
+                return false;
+            }
+            if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+                ir_buf.push_back(cProtocol::Payload::VarEightByteEncoding);
+            } else {
+                ir_buf.push_back(cProtocol::Payload::VarFourByteEncoding);
+            }
+            serialize_int(encoded_vars[encoded_var_ix++], ir_buf);
+        } else if (enum_to_underlying_type(ir::VariablePlaceholder::Dictionary) == c) {
+            if (dict_var_ix >= dict_vars.size()) {
+                return false;
+            }
+            auto const dict_var = dict_vars[dict_var_ix++];
+            if (false == dictionary_variable_handler(dict_var, 0, dict_var.length())) {
+                return false;
+            }
+        }
+    }
+    if (encoded_vars.size() != encoded_var_ix || dict_vars.size() != dict_var_ix) {
+        return false;
+    }
+
+    return serialize_logtype(logtype, ir_buf);
+}
+
 static void add_base_metadata_fields(
         string_view timestamp_pattern,
         string_view timestamp_pattern_syntax,
@@ -147,6 +217,24 @@ bool serialize_log_event(
     return true;
 }
 
+bool serialize_parsed_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        span<eight_byte_encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars,
+        vector<int8_t>& ir_buf
+) {
+    if (false == serialize_parsed_message(logtype, encoded_vars, dict_vars, ir_buf)) {
+        return false;
+    }
+
+    // Encode timestamp
+    ir_buf.push_back(cProtocol::Payload::TimestampVal);
+    serialize_int(timestamp, ir_buf);
+
+    return true;
+}
+
 bool serialize_message(
         std::string_view message,
         std::string& logtype,
@@ -216,6 +304,20 @@ bool serialize_log_event(
     return true;
 }
 
+bool serialize_parsed_log_event(
+        epoch_time_ms_t timestamp_delta,
+        string_view logtype,
+        span<four_byte_encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars,
+        vector<int8_t>& ir_buf
+) {
+    if (false == serialize_parsed_message(logtype, encoded_vars, dict_vars, ir_buf)) {
+        return false;
+    }
+
+    return serialize_timestamp(timestamp_delta, ir_buf);
+}
+
 bool serialize_message(string_view message, string& logtype, vector<int8_t>& ir_buf) {
     auto encoded_var_handler = [&ir_buf](four_byte_encoded_variable_t encoded_var) {
         ir_buf.push_back(cProtocol::Payload::VarFourByteEncoding);
@@ -1,6 +1,7 @@
 #ifndef CLP_FFI_IR_STREAM_ENCODING_METHODS_HPP
 #define CLP_FFI_IR_STREAM_ENCODING_METHODS_HPP
 
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -40,6 +41,25 @@ bool serialize_log_event(
         std::vector<int8_t>& ir_buf
 );
 
+/**
+ * Serializes the given log event, whose message has already been parsed into a logtype and
+ * variables, into the eight-byte encoding IR stream
+ * @param timestamp
+ * @param logtype The message's logtype, with placeholders and escapes as in the IR stream
+ * @param encoded_vars The message's encoded variables, in order
+ * @param dict_vars The message's dictionary variables, in order
+ * @param ir_buf
+ * @return true on success, false if the variables don't match the logtype's placeholders or the
+ * message can't be encoded
+ */
+bool serialize_parsed_log_event(
+        ir::epoch_time_ms_t timestamp,
+        std::string_view logtype,
+        std::span<ir::eight_byte_encoded_variable_t const> encoded_vars,
+        std::span<std::string_view const> dict_vars,
+        std::vector<int8_t>& ir_buf
+);
+
 /**
  * Serializes the given message into the eight-byte encoding IR stream.
  * @param message
@@ -83,6 +103,25 @@ bool serialize_log_event(
         std::vector<int8_t>& ir_buf
 );
 
+/**
+ * Serializes the given log event, whose message has already been parsed into a logtype and
+ * variables, into the four-byte encoding IR stream
+ * @param timestamp_delta
+ * @param logtype The message's logtype, with placeholders and escapes as in the IR stream
+ * @param encoded_vars The message's encoded variables, in order
+ * @param dict_vars The message's dictionary variables, in order
+ * @param ir_buf
+ * @return true on success, false if the variables don't match the logtype's placeholders or the
+ * message can't be encoded
+ */
+bool serialize_parsed_log_event(
+        ir::epoch_time_ms_t timestamp_delta,
+        std::string_view logtype,
+        std::span<ir::four_byte_encoded_variable_t const> encoded_vars,
+        std::span<std::string_view const> dict_vars,
+        std::vector<int8_t>& ir_buf
+);
+
 /**
  * Serializes the given message into the four-byte encoding IR stream
  * delta
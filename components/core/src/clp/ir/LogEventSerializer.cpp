@@ -1,5 +1,6 @@
 #include "LogEventSerializer.hpp"
 
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -12,6 +13,7 @@
 #include "../ir/types.hpp"
 #include "../type_utils.hpp"
 
+using std::span;
 using std::string;
 using std::string_view;
 
@@ -129,6 +131,49 @@ auto LogEventSerializer<encoded_variable_t>::serialize_log_event(
     return true;
 }
 
+template <typename encoded_variable_t>
+auto LogEventSerializer<encoded_variable_t>::serialize_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        span<encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars
+) -> bool {
+    if (false == m_is_open) {
+        throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    bool res{};
+    auto const buf_size_before_serialization = m_ir_buf.size();
+    if constexpr (std::is_same_v<encoded_variable_t, eight_byte_encoded_variable_t>) {
+        res = clp::ffi::ir_stream::eight_byte_encoding::serialize_parsed_log_event(
+                timestamp,
+                logtype,
+                encoded_vars,
+                dict_vars,
+                m_ir_buf
+        );
+    } else {
+        res = clp::ffi::ir_stream::four_byte_encoding::serialize_parsed_log_event(
+                timestamp - m_prev_event_timestamp,
+                logtype,
+                encoded_vars,
+                dict_vars,
+                m_ir_buf
+        );
+    }
+    if (false == res) {
+        // Discard any partially serialized log event
+        m_ir_buf.resize(buf_size_before_serialization);
+        return false;
+    }
+    if constexpr (std::is_same_v<encoded_variable_t, four_byte_encoded_variable_t>) {
+        m_prev_event_timestamp = timestamp;
+    }
+    m_serialized_size += m_ir_buf.size() - buf_size_before_serialization;
+    ++m_num_log_events;
+    return true;
+}
+
 template <typename encoded_variable_t>
 auto LogEventSerializer<encoded_variable_t>::close_writer() -> void {
     m_zstd_compressor.close();
@@ -155,6 +200,18 @@ template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_log_ev
         epoch_time_ms_t timestamp,
         string_view message
 ) -> bool;
+template auto LogEventSerializer<eight_byte_encoded_variable_t>::serialize_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        span<eight_byte_encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars
+) -> bool;
+template auto LogEventSerializer<four_byte_encoded_variable_t>::serialize_log_event(
+        epoch_time_ms_t timestamp,
+        string_view logtype,
+        span<four_byte_encoded_variable_t const> encoded_vars,
+        span<string_view const> dict_vars
+) -> bool;
 template auto LogEventSerializer<eight_byte_encoded_variable_t>::close_writer() -> void;
 template auto LogEventSerializer<four_byte_encoded_variable_t>::close_writer() -> void;
 }  // namespace clp::ir
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -90,6 +91,22 @@ public:
     [[nodiscard]] auto
     serialize_log_event(epoch_time_ms_t timestamp, std::string_view message) -> bool;
 
+    /**
+     * Serializes the given log event, whose message has already been parsed into a logtype and
+     * variables (e.g., by a CLP archive), without reconstructing and re-parsing the message.
+     * @param timestamp
+     * @param logtype The message's logtype, with placeholders and escapes as in the IR stream
+     * @param encoded_vars The message's encoded variables, in order
+     * @param dict_vars The message's dictionary variables, in order
+     * @return Whether the log event was successfully serialized.
+     */
+    [[nodiscard]] auto serialize_log_event(
+            epoch_time_ms_t timestamp,
+            std::string_view logtype,
+            std::span<encoded_variable_t const> encoded_vars,
+            std::span<std::string_view const> dict_vars
+    ) -> bool;
+
 private:
     // Constants
     // NOTE: IR files currently store the log's timestamp pattern and timezone ID. However:
@@ -11,6 +11,7 @@ constexpr char cLogTypeDictFilename[] = "logtype.dict";
 constexpr char cVarDictFilename[] = "var.dict";
 constexpr char cLogTypeSegmentIndexFilename[] = "logtype.segindex";
 constexpr char cVarSegmentIndexFilename[] = "var.segindex";
+constexpr char cVarDictBloomFilterFilename[] = "var.bloom";
 constexpr char cMetadataFileName[] = "metadata";
 constexpr char cMetadataDBFileName[] = "metadata.db";
 constexpr char cSchemaFileName[] = "schema.txt";
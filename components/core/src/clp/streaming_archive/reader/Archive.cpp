@@ -9,6 +9,7 @@
 #include <boost/filesystem.hpp>
 
 #include "../../EncodedVariableInterpreter.hpp"
+#include "../../Metrics.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../../Utils.hpp"
 #include "../ArchiveMetadata.hpp"
@@ -189,7 +190,10 @@ bool Archive::decompress_message(
             }
             file.increment_current_ts_pattern_ix();
         }
-        timestamp_patterns[file.get_current_ts_pattern_ix()].second.insert_formatted_timestamp(
+        auto const& timestamp_pattern
+                = timestamp_patterns[file.get_current_ts_pattern_ix()].second;
+        m_timestamp_formatter.set_pattern(timestamp_pattern);
+        m_timestamp_formatter.insert_formatted_timestamp(
                 compressed_msg.get_ts_in_milli(),
                 decompressed_msg
         );
@@ -202,6 +206,7 @@ bool Archive::decompress_message_without_ts(
         Message const& compressed_msg,
         string& decompressed_msg
 ) {
+    Metrics::ScopedTimer const marshalling_timer{Metrics::Stage::Marshalling};
     decompressed_msg.clear();
 
     // Build original message content
@@ -226,6 +231,38 @@ bool Archive::decompress_message_without_ts(
     return true;
 }
 
+bool Archive::transcode_message_to_four_byte_ir(
+        Message const& compressed_msg,
+        string& ir_logtype,
+        vector<ir::four_byte_encoded_variable_t>& ir_encoded_vars,
+        vector<std::string_view>& ir_dict_vars,
+        string& converted_vars
+) {
+    Metrics::ScopedTimer const marshalling_timer{Metrics::Stage::Marshalling};
+    auto const logtype_id = compressed_msg.get_logtype_id();
+    auto const& logtype_entry = m_logtype_dictionary.get_entry(logtype_id);
+    if (false
+        == EncodedVariableInterpreter::transcode_to_four_byte_ir(
+                logtype_entry,
+                m_var_dictionary,
+                compressed_msg.get_vars(),
+                ir_logtype,
+                ir_encoded_vars,
+                ir_dict_vars,
+                converted_vars
+        ))
+    {
+        SPDLOG_ERROR(
+                "streaming_archive::reader::Archive: Failed to transcode variables from logtype "
+                "id {}",
+                logtype_id
+        );
+        return false;
+    }
+
+    return true;
+}
+
 void Archive::decompress_empty_directories(string const& output_dir) {
     boost::filesystem::path output_dir_path = boost::filesystem::path(output_dir);
 
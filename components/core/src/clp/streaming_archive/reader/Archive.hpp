@@ -6,12 +6,16 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "../../ErrorCode.hpp"
+#include "../../ir/types.hpp"
 #include "../../LogTypeDictionaryReader.hpp"
 #include "../../Query.hpp"
 #include "../../SQLiteDB.hpp"
+#include "../../TimestampFormatter.hpp"
 #include "../../VariableDictionaryReader.hpp"
 #include "../MetadataDB.hpp"
 #include "File.hpp"
@@ -109,6 +113,26 @@ public:
     bool
     decompress_message_without_ts(Message const& compressed_msg, std::string& decompressed_msg);
 
+    /**
+     * Transcodes the given message (without its timestamp) into the form used by four-byte encoding
+     * IR streams, without decompressing it into text.
+     * @param compressed_msg
+     * @param ir_logtype Returns the message's logtype
+     * @param ir_encoded_vars Returns the message's four-byte encoded variables
+     * @param ir_dict_vars Returns the message's dictionary variables, which are valid until the
+     * archive is closed or `converted_vars` is modified
+     * @param converted_vars Returns the text of encoded variables that aren't representable using
+     * the four-byte encoding
+     * @return Whether the message was successfully transcoded
+     */
+    bool transcode_message_to_four_byte_ir(
+            Message const& compressed_msg,
+            std::string& ir_logtype,
+            std::vector<ir::four_byte_encoded_variable_t>& ir_encoded_vars,
+            std::vector<std::string_view>& ir_dict_vars,
+            std::string& converted_vars
+    );
+
     void decompress_empty_directories(std::string const& output_dir);
 
     std::unique_ptr<MetadataDB::FileIterator> get_file_iterator_by_split_id(
@@ -196,6 +220,9 @@ private:
     SegmentManager m_segment_manager;
 
     MetadataDB m_metadata_db;
+
+    // Formatter for the timestamp pattern of the last message decompressed
+    TimestampFormatter m_timestamp_formatter;
 };
 }  // namespace clp::streaming_archive::reader
 
@@ -16,6 +16,7 @@
 
 #include "../../EncodedVariableInterpreter.hpp"
 #include "../../ir/types.hpp"
+#include "../../Metrics.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../../Utils.hpp"
 #include "../Constants.hpp"
@@ -224,6 +225,7 @@ void Archive::close() {
 
     // Persist all metadata including dictionaries
     write_dir_snapshot();
+    write_var_dict_bloom_filter();
 
     m_logtype_dict.close();
     m_logtype_dict_entry.clear();
@@ -297,15 +299,18 @@ void Archive::write_msg(
     // Encode message and add components to dictionaries
     vector<encoded_variable_t> encoded_vars;
     vector<variable_dictionary_id_t> var_ids;
-    EncodedVariableInterpreter::encode_and_add_to_dictionary(
-            message,
-            m_logtype_dict_entry,
-            m_var_dict,
-            encoded_vars,
-            var_ids
-    );
     logtype_dictionary_id_t logtype_id;
-    m_logtype_dict.add_entry(m_logtype_dict_entry, logtype_id);
+    {
+        Metrics::ScopedTimer const insert_timer{Metrics::Stage::DictionaryInsert};
+        EncodedVariableInterpreter::encode_and_add_to_dictionary(
+                message,
+                m_logtype_dict_entry,
+                m_var_dict,
+                encoded_vars,
+                var_ids
+        );
+        m_logtype_dict.add_entry(m_logtype_dict_entry, logtype_id);
+    }
 
     m_file->write_encoded_msg(timestamp, logtype_id, encoded_vars, var_ids, num_uncompressed_bytes);
 
@@ -445,17 +450,19 @@ void Archive::write_log_event_ir(ir::LogEvent<encoded_variable_t> const& log_eve
     vector<eight_byte_encoded_variable_t> encoded_vars;
     vector<variable_dictionary_id_t> var_ids;
     size_t original_num_bytes{0};
-    EncodedVariableInterpreter::encode_and_add_to_dictionary(
-            log_event,
-            m_logtype_dict_entry,
-            m_var_dict,
-            encoded_vars,
-            var_ids,
-            original_num_bytes
-    );
-
     logtype_dictionary_id_t logtype_id{cLogtypeDictionaryIdMax};
-    m_logtype_dict.add_entry(m_logtype_dict_entry, logtype_id);
+    {
+        Metrics::ScopedTimer const insert_timer{Metrics::Stage::DictionaryInsert};
+        EncodedVariableInterpreter::encode_and_add_to_dictionary(
+                log_event,
+                m_logtype_dict_entry,
+                m_var_dict,
+                encoded_vars,
+                var_ids,
+                original_num_bytes
+        );
+        m_logtype_dict.add_entry(m_logtype_dict_entry, logtype_id);
+    }
 
     m_file->write_encoded_msg(
             log_event.get_timestamp(),
@@ -650,6 +657,16 @@ void Archive::update_metadata() {
     }
 }
 
+void Archive::write_var_dict_bloom_filter() {
+    FileWriter filter_writer;
+    filter_writer.open(
+            m_path + '/' + cVarDictBloomFilterFilename,
+            FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    m_var_dict.build_bloom_filter(cVarDictBloomFilterFalsePositiveRate).write(filter_writer);
+    filter_writer.close();
+}
+
 // Explicitly declare template specializations so that we can define the template methods in this
 // file
 template void Archive::write_log_event_ir<eight_byte_encoded_variable_t>(
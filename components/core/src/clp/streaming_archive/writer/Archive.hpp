@@ -194,6 +194,9 @@ public:
     }
 
 private:
+    // Constants
+    static constexpr double cVarDictBloomFilterFalsePositiveRate{0.01};
+
     // Types
     /**
      * Custom less-than comparator for sets to:
@@ -279,6 +282,13 @@ private:
      */
     void update_metadata();
 
+    /**
+     * Writes a Bloom filter over the variable dictionary's values into the archive, allowing
+     * searches to skip the archive without reading its dictionaries
+     * @throw FileWriter::OperationFailed if the filter couldn't be written
+     */
+    void write_var_dict_bloom_filter();
+
     // Variables
     boost::uuids::uuid m_id;
     std::string m_id_as_string;
@@ -0,0 +1,245 @@
+#include "string_utils/WildcardMatcher.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace clp::string_utils {
+namespace {
+// Setting this bit in an uppercase ASCII letter makes it lowercase
+constexpr char cCaseBit{0x20};
+
+/**
+ * @param c
+ * @return The given character, lowercased if it's an uppercase ASCII letter
+ */
+inline auto to_lower_ascii(char c) -> char {
+    return ('A' <= c && c <= 'Z') ? static_cast<char>(c | cCaseBit) : c;
+}
+
+/**
+ * @param c A pattern character
+ * @param case_sensitive_match
+ * @return The bits to set in a literal character before comparing it with the given pattern
+ * character, so that both cases of a letter match a lowercase letter in a case-insensitive match
+ */
+inline auto get_fold_bits(char c, bool case_sensitive_match) -> char {
+    return (false == case_sensitive_match && 'a' <= c && c <= 'z') ? cCaseBit : char{0};
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    #if defined(__AVX2__)
+constexpr size_t cVectorSize{32};
+    #else
+constexpr size_t cVectorSize{16};
+    #endif
+
+/**
+ * Compares a vector of literal characters with a pattern character
+ * @param tame The first of the literal characters
+ * @param c
+ * @param fold_bits The bits to set in each literal character before comparing it
+ * @return A bitmask with the i-th bit set if the i-th literal character matches
+ */
+inline auto match_vector(char const* tame, char c, char fold_bits) -> uint32_t {
+    #if defined(__AVX2__)
+    auto const chars = _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(tame)),
+            _mm256_set1_epi8(fold_bits)
+    );
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(c)))
+    );
+    #else
+    auto const chars = _mm_or_si128(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(tame)),
+            _mm_set1_epi8(fold_bits)
+    );
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(c))));
+    #endif
+}
+#endif
+}  // namespace
+
+WildcardMatcher::WildcardMatcher(std::string_view wild, bool case_sensitive_match)
+        : m_case_sensitive_match{case_sensitive_match} {
+    Segment segment{0, 0, 0, 0, false};
+    auto add_segment = [&]() {
+        if (0 == segment.length) {
+            return;
+        }
+        m_segments.push_back(segment);
+        segment = Segment{m_pattern.size(), 0, 0, 0, false};
+    };
+
+    for (size_t i = 0; i < wild.size(); ++i) {
+        auto c = wild[i];
+        if ('*' == c) {
+            if (m_segments.empty() && 0 == segment.length) {
+                m_has_wildcard_prefix = true;
+            }
+            add_segment();
+            m_has_wildcard_suffix = true;
+            continue;
+        }
+
+        if ('?' == c) {
+            m_pattern += '\0';
+            m_masks += '\0';
+        } else {
+            if ('\\' == c) {
+                ++i;
+                if (wild.size() == i) {
+                    // Ignore a dangling escape character
+                    break;
+                }
+                c = wild[i];
+            }
+            if (false == segment.has_literal) {
+                segment.has_literal = true;
+                segment.first_literal_offset = segment.length;
+            }
+            segment.last_literal_offset = segment.length;
+            m_pattern += m_case_sensitive_match ? c : to_lower_ascii(c);
+            m_masks += static_cast<char>(0xFF);
+        }
+        ++segment.length;
+        m_has_wildcard_suffix = false;
+    }
+    add_segment();
+}
+
+bool WildcardMatcher::matches(std::string_view tame) const {
+    if (m_segments.empty()) {
+        // The wildcard string is empty or only contains '*'
+        return m_has_wildcard_prefix || tame.empty();
+    }
+
+    // Anchor the first and last segments to the start and end of tame, unless they're preceded or
+    // followed by a '*', and then find the remaining segments in between, in order
+    size_t begin_pos{0};
+    size_t end_pos{tame.size()};
+    auto segments_begin = m_segments.cbegin();
+    auto segments_end = m_segments.cend();
+    if (false == m_has_wildcard_prefix) {
+        auto const& first_segment = m_segments.front();
+        if (first_segment.length > tame.size()
+            || false == segment_matches_at(first_segment, tame.data()))
+        {
+            return false;
+        }
+        if (1 == m_segments.size() && false == m_has_wildcard_suffix) {
+            return first_segment.length == tame.size();
+        }
+        begin_pos = first_segment.length;
+        ++segments_begin;
+    }
+    if (false == m_has_wildcard_suffix) {
+        auto const& last_segment = m_segments.back();
+        if (last_segment.length > end_pos - begin_pos
+            || false
+                       == segment_matches_at(
+                               last_segment,
+                               tame.data() + end_pos - last_segment.length
+                       ))
+        {
+            return false;
+        }
+        end_pos -= last_segment.length;
+        --segments_end;
+    }
+
+    for (auto it = segments_begin; segments_end != it; ++it) {
+        auto const pos = find_segment(*it, tame, begin_pos, end_pos);
+        if (std::string_view::npos == pos) {
+            return false;
+        }
+        begin_pos = pos + it->length;
+    }
+    return true;
+}
+
+bool WildcardMatcher::segment_matches_at(Segment const& segment, char const* tame) const {
+    auto const* pattern = m_pattern.data() + segment.begin;
+    auto const* masks = m_masks.data() + segment.begin;
+    if (m_case_sensitive_match) {
+        for (size_t i = 0; i < segment.length; ++i) {
+            if (static_cast<char>(tame[i] & masks[i]) != pattern[i]) {
+                return false;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < segment.length; ++i) {
+            if (static_cast<char>(to_lower_ascii(tame[i]) & masks[i]) != pattern[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t WildcardMatcher::find_segment(
+        Segment const& segment,
+        std::string_view tame,
+        size_t begin_pos,
+        size_t end_pos
+) const {
+    if (segment.length > end_pos - begin_pos) {
+        return std::string_view::npos;
+    }
+    if (false == segment.has_literal) {
+        // The segment only contains '?', so it matches anywhere it fits
+        return begin_pos;
+    }
+
+    // The last position at which the segment fits
+    auto const last_pos = end_pos - segment.length;
+    auto const first_literal_offset = segment.first_literal_offset;
+    auto const last_literal_offset = segment.last_literal_offset;
+    auto const first_literal = m_pattern[segment.begin + first_literal_offset];
+    auto const last_literal = m_pattern[segment.begin + last_literal_offset];
+    auto const first_literal_fold_bits = get_fold_bits(first_literal, m_case_sensitive_match);
+    auto const last_literal_fold_bits = get_fold_bits(last_literal, m_case_sensitive_match);
+    auto const* data = tame.data();
+
+    size_t pos{begin_pos};
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Find the positions in each vector of candidates where both the first and last literals match,
+    // then verify the whole segment at each of them
+    for (; pos + cVectorSize - 1 <= last_pos; pos += cVectorSize) {
+        auto candidates
+                = match_vector(data + pos + first_literal_offset, first_literal, first_literal_fold_bits)
+                  & match_vector(
+                          data + pos + last_literal_offset,
+                          last_literal,
+                          last_literal_fold_bits
+                  );
+        while (0 != candidates) {
+            auto const candidate_pos = pos + static_cast<size_t>(std::countr_zero(candidates));
+            if (segment_matches_at(segment, data + candidate_pos)) {
+                return candidate_pos;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+
+    for (; pos <= last_pos; ++pos) {
+        if (static_cast<char>(data[pos + first_literal_offset] | first_literal_fold_bits)
+                    == first_literal
+            && static_cast<char>(data[pos + last_literal_offset] | last_literal_fold_bits)
+                       == last_literal
+            && segment_matches_at(segment, data + pos))
+        {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+}  // namespace clp::string_utils
@@ -0,0 +1,95 @@
+#ifndef CLP_STRING_UTILS_WILDCARDMATCHER_HPP
+#define CLP_STRING_UTILS_WILDCARDMATCHER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clp::string_utils {
+/**
+ * A wildcard string compiled for matching many strings against it. It supports the same syntax as
+ * `wildcard_match_unsafe`: '*' matches 0 or more characters, '?' matches any single character, and
+ * '\' escapes the character following it.
+ *
+ * The wildcard string is split at each '*' into segments, which must occur in the matched string in
+ * order. Since a segment can only contain literals and '?', the leftmost occurrence of each segment
+ * is always the best one, so matching never backtracks. Occurrences are found by comparing two
+ * literal bytes of the segment against a vector of candidate positions at a time (using SSE2 or
+ * AVX2 when the target supports them), and only verifying the full segment at positions where both
+ * bytes match.
+ *
+ * Unlike `wildcard_match_unsafe`, the wildcard string doesn't need to be cleaned up first, and
+ * case-insensitive matching doesn't copy the matched string.
+ */
+class WildcardMatcher {
+public:
+    // Constructors
+    /**
+     * @param wild The wildcard string
+     * @param case_sensitive_match Whether to consider case when matching
+     */
+    explicit WildcardMatcher(std::string_view wild, bool case_sensitive_match = true);
+
+    // Methods
+    /**
+     * @param tame The literal string
+     * @return Whether the literal string matches the wildcard string
+     */
+    [[nodiscard]] bool matches(std::string_view tame) const;
+
+private:
+    // Types
+    /**
+     * A run of literals and '?' between two '*'
+     */
+    struct Segment {
+        // The segment's range in m_pattern and m_masks
+        size_t begin;
+        size_t length;
+        // The offsets of the first and last literals in the segment, which are compared against
+        // candidate positions before verifying the whole segment
+        size_t first_literal_offset;
+        size_t last_literal_offset;
+        bool has_literal;
+    };
+
+    // Methods
+    /**
+     * @param segment
+     * @param tame
+     * @return Whether the segment matches the start of the given string, which must be at least as
+     * long as the segment
+     */
+    [[nodiscard]] bool segment_matches_at(Segment const& segment, char const* tame) const;
+
+    /**
+     * Finds the leftmost occurrence of the segment in the given range of the literal string
+     * @param segment
+     * @param tame
+     * @param begin_pos
+     * @param end_pos
+     * @return The position of the occurrence, or `std::string_view::npos` if there's none
+     */
+    [[nodiscard]] size_t find_segment(
+            Segment const& segment,
+            std::string_view tame,
+            size_t begin_pos,
+            size_t end_pos
+    ) const;
+
+    // Variables
+    // The segments' characters, lowercased if the match is case-insensitive, with each '?'
+    // replaced by 0
+    std::string m_pattern;
+    // For each character in m_pattern, the bits of a literal character that must match it, i.e., 0
+    // for a '?' and 0xFF otherwise
+    std::string m_masks;
+    std::vector<Segment> m_segments;
+    bool m_case_sensitive_match;
+    bool m_has_wildcard_prefix{false};
+    bool m_has_wildcard_suffix{false};
+};
+}  // namespace clp::string_utils
+
+#endif  // CLP_STRING_UTILS_WILDCARDMATCHER_HPP
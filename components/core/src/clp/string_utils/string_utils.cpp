@@ -4,6 +4,8 @@
 #include <charconv>
 #include <cstring>
 
+#include "string_utils/WildcardMatcher.hpp"
+
 using std::string;
 using std::string_view;
 
@@ -170,13 +172,8 @@ bool wildcard_match_unsafe(string_view tame, string_view wild, bool case_sensiti
     if (case_sensitive_match) {
         return wildcard_match_unsafe_case_sensitive(tame, wild);
     } else {
-        // We convert to lowercase (rather than uppercase) anticipating that
-        // callers use lowercase more frequently, so little will need to change.
-        string lowercase_tame(tame);
-        to_lower(lowercase_tame);
-        string lowercase_wild(wild);
-        to_lower(lowercase_wild);
-        return wildcard_match_unsafe_case_sensitive(lowercase_tame, lowercase_wild);
+        // The matcher folds case as it compares, rather than lowercasing copies of both strings
+        return WildcardMatcher{wild, false}.matches(tame);
     }
 }
 
@@ -83,6 +83,9 @@ bool is_wildcard(char c);
  * Same as ``wildcard_match_unsafe_case_sensitive`` except this method allows
  * the caller to specify whether the match should be case sensitive.
  *
+ * NOTE: Callers matching many strings against the same wildcard string should
+ * use ``WildcardMatcher`` instead.
+ *
  * @param tame The literal string
  * @param wild The wildcard string
  * @param case_sensitive_match Whether to consider case when matching
@@ -0,0 +1,321 @@
+#include "ArchiveRangeCache.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <curl/curl.h>
+#include <spdlog/spdlog.h>
+
+#include "../clp/CurlDownloadHandler.hpp"
+#include "../clp/CurlOperationFailed.hpp"
+
+namespace clp_s {
+namespace {
+constexpr char cRangesFileExtension[] = ".ranges";
+constexpr char cTempFileExtension[] = ".tmp.";
+constexpr long cHttpOk{200};
+constexpr long cHttpNotFound{404};
+
+/**
+ * The destination of a download, passed to the libcurl callbacks.
+ */
+struct DownloadDestination {
+    int fd;
+    size_t offset;
+    bool write_failed{false};
+};
+
+/**
+ * libcurl progress callback. Downloads are never aborted.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @return 0
+ */
+extern "C" int curl_progress_callback(
+        [[maybe_unused]] void* dest_ptr,
+        [[maybe_unused]] curl_off_t dltotal,
+        [[maybe_unused]] curl_off_t dlnow,
+        [[maybe_unused]] curl_off_t ultotal,
+        [[maybe_unused]] curl_off_t ulnow
+) {
+    return 0;
+}
+
+/**
+ * libcurl write callback that writes downloaded data to the destination file at the destination
+ * offset.
+ * NOTE: This function must have C linkage to be a libcurl callback.
+ * @param ptr A pointer to the downloaded data
+ * @param size Always 1.
+ * @param nmemb The number of bytes downloaded.
+ * @param dest_ptr A pointer to a `DownloadDestination`.
+ * @return On success, the number of bytes processed. If this is less than `nmemb`, the download
+ * will be aborted.
+ */
+extern "C" size_t curl_write_callback(char* ptr, size_t size, size_t nmemb, void* dest_ptr) {
+    auto* dest = static_cast<DownloadDestination*>(dest_ptr);
+    auto const num_bytes = size * nmemb;
+    size_t num_bytes_written{0};
+    while (num_bytes_written < num_bytes) {
+        auto const rc = pwrite(
+                dest->fd,
+                ptr + num_bytes_written,
+                num_bytes - num_bytes_written,
+                static_cast<off_t>(dest->offset + num_bytes_written)
+        );
+        if (-1 == rc) {
+            if (EINTR == errno) {
+                continue;
+            }
+            dest->write_failed = true;
+            return 0;
+        }
+        num_bytes_written += static_cast<size_t>(rc);
+    }
+    dest->offset += num_bytes;
+    return num_bytes;
+}
+}  // namespace
+
+ArchiveRangeCache::ArchiveRangeCache(std::string_view archive_url, std::string_view cache_dir)
+        : m_archive_url{archive_url},
+          m_cache_dir{cache_dir} {
+    std::error_code error_code;
+    std::filesystem::create_directories(m_cache_dir, error_code);
+    if (error_code) {
+        SPDLOG_ERROR(
+                "Failed to create archive cache directory '{}' - {}",
+                m_cache_dir,
+                error_code.message()
+        );
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+}
+
+bool ArchiveRangeCache::is_remote_path(std::string_view path) {
+    return path.starts_with("http://") || path.starts_with("https://");
+}
+
+std::string ArchiveRangeCache::fetch_file(std::string_view file_name) {
+    auto const path = m_cache_dir + std::string{file_name};
+    if (std::filesystem::exists(path)) {
+        return path;
+    }
+
+    auto const temp_path = path + cTempFileExtension + std::to_string(getpid());
+    int const fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (-1 == fd) {
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    auto const error = download(file_name, fd, 0, std::nullopt);
+    ::close(fd);
+    if (ErrorCodeSuccess != error) {
+        std::filesystem::remove(temp_path);
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+
+    // Renaming is atomic, so concurrent readers never see a partially downloaded file
+    std::error_code error_code;
+    std::filesystem::rename(temp_path, path, error_code);
+    if (error_code) {
+        std::filesystem::remove(temp_path);
+        throw OperationFailed(ErrorCodeFailure, __FILENAME__, __LINE__);
+    }
+    return path;
+}
+
+std::optional<std::string> ArchiveRangeCache::try_fetch_file(std::string_view file_name) {
+    try {
+        return fetch_file(file_name);
+    } catch (OperationFailed const& ex) {
+        if (ErrorCodeFileNotFound == ex.get_error_code()) {
+            return std::nullopt;
+        }
+        throw;
+    }
+}
+
+std::string ArchiveRangeCache::get_partial_file_path(std::string_view file_name) {
+    auto const path = m_cache_dir + std::string{file_name};
+    int const fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (-1 == fd) {
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    ::close(fd);
+    return path;
+}
+
+void ArchiveRangeCache::fetch_range(
+        std::string_view file_name,
+        size_t begin_offset,
+        std::optional<size_t> end_offset
+) {
+    auto const range_end_offset = end_offset.value_or(SIZE_MAX);
+    if (range_end_offset <= begin_offset) {
+        return;
+    }
+    auto const is_cached = [&](RangeMap const& ranges) {
+        auto it = ranges.upper_bound(begin_offset);
+        if (ranges.cbegin() == it) {
+            return false;
+        }
+        --it;
+        return it->second >= range_end_offset;
+    };
+
+    std::string const file_name_str{file_name};
+    if (is_cached(load_cached_ranges(file_name_str))) {
+        return;
+    }
+    // Another process may have fetched the range since the ranges were loaded
+    m_cached_ranges.erase(file_name_str);
+    auto& ranges = load_cached_ranges(file_name_str);
+    if (is_cached(ranges)) {
+        return;
+    }
+
+    auto const path = get_partial_file_path(file_name);
+    int const fd = ::open(path.c_str(), O_WRONLY);
+    if (-1 == fd) {
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    auto const error = download(file_name, fd, begin_offset, end_offset);
+    ::close(fd);
+    if (ErrorCodeSuccess != error) {
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+
+    // Record the range only once its data has been written, using a single append so that
+    // concurrent processes never observe a partial record.
+    auto const ranges_path = path + cRangesFileExtension;
+    int const ranges_fd = ::open(ranges_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (-1 == ranges_fd) {
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    uint64_t const record[] = {begin_offset, range_end_offset};
+    auto const rc = ::write(ranges_fd, record, sizeof(record));
+    ::close(ranges_fd);
+    if (static_cast<ssize_t>(sizeof(record)) != rc) {
+        throw OperationFailed(ErrorCodeErrno, __FILENAME__, __LINE__);
+    }
+    add_range(ranges, begin_offset, range_end_offset);
+}
+
+ArchiveRangeCache::RangeMap& ArchiveRangeCache::load_cached_ranges(std::string const& file_name) {
+    auto [it, inserted] = m_cached_ranges.try_emplace(file_name);
+    auto& ranges = it->second;
+    if (false == inserted) {
+        return ranges;
+    }
+
+    auto const ranges_path = m_cache_dir + file_name + cRangesFileExtension;
+    int const fd = ::open(ranges_path.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return ranges;
+    }
+    uint64_t record[2];
+    while (static_cast<ssize_t>(sizeof(record)) == ::read(fd, record, sizeof(record))) {
+        add_range(ranges, record[0], record[1]);
+    }
+    ::close(fd);
+    return ranges;
+}
+
+ErrorCode ArchiveRangeCache::download(
+        std::string_view file_name,
+        int fd,
+        size_t begin_offset,
+        std::optional<size_t> end_offset
+) {
+    auto const url = m_archive_url + std::string{file_name};
+    auto const error_msg_buf = std::make_shared<clp::CurlDownloadHandler::ErrorMsgBuf>();
+    DownloadDestination dest{fd, begin_offset};
+    try {
+        std::optional<size_t> last_byte_offset;
+        if (end_offset.has_value()) {
+            last_byte_offset = end_offset.value() - 1;
+        }
+        clp::CurlDownloadHandler curl_handler{
+                error_msg_buf,
+                curl_progress_callback,
+                curl_write_callback,
+                &dest,
+                url,
+                begin_offset,
+                false,
+                clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                last_byte_offset
+        };
+        auto const ret_code = curl_handler.perform();
+        if (dest.write_failed) {
+            return ErrorCodeErrno;
+        }
+        if (CURLE_OK != ret_code) {
+            if (cHttpNotFound == curl_handler.get_response_code()
+                || CURLE_FILE_COULDNT_READ_FILE == ret_code)
+            {
+                // Callers decide whether a missing file is an error
+                return ErrorCodeFileNotFound;
+            }
+            SPDLOG_ERROR("Failed to download '{}' - {}", url, error_msg_buf->data());
+            return ErrorCodeFailureNetwork;
+        }
+        if ((0 != begin_offset || end_offset.has_value())
+            && cHttpOk == curl_handler.get_response_code())
+        {
+            // The server ignored the range, so the data was written at the wrong offset
+            SPDLOG_ERROR("Server for '{}' doesn't support range requests.", url);
+            return ErrorCodeUnsupported;
+        }
+        // Anything that's downloaded successfully is cached as complete, so make sure every byte
+        // of the response was written rather than relying on the transport to detect a short
+        // transfer
+        auto const content_length = curl_handler.get_content_length();
+        if (content_length.has_value() && dest.offset - begin_offset != content_length.value()) {
+            SPDLOG_ERROR("Failed to download '{}' - response is truncated.", url);
+            return ErrorCodeTruncated;
+        }
+    } catch (clp::CurlOperationFailed const& ex) {
+        SPDLOG_ERROR("Failed to download '{}' - {}", url, ex.what());
+        return ErrorCodeFailureNetwork;
+    }
+
+    if (end_offset.has_value() && dest.offset != end_offset.value()) {
+        SPDLOG_ERROR("Failed to download '{}' - range is truncated.", url);
+        return ErrorCodeTruncated;
+    }
+    return ErrorCodeSuccess;
+}
+
+void ArchiveRangeCache::add_range(RangeMap& ranges, size_t begin_offset, size_t end_offset) {
+    // Merge with a preceding range that overlaps or is adjacent
+    auto it = ranges.upper_bound(begin_offset);
+    if (ranges.begin() != it) {
+        auto prev_it = std::prev(it);
+        if (prev_it->second >= begin_offset) {
+            begin_offset = prev_it->first;
+            end_offset = std::max(end_offset, prev_it->second);
+            ranges.erase(prev_it);
+        }
+    }
+
+    // Merge with any following ranges that overlap or are adjacent
+    it = ranges.lower_bound(begin_offset);
+    while (ranges.end() != it && it->first <= end_offset) {
+        end_offset = std::max(end_offset, it->second);
+        it = ranges.erase(it);
+    }
+    ranges.emplace(begin_offset, end_offset);
+}
+}  // namespace clp_s
@@ -0,0 +1,147 @@
+#ifndef CLP_S_ARCHIVERANGECACHE_HPP
+#define CLP_S_ARCHIVERANGECACHE_HPP
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../clp/CurlGlobalInstance.hpp"
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+
+namespace clp_s {
+/**
+ * Provides local access to the files of an archive stored at a remote URL (e.g., an object store
+ * bucket served over HTTP), so that an archive can be searched without first downloading all of
+ * it.
+ *
+ * Small archive files (dictionaries, the schema tree, etc.) are downloaded in their entirety on
+ * first use. Large files (i.e., the tables file) are downloaded on demand, one byte range at a
+ * time, using HTTP range requests. Downloaded ranges are written at their original offsets into a
+ * sparse file in the cache directory, so the file can be read with a regular `FileReader` as long
+ * as only the fetched ranges are read. The fetched ranges of each file are recorded in a sidecar
+ * file so that they're reused by later searches of the same archive.
+ *
+ * Whole files are downloaded to a temporary path and then renamed, and fetched ranges are recorded
+ * using atomic appends, so the cache directory may be shared by concurrent processes.
+ */
+class ArchiveRangeCache {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Constructors
+    /**
+     * @param archive_url The URL of the archive, such that appending an archive file name (e.g.,
+     * `constants::cArchiveTablesFile`) to it gives the URL of that file.
+     * @param cache_dir The local directory to cache the archive's files in. It's created if it
+     * doesn't exist.
+     * @throw ArchiveRangeCache::OperationFailed if the cache directory can't be created.
+     */
+    ArchiveRangeCache(std::string_view archive_url, std::string_view cache_dir);
+
+    // Methods
+    /**
+     * @param path
+     * @return Whether the given archives path is a remote URL rather than a local directory.
+     */
+    static bool is_remote_path(std::string_view path);
+
+    /**
+     * Downloads the given archive file in its entirety, unless it's already cached.
+     * @param file_name
+     * @return The local path of the cached file.
+     * @throw ArchiveRangeCache::OperationFailed if the download fails.
+     */
+    std::string fetch_file(std::string_view file_name);
+
+    /**
+     * Same as `fetch_file`, except that a file that doesn't exist in the archive isn't an error.
+     * This is meant for optional archive files (e.g., indexes).
+     * @param file_name
+     * @return The local path of the cached file, or `std::nullopt` if the archive has no such file.
+     * @throw ArchiveRangeCache::OperationFailed if the download fails for any other reason.
+     */
+    std::optional<std::string> try_fetch_file(std::string_view file_name);
+
+    /**
+     * Gets the local path of the given archive file for use with `fetch_range`, creating an empty
+     * (sparse) file if it doesn't exist yet.
+     * @param file_name
+     * @return The local path of the cached file.
+     * @throw ArchiveRangeCache::OperationFailed if the file can't be created.
+     */
+    std::string get_partial_file_path(std::string_view file_name);
+
+    /**
+     * Downloads the given byte range of the given archive file into its partial file, unless the
+     * range is already cached.
+     * @param file_name
+     * @param begin_offset
+     * @param end_offset The offset after the last byte of the range, or `std::nullopt` for the end
+     * of the file.
+     * @throw ArchiveRangeCache::OperationFailed if the download fails.
+     */
+    void
+    fetch_range(std::string_view file_name, size_t begin_offset, std::optional<size_t> end_offset);
+
+private:
+    // Types
+    // Map from the begin offset to the end offset of every disjoint cached range in a file. A range
+    // that extends to the end of the file has an end offset of `SIZE_MAX`.
+    using RangeMap = std::map<size_t, size_t>;
+
+    // Methods
+    /**
+     * Loads the ranges of the given file that have been cached, by this or another process.
+     * @param file_name
+     * @return The cached ranges.
+     */
+    RangeMap& load_cached_ranges(std::string const& file_name);
+
+    /**
+     * Downloads the given byte range of the given archive file into the given file descriptor, at
+     * the same offset.
+     * @param file_name
+     * @param fd
+     * @param begin_offset
+     * @param end_offset The offset after the last byte of the range, or `std::nullopt` for the end
+     * of the file.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFileNotFound if the file doesn't exist on the server
+     * @return ErrorCodeFailureNetwork if the download fails
+     * @return ErrorCodeUnsupported if the server doesn't support range requests
+     * @return ErrorCodeTruncated if fewer bytes than requested, or than the server reported, were
+     * downloaded
+     * @return ErrorCodeErrno if writing to the file fails
+     */
+    ErrorCode download(
+            std::string_view file_name,
+            int fd,
+            size_t begin_offset,
+            std::optional<size_t> end_offset
+    );
+
+    /**
+     * Adds a range to the given range map, merging it with any overlapping or adjacent ranges.
+     * @param ranges
+     * @param begin_offset
+     * @param end_offset
+     */
+    static void add_range(RangeMap& ranges, size_t begin_offset, size_t end_offset);
+
+    clp::CurlGlobalInstance m_curl_global_instance;
+    std::string m_archive_url;
+    std::string m_cache_dir;
+    std::map<std::string, RangeMap> m_cached_ranges;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_ARCHIVERANGECACHE_HPP
@@ -1,23 +1,62 @@
 #include "ArchiveReader.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <optional>
+#include <string>
 #include <string_view>
 
+#include "../clp/Metrics.hpp"
 #include "archive_constants.hpp"
 #include "ReaderUtils.hpp"
 
 using std::string_view;
 
 namespace clp_s {
-void ArchiveReader::open(string_view archives_dir, string_view archive_id) {
+void ArchiveReader::open(
+        string_view archives_dir,
+        string_view archive_id,
+        string_view archive_cache_dir
+) {
     if (m_is_open) {
         throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
     }
     m_is_open = true;
     m_archive_id = archive_id;
-    std::filesystem::path archive_path{archives_dir};
-    archive_path /= m_archive_id;
-    auto const archive_path_str = archive_path.string();
+    std::string archive_path_str;
+    if (ArchiveRangeCache::is_remote_path(archives_dir)) {
+        std::string archive_url{archives_dir};
+        if (false == archive_url.ends_with('/')) {
+            archive_url += '/';
+        }
+        archive_url += m_archive_id;
+
+        std::filesystem::path cache_path{archive_cache_dir};
+        if (archive_cache_dir.empty()) {
+            cache_path = std::filesystem::temp_directory_path() / cDefaultArchiveCacheDirName;
+        }
+        cache_path /= m_archive_id;
+        archive_path_str = cache_path.string();
+
+        // Download every file except for the tables, which are fetched on demand as they're read
+        m_range_cache = std::make_unique<ArchiveRangeCache>(archive_url, archive_path_str);
+        for (auto const* file_name :
+             {constants::cArchiveVarDictFile,
+              constants::cArchiveLogDictFile,
+              constants::cArchiveArrayDictFile,
+              constants::cArchiveTimestampDictFile,
+              constants::cArchiveSchemaTreeFile,
+              constants::cArchiveSchemaMapFile,
+              constants::cArchiveTableMetadataFile})
+        {
+            m_range_cache->fetch_file(file_name);
+        }
+        m_range_cache->get_partial_file_path(constants::cArchiveTablesFile);
+    } else {
+        std::filesystem::path archive_path{archives_dir};
+        archive_path /= m_archive_id;
+        archive_path_str = archive_path.string();
+    }
 
     m_var_dict = ReaderUtils::get_variable_dictionary_reader(archive_path_str);
     m_log_dict = ReaderUtils::get_log_type_dictionary_reader(archive_path_str);
@@ -25,8 +64,10 @@ void ArchiveReader::open(string_view archives_dir, string_view archive_id) {
     m_timestamp_dict = ReaderUtils::get_timestamp_dictionary_reader(archive_path_str);
 
     m_schema_tree = ReaderUtils::read_schema_tree(archive_path_str);
+    m_plan_cache = std::make_shared<SerializationPlanCache>(m_schema_tree);
     m_schema_map = ReaderUtils::read_schemas(archive_path_str);
 
+    m_archive_path = archive_path_str;
     m_tables_file_reader.open(archive_path_str + constants::cArchiveTablesFile);
     m_table_metadata_file_reader.open(archive_path_str + constants::cArchiveTableMetadataFile);
 }
@@ -50,6 +91,8 @@ void ArchiveReader::read_metadata() {
         uint64_t num_messages;
         size_t table_offset;
         size_t uncompressed_size;
+        epochtime_t begin_timestamp;
+        epochtime_t end_timestamp;
 
         if (auto error = m_table_metadata_decompressor.try_read_numeric_value(schema_id);
             ErrorCodeSuccess != error)
@@ -75,10 +118,59 @@ void ArchiveReader::read_metadata() {
             throw OperationFailed(error, __FILENAME__, __LINE__);
         }
 
-        m_id_to_table_metadata[schema_id] = {num_messages, table_offset, uncompressed_size};
+        if (auto error = m_table_metadata_decompressor.try_read_numeric_value(begin_timestamp);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+
+        if (auto error = m_table_metadata_decompressor.try_read_numeric_value(end_timestamp);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+
+        m_id_to_table_metadata[schema_id]
+                = {num_messages, table_offset, uncompressed_size, begin_timestamp, end_timestamp};
         m_schema_ids.push_back(schema_id);
+        m_table_offsets.push_back(table_offset);
     }
     m_table_metadata_decompressor.close();
+    std::sort(m_table_offsets.begin(), m_table_offsets.end());
+}
+
+std::shared_ptr<DictionaryIndexReader> ArchiveReader::read_dictionary_index(
+        std::vector<uint64_t> const& variable_ids,
+        std::vector<uint64_t> const& logtype_ids
+) {
+    auto index_path = m_archive_path + constants::cArchiveDictionaryIndexFile;
+    if (nullptr != m_range_cache) {
+        auto const cached_path
+                = m_range_cache->try_fetch_file(constants::cArchiveDictionaryIndexFile);
+        if (false == cached_path.has_value()) {
+            return nullptr;
+        }
+        index_path = cached_path.value();
+    } else if (false == std::filesystem::exists(index_path)) {
+        return nullptr;
+    }
+
+    auto dictionary_index = std::make_shared<DictionaryIndexReader>();
+    dictionary_index->read(index_path, variable_ids, logtype_ids);
+    return dictionary_index;
+}
+
+std::optional<clp::BloomFilter> ArchiveReader::read_var_dict_bloom_filter() {
+    auto filter_path = m_archive_path + constants::cArchiveVarDictBloomFilterFile;
+    if (nullptr != m_range_cache) {
+        auto const cached_path
+                = m_range_cache->try_fetch_file(constants::cArchiveVarDictBloomFilterFile);
+        if (false == cached_path.has_value()) {
+            return std::nullopt;
+        }
+        filter_path = cached_path.value();
+    }
+    return clp::BloomFilter::try_read_from_file(filter_path);
 }
 
 void ArchiveReader::read_dictionaries_and_metadata() {
@@ -107,6 +199,8 @@ SchemaReader& ArchiveReader::read_table(
             should_marshal_records
     );
 
+    clp::Metrics::ScopedTimer const decompression_timer{clp::Metrics::Stage::TableDecompression};
+    fetch_table(schema_id);
     m_tables_file_reader.try_seek_from_begin(m_id_to_table_metadata[schema_id].offset);
     m_tables_decompressor.open(m_tables_file_reader, cDecompressorFileReadBufferCapacity);
     m_schema_reader.load(
@@ -117,23 +211,50 @@ SchemaReader& ArchiveReader::read_table(
     return m_schema_reader;
 }
 
-std::vector<std::shared_ptr<SchemaReader>> ArchiveReader::read_all_tables() {
+std::unique_ptr<SchemaReader> ArchiveReader::load_table(
+        int32_t schema_id,
+        bool should_extract_timestamp,
+        bool should_marshal_records
+) {
     constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
 
-    std::vector<std::shared_ptr<SchemaReader>> readers;
-    readers.reserve(m_id_to_table_metadata.size());
-    for (auto const& [id, table_metadata] : m_id_to_table_metadata) {
-        auto schema_reader = std::make_shared<SchemaReader>();
-        initialize_schema_reader(*schema_reader, id, true, true);
+    auto const it = m_id_to_table_metadata.find(schema_id);
+    if (m_id_to_table_metadata.end() == it) {
+        throw OperationFailed(ErrorCodeFileNotFound, __FILENAME__, __LINE__);
+    }
+    auto const& table_metadata = it->second;
 
-        m_tables_file_reader.try_seek_from_begin(table_metadata.offset);
-        m_tables_decompressor.open(m_tables_file_reader, cDecompressorFileReadBufferCapacity);
-        schema_reader->load(m_tables_decompressor, table_metadata.uncompressed_size);
-        m_tables_decompressor.close_for_reuse();
+    auto schema_reader = std::make_unique<SchemaReader>();
+    initialize_schema_reader(
+            *schema_reader,
+            schema_id,
+            should_extract_timestamp,
+            should_marshal_records
+    );
+
+    clp::Metrics::ScopedTimer const decompression_timer{clp::Metrics::Stage::TableDecompression};
+    fetch_table(schema_id);
+    m_tables_file_reader.try_seek_from_begin(table_metadata.offset);
+    m_tables_decompressor.open(m_tables_file_reader, cDecompressorFileReadBufferCapacity);
+    schema_reader->load(m_tables_decompressor, table_metadata.uncompressed_size);
+    m_tables_decompressor.close_for_reuse();
+    return schema_reader;
+}
+
+void ArchiveReader::fetch_table(int32_t schema_id) {
+    if (nullptr == m_range_cache) {
+        return;
+    }
 
-        readers.push_back(std::move(schema_reader));
+    // Tables are stored contiguously, so each table ends where the next one begins
+    auto const begin_offset = m_id_to_table_metadata.at(schema_id).offset;
+    std::optional<size_t> end_offset;
+    auto const next_offset_it
+            = std::upper_bound(m_table_offsets.cbegin(), m_table_offsets.cend(), begin_offset);
+    if (m_table_offsets.cend() != next_offset_it) {
+        end_offset = *next_offset_it;
     }
-    return readers;
+    m_range_cache->fetch_range(constants::cArchiveTablesFile, begin_offset, end_offset);
 }
 
 BaseColumnReader* ArchiveReader::append_reader_column(SchemaReader& reader, int32_t column_id) {
@@ -178,8 +299,7 @@ BaseColumnReader* ArchiveReader::append_reader_column(SchemaReader& reader, int3
 void ArchiveReader::append_unordered_reader_columns(
         SchemaReader& reader,
         int32_t mst_subtree_root_node_id,
-        std::span<int32_t> schema_ids,
-        bool should_marshal_records
+        std::span<int32_t> schema_ids
 ) {
     size_t object_begin_pos = reader.get_column_size();
     for (int32_t column_id : schema_ids) {
@@ -221,9 +341,9 @@ void ArchiveReader::append_unordered_reader_columns(
         }
     }
 
-    if (should_marshal_records) {
-        reader.mark_unordered_object(object_begin_pos, mst_subtree_root_node_id, schema_ids);
-    }
+    // Unordered objects are marked even when records won't be marshalled, since a serialization
+    // plan built by this reader is cached for every later reader of the same table
+    reader.mark_unordered_object(object_begin_pos, mst_subtree_root_node_id, schema_ids);
 }
 
 void ArchiveReader::initialize_schema_reader(
@@ -234,7 +354,7 @@ void ArchiveReader::initialize_schema_reader(
 ) {
     auto& schema = (*m_schema_map)[schema_id];
     reader.reset(
-            m_schema_tree,
+            m_plan_cache,
             schema_id,
             schema.get_ordered_schema_view(),
             m_id_to_table_metadata[schema_id].num_messages,
@@ -252,12 +372,7 @@ void ArchiveReader::initialize_schema_reader(
                     SchemaReader::get_first_column_in_span(sub_schema),
                     Schema::get_unordered_object_type(column_id)
             );
-            append_unordered_reader_columns(
-                    reader,
-                    mst_subtree_root_node_id,
-                    sub_schema,
-                    should_marshal_records
-            );
+            append_unordered_reader_columns(reader, mst_subtree_root_node_id, sub_schema);
             i += length;
             continue;
         }
@@ -265,12 +380,7 @@ void ArchiveReader::initialize_schema_reader(
             // Length one unordered object that doesn't have a tag. This is only allowed when the
             // column id is the root of the unordered object, so we can pass it directly to
             // append_unordered_reader_columns.
-            append_unordered_reader_columns(
-                    reader,
-                    column_id,
-                    std::span<int32_t>(),
-                    should_marshal_records
-            );
+            append_unordered_reader_columns(reader, column_id, std::span<int32_t>());
             continue;
         }
         BaseColumnReader* column_reader = append_reader_column(reader, column_id);
@@ -293,6 +403,32 @@ void ArchiveReader::store(FileWriter& writer) {
     }
 }
 
+void ArchiveReader::store(FileWriter& writer, std::mutex& writer_mutex) {
+    constexpr size_t cBufferSize{1024 * 1024};
+    std::string buffer;
+    buffer.reserve(cBufferSize);
+    auto flush_buffer = [&]() {
+        std::lock_guard const lock{writer_mutex};
+        writer.write(buffer.data(), buffer.length());
+        writer.flush();
+        buffer.clear();
+    };
+
+    std::string message;
+    for (auto& [id, table_metadata] : m_id_to_table_metadata) {
+        auto& schema_reader = read_table(id, false, true);
+        while (schema_reader.get_next_message(message)) {
+            buffer += message;
+            if (buffer.length() >= cBufferSize) {
+                flush_buffer();
+            }
+        }
+    }
+    if (false == buffer.empty()) {
+        flush_buffer();
+    }
+}
+
 void ArchiveReader::close() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
@@ -309,6 +445,9 @@ void ArchiveReader::close() {
 
     m_id_to_table_metadata.clear();
     m_schema_ids.clear();
+    m_table_offsets.clear();
+    m_range_cache.reset();
+    m_plan_cache.reset();
 }
 
 }  // namespace clp_s
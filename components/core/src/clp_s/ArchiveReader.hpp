@@ -2,6 +2,9 @@
 #define CLP_S_ARCHIVEREADER_HPP
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <span>
 #include <string_view>
@@ -9,6 +12,9 @@
 
 #include <boost/filesystem.hpp>
 
+#include "../clp/BloomFilter.hpp"
+#include "ArchiveRangeCache.hpp"
+#include "DictionaryIndexReader.hpp"
 #include "DictionaryReader.hpp"
 #include "ReaderUtils.hpp"
 #include "SchemaReader.hpp"
@@ -28,12 +34,25 @@ public:
     // Constructor
     ArchiveReader() : m_is_open(false) {}
 
+    // Constants
+    static constexpr char cDefaultArchiveCacheDirName[] = "clp-s-archive-cache";
+
     /**
      * Opens an archive for reading.
+     *
+     * If `archives_dir` is an HTTP(S) URL, the archive is read remotely: the archive's small files
+     * are downloaded into a local cache, while only the byte ranges of the tables that are read are
+     * downloaded, on demand. See `ArchiveRangeCache` for details.
      * @param archives_dir
      * @param archive_id
+     * @param archive_cache_dir The directory to cache remote archives in. Defaults to a directory
+     * in the system's temporary directory if empty.
      */
-    void open(std::string_view archives_dir, std::string_view archive_id);
+    void open(
+            std::string_view archives_dir,
+            std::string_view archive_id,
+            std::string_view archive_cache_dir = {}
+    );
 
     /**
      * Reads the dictionaries and metadata.
@@ -75,6 +94,27 @@ public:
      */
     void read_metadata();
 
+    /**
+     * Reads the postings of the given dictionary IDs from the archive's dictionary index, if the
+     * archive has one.
+     * @param variable_ids The variable dictionary IDs to look up, in ascending order.
+     * @param logtype_ids The logtype dictionary IDs to look up, in ascending order.
+     * @return the dictionary index reader, or nullptr if the archive has no dictionary index
+     */
+    std::shared_ptr<DictionaryIndexReader> read_dictionary_index(
+            std::vector<uint64_t> const& variable_ids,
+            std::vector<uint64_t> const& logtype_ids
+    );
+
+    /**
+     * Reads the Bloom filter over the archive's variable dictionary, if the archive has one.
+     * @return the filter, or std::nullopt if the archive has no filter
+     * @throw clp::TraceableException if the filter can't be read
+     * @throw ArchiveRangeCache::OperationFailed if the filter can't be fetched from a remote
+     * archive
+     */
+    std::optional<clp::BloomFilter> read_var_dict_bloom_filter();
+
     /**
      * Reads the local timestamp dictionary from the archive.
      * @return the timestamp dictionary reader
@@ -95,10 +135,24 @@ public:
     read_table(int32_t schema_id, bool should_extract_timestamp, bool should_marshal_records);
 
     /**
-     * Loads all of the tables in the archive and returns SchemaReaders for them.
-     * @return the schema readers for every table in the archive
+     * Loads a table from the archive into a new schema reader. Unlike `read_table`, the returned
+     * reader remains valid when other tables are read, so that several tables can be resident at
+     * once.
+     * @param schema_id
+     * @param should_extract_timestamp
+     * @param should_marshal_records
+     * @return the schema reader
+     */
+    std::unique_ptr<SchemaReader>
+    load_table(int32_t schema_id, bool should_extract_timestamp, bool should_marshal_records);
+
+    /**
+     * @param schema_id
+     * @return The metadata of the table for the given schema
      */
-    std::vector<std::shared_ptr<SchemaReader>> read_all_tables();
+    [[nodiscard]] SchemaReader::TableMetadata const& get_table_metadata(int32_t schema_id) const {
+        return m_id_to_table_metadata.at(schema_id);
+    }
 
     std::string_view get_archive_id() { return m_archive_id; }
 
@@ -122,6 +176,15 @@ public:
      */
     void store(FileWriter& writer);
 
+    /**
+     * Writes decoded messages to a file that other threads are writing to concurrently. Messages
+     * are buffered, and each full buffer is written and flushed while holding the given mutex, so
+     * that the messages written by different threads are never interleaved.
+     * @param writer A writer that appends to the file
+     * @param writer_mutex The mutex shared by all threads writing to the file
+     */
+    void store(FileWriter& writer, std::mutex& writer_mutex);
+
     /**
      * Closes the archive.
      */
@@ -148,6 +211,13 @@ private:
             bool should_marshal_records
     );
 
+    /**
+     * Downloads the byte range of the given table from the remote archive, if the archive is
+     * remote.
+     * @param schema_id
+     */
+    void fetch_table(int32_t schema_id);
+
     /**
      * Appends a column to the schema reader.
      * @param reader
@@ -162,26 +232,31 @@ private:
      * @param reader
      * @param mst_subtree_root_node_id
      * @param schema_ids
-     * @param should_marshal_records
      */
     void append_unordered_reader_columns(
             SchemaReader& reader,
             int32_t mst_subtree_root_node_id,
-            std::span<int32_t> schema_ids,
-            bool should_marshal_records
+            std::span<int32_t> schema_ids
     );
 
     bool m_is_open;
     std::string m_archive_id;
+    std::string m_archive_path;
     std::shared_ptr<VariableDictionaryReader> m_var_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_log_dict;
     std::shared_ptr<LogTypeDictionaryReader> m_array_dict;
     std::shared_ptr<TimestampDictionaryReader> m_timestamp_dict;
 
     std::shared_ptr<SchemaTree> m_schema_tree;
+    std::shared_ptr<SerializationPlanCache> m_plan_cache;
     std::shared_ptr<ReaderUtils::SchemaMap> m_schema_map;
     std::vector<int32_t> m_schema_ids;
     std::map<int32_t, SchemaReader::TableMetadata> m_id_to_table_metadata;
+    // Sorted offsets of all tables, used to find the end of each table in the tables file
+    std::vector<size_t> m_table_offsets;
+
+    // Only set for remote archives
+    std::unique_ptr<ArchiveRangeCache> m_range_cache;
 
     FileReader m_tables_file_reader;
     FileReader m_table_metadata_file_reader;
@@ -1,7 +1,11 @@
 #include "ArchiveWriter.hpp"
 
+#include <algorithm>
+
 #include <json/single_include/nlohmann/json.hpp>
 
+#include "../clp/FileWriter.hpp"
+#include "../clp/Metrics.hpp"
 #include "archive_constants.hpp"
 #include "Defs.hpp"
 #include "SchemaTree.hpp"
@@ -11,6 +15,10 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
     m_id = boost::uuids::to_string(option.id);
     m_compression_level = option.compression_level;
     m_print_archive_stats = option.print_archive_stats;
+    m_build_dictionary_index = option.build_dictionary_index;
+    m_sort_dictionaries = option.sort_dictionaries;
+    m_spill_threshold = option.spill_threshold;
+    m_next_spill_size = m_spill_threshold;
     auto archive_path = boost::filesystem::path(option.archives_dir) / m_id;
 
     boost::system::error_code boost_error_code;
@@ -28,6 +36,9 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
     std::string var_dict_path = m_archive_path + constants::cArchiveVarDictFile;
     m_var_dict = std::make_shared<VariableDictionaryWriter>();
     m_var_dict->open(var_dict_path, m_compression_level, UINT64_MAX);
+    if (m_sort_dictionaries) {
+        m_var_dict->enable_sorting();
+    }
 
     std::string log_dict_path = m_archive_path + constants::cArchiveLogDictFile;
     m_log_dict = std::make_shared<LogTypeDictionaryWriter>();
@@ -43,13 +54,24 @@ void ArchiveWriter::open(ArchiveWriterOption const& option) {
 }
 
 void ArchiveWriter::close() {
+    // The tables and dictionary index are remapped to the sorted IDs when they're stored below
+    if (m_sort_dictionaries) {
+        m_var_dict->sort_entries();
+    }
+    // NOTE: The filter must be stored before the variable dictionary is closed since closing it
+    // clears its values
+    m_compressed_size += store_var_dict_bloom_filter();
     m_compressed_size += m_var_dict->close();
     m_compressed_size += m_log_dict->close();
     m_compressed_size += m_array_dict->close();
     m_compressed_size += m_timestamp_dict->close();
     m_compressed_size += m_schema_tree.store(m_archive_path, m_compression_level);
     m_compressed_size += m_schema_map.store(m_archive_path, m_compression_level);
+    if (m_build_dictionary_index) {
+        m_compressed_size += store_dictionary_index();
+    }
     m_compressed_size += store_tables();
+    m_spill_file.close();
 
     if (m_metadata_db) {
         update_metadata_db();
@@ -60,6 +82,8 @@ void ArchiveWriter::close() {
     }
 
     m_id_to_schema_writer.clear();
+    m_table_arena.reset();
+    m_table_heap_size = 0;
     m_schema_tree.clear();
     m_schema_map.clear();
     m_encoded_message_size = 0UL;
@@ -77,12 +101,19 @@ void ArchiveWriter::append_message(
     if (it != m_id_to_schema_writer.end()) {
         schema_writer = it->second;
     } else {
-        schema_writer = new SchemaWriter();
+        schema_writer = m_table_arena.create<SchemaWriter>();
         initialize_schema_writer(schema_writer, schema);
         m_id_to_schema_writer[schema_id] = schema_writer;
+        m_table_heap_size += cSchemaWriterMapNodeSize + schema_writer->get_heap_size();
     }
 
     m_encoded_message_size += schema_writer->append_message(message);
+    schema_writer->expand_timestamp_range(m_cur_message_timestamp);
+    m_cur_message_timestamp = 0;
+
+    if (0 != m_spill_threshold && m_table_arena.get_allocated_size() >= m_next_spill_size) {
+        spill_tables();
+    }
 }
 
 size_t ArchiveWriter::get_data_size() {
@@ -90,7 +121,15 @@ size_t ArchiveWriter::get_data_size() {
            + m_encoded_message_size;
 }
 
+size_t ArchiveWriter::get_memory_usage() const {
+    return get_table_memory_size() + m_schema_tree.get_memory_usage()
+           + m_schema_map.get_memory_usage() + m_var_dict->get_memory_usage()
+           + m_log_dict->get_memory_usage() + m_array_dict->get_memory_usage()
+           + m_timestamp_dict->get_memory_usage();
+}
+
 void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const& schema) {
+    auto& arena = m_table_arena;
     for (int32_t id : schema) {
         if (Schema::schema_entry_is_unordered_object(id)) {
             continue;
@@ -98,25 +137,35 @@ void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const&
         auto const& node = m_schema_tree.get_node(id);
         switch (node.get_type()) {
             case NodeType::Integer:
-                writer->append_column(new Int64ColumnWriter(id));
+                writer->append_column(arena.create<Int64ColumnWriter>(id, arena));
                 break;
             case NodeType::Float:
-                writer->append_column(new FloatColumnWriter(id));
+                writer->append_column(arena.create<FloatColumnWriter>(id, arena));
                 break;
             case NodeType::ClpString:
-                writer->append_column(new ClpStringColumnWriter(id, m_var_dict, m_log_dict));
+                writer->append_column(
+                        arena.create<ClpStringColumnWriter>(id, m_var_dict, m_log_dict, arena)
+                );
                 break;
             case NodeType::VarString:
-                writer->append_column(new VariableStringColumnWriter(id, m_var_dict));
+                writer->append_column(
+                        arena.create<VariableStringColumnWriter>(id, m_var_dict, arena)
+                );
                 break;
             case NodeType::Boolean:
-                writer->append_column(new BooleanColumnWriter(id));
+                writer->append_column(arena.create<BooleanColumnWriter>(id, arena));
                 break;
             case NodeType::UnstructuredArray:
-                writer->append_column(new ClpStringColumnWriter(id, m_var_dict, m_array_dict));
+                writer->append_column(arena.create<ClpStringColumnWriter>(
+                        id,
+                        m_var_dict,
+                        m_array_dict,
+                        arena,
+                        true
+                ));
                 break;
             case NodeType::DateString:
-                writer->append_column(new DateStringColumnWriter(id));
+                writer->append_column(arena.create<DateStringColumnWriter>(id, arena));
                 break;
             case NodeType::StructuredArray:
             case NodeType::Object:
@@ -127,6 +176,50 @@ void ArchiveWriter::initialize_schema_writer(SchemaWriter* writer, Schema const&
     }
 }
 
+size_t ArchiveWriter::store_dictionary_index() {
+    for (auto const& [schema_id, schema_writer] : m_id_to_schema_writer) {
+        schema_writer->index_dictionary_ids(schema_id, m_dictionary_index);
+    }
+    if (m_sort_dictionaries) {
+        m_dictionary_index.remap_variable_ids(m_var_dict->get_sorted_ids());
+    }
+    return m_dictionary_index.store(m_archive_path, m_compression_level);
+}
+
+size_t ArchiveWriter::store_var_dict_bloom_filter() {
+    clp::FileWriter filter_writer;
+    filter_writer.open(
+            m_archive_path + constants::cArchiveVarDictBloomFilterFile,
+            clp::FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    m_var_dict->build_bloom_filter(cVarDictBloomFilterFalsePositiveRate).write(filter_writer);
+    auto const filter_size = filter_writer.get_pos();
+    filter_writer.close();
+    return filter_size;
+}
+
+void ArchiveWriter::spill_tables() {
+    clp::Metrics::ScopedTimer const compression_timer{clp::Metrics::Stage::Compression};
+    if (false == m_spill_file.is_open()) {
+        m_spill_file.open(m_archive_path + constants::cArchiveSpillFile, cSpillCompressionLevel);
+    }
+    for (auto const& [schema_id, schema_writer] : m_id_to_schema_writer) {
+        // The dictionary index is built from the values in memory, so they must be indexed before
+        // they're spilled
+        if (m_build_dictionary_index) {
+            schema_writer->index_dictionary_ids(schema_id, m_dictionary_index);
+        }
+        schema_writer->spill(m_spill_file);
+    }
+
+    // Some of the tables' memory (e.g., the schema writers themselves) can't be spilled, so wait
+    // for the columns to grow again before the next spill rather than spilling after every message
+    m_next_spill_size = std::max(
+            m_spill_threshold,
+            m_table_arena.get_allocated_size() + m_spill_threshold / 2
+    );
+}
+
 size_t ArchiveWriter::store_tables() {
     size_t compressed_size = 0;
     m_tables_file_writer.open(
@@ -144,12 +237,17 @@ size_t ArchiveWriter::store_tables() {
         m_table_metadata_compressor.write_numeric_value(i.second->get_num_messages());
         m_table_metadata_compressor.write_numeric_value(m_tables_file_writer.get_pos());
 
-        m_tables_compressor.open(m_tables_file_writer, m_compression_level);
-        size_t uncompressed_size = i.second->store(m_tables_compressor);
-        m_tables_compressor.close();
-        delete i.second;
+        size_t uncompressed_size{0};
+        {
+            clp::Metrics::ScopedTimer const compression_timer{clp::Metrics::Stage::Compression};
+            m_tables_compressor.open(m_tables_file_writer, m_compression_level);
+            uncompressed_size = i.second->store(m_tables_compressor, m_spill_file);
+            m_tables_compressor.close();
+        }
 
         m_table_metadata_compressor.write_numeric_value(uncompressed_size);
+        m_table_metadata_compressor.write_numeric_value(i.second->get_begin_timestamp());
+        m_table_metadata_compressor.write_numeric_value(i.second->get_end_timestamp());
     }
     m_table_metadata_compressor.close();
 
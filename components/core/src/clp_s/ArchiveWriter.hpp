@@ -1,6 +1,7 @@
 #ifndef CLP_S_ARCHIVEWRITER_HPP
 #define CLP_S_ARCHIVEWRITER_HPP
 
+#include <string_view>
 #include <utility>
 
 #include <boost/filesystem.hpp>
@@ -8,6 +9,9 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include "../clp/GlobalMySQLMetadataDB.hpp"
+#include "ColumnArena.hpp"
+#include "ColumnSpillFile.hpp"
+#include "DictionaryIndexWriter.hpp"
 #include "DictionaryWriter.hpp"
 #include "Schema.hpp"
 #include "SchemaMap.hpp"
@@ -21,6 +25,12 @@ struct ArchiveWriterOption {
     std::string archives_dir;
     int compression_level;
     bool print_archive_stats;
+    bool build_dictionary_index;
+    // Whether to sort the variable dictionary when the archive is closed, so that searches can find
+    // the entries with a given prefix using a binary search
+    bool sort_dictionaries{false};
+    // The memory the tables may use before their columns are spilled to disk, or 0 to never spill
+    size_t spill_threshold{0};
 };
 
 class ArchiveWriter {
@@ -65,10 +75,16 @@ public:
      * @param key
      * @return the node id
      */
-    int32_t add_node(int parent_node_id, NodeType type, std::string const& key) {
+    int32_t add_node(int parent_node_id, NodeType type, std::string_view key) {
         return m_schema_tree.add_node(parent_node_id, type, key);
     }
 
+    /**
+     * Increases the count of a node in the schema tree whose ID was found without `add_node`
+     * @param node_id
+     */
+    void increase_node_count(int32_t node_id) { m_schema_tree.increase_node_count(node_id); }
+
     /**
      * Return a schema's Id and add the schema to the
      * schema map if it does not already exist.
@@ -91,7 +107,9 @@ public:
             std::string const& timestamp,
             uint64_t& pattern_id
     ) {
-        return m_timestamp_dict->ingest_entry(key, node_id, timestamp, pattern_id);
+        m_cur_message_timestamp
+                = m_timestamp_dict->ingest_entry(key, node_id, timestamp, pattern_id);
+        return m_cur_message_timestamp;
     }
 
     /**
@@ -102,10 +120,12 @@ public:
      */
     void ingest_timestamp_entry(std::string const& key, int32_t node_id, double timestamp) {
         m_timestamp_dict->ingest_entry(key, node_id, timestamp);
+        m_cur_message_timestamp = static_cast<epochtime_t>(timestamp);
     }
 
     void ingest_timestamp_entry(std::string const& key, int32_t node_id, int64_t timestamp) {
         m_timestamp_dict->ingest_entry(key, node_id, timestamp);
+        m_cur_message_timestamp = timestamp;
     }
 
     /**
@@ -119,7 +139,30 @@ public:
      */
     size_t get_data_size();
 
+    /**
+     * @return The number of bytes of memory held by the archive's tables
+     */
+    [[nodiscard]] size_t get_table_memory_size() const {
+        return m_table_arena.get_reserved_size() + m_table_heap_size;
+    }
+
+    /**
+     * @return The number of bytes of memory held by the archive, i.e., by its tables, schema tree,
+     * schema map, and dictionaries
+     */
+    [[nodiscard]] size_t get_memory_usage() const;
+
 private:
+    // Constants
+    static constexpr double cVarDictBloomFilterFalsePositiveRate{0.01};
+    // Spilled columns are recompressed when the tables are stored, so they're compressed quickly
+    static constexpr int cSpillCompressionLevel{1};
+    // The size of a node in m_id_to_schema_writer, including the red-black tree's bookkeeping
+    static constexpr size_t cSchemaWriterMapNodeSize{
+            4 * sizeof(void*) + sizeof(std::pair<int32_t const, SchemaWriter*>)
+    };
+
+    // Methods
     /**
      * Initializes the schema writer
      * @param writer
@@ -128,7 +171,25 @@ private:
     void initialize_schema_writer(SchemaWriter* writer, Schema const& schema);
 
     /**
-     * Stores the tables
+     * Stores the index from dictionary IDs to the tables and columns that contain them
+     * @return Size of the compressed index in bytes
+     */
+    [[nodiscard]] size_t store_dictionary_index();
+
+    /**
+     * Stores a Bloom filter over the variable dictionary's values, allowing searches to skip the
+     * archive without reading its dictionaries
+     * @return Size of the filter in bytes
+     */
+    [[nodiscard]] size_t store_var_dict_bloom_filter();
+
+    /**
+     * Spills the tables' columns to disk to return their memory to m_table_arena
+     */
+    void spill_tables();
+
+    /**
+     * Stores the tables, merging in any columns that were spilled to disk
      * @return Size of the compressed data in bytes
      */
     [[nodiscard]] size_t store_tables();
@@ -159,11 +220,26 @@ private:
     std::shared_ptr<clp::GlobalMySQLMetadataDB> m_metadata_db;
     int m_compression_level{};
     bool m_print_archive_stats{};
+    bool m_build_dictionary_index{};
+    bool m_sort_dictionaries{};
 
     SchemaMap m_schema_map;
     SchemaTree m_schema_tree;
 
+    // Owns the schema writers, their columns, and the columns' buffers until the archive is closed
+    ColumnArena m_table_arena;
     std::map<int32_t, SchemaWriter*> m_id_to_schema_writer;
+    // The memory held by the tables outside the arena, i.e., by m_id_to_schema_writer and the
+    // schema writers' heap allocations
+    size_t m_table_heap_size{0};
+    size_t m_spill_threshold{0};
+    // The size m_table_arena must reach before the tables are spilled again
+    size_t m_next_spill_size{0};
+    ColumnSpillFile m_spill_file;
+    DictionaryIndexWriter m_dictionary_index;
+    // The timestamp of the message currently being parsed, or 0 if it doesn't have one, matching
+    // the timestamp SchemaReader reports for such messages
+    epochtime_t m_cur_message_timestamp{0};
 
     FileWriter m_tables_file_writer;
     FileWriter m_table_metadata_file_writer;
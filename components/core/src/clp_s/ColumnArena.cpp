@@ -0,0 +1,82 @@
+#include "ColumnArena.hpp"
+
+#include <cstring>
+
+namespace clp_s {
+void* ColumnArena::allocate(size_t size, size_t alignment) {
+    if (auto it = m_free_lists.find({size, alignment}); m_free_lists.end() != it) {
+        auto* ptr = it->second;
+        void* next{nullptr};
+        std::memcpy(&next, ptr, sizeof(next));
+        if (nullptr == next) {
+            m_free_lists.erase(it);
+        } else {
+            it->second = next;
+        }
+        m_allocated_size += size;
+        return ptr;
+    }
+
+    // Requests larger than a quarter of a block get their own block, so they don't waste the rest
+    // of the current one
+    if (size > m_block_size / 4) {
+        auto& block = add_block(size);
+        m_allocated_size += size;
+        return block.data;
+    }
+
+    auto const cur = reinterpret_cast<uintptr_t>(m_cur);
+    auto const padding = (alignment - (cur % alignment)) % alignment;
+    if (nullptr == m_cur || static_cast<size_t>(m_end - m_cur) < padding + size) {
+        auto& block = add_block(m_block_size);
+        m_cur = block.data;
+        m_end = block.data + block.size;
+        m_cur += size;
+        m_allocated_size += size;
+        return block.data;
+    }
+
+    // The padding isn't counted as allocated, since it's never given back by `deallocate`
+    auto* ptr = m_cur + padding;
+    m_cur = ptr + size;
+    m_allocated_size += size;
+    return ptr;
+}
+
+void ColumnArena::deallocate(void* ptr, size_t size, size_t alignment) {
+    auto& head = m_free_lists[{size, alignment}];
+    // The memory may not be aligned for a pointer, so the link is copied rather than assigned
+    std::memcpy(ptr, &head, sizeof(head));
+    head = ptr;
+    m_allocated_size -= size;
+}
+
+void ColumnArena::reset() {
+    for (auto it = m_destructors.rbegin(); m_destructors.rend() != it; ++it) {
+        it->destroy(it->object);
+    }
+    m_destructors.clear();
+    m_free_lists.clear();
+
+    for (auto const& block : m_blocks) {
+        ::operator delete(block.data, std::align_val_t{cCacheLineSize});
+    }
+    m_blocks.clear();
+    m_cur = nullptr;
+    m_end = nullptr;
+    m_reserved_size = 0;
+    m_allocated_size = 0;
+}
+
+ColumnArena::Block& ColumnArena::add_block(size_t size) {
+    // Round up to a whole number of cache lines so that every block starts and ends on a cache line
+    size = (size + cCacheLineSize - 1) / cCacheLineSize * cCacheLineSize;
+    if (m_blocks.size() == m_blocks.capacity()) {
+        // Reserve first so that the block can't leak if growing the list of blocks fails
+        m_blocks.reserve(std::max<size_t>(2 * m_blocks.capacity(), 16));
+    }
+    auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t{cCacheLineSize}));
+    m_reserved_size += size;
+    return m_blocks.emplace_back(Block{data, size});
+}
+}  // namespace clp_s
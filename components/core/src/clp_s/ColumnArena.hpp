@@ -0,0 +1,264 @@
+#ifndef CLP_S_COLUMNARENA_HPP
+#define CLP_S_COLUMNARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace clp_s {
+/**
+ * An archive-scoped arena for the schema writers and column buffers of an archive being written.
+ *
+ * Memory is requested from the system in large, cache-line-aligned blocks and handed out by bumping
+ * a pointer, so tens of thousands of small tables don't fragment the heap. Blocks are never returned
+ * to the system individually; instead, `reset` runs the destructors of the objects created in the
+ * arena and releases every block in one shot. Memory that's given back with `deallocate` (e.g., by a
+ * column buffer that was spilled to disk) is kept on a free list and reused by later allocations of
+ * the same size and alignment. Since blocks are first touched by the thread writing the archive, the
+ * default first-touch policy places them on that thread's NUMA node.
+ *
+ * The arena isn't thread-safe.
+ */
+class ColumnArena {
+public:
+    // Constants
+    static constexpr size_t cCacheLineSize{64};
+    static constexpr size_t cDefaultBlockSize{1024 * 1024};
+
+    // Constructors
+    explicit ColumnArena(size_t block_size = cDefaultBlockSize) : m_block_size{block_size} {}
+
+    // Delete copy & move constructors and assignment operators
+    ColumnArena(ColumnArena const&) = delete;
+    ColumnArena(ColumnArena&&) = delete;
+    auto operator=(ColumnArena const&) -> ColumnArena& = delete;
+    auto operator=(ColumnArena&&) -> ColumnArena& = delete;
+
+    // Destructor
+    ~ColumnArena() { reset(); }
+
+    // Methods
+    /**
+     * Allocates uninitialized memory from the arena
+     * @param size
+     * @param alignment Must be a power of two no greater than `cCacheLineSize`
+     * @return A pointer to the memory, which remains valid until the arena is reset
+     */
+    [[nodiscard]] void* allocate(size_t size, size_t alignment);
+
+    /**
+     * Returns memory to the arena so that a later allocation of the same size and alignment can
+     * reuse it
+     * @param ptr A pointer returned by `allocate`
+     * @param size The size passed to `allocate`, which must be at least `sizeof(void*)`
+     * @param alignment The alignment passed to `allocate`
+     */
+    void deallocate(void* ptr, size_t size, size_t alignment);
+
+    /**
+     * Creates an object in the arena. The object is destroyed when the arena is reset, in the
+     * reverse order of creation.
+     * @tparam T
+     * @param args The arguments to construct the object with
+     * @return A pointer to the object
+     */
+    template <typename T, typename... Args>
+    [[nodiscard]] T* create(Args&&... args) {
+        static_assert(alignof(T) <= cCacheLineSize);
+        auto* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (false == std::is_trivially_destructible_v<T>) {
+            m_destructors.push_back({object, [](void* ptr) { static_cast<T*>(ptr)->~T(); }});
+        }
+        return object;
+    }
+
+    /**
+     * Destroys every object created in the arena and releases all of its memory
+     */
+    void reset();
+
+    /**
+     * @return The number of bytes the arena has requested from the system
+     */
+    [[nodiscard]] size_t get_reserved_size() const { return m_reserved_size; }
+
+    /**
+     * @return The number of bytes handed out by the arena and not yet deallocated, excluding
+     * alignment padding
+     */
+    [[nodiscard]] size_t get_allocated_size() const { return m_allocated_size; }
+
+private:
+    // Types
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    struct Destructor {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    // Methods
+    /**
+     * Requests a new block from the system
+     * @param size
+     * @return The block
+     */
+    Block& add_block(size_t size);
+
+    // Variables
+    size_t m_block_size;
+    std::vector<Block> m_blocks;
+    // The unused region of the most recent regular-sized block
+    std::byte* m_cur{nullptr};
+    std::byte* m_end{nullptr};
+    std::vector<Destructor> m_destructors;
+    // The head of the list of deallocated memory for each size and alignment. Each piece of memory
+    // stores a pointer to the next piece in the list.
+    std::map<std::pair<size_t, size_t>, void*> m_free_lists;
+
+    size_t m_reserved_size{0};
+    size_t m_allocated_size{0};
+};
+
+/**
+ * An append-only buffer of trivially copyable values, stored in a list of segments allocated from a
+ * `ColumnArena`. Segments double in size up to `cMaxSegmentSize` bytes, so small columns stay small
+ * and growing a large column never copies the values that were already appended. Each segment's
+ * header lives in the arena alongside its values, so all of the buffer's memory is accounted for by
+ * the arena, and `clear` gives it back to the arena for reuse.
+ * @tparam T
+ */
+template <typename T>
+class ArenaBuffer {
+public:
+    // Constants
+    static constexpr size_t cMinSegmentSize{256};
+    static constexpr size_t cMaxSegmentSize{64 * 1024};
+
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) <= cMinSegmentSize);
+
+    // Constructors
+    explicit ArenaBuffer(ColumnArena& arena) : m_arena{arena} {}
+
+    // Methods
+    void push_back(T value) {
+        if (m_tail_size == m_tail_capacity) {
+            add_segment();
+        }
+        get_values(m_tail)[m_tail_size++] = value;
+        ++m_size;
+    }
+
+    [[nodiscard]] size_t size() const { return m_size; }
+
+    [[nodiscard]] bool empty() const { return 0 == m_size; }
+
+    /**
+     * Removes every value from the buffer and returns its segments to the arena
+     */
+    void clear() {
+        auto* segment = m_head;
+        while (nullptr != segment) {
+            auto* next = segment->next;
+            m_arena.deallocate(
+                    segment,
+                    cValuesOffset + segment->capacity * sizeof(T),
+                    cSegmentAlignment
+            );
+            segment = next;
+        }
+        m_head = nullptr;
+        m_tail = nullptr;
+        m_size = 0;
+        m_tail_size = 0;
+        m_tail_capacity = 0;
+    }
+
+    /**
+     * Calls the given callback with a span over each segment's values, in order
+     * @tparam Callback A callable taking a `std::span<T const>`
+     * @param callback
+     */
+    template <typename Callback>
+    void for_each_segment(Callback&& callback) const {
+        for (auto const* segment = m_head; nullptr != segment; segment = segment->next) {
+            auto const size = (m_tail == segment) ? m_tail_size : segment->capacity;
+            callback(std::span<T const>{get_values(segment), size});
+        }
+    }
+
+    /**
+     * Calls the given callback with a mutable span over each segment's values, in order
+     * @tparam Callback A callable taking a `std::span<T>`
+     * @param callback
+     */
+    template <typename Callback>
+    void for_each_segment(Callback&& callback) {
+        for (auto* segment = m_head; nullptr != segment; segment = segment->next) {
+            auto const size = (m_tail == segment) ? m_tail_size : segment->capacity;
+            callback(std::span<T>{get_values(segment), size});
+        }
+    }
+
+private:
+    // Types
+    struct Segment {
+        Segment* next;
+        size_t capacity;
+    };
+
+    // Constants
+    // The offset of a segment's values from its header
+    static constexpr size_t cValuesOffset{
+            (sizeof(Segment) + alignof(T) - 1) / alignof(T) * alignof(T)
+    };
+    static constexpr size_t cSegmentAlignment{std::max(alignof(Segment), alignof(T))};
+
+    // Methods
+    static T* get_values(Segment* segment) {
+        return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(segment) + cValuesOffset);
+    }
+
+    static T const* get_values(Segment const* segment) {
+        return reinterpret_cast<T const*>(
+                reinterpret_cast<std::byte const*>(segment) + cValuesOffset
+        );
+    }
+
+    void add_segment() {
+        auto const capacity = (nullptr == m_tail)
+                                      ? cMinSegmentSize / sizeof(T)
+                                      : std::min(m_tail_capacity * 2, cMaxSegmentSize / sizeof(T));
+        auto* memory = m_arena.allocate(cValuesOffset + capacity * sizeof(T), cSegmentAlignment);
+        auto* segment = new (memory) Segment{nullptr, capacity};
+        if (nullptr == m_tail) {
+            m_head = segment;
+        } else {
+            m_tail->next = segment;
+        }
+        m_tail = segment;
+        m_tail_size = 0;
+        m_tail_capacity = capacity;
+    }
+
+    // Variables
+    ColumnArena& m_arena;
+    Segment* m_head{nullptr};
+    Segment* m_tail{nullptr};
+    size_t m_size{0};
+    size_t m_tail_size{0};
+    size_t m_tail_capacity{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_COLUMNARENA_HPP
@@ -0,0 +1,82 @@
+#include "ColumnSpillFile.hpp"
+
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+#include <spdlog/spdlog.h>
+
+namespace clp_s {
+ColumnSpillFile::~ColumnSpillFile() {
+    try {
+        close();
+    } catch (TraceableException const& e) {
+        SPDLOG_ERROR("Failed to close spill file {} - {}", m_path, e.what());
+    }
+}
+
+void ColumnSpillFile::open(std::string const& path, int compression_level) {
+    if (is_open()) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+    m_writer.open(path, FileWriter::OpenMode::CreateForWriting);
+    m_path = path;
+    m_compression_level = compression_level;
+    m_size = 0;
+    m_is_writing = true;
+}
+
+void ColumnSpillFile::close() {
+    if (false == is_open()) {
+        return;
+    }
+    if (m_is_writing) {
+        m_writer.close();
+        m_is_writing = false;
+    } else {
+        m_reader.close();
+    }
+    m_read_buffer.reset();
+
+    boost::system::error_code boost_error_code;
+    boost::filesystem::remove(m_path, boost_error_code);
+    if (boost_error_code) {
+        SPDLOG_WARN("Failed to remove spill file {} - {}", m_path, boost_error_code.message());
+    }
+    m_path.clear();
+    m_size = 0;
+}
+
+void ColumnSpillFile::copy(Chunk const& chunk, ZstdCompressor& compressor) {
+    read(chunk, [&](std::span<char> block) { compressor.write(block.data(), block.size()); });
+}
+
+void ColumnSpillFile::read(
+        Chunk const& chunk,
+        std::function<void(std::span<char>)> const& callback
+) {
+    if (false == is_open()) {
+        throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
+    }
+    if (m_is_writing) {
+        // Closing the writer flushes it, so the reader sees every chunk
+        m_writer.close();
+        m_is_writing = false;
+        m_reader.open(m_path);
+        m_read_buffer = std::make_unique<char[]>(cReadBufferSize);
+    }
+
+    m_reader.seek_from_begin(chunk.offset);
+    m_decompressor.open(m_reader, cReadBufferSize);
+    for (size_t num_bytes_left = chunk.uncompressed_size; num_bytes_left > 0;) {
+        auto const num_bytes_to_read = std::min(num_bytes_left, cReadBufferSize);
+        auto const error_code
+                = m_decompressor.try_read_exact_length(m_read_buffer.get(), num_bytes_to_read);
+        if (ErrorCodeSuccess != error_code) {
+            throw OperationFailed(error_code, __FILENAME__, __LINE__);
+        }
+        callback(std::span<char>{m_read_buffer.get(), num_bytes_to_read});
+        num_bytes_left -= num_bytes_to_read;
+    }
+    m_decompressor.close_for_reuse();
+}
+}  // namespace clp_s
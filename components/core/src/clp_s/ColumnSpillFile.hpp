@@ -0,0 +1,229 @@
+#ifndef CLP_S_COLUMNSPILLFILE_HPP
+#define CLP_S_COLUMNSPILLFILE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ColumnArena.hpp"
+#include "FileReader.hpp"
+#include "FileWriter.hpp"
+#include "TraceableException.hpp"
+#include "ZstdCompressor.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * A temporary file that column buffers are spilled to when the tables of the archive being written
+ * use too much memory.
+ *
+ * Each spilled buffer is written as its own Zstandard frame, so that it can later be decompressed
+ * independently and copied into the buffer's table when the tables are stored. Spilling must be
+ * finished before the first chunk is copied back.
+ */
+class ColumnSpillFile {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    /**
+     * The location of a spilled buffer in the file
+     */
+    struct Chunk {
+        size_t offset;
+        size_t uncompressed_size;
+    };
+
+    // Constructors
+    ColumnSpillFile() = default;
+
+    // Delete copy & move constructors and assignment operators
+    ColumnSpillFile(ColumnSpillFile const&) = delete;
+    ColumnSpillFile(ColumnSpillFile&&) = delete;
+    auto operator=(ColumnSpillFile const&) -> ColumnSpillFile& = delete;
+    auto operator=(ColumnSpillFile&&) -> ColumnSpillFile& = delete;
+
+    // Destructor
+    /**
+     * Closes and removes the file if it's still open (e.g., if writing the archive failed)
+     */
+    ~ColumnSpillFile();
+
+    // Methods
+    /**
+     * Creates the file
+     * @param path
+     * @param compression_level
+     */
+    void open(std::string const& path, int compression_level);
+
+    /**
+     * Closes and removes the file
+     */
+    void close();
+
+    [[nodiscard]] bool is_open() const { return false == m_path.empty(); }
+
+    /**
+     * Compresses the values in the given buffer into a new chunk
+     * @tparam T
+     * @param buffer
+     * @return The chunk
+     */
+    template <typename T>
+    [[nodiscard]] Chunk write(ArenaBuffer<T> const& buffer) {
+        if (false == m_is_writing) {
+            throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+        }
+        Chunk chunk{m_size, buffer.size() * sizeof(T)};
+        m_compressor.open(m_writer, m_compression_level);
+        buffer.for_each_segment([&](std::span<T const> segment) {
+            m_compressor.write(reinterpret_cast<char const*>(segment.data()), segment.size_bytes());
+        });
+        m_compressor.close();
+        m_size = m_writer.get_pos();
+        return chunk;
+    }
+
+    /**
+     * Decompresses the given chunk into the given compressor
+     * @param chunk
+     * @param compressor
+     */
+    void copy(Chunk const& chunk, ZstdCompressor& compressor);
+
+    /**
+     * Decompresses the given chunk, calling the given callback with each block of decompressed
+     * bytes, in order. Each block's size is a multiple of the size of any column value.
+     * @param chunk
+     * @param callback
+     */
+    void read(Chunk const& chunk, std::function<void(std::span<char>)> const& callback);
+
+    /**
+     * @return The number of bytes written to the file
+     */
+    [[nodiscard]] size_t get_size() const { return m_size; }
+
+private:
+    // Constants
+    static constexpr size_t cReadBufferSize{64 * 1024};
+    static_assert(0 == cReadBufferSize % sizeof(int64_t));
+
+    // Variables
+    std::string m_path;
+    int m_compression_level{};
+    size_t m_size{0};
+
+    bool m_is_writing{false};
+    FileWriter m_writer;
+    ZstdCompressor m_compressor;
+
+    FileReader m_reader;
+    ZstdDecompressor m_decompressor;
+    std::unique_ptr<char[]> m_read_buffer;
+};
+
+/**
+ * An `ArenaBuffer` whose values can be spilled to a `ColumnSpillFile` to return their memory to the
+ * arena. The buffer behaves as if it still held the spilled values, except that only the unspilled
+ * values can be visited in memory.
+ * @tparam T
+ */
+template <typename T>
+class SpillableBuffer {
+public:
+    // Constructors
+    explicit SpillableBuffer(ColumnArena& arena) : m_values{arena} {}
+
+    // Methods
+    void push_back(T value) { m_values.push_back(value); }
+
+    /**
+     * @return The number of values in the buffer, including spilled values
+     */
+    [[nodiscard]] size_t size() const { return m_num_spilled_values + m_values.size(); }
+
+    [[nodiscard]] size_t get_num_unspilled_values() const { return m_values.size(); }
+
+    /**
+     * Calls the given callback with a span over each segment of unspilled values, in order
+     * @tparam Callback A callable taking a `std::span<T const>`
+     * @param callback
+     */
+    template <typename Callback>
+    void for_each_unspilled_segment(Callback&& callback) const {
+        m_values.for_each_segment(std::forward<Callback>(callback));
+    }
+
+    /**
+     * Writes the unspilled values to the spill file and returns their memory to the arena
+     * @param spill_file
+     */
+    void spill(ColumnSpillFile& spill_file) {
+        if (m_values.empty()) {
+            return;
+        }
+        m_chunks.push_back(spill_file.write(m_values));
+        m_num_spilled_values += m_values.size();
+        m_values.clear();
+    }
+
+    /**
+     * Writes every value in the buffer, in order, to the compressor
+     * @param compressor
+     * @param spill_file The file the buffer was spilled to, if any
+     * @return The number of bytes written
+     */
+    size_t write(ZstdCompressor& compressor, ColumnSpillFile& spill_file) const {
+        for (auto const& chunk : m_chunks) {
+            spill_file.copy(chunk, compressor);
+        }
+        m_values.for_each_segment([&](std::span<T const> segment) {
+            compressor.write(reinterpret_cast<char const*>(segment.data()), segment.size_bytes());
+        });
+        return size() * sizeof(T);
+    }
+
+    /**
+     * Writes every value in the buffer, in order, to the compressor after transforming it. The
+     * unspilled values are transformed in place.
+     * @tparam Transform A callable taking a `std::span<T>` of values and transforming them in place
+     * @param compressor
+     * @param spill_file The file the buffer was spilled to, if any
+     * @param transform
+     * @return The number of bytes written
+     */
+    template <typename Transform>
+    size_t write(ZstdCompressor& compressor, ColumnSpillFile& spill_file, Transform&& transform) {
+        auto write_values = [&](std::span<T> values) {
+            transform(values);
+            compressor.write(reinterpret_cast<char const*>(values.data()), values.size_bytes());
+        };
+        for (auto const& chunk : m_chunks) {
+            spill_file.read(chunk, [&](std::span<char> block) {
+                write_values({reinterpret_cast<T*>(block.data()), block.size() / sizeof(T)});
+            });
+        }
+        m_values.for_each_segment(write_values);
+        return size() * sizeof(T);
+    }
+
+private:
+    // Variables
+    ArenaBuffer<T> m_values;
+    std::vector<ColumnSpillFile::Chunk> m_chunks;
+    size_t m_num_spilled_values{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_COLUMNSPILLFILE_HPP
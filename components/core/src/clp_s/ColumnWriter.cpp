@@ -1,15 +1,21 @@
 #include "ColumnWriter.hpp"
 
+#include <span>
+#include <utility>
+#include <vector>
+
 namespace clp_s {
 void Int64ColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size) {
     size = sizeof(int64_t);
     m_values.push_back(std::get<int64_t>(value));
 }
 
-size_t Int64ColumnWriter::store(ZstdCompressor& compressor) {
-    size_t size = m_values.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
-    return size;
+size_t Int64ColumnWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
+    return m_values.write(compressor, spill_file);
+}
+
+void Int64ColumnWriter::spill(ColumnSpillFile& spill_file) {
+    m_values.spill(spill_file);
 }
 
 void FloatColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size) {
@@ -17,10 +23,12 @@ void FloatColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size
     m_values.push_back(std::get<double>(value));
 }
 
-size_t FloatColumnWriter::store(ZstdCompressor& compressor) {
-    size_t size = m_values.size() * sizeof(double);
-    compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
-    return size;
+size_t FloatColumnWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
+    return m_values.write(compressor, spill_file);
+}
+
+void FloatColumnWriter::spill(ColumnSpillFile& spill_file) {
+    m_values.spill(spill_file);
 }
 
 void BooleanColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size) {
@@ -28,15 +36,17 @@ void BooleanColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& si
     m_values.push_back(std::get<bool>(value) ? 1 : 0);
 }
 
-size_t BooleanColumnWriter::store(ZstdCompressor& compressor) {
-    size_t size = m_values.size() * sizeof(uint8_t);
-    compressor.write(reinterpret_cast<char const*>(m_values.data()), size);
-    return size;
+size_t BooleanColumnWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
+    return m_values.write(compressor, spill_file);
+}
+
+void BooleanColumnWriter::spill(ColumnSpillFile& spill_file) {
+    m_values.spill(spill_file);
 }
 
 void ClpStringColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size) {
     size = sizeof(int64_t);
-    std::string string_var = std::get<std::string>(value);
+    auto const& string_var = std::get<std::string>(value);
     uint64_t id;
     uint64_t offset = m_encoded_vars.size();
     VariableEncoder::encode_and_add_to_dictionary(
@@ -51,28 +61,107 @@ void ClpStringColumnWriter::add_value(ParsedMessage::variable_t& value, size_t&
     size += sizeof(int64_t) * (m_encoded_vars.size() - offset);
 }
 
-size_t ClpStringColumnWriter::store(ZstdCompressor& compressor) {
-    size_t logtypes_size = m_logtypes.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_logtypes.data()), logtypes_size);
-    size_t encoded_vars_size = m_encoded_vars.size() * sizeof(int64_t);
+size_t ClpStringColumnWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
+    auto const sorted_var_ids = m_var_dict->get_sorted_ids();
+    if (sorted_var_ids.empty()) {
+        size_t logtypes_size = m_logtypes.write(compressor, spill_file);
+        size_t num_encoded_vars = m_encoded_vars.size();
+        compressor.write_numeric_value(num_encoded_vars);
+        size_t encoded_vars_size = m_encoded_vars.write(compressor, spill_file);
+        return logtypes_size + sizeof(num_encoded_vars) + encoded_vars_size;
+    }
+
+    // The variable dictionary was sorted, so the dictionary variables must be remapped to their
+    // new IDs. Encoded doubles can fall in the range of encoded dictionary IDs, so the logtypes are
+    // used to find the variables that weren't encoded as doubles.
+    std::vector<bool> is_non_double_var(m_encoded_vars.size(), false);
+    size_t logtypes_size
+            = m_logtypes.write(compressor, spill_file, [&](std::span<int64_t> encoded_ids) {
+                  for (auto encoded_id : encoded_ids) {
+                      auto const offset = get_encoded_offset(encoded_id);
+                      auto const var_delims
+                              = m_log_dict->get_var_delims(get_encoded_log_dict_id(encoded_id));
+                      for (size_t i = 0; i < var_delims.size(); ++i) {
+                          is_non_double_var[offset + i]
+                                  = static_cast<char>(LogTypeDictionaryEntry::VarDelim::NonDouble)
+                                    == var_delims[i];
+                      }
+                  }
+              });
     size_t num_encoded_vars = m_encoded_vars.size();
     compressor.write_numeric_value(num_encoded_vars);
-    compressor.write(reinterpret_cast<char const*>(m_encoded_vars.data()), encoded_vars_size);
+    size_t var_ix{0};
+    size_t encoded_vars_size
+            = m_encoded_vars.write(compressor, spill_file, [&](std::span<int64_t> encoded_vars) {
+                  for (auto& encoded_var : encoded_vars) {
+                      if (is_non_double_var[var_ix] && VariableEncoder::is_var_dict_id(encoded_var))
+                      {
+                          encoded_var = VariableEncoder::encode_var_dict_id(
+                                  sorted_var_ids[VariableEncoder::decode_var_dict_id(encoded_var)]
+                          );
+                      }
+                      ++var_ix;
+                  }
+              });
     return logtypes_size + sizeof(num_encoded_vars) + encoded_vars_size;
 }
 
+void ClpStringColumnWriter::spill(ColumnSpillFile& spill_file) {
+    m_logtypes.spill(spill_file);
+    m_encoded_vars.spill(spill_file);
+}
+
+void ClpStringColumnWriter::index_dictionary_ids(
+        int32_t schema_id,
+        DictionaryIndexWriter& index
+) const {
+    if (m_is_array) {
+        return;
+    }
+    std::vector<uint64_t> logtype_ids;
+    logtype_ids.reserve(m_logtypes.get_num_unspilled_values());
+    m_logtypes.for_each_unspilled_segment([&](std::span<int64_t const> segment) {
+        for (auto encoded_id : segment) {
+            logtype_ids.push_back(get_encoded_log_dict_id(encoded_id));
+        }
+    });
+    index.add_logtype_ids(schema_id, m_id, std::move(logtype_ids));
+}
+
 void VariableStringColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size) {
     size = sizeof(int64_t);
-    std::string string_var = std::get<std::string>(value);
+    auto const& string_var = std::get<std::string>(value);
     uint64_t id;
     m_var_dict->add_entry(string_var, id);
     m_variables.push_back(id);
 }
 
-size_t VariableStringColumnWriter::store(ZstdCompressor& compressor) {
-    size_t size = m_variables.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_variables.data()), size);
-    return size;
+size_t VariableStringColumnWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
+    auto const sorted_ids = m_var_dict->get_sorted_ids();
+    if (sorted_ids.empty()) {
+        return m_variables.write(compressor, spill_file);
+    }
+    return m_variables.write(compressor, spill_file, [&](std::span<int64_t> ids) {
+        for (auto& id : ids) {
+            id = static_cast<int64_t>(sorted_ids[id]);
+        }
+    });
+}
+
+void VariableStringColumnWriter::spill(ColumnSpillFile& spill_file) {
+    m_variables.spill(spill_file);
+}
+
+void VariableStringColumnWriter::index_dictionary_ids(
+        int32_t schema_id,
+        DictionaryIndexWriter& index
+) const {
+    std::vector<uint64_t> variable_ids;
+    variable_ids.reserve(m_variables.get_num_unspilled_values());
+    m_variables.for_each_unspilled_segment([&](std::span<int64_t const> segment) {
+        variable_ids.insert(variable_ids.end(), segment.begin(), segment.end());
+    });
+    index.add_variable_ids(schema_id, m_id, std::move(variable_ids));
 }
 
 void DateStringColumnWriter::add_value(ParsedMessage::variable_t& value, size_t& size) {
@@ -82,11 +171,14 @@ void DateStringColumnWriter::add_value(ParsedMessage::variable_t& value, size_t&
     m_timestamp_encodings.push_back(encoded_timestamp.first);
 }
 
-size_t DateStringColumnWriter::store(ZstdCompressor& compressor) {
-    size_t timestamps_size = m_timestamps.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_timestamps.data()), timestamps_size);
-    size_t encodings_size = m_timestamp_encodings.size() * sizeof(int64_t);
-    compressor.write(reinterpret_cast<char const*>(m_timestamp_encodings.data()), encodings_size);
+size_t DateStringColumnWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
+    size_t timestamps_size = m_timestamps.write(compressor, spill_file);
+    size_t encodings_size = m_timestamp_encodings.write(compressor, spill_file);
     return timestamps_size + encodings_size;
 }
+
+void DateStringColumnWriter::spill(ColumnSpillFile& spill_file) {
+    m_timestamps.spill(spill_file);
+    m_timestamp_encodings.spill(spill_file);
+}
 }  // namespace clp_s
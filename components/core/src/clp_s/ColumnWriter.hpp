@@ -3,9 +3,13 @@
 
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <simdjson.h>
 
+#include "ColumnArena.hpp"
+#include "ColumnSpillFile.hpp"
+#include "DictionaryIndexWriter.hpp"
 #include "DictionaryWriter.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
@@ -34,9 +38,28 @@ public:
     /**
      * Stores the column to a compressed file.
      * @param compressor
+     * @param spill_file The file the column's values were spilled to, if any
      * @return the in-memory uncompressed size of the data written to the compressor
      */
-    virtual size_t store(ZstdCompressor& compressor) = 0;
+    virtual size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) = 0;
+
+    /**
+     * Writes the column's values to the spill file and returns their memory to the column's arena.
+     * The values are copied back into the table when the column is stored.
+     * @param spill_file
+     */
+    virtual void spill(ColumnSpillFile& spill_file) = 0;
+
+    /**
+     * Adds the IDs of the dictionary entries that the column's unspilled values reference to the
+     * dictionary index.
+     * @param schema_id The ID of the column's schema table
+     * @param index
+     */
+    virtual void index_dictionary_ids(
+            [[maybe_unused]] int32_t schema_id,
+            [[maybe_unused]] DictionaryIndexWriter& index
+    ) const {}
 
 protected:
     int32_t m_id;
@@ -45,7 +68,7 @@ protected:
 class Int64ColumnWriter : public BaseColumnWriter {
 public:
     // Constructor
-    explicit Int64ColumnWriter(int32_t id) : BaseColumnWriter(id) {}
+    Int64ColumnWriter(int32_t id, ColumnArena& arena) : BaseColumnWriter(id), m_values(arena) {}
 
     // Destructor
     ~Int64ColumnWriter() override = default;
@@ -53,16 +76,18 @@ public:
     // Methods inherited from BaseColumnWriter
     void add_value(ParsedMessage::variable_t& value, size_t& size) override;
 
-    size_t store(ZstdCompressor& compressor) override;
+    size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) override;
+
+    void spill(ColumnSpillFile& spill_file) override;
 
 private:
-    std::vector<int64_t> m_values;
+    SpillableBuffer<int64_t> m_values;
 };
 
 class FloatColumnWriter : public BaseColumnWriter {
 public:
     // Constructor
-    explicit FloatColumnWriter(int32_t id) : BaseColumnWriter(id) {}
+    FloatColumnWriter(int32_t id, ColumnArena& arena) : BaseColumnWriter(id), m_values(arena) {}
 
     // Destructor
     ~FloatColumnWriter() override = default;
@@ -70,16 +95,18 @@ public:
     // Methods inherited from BaseColumnWriter
     void add_value(ParsedMessage::variable_t& value, size_t& size) override;
 
-    size_t store(ZstdCompressor& compressor) override;
+    size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) override;
+
+    void spill(ColumnSpillFile& spill_file) override;
 
 private:
-    std::vector<double> m_values;
+    SpillableBuffer<double> m_values;
 };
 
 class BooleanColumnWriter : public BaseColumnWriter {
 public:
     // Constructor
-    explicit BooleanColumnWriter(int32_t id) : BaseColumnWriter(id) {}
+    BooleanColumnWriter(int32_t id, ColumnArena& arena) : BaseColumnWriter(id), m_values(arena) {}
 
     // Destructor
     ~BooleanColumnWriter() override = default;
@@ -87,10 +114,12 @@ public:
     // Methods inherited from BaseColumnWriter
     void add_value(ParsedMessage::variable_t& value, size_t& size) override;
 
-    size_t store(ZstdCompressor& compressor) override;
+    size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) override;
+
+    void spill(ColumnSpillFile& spill_file) override;
 
 private:
-    std::vector<uint8_t> m_values;
+    SpillableBuffer<uint8_t> m_values;
 };
 
 class ClpStringColumnWriter : public BaseColumnWriter {
@@ -99,11 +128,16 @@ public:
     ClpStringColumnWriter(
             int32_t id,
             std::shared_ptr<VariableDictionaryWriter> var_dict,
-            std::shared_ptr<LogTypeDictionaryWriter> log_dict
+            std::shared_ptr<LogTypeDictionaryWriter> log_dict,
+            ColumnArena& arena,
+            bool is_array = false
     )
             : BaseColumnWriter(id),
               m_var_dict(std::move(var_dict)),
-              m_log_dict(std::move(log_dict)) {}
+              m_log_dict(std::move(log_dict)),
+              m_is_array(is_array),
+              m_logtypes(arena),
+              m_encoded_vars(arena) {}
 
     // Destructor
     ~ClpStringColumnWriter() override = default;
@@ -111,7 +145,11 @@ public:
     // Methods inherited from BaseColumnWriter
     void add_value(ParsedMessage::variable_t& value, size_t& size) override;
 
-    size_t store(ZstdCompressor& compressor) override;
+    size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) override;
+
+    void spill(ColumnSpillFile& spill_file) override;
+
+    void index_dictionary_ids(int32_t schema_id, DictionaryIndexWriter& index) const override;
 
     /**
      * @param encoded_id
@@ -147,17 +185,24 @@ private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
     std::shared_ptr<LogTypeDictionaryWriter> m_log_dict;
     LogTypeDictionaryEntry m_logtype_entry;
+    // Arrays are encoded using the array dictionary, whose IDs aren't indexed
+    bool m_is_array;
 
-    std::vector<int64_t> m_logtypes;
-    std::vector<int64_t> m_encoded_vars;
+    SpillableBuffer<int64_t> m_logtypes;
+    SpillableBuffer<int64_t> m_encoded_vars;
 };
 
 class VariableStringColumnWriter : public BaseColumnWriter {
 public:
     // Constructor
-    VariableStringColumnWriter(int32_t id, std::shared_ptr<VariableDictionaryWriter> var_dict)
+    VariableStringColumnWriter(
+            int32_t id,
+            std::shared_ptr<VariableDictionaryWriter> var_dict,
+            ColumnArena& arena
+    )
             : BaseColumnWriter(id),
-              m_var_dict(std::move(var_dict)) {}
+              m_var_dict(std::move(var_dict)),
+              m_variables(arena) {}
 
     // Destructor
     ~VariableStringColumnWriter() override = default;
@@ -165,17 +210,24 @@ public:
     // Methods inherited from BaseColumnWriter
     void add_value(ParsedMessage::variable_t& value, size_t& size) override;
 
-    size_t store(ZstdCompressor& compressor) override;
+    size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) override;
+
+    void spill(ColumnSpillFile& spill_file) override;
+
+    void index_dictionary_ids(int32_t schema_id, DictionaryIndexWriter& index) const override;
 
 private:
     std::shared_ptr<VariableDictionaryWriter> m_var_dict;
-    std::vector<int64_t> m_variables;
+    SpillableBuffer<int64_t> m_variables;
 };
 
 class DateStringColumnWriter : public BaseColumnWriter {
 public:
     // Constructor
-    explicit DateStringColumnWriter(int32_t id) : BaseColumnWriter(id) {}
+    DateStringColumnWriter(int32_t id, ColumnArena& arena)
+            : BaseColumnWriter(id),
+              m_timestamps(arena),
+              m_timestamp_encodings(arena) {}
 
     // Destructor
     ~DateStringColumnWriter() override = default;
@@ -183,11 +235,13 @@ public:
     // Methods inherited from BaseColumnWriter
     void add_value(ParsedMessage::variable_t& value, size_t& size) override;
 
-    size_t store(ZstdCompressor& compressor) override;
+    size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) override;
+
+    void spill(ColumnSpillFile& spill_file) override;
 
 private:
-    std::vector<int64_t> m_timestamps;
-    std::vector<int64_t> m_timestamp_encodings;
+    SpillableBuffer<int64_t> m_timestamps;
+    SpillableBuffer<int64_t> m_timestamp_encodings;
 };
 }  // namespace clp_s
 
@@ -7,6 +7,7 @@
 
 #include "../clp/cli_utils.hpp"
 #include "../reducer/types.hpp"
+#include "ArchiveRangeCache.hpp"
 #include "FileReader.hpp"
 #include "type_utils.hpp"
 
@@ -65,7 +66,21 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
     }
 
     po::options_description general_options("General options");
-    general_options.add_options()("help,h", "Print help");
+    // clang-format off
+    general_options.add_options()(
+            "help,h", "Print help"
+    )(
+            "metrics-file",
+            po::value<std::string>(&m_metrics_file_path)->value_name("FILE"),
+            "Collect metrics and write them to FILE as a JSON document when the run ends"
+    )(
+            "metrics-interval",
+            po::value<size_t>(&m_metrics_interval)
+                    ->value_name("SECONDS")
+                    ->default_value(m_metrics_interval),
+            "Also write metrics to the metrics file every SECONDS (0 = disabled)"
+    );
+    // clang-format on
 
     char command_input;
     po::options_description general_positional_options("General positional options");
@@ -160,6 +175,18 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                         default_value(m_target_encoded_size),
                     "Target size (B) for the dictionaries and encoded messages before a new "
                     "archive is created."
+            )(
+                    "max-memory",
+                    po::value<size_t>(&m_max_memory)->value_name("MAX_MEMORY")->
+                        default_value(m_max_memory),
+                    "Maximum memory (B) an archive may use while it's being written before a new "
+                    "archive is created (0 for no limit)."
+            )(
+                    "spill-threshold",
+                    po::value<size_t>(&m_spill_threshold)->value_name("SPILL_THRESHOLD")->
+                        default_value(m_spill_threshold),
+                    "Memory (B) an archive's tables may use before their columns are spilled to a "
+                    "temporary file in the archive (0 to never spill)."
             )(
                     "max-document-size",
                     po::value<size_t>(&m_max_document_size)->value_name("DOC_SIZE")->
@@ -189,6 +216,16 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "structurize-arrays",
                     po::bool_switch(&m_structurize_arrays),
                     "Structurize arrays instead of compressing them as clp strings."
+            )(
+                    "build-dictionary-index",
+                    po::bool_switch(&m_build_dictionary_index),
+                    "Index which tables contain each dictionary entry, so that searches for rare "
+                    "values can skip other tables."
+            )(
+                    "sort-dictionaries",
+                    po::bool_switch(&m_sort_dictionaries),
+                    "Sort the variable dictionary when each archive is closed, so that searches "
+                    "for string prefixes can find matching entries with a binary search."
             );
             // clang-format on
 
@@ -298,6 +335,12 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                             ->default_value(m_ordered_chunk_size),
                     "Number of records to include in each output file when decompressing records "
                     "in ascending timestamp order"
+            )(
+                    "num-threads",
+                    po::value<size_t>(&m_num_decompression_threads)
+                            ->value_name("NUM")
+                            ->default_value(m_num_decompression_threads),
+                    "Number of archives to decompress concurrently"
             );
             // clang-format on
             extraction_options.add(decompression_options);
@@ -360,6 +403,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No output directory specified");
             }
 
+            if (0 == m_num_decompression_threads) {
+                throw std::invalid_argument("num-threads cannot be 0");
+            }
+
             if (0 != m_ordered_chunk_size && false == m_ordered_decompression) {
                 throw std::invalid_argument("ordered-chunk-size must be used with ordered argument"
                 );
@@ -388,7 +435,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
             search_options.add_options()(
                     "archives-dir",
                     po::value<std::string>(&m_archives_dir),
-                    "The directory containing the archives"
+                    "The directory (or HTTP URL) containing the archives"
             )(
                     "query,q",
                     po::value<std::string>(&m_query),
@@ -425,6 +472,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 "archive-id",
                 po::value<std::string>(&m_archive_id)->value_name("ID"),
                 "Limit search to the archive with the given ID"
+            )(
+                "archive-cache-dir",
+                po::value<std::string>(&m_archive_cache_dir)->value_name("DIR"),
+                "Cache files downloaded from remote (HTTP) archives in DIR"
             );
             // clang-format on
             search_options.add(match_options);
@@ -439,10 +490,41 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                     "count-by-time",
                     po::value<int64_t>(&m_count_by_time_bucket_size)->value_name("SIZE"),
                     "Count the number of results in each time span of the given size (ms)"
+            )(
+                    "group-by",
+                    po::value<std::vector<std::string>>(&m_group_by_keys)->value_name("KEY"),
+                    "Count the number of results grouped by the value of KEY. May be specified"
+                    " multiple times."
             );
             // clang-format on
             search_options.add(aggregation_options);
 
+            po::options_description output_options("Output Options");
+            // clang-format off
+            output_options.add_options()(
+                    "output-buffer-size",
+                    po::value<size_t>(&m_output_buffer_size)->value_name("SIZE")->
+                            default_value(m_output_buffer_size),
+                    "Buffer up to SIZE bytes of results before writing them to stdout or a network"
+                    " destination"
+            )(
+                    "async-output",
+                    po::bool_switch(&m_async_output),
+                    "Write buffered results to stdout or a network destination from a background"
+                    " thread"
+            )(
+                    "limit",
+                    po::value<uint64_t>(&m_result_limit)->value_name("N"),
+                    "Output at most N results, stopping the search as soon as they're found"
+            )(
+                    "latest",
+                    po::bool_switch(&m_order_by_timestamp_desc),
+                    "With --limit, output the N results with the latest timestamps, in descending"
+                    " timestamp order"
+            );
+            // clang-format on
+            search_options.add(output_options);
+
             po::options_description network_output_handler_options("Network Output Handler Options"
             );
             // clang-format off
@@ -569,6 +651,7 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 visible_options.add(general_options);
                 visible_options.add(match_options);
                 visible_options.add(aggregation_options);
+                visible_options.add(output_options);
                 visible_options.add(network_output_handler_options);
                 visible_options.add(results_cache_output_handler_options);
                 visible_options.add(reducer_output_handler_options);
@@ -584,6 +667,10 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 throw std::invalid_argument("No query specified");
             }
 
+            if (ArchiveRangeCache::is_remote_path(m_archives_dir) && m_archive_id.empty()) {
+                throw std::invalid_argument("An archive ID must be specified for remote archives");
+            }
+
             if (parsed_command_line_options.count("tge")) {
                 m_search_begin_ts = parsed_command_line_options["tge"].as<epochtime_t>();
             }
@@ -655,8 +742,9 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                 );
             }
 
-            bool aggregation_was_specified
-                    = m_do_count_by_time_aggregation || m_do_count_results_aggregation;
+            bool aggregation_was_specified = m_do_count_by_time_aggregation
+                                             || m_do_count_results_aggregation
+                                             || do_group_by_aggregation();
             if (aggregation_was_specified && OutputHandlerType::Reducer != m_output_handler_type) {
                 throw std::invalid_argument(
                         "Aggregations are only supported with the reducer output handler."
@@ -665,7 +753,26 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                         && OutputHandlerType::Reducer == m_output_handler_type))
             {
                 throw std::invalid_argument("The reducer output handler currently only supports "
-                                            "count and count-by-time aggregations.");
+                                            "count, count-by-time, and group-by aggregations.");
+            }
+
+            if (parsed_command_line_options.count("limit") > 0) {
+                if (0 == m_result_limit) {
+                    throw std::invalid_argument("limit cannot be 0.");
+                }
+                if (OutputHandlerType::Reducer == m_output_handler_type) {
+                    throw std::invalid_argument(
+                            "The --limit option isn't supported with the reducer output handler."
+                    );
+                }
+                if (OutputHandlerType::ResultsCache == m_output_handler_type) {
+                    throw std::invalid_argument(
+                            "The results cache output handler is limited by --max-num-results"
+                            " rather than --limit."
+                    );
+                }
+            } else if (m_order_by_timestamp_desc) {
+                throw std::invalid_argument("The --latest option requires --limit.");
             }
 
             if (m_do_count_by_time_aggregation && m_do_count_results_aggregation) {
@@ -673,6 +780,15 @@ CommandLineArguments::parse_arguments(int argc, char const** argv) {
                         "The --count-by-time and --count options are mutually exclusive."
                 );
             }
+
+            if (do_group_by_aggregation()
+                && (m_do_count_by_time_aggregation || m_do_count_results_aggregation))
+            {
+                throw std::invalid_argument(
+                        "The --group-by option is mutually exclusive with the --count and "
+                        "--count-by-time options."
+                );
+            }
         }
     } catch (std::exception& e) {
         SPDLOG_ERROR("{}", e.what());
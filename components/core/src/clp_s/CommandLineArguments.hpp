@@ -46,6 +46,10 @@ public:
 
     Command get_command() const { return m_command; }
 
+    std::string const& get_metrics_file_path() const { return m_metrics_file_path; }
+
+    size_t get_metrics_interval() const { return m_metrics_interval; }
+
     std::vector<std::string> const& get_file_paths() const { return m_file_paths; }
 
     std::string const& get_archives_dir() const { return m_archives_dir; }
@@ -58,6 +62,10 @@ public:
 
     size_t get_target_encoded_size() const { return m_target_encoded_size; }
 
+    [[nodiscard]] size_t get_max_memory() const { return m_max_memory; }
+
+    [[nodiscard]] size_t get_spill_threshold() const { return m_spill_threshold; }
+
     size_t get_max_document_size() const { return m_max_document_size; }
 
     [[nodiscard]] bool print_archive_stats() const { return m_print_archive_stats; }
@@ -82,8 +90,17 @@ public:
 
     bool get_ignore_case() const { return m_ignore_case; }
 
+    /**
+     * @return The maximum number of results to output, or 0 if the number of results isn't limited
+     */
+    [[nodiscard]] uint64_t get_result_limit() const { return m_result_limit; }
+
+    [[nodiscard]] bool get_order_by_timestamp_desc() const { return m_order_by_timestamp_desc; }
+
     std::string const& get_archive_id() const { return m_archive_id; }
 
+    std::string const& get_archive_cache_dir() const { return m_archive_cache_dir; }
+
     std::optional<clp::GlobalMetadataDBConfig> const& get_metadata_db_config() const {
         return m_metadata_db_config;
     }
@@ -100,14 +117,28 @@ public:
 
     int64_t get_count_by_time_bucket_size() const { return m_count_by_time_bucket_size; }
 
+    [[nodiscard]] size_t get_output_buffer_size() const { return m_output_buffer_size; }
+
+    [[nodiscard]] bool do_async_output() const { return m_async_output; }
+
+    bool do_group_by_aggregation() const { return false == m_group_by_keys.empty(); }
+
+    std::vector<std::string> const& get_group_by_keys() const { return m_group_by_keys; }
+
     OutputHandlerType get_output_handler_type() const { return m_output_handler_type; }
 
     bool get_structurize_arrays() const { return m_structurize_arrays; }
 
+    bool get_build_dictionary_index() const { return m_build_dictionary_index; }
+
+    bool get_sort_dictionaries() const { return m_sort_dictionaries; }
+
     bool get_ordered_decompression() const { return m_ordered_decompression; }
 
     size_t get_ordered_chunk_size() const { return m_ordered_chunk_size; }
 
+    size_t get_num_decompression_threads() const { return m_num_decompression_threads; }
+
 private:
     // Methods
     /**
@@ -160,6 +191,8 @@ private:
     // Variables
     std::string m_program_name;
     Command m_command;
+    std::string m_metrics_file_path;
+    size_t m_metrics_interval{0};
 
     // Compression and decompression variables
     std::vector<std::string> m_file_paths;
@@ -168,11 +201,16 @@ private:
     std::string m_timestamp_key;
     int m_compression_level{3};
     size_t m_target_encoded_size{8ULL * 1024 * 1024 * 1024};  // 8 GiB
+    size_t m_max_memory{0};
+    size_t m_spill_threshold{0};
     bool m_print_archive_stats{false};
     size_t m_max_document_size{512ULL * 1024 * 1024};  // 512 MB
     bool m_structurize_arrays{false};
+    bool m_build_dictionary_index{false};
+    bool m_sort_dictionaries{false};
     bool m_ordered_decompression{false};
     size_t m_ordered_chunk_size{0};
+    size_t m_num_decompression_threads{1};
 
     // Metadata db variables
     std::optional<clp::GlobalMetadataDBConfig> m_metadata_db_config;
@@ -192,9 +230,12 @@ private:
     std::optional<epochtime_t> m_search_begin_ts;
     std::optional<epochtime_t> m_search_end_ts;
     bool m_ignore_case{false};
+    uint64_t m_result_limit{0};
+    bool m_order_by_timestamp_desc{false};
 
     // Decompression and search variables
     std::string m_archive_id;
+    std::string m_archive_cache_dir;
 
     // Search aggregation variables
     std::string m_reducer_host;
@@ -204,6 +245,11 @@ private:
     bool m_do_count_by_time_aggregation{false};
     int64_t m_count_by_time_bucket_size{0};  // Milliseconds
 
+    // Output variables
+    size_t m_output_buffer_size{1024 * 1024};
+    bool m_async_output{false};
+    std::vector<std::string> m_group_by_keys;
+
     OutputHandlerType m_output_handler_type{OutputHandlerType::Stdout};
 };
 }  // namespace clp_s
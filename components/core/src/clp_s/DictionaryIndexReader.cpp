@@ -0,0 +1,97 @@
+#include "DictionaryIndexReader.hpp"
+
+#include <algorithm>
+
+#include "FileReader.hpp"
+
+namespace clp_s {
+void DictionaryIndexReader::read(
+        std::string const& index_path,
+        std::vector<uint64_t> const& variable_ids,
+        std::vector<uint64_t> const& logtype_ids
+) {
+    constexpr size_t cDecompressorFileReadBufferCapacity = 64 * 1024;  // 64 KB
+
+    FileReader index_reader;
+    ZstdDecompressor index_decompressor;
+    index_reader.open(index_path);
+    index_decompressor.open(index_reader, cDecompressorFileReadBufferCapacity);
+
+    m_variable_postings.clear();
+    m_logtype_postings.clear();
+    read_postings(index_decompressor, variable_ids, m_variable_postings);
+    read_postings(index_decompressor, logtype_ids, m_logtype_postings);
+
+    index_decompressor.close();
+    index_reader.close();
+}
+
+void DictionaryIndexReader::read_postings(
+        ZstdDecompressor& decompressor,
+        std::vector<uint64_t> const& ids,
+        Postings& postings
+) {
+    size_t num_ids;
+    if (auto error = decompressor.try_read_numeric_value(num_ids); ErrorCodeSuccess != error) {
+        throw OperationFailed(error, __FILENAME__, __LINE__);
+    }
+
+    for (size_t i = 0; i < num_ids; ++i) {
+        uint64_t id;
+        uint32_t num_columns;
+        if (auto error = decompressor.try_read_numeric_value(id); ErrorCodeSuccess != error) {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+        if (auto error = decompressor.try_read_numeric_value(num_columns);
+            ErrorCodeSuccess != error)
+        {
+            throw OperationFailed(error, __FILENAME__, __LINE__);
+        }
+
+        // The postings of every ID must be read to reach the next ID, but only those of the given
+        // IDs are kept
+        std::vector<std::pair<int32_t, int32_t>>* columns{nullptr};
+        if (std::binary_search(ids.cbegin(), ids.cend(), id)) {
+            columns = &postings[id];
+            columns->reserve(num_columns);
+        }
+        for (uint32_t j = 0; j < num_columns; ++j) {
+            int32_t schema_id;
+            int32_t column_id;
+            if (auto error = decompressor.try_read_numeric_value(schema_id);
+                ErrorCodeSuccess != error)
+            {
+                throw OperationFailed(error, __FILENAME__, __LINE__);
+            }
+            if (auto error = decompressor.try_read_numeric_value(column_id);
+                ErrorCodeSuccess != error)
+            {
+                throw OperationFailed(error, __FILENAME__, __LINE__);
+            }
+            if (nullptr != columns) {
+                columns->emplace_back(schema_id, column_id);
+            }
+        }
+    }
+}
+
+bool DictionaryIndexReader::contains_any_id(
+        Postings const& postings,
+        std::vector<uint64_t> const& ids,
+        int32_t schema_id,
+        int32_t column_id
+) {
+    auto const column = std::make_pair(schema_id, column_id);
+    for (auto id : ids) {
+        auto it = postings.find(id);
+        if (postings.end() == it) {
+            continue;
+        }
+        // Postings are sorted by schema ID and then column ID
+        if (std::binary_search(it->second.cbegin(), it->second.cend(), column)) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace clp_s
@@ -0,0 +1,113 @@
+#ifndef CLP_S_DICTIONARYINDEXREADER_HPP
+#define CLP_S_DICTIONARYINDEXREADER_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "TraceableException.hpp"
+#include "ZstdDecompressor.hpp"
+
+namespace clp_s {
+/**
+ * Reads an archive's dictionary index (see `DictionaryIndexWriter`) to find the tables and columns
+ * that may contain a set of dictionary IDs.
+ *
+ * Only the postings of the IDs that a query needs are kept in memory, since an archive's index may
+ * contain millions of IDs while needle-in-haystack queries only need a handful.
+ */
+class DictionaryIndexReader {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+    };
+
+    // Methods
+    /**
+     * Reads the postings of the given IDs from the given index file.
+     * @param index_path
+     * @param variable_ids The variable dictionary IDs to read the postings of, in ascending order.
+     * @param logtype_ids The logtype dictionary IDs to read the postings of, in ascending order.
+     * @throw DictionaryIndexReader::OperationFailed if the index can't be read
+     */
+    void read(
+            std::string const& index_path,
+            std::vector<uint64_t> const& variable_ids,
+            std::vector<uint64_t> const& logtype_ids
+    );
+
+    /**
+     * @param variable_ids
+     * @param schema_id
+     * @param column_id
+     * @return Whether the given column of the given table contains any of the given variable
+     * dictionary IDs. The IDs must have been read from the index.
+     */
+    [[nodiscard]] bool contains_any_variable_id(
+            std::vector<uint64_t> const& variable_ids,
+            int32_t schema_id,
+            int32_t column_id
+    ) const {
+        return contains_any_id(m_variable_postings, variable_ids, schema_id, column_id);
+    }
+
+    /**
+     * @param logtype_ids
+     * @param schema_id
+     * @param column_id
+     * @return Whether the given column of the given table contains any of the given logtype
+     * dictionary IDs. The IDs must have been read from the index.
+     */
+    [[nodiscard]] bool contains_any_logtype_id(
+            std::vector<uint64_t> const& logtype_ids,
+            int32_t schema_id,
+            int32_t column_id
+    ) const {
+        return contains_any_id(m_logtype_postings, logtype_ids, schema_id, column_id);
+    }
+
+private:
+    // Types
+    // Map from a dictionary ID to the (schema ID, column ID) pairs that contain it
+    using Postings = std::unordered_map<uint64_t, std::vector<std::pair<int32_t, int32_t>>>;
+
+    // Methods
+    /**
+     * Reads one dictionary's postings from the index, keeping only those of the given IDs.
+     * @param decompressor
+     * @param ids
+     * @param postings Returns the postings of the given IDs.
+     * @throw DictionaryIndexReader::OperationFailed if the index can't be read
+     */
+    static void read_postings(
+            ZstdDecompressor& decompressor,
+            std::vector<uint64_t> const& ids,
+            Postings& postings
+    );
+
+    /**
+     * @param postings
+     * @param ids
+     * @param schema_id
+     * @param column_id
+     * @return Whether the given postings contain the given column for any of the given IDs.
+     */
+    static bool contains_any_id(
+            Postings const& postings,
+            std::vector<uint64_t> const& ids,
+            int32_t schema_id,
+            int32_t column_id
+    );
+
+    Postings m_variable_postings;
+    Postings m_logtype_postings;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_DICTIONARYINDEXREADER_HPP
@@ -0,0 +1,91 @@
+#include "DictionaryIndexWriter.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include "archive_constants.hpp"
+#include "FileWriter.hpp"
+
+namespace clp_s {
+size_t DictionaryIndexWriter::store(std::string const& archive_path, int compression_level) {
+    FileWriter index_writer;
+    ZstdCompressor index_compressor;
+
+    index_writer.open(
+            archive_path + constants::cArchiveDictionaryIndexFile,
+            FileWriter::OpenMode::CreateForWriting
+    );
+    index_compressor.open(index_writer, compression_level);
+    write_postings(m_variable_postings, index_compressor);
+    write_postings(m_logtype_postings, index_compressor);
+    index_compressor.close();
+    size_t compressed_size = index_writer.get_pos();
+    index_writer.close();
+
+    m_variable_postings.clear();
+    m_logtype_postings.clear();
+    return compressed_size;
+}
+
+void DictionaryIndexWriter::remap_variable_ids(std::span<uint64_t const> sorted_ids) {
+    for (auto& posting : m_variable_postings) {
+        posting.id = sorted_ids[posting.id];
+    }
+}
+
+void DictionaryIndexWriter::add_ids(
+        std::vector<Posting>& postings,
+        int32_t schema_id,
+        int32_t column_id,
+        std::vector<uint64_t> ids
+) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    for (auto id : ids) {
+        postings.push_back({id, schema_id, column_id});
+    }
+}
+
+void DictionaryIndexWriter::write_postings(
+        std::vector<Posting>& postings,
+        ZstdCompressor& compressor
+) {
+    std::sort(postings.begin(), postings.end(), [](Posting const& lhs, Posting const& rhs) {
+        return std::tie(lhs.id, lhs.schema_id, lhs.column_id)
+               < std::tie(rhs.id, rhs.schema_id, rhs.column_id);
+    });
+    // A column's IDs may be added more than once (e.g., once each time the column is spilled)
+    postings.erase(
+            std::unique(
+                    postings.begin(),
+                    postings.end(),
+                    [](Posting const& lhs, Posting const& rhs) {
+                        return std::tie(lhs.id, lhs.schema_id, lhs.column_id)
+                               == std::tie(rhs.id, rhs.schema_id, rhs.column_id);
+                    }
+            ),
+            postings.end()
+    );
+
+    size_t num_ids = 0;
+    for (size_t i = 0; i < postings.size(); ++i) {
+        if (0 == i || postings[i - 1].id != postings[i].id) {
+            ++num_ids;
+        }
+    }
+    compressor.write_numeric_value(num_ids);
+
+    for (size_t begin = 0, end = 0; begin < postings.size(); begin = end) {
+        auto const id = postings[begin].id;
+        while (end < postings.size() && postings[end].id == id) {
+            ++end;
+        }
+        compressor.write_numeric_value(id);
+        compressor.write_numeric_value(static_cast<uint32_t>(end - begin));
+        for (auto i = begin; i < end; ++i) {
+            compressor.write_numeric_value(postings[i].schema_id);
+            compressor.write_numeric_value(postings[i].column_id);
+        }
+    }
+}
+}  // namespace clp_s
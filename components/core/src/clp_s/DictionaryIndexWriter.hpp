@@ -0,0 +1,101 @@
+#ifndef CLP_S_DICTIONARYINDEXWRITER_HPP
+#define CLP_S_DICTIONARYINDEXWRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ZstdCompressor.hpp"
+
+namespace clp_s {
+/**
+ * Writes an archive's dictionary index: an inverted index from each variable and logtype
+ * dictionary ID to the (schema table, column) pairs that contain it. This is the clp-s analogue of
+ * clp's per-segment dictionary index; it allows search to skip tables that can't contain any of
+ * the dictionary entries a query needs (e.g., when searching for a trace ID).
+ *
+ * The index is stored as a sequence of numeric values in a zstd-compressed file:
+ * - For the variable dictionary and then the logtype dictionary:
+ *   - The number of IDs in the index
+ *   - For each ID, in ascending order:
+ *     - The ID
+ *     - The number of columns that contain it
+ *     - For each column, the ID of its schema table and its ID in the schema tree
+ */
+class DictionaryIndexWriter {
+public:
+    // Methods
+    /**
+     * Adds the given variable dictionary IDs to the index as being contained in the given column.
+     * @param schema_id
+     * @param column_id
+     * @param ids The IDs, possibly with duplicates.
+     */
+    void add_variable_ids(int32_t schema_id, int32_t column_id, std::vector<uint64_t> ids) {
+        add_ids(m_variable_postings, schema_id, column_id, std::move(ids));
+    }
+
+    /**
+     * Adds the given logtype dictionary IDs to the index as being contained in the given column.
+     * @param schema_id
+     * @param column_id
+     * @param ids The IDs, possibly with duplicates.
+     */
+    void add_logtype_ids(int32_t schema_id, int32_t column_id, std::vector<uint64_t> ids) {
+        add_ids(m_logtype_postings, schema_id, column_id, std::move(ids));
+    }
+
+    /**
+     * Replaces each variable dictionary ID in the index with its new ID after the variable
+     * dictionary was sorted.
+     * @param sorted_ids The new ID of each variable dictionary ID
+     */
+    void remap_variable_ids(std::span<uint64_t const> sorted_ids);
+
+    /**
+     * Stores the index in the given archive and clears it.
+     * @param archive_path
+     * @param compression_level
+     * @return the compressed size of the index in bytes
+     */
+    [[nodiscard]] size_t store(std::string const& archive_path, int compression_level);
+
+private:
+    // Types
+    struct Posting {
+        uint64_t id;
+        int32_t schema_id;
+        int32_t column_id;
+    };
+
+    // Methods
+    /**
+     * Adds a posting to the given postings for each distinct ID in the given IDs.
+     * @param postings
+     * @param schema_id
+     * @param column_id
+     * @param ids
+     */
+    static void add_ids(
+            std::vector<Posting>& postings,
+            int32_t schema_id,
+            int32_t column_id,
+            std::vector<uint64_t> ids
+    );
+
+    /**
+     * Writes the given postings, grouped by ID.
+     * @param postings
+     * @param compressor
+     */
+    static void write_postings(std::vector<Posting>& postings, ZstdCompressor& compressor);
+
+    std::vector<Posting> m_variable_postings;
+    std::vector<Posting> m_logtype_postings;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_DICTIONARYINDEXWRITER_HPP
@@ -3,10 +3,15 @@
 #ifndef CLP_S_DICTIONARYREADER_HPP
 #define CLP_S_DICTIONARYREADER_HPP
 
+#include <algorithm>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
 
 #include <boost/algorithm/string/case_conv.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
+#include "../clp/Metrics.hpp"
 #include "DictionaryEntry.hpp"
 #include "Utils.hpp"
 
@@ -80,8 +85,24 @@ public:
             std::unordered_set<EntryType const*>& entries
     ) const;
 
+    /**
+     * @return Whether the entries' IDs are in lexicographical order of their values, e.g., because
+     * the dictionary was sorted when it was written
+     */
+    [[nodiscard]] bool is_sorted() const { return m_is_sorted; }
+
+    /**
+     * Gets the IDs of the entries whose values start with the given prefix (case-sensitively). The
+     * dictionary must be sorted.
+     * @param prefix
+     * @return The half-open range of the IDs
+     */
+    [[nodiscard]] std::pair<DictionaryIdType, DictionaryIdType>
+    get_id_range_matching_prefix(std::string_view prefix) const;
+
 protected:
     bool m_is_open;
+    bool m_is_sorted{true};
     FileReader m_dictionary_file_reader;
     ZstdDecompressor m_dictionary_decompressor;
     std::vector<EntryType> m_entries;
@@ -125,6 +146,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries(bool lazy)
     if (false == m_is_open) {
         throw OperationFailed(ErrorCodeNotInit, __FILENAME__, __LINE__);
     }
+    clp::Metrics::ScopedTimer const load_timer{clp::Metrics::Stage::DictionaryLoad};
 
     auto dictionary_file_reader_pos = m_dictionary_file_reader.get_pos();
     m_dictionary_file_reader.seek_from_begin(0);
@@ -146,6 +168,18 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries(bool lazy)
             auto& entry = m_entries[i];
             entry.read_from_file(m_dictionary_decompressor, i, lazy);
         }
+
+        if (m_is_sorted) {
+            auto const sorted_begin_ix
+                    = 0 == prev_num_dictionary_entries ? 0 : prev_num_dictionary_entries - 1;
+            m_is_sorted = std::is_sorted(
+                    m_entries.cbegin() + sorted_begin_ix,
+                    m_entries.cend(),
+                    [](EntryType const& lhs, EntryType const& rhs) {
+                        return lhs.get_value() < rhs.get_value();
+                    }
+            );
+        }
     }
 }
 
@@ -199,12 +233,36 @@ void DictionaryReader<DictionaryIdType, EntryType>::get_entries_matching_wildcar
         bool ignore_case,
         std::unordered_set<EntryType const*>& entries
 ) const {
+    clp::string_utils::WildcardMatcher const matcher{wildcard_string, false == ignore_case};
     for (auto const& entry : m_entries) {
-        if (StringUtils::wildcard_match_unsafe(entry.get_value(), wildcard_string, !ignore_case)) {
+        if (matcher.matches(entry.get_value())) {
             entries.insert(&entry);
         }
     }
 }
+
+template <typename DictionaryIdType, typename EntryType>
+std::pair<DictionaryIdType, DictionaryIdType>
+DictionaryReader<DictionaryIdType, EntryType>::get_id_range_matching_prefix(std::string_view prefix
+) const {
+    if (false == m_is_sorted) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+
+    // Since the entries are sorted, the entries starting with the prefix are contiguous and start
+    // at the first entry that isn't less than the prefix
+    auto const begin = std::lower_bound(
+            m_entries.cbegin(),
+            m_entries.cend(),
+            prefix,
+            [](EntryType const& entry, std::string_view value) { return entry.get_value() < value; }
+    );
+    auto const end = std::partition_point(begin, m_entries.cend(), [&](EntryType const& entry) {
+        return std::string_view{entry.get_value()}.starts_with(prefix);
+    });
+    return {static_cast<DictionaryIdType>(begin - m_entries.cbegin()),
+            static_cast<DictionaryIdType>(end - m_entries.cbegin())};
+}
 }  // namespace clp_s
 
 #endif  // CLP_S_DICTIONARYREADER_HPP
@@ -2,8 +2,11 @@
 
 #include "DictionaryWriter.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace clp_s {
-bool VariableDictionaryWriter::add_entry(std::string const& value, uint64_t& id) {
+bool VariableDictionaryWriter::add_entry(std::string_view value, uint64_t& id) {
     bool new_entry = false;
 
     auto const ix = m_value_to_id.find(value);
@@ -22,19 +25,53 @@ bool VariableDictionaryWriter::add_entry(std::string const& value, uint64_t& id)
         ++m_next_id;
 
         // Insert the ID obtained from the database into the dictionary
-        auto entry = VariableDictionaryEntry(value, id);
-        m_value_to_id[value] = id;
+        auto entry = VariableDictionaryEntry(std::string{value}, id);
+        m_value_to_id.emplace(value, id);
 
         new_entry = true;
 
         // TODO: This doesn't account for the segment index that's constantly updated
         m_data_size += entry.get_data_size();
 
-        entry.write_to_file(m_dictionary_compressor);
+        // Sorted dictionaries are written once they're sorted
+        if (false == m_sort_entries) {
+            entry.write_to_file(m_dictionary_compressor);
+        }
     }
     return new_entry;
 }
 
+void VariableDictionaryWriter::enable_sorting() {
+    if (false == m_is_open || 0 != m_next_id) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+    m_sort_entries = true;
+}
+
+void VariableDictionaryWriter::sort_entries() {
+    if (false == m_is_open || false == m_sort_entries) {
+        throw OperationFailed(ErrorCodeNotReady, __FILENAME__, __LINE__);
+    }
+
+    std::vector<value_to_id_t::value_type*> entries;
+    entries.reserve(m_value_to_id.size());
+    for (auto& entry : m_value_to_id) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](auto const* lhs, auto const* rhs) {
+        return lhs->first < rhs->first;
+    });
+
+    m_sorted_ids.resize(entries.size());
+    for (uint64_t sorted_id = 0; sorted_id < entries.size(); ++sorted_id) {
+        auto& [value, id] = *entries[sorted_id];
+        m_sorted_ids[id] = sorted_id;
+        id = sorted_id;
+        VariableDictionaryEntry{value, sorted_id}.write_to_file(m_dictionary_compressor);
+    }
+    m_sort_entries = false;
+}
+
 bool LogTypeDictionaryWriter::add_entry(
         LogTypeDictionaryEntry& logtype_entry,
         uint64_t& logtype_id
@@ -60,6 +97,12 @@ bool LogTypeDictionaryWriter::add_entry(
         // TODO: This doesn't account for the segment index that's constantly updated
         m_data_size += logtype_entry.get_data_size();
 
+        std::string var_delims;
+        for (size_t i = 0; i < logtype_entry.get_num_vars(); ++i) {
+            var_delims += static_cast<char>(logtype_entry.get_var_delim(i));
+        }
+        m_id_to_var_delims.push_back(std::move(var_delims));
+
         logtype_entry.write_to_file(m_dictionary_compressor);
     }
     return is_new_entry;
@@ -3,6 +3,15 @@
 #ifndef CLP_S_DICTIONARYWRITER_HPP
 #define CLP_S_DICTIONARYWRITER_HPP
 
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../clp/BloomFilter.hpp"
+#include "../clp/TransparentStringHash.hpp"
 #include "DictionaryEntry.hpp"
 
 namespace clp_s {
@@ -48,9 +57,41 @@ public:
      */
     size_t get_data_size() const { return m_data_size; }
 
+    /**
+     * @return The number of bytes of memory held by the dictionary
+     */
+    [[nodiscard]] size_t get_memory_usage() const {
+        // Each entry is a hash node holding the next node's pointer, the value, its ID, and its
+        // cached hash
+        constexpr size_t cNodeSize{
+                sizeof(void*) + sizeof(typename value_to_id_t::value_type) + sizeof(size_t)
+        };
+        return m_data_size + m_value_to_id.size() * cNodeSize
+               + m_value_to_id.bucket_count() * sizeof(void*);
+    }
+
+    /**
+     * Builds a Bloom filter over the values in the dictionary, so that searches can check whether
+     * a value may be in the dictionary without reading it
+     * @param false_positive_rate
+     * @return The filter
+     */
+    clp::BloomFilter build_bloom_filter(double false_positive_rate) const {
+        clp::BloomFilter filter{m_value_to_id.size(), false_positive_rate};
+        for (auto const& [value, id] : m_value_to_id) {
+            filter.add(value);
+        }
+        return filter;
+    }
+
 protected:
     // Types
-    using value_to_id_t = std::unordered_map<std::string, DictionaryIdType>;
+    // Values can be looked up without copying them into a `std::string`
+    using value_to_id_t = std::unordered_map<
+            std::string,
+            DictionaryIdType,
+            clp::TransparentStringHash,
+            std::equal_to<>>;
 
     // Variables
     bool m_is_open;
@@ -81,7 +122,33 @@ public:
      * @param value
      * @param id ID of the variable matching the given entry
      */
-    bool add_entry(std::string const& value, uint64_t& id);
+    bool add_entry(std::string_view value, uint64_t& id);
+
+    /**
+     * Defers writing the dictionary's entries until `sort_entries` is called, so that they can be
+     * written in lexicographical order. This must be called before any entries are added, and
+     * `sort_entries` must be called before the dictionary is closed.
+     */
+    void enable_sorting();
+
+    /**
+     * Sorts the dictionary's entries lexicographically, reassigns each entry the ID of its
+     * position in the sorted order, and writes the entries in that order. Afterwards, the IDs
+     * returned by `add_entry` must be mapped to the new IDs using `get_sorted_ids`.
+     */
+    void sort_entries();
+
+    /**
+     * @return The new ID of each entry indexed by the ID `add_entry` returned for it, or an empty
+     * span if the dictionary hasn't been sorted. The mapping remains valid after the dictionary is
+     * closed, so that the archive's columns can be remapped when they're stored.
+     */
+    [[nodiscard]] std::span<uint64_t const> get_sorted_ids() const { return m_sorted_ids; }
+
+private:
+    // Variables
+    bool m_sort_entries{false};
+    std::vector<uint64_t> m_sorted_ids;
 };
 
 class LogTypeDictionaryWriter : public DictionaryWriter<uint64_t, LogTypeDictionaryEntry> {
@@ -99,6 +166,20 @@ public:
      * @param logtype_id ID of the logtype matching the given entry
      */
     bool add_entry(LogTypeDictionaryEntry& logtype_entry, uint64_t& logtype_id);
+
+    /**
+     * Gets the delimiters of the given logtype's variables, which distinguish the variables that
+     * were encoded as doubles from the others. This remains valid after the dictionary is closed.
+     * @param logtype_id
+     * @return The delimiter of each of the logtype's variables, in order, as `char`s
+     */
+    [[nodiscard]] std::string_view get_var_delims(uint64_t logtype_id) const {
+        return m_id_to_var_delims[logtype_id];
+    }
+
+private:
+    // Variables
+    std::vector<std::string> m_id_to_var_delims;
 };
 
 template <typename DictionaryIdType, typename EntryType>
@@ -1,7 +1,13 @@
 #include "JsonConstructor.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
-#include <queue>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <system_error>
 
 #include <fmt/core.h>
@@ -9,7 +15,9 @@
 #include <mongocxx/collection.hpp>
 #include <mongocxx/exception/exception.hpp>
 #include <mongocxx/uri.hpp>
+#include <spdlog/spdlog.h>
 
+#include "../clp/ThreadJoiner.hpp"
 #include "archive_constants.hpp"
 #include "ErrorCode.hpp"
 #include "ReaderUtils.hpp"
@@ -17,6 +25,104 @@
 #include "TraceableException.hpp"
 
 namespace clp_s {
+namespace {
+/**
+ * A tournament (winner) tree over the next timestamps of a fixed number of leaves (tables), used to
+ * repeatedly find the table containing the record with the smallest timestamp.
+ *
+ * The tree is stored implicitly in contiguous arrays, and leaves can be updated, inserted, or
+ * removed in O(log n) time by replaying only the matches on the path from the leaf to the root.
+ */
+class TimestampTournamentTree {
+public:
+    // Constructors
+    explicit TimestampTournamentTree(size_t num_leaves) {
+        while (m_num_leaves < num_leaves) {
+            m_num_leaves *= 2;
+        }
+        m_timestamps.resize(m_num_leaves, cEpochTimeMax);
+        m_is_active.resize(m_num_leaves, false);
+        m_winners.resize(2 * m_num_leaves);
+        for (size_t i = 0; i < m_num_leaves; ++i) {
+            m_winners[m_num_leaves + i] = i;
+        }
+        for (size_t node = m_num_leaves - 1; node > 0; --node) {
+            replay_match(node);
+        }
+    }
+
+    // Methods
+    [[nodiscard]] bool empty() const { return false == m_is_active[get_min_leaf()]; }
+
+    /**
+     * NOTE: It's the caller's responsibility to ensure the tree isn't empty.
+     * @return The leaf with the smallest timestamp
+     */
+    [[nodiscard]] size_t get_min_leaf() const { return m_winners[1]; }
+
+    /**
+     * NOTE: It's the caller's responsibility to ensure the tree isn't empty.
+     * @return The smallest timestamp in the tree
+     */
+    [[nodiscard]] epochtime_t get_min_timestamp() const { return m_timestamps[get_min_leaf()]; }
+
+    /**
+     * Sets the timestamp of a leaf, making it active if it isn't already.
+     * @param leaf
+     * @param timestamp
+     */
+    void update(size_t leaf, epochtime_t timestamp) {
+        m_timestamps[leaf] = timestamp;
+        m_is_active[leaf] = true;
+        replay_path(leaf);
+    }
+
+    /**
+     * Deactivates a leaf so that it never wins a match.
+     * @param leaf
+     */
+    void remove(size_t leaf) {
+        m_is_active[leaf] = false;
+        replay_path(leaf);
+    }
+
+private:
+    /**
+     * @param lhs
+     * @param rhs
+     * @return Whether leaf `lhs` beats leaf `rhs`. Ties are broken by leaf index so that the
+     * output is deterministic.
+     */
+    [[nodiscard]] bool beats(size_t lhs, size_t rhs) const {
+        if (m_is_active[lhs] != m_is_active[rhs]) {
+            return m_is_active[lhs];
+        }
+        if (m_timestamps[lhs] != m_timestamps[rhs]) {
+            return m_timestamps[lhs] < m_timestamps[rhs];
+        }
+        return lhs < rhs;
+    }
+
+    void replay_match(size_t node) {
+        auto const left = m_winners[2 * node];
+        auto const right = m_winners[2 * node + 1];
+        m_winners[node] = beats(right, left) ? right : left;
+    }
+
+    void replay_path(size_t leaf) {
+        for (auto node = (m_num_leaves + leaf) / 2; node > 0; node /= 2) {
+            replay_match(node);
+        }
+    }
+
+    size_t m_num_leaves{1};
+    std::vector<epochtime_t> m_timestamps;
+    std::vector<bool> m_is_active;
+    // m_winners[1] is the root, and m_winners[m_num_leaves + i] is leaf i
+    std::vector<size_t> m_winners;
+};
+}  // namespace
+
 JsonConstructor::JsonConstructor(JsonConstructorOption const& option) : m_option{option} {
     std::error_code error_code;
     if (false == std::filesystem::create_directory(option.output_dir, error_code) && error_code) {
@@ -51,10 +157,14 @@ void JsonConstructor::store() {
     if (false == m_option.ordered) {
         FileWriter writer;
         writer.open(
-                m_option.output_dir + "/original",
+                m_option.output_dir + "/" + cUnorderedOutputFileName,
                 FileWriter::OpenMode::CreateIfNonexistentForAppending
         );
-        m_archive_reader->store(writer);
+        if (nullptr == m_option.output_mutex) {
+            m_archive_reader->store(writer);
+        } else {
+            m_archive_reader->store(writer, *m_option.output_mutex);
+        }
 
         writer.close();
     } else {
@@ -65,15 +175,26 @@ void JsonConstructor::store() {
 
 void JsonConstructor::construct_in_order() {
     std::string buffer;
-    auto tables = m_archive_reader->read_all_tables();
-    using ReaderPointer = std::shared_ptr<SchemaReader>;
-    auto cmp = [](ReaderPointer& left, ReaderPointer& right) {
-        return left->get_next_timestamp() > right->get_next_timestamp();
+
+    // Tables are loaded lazily in order of their earliest timestamp, so that a table only becomes
+    // resident once the merge reaches its timestamp range, and it's released as soon as all of its
+    // records have been written.
+    auto schema_ids = m_archive_reader->get_schema_ids();
+    std::stable_sort(schema_ids.begin(), schema_ids.end(), [&](int32_t lhs, int32_t rhs) {
+        return m_archive_reader->get_table_metadata(lhs).begin_timestamp
+               < m_archive_reader->get_table_metadata(rhs).begin_timestamp;
+    });
+    std::vector<std::unique_ptr<SchemaReader>> tables(schema_ids.size());
+    TimestampTournamentTree record_tree{schema_ids.size()};
+    size_t num_tables_loaded{0};
+    auto load_next_table = [&]() {
+        auto const table_ix = num_tables_loaded++;
+        auto table = m_archive_reader->load_table(schema_ids[table_ix], true, true);
+        if (false == table->done()) {
+            record_tree.update(table_ix, table->get_next_timestamp());
+            tables[table_ix] = std::move(table);
+        }
     };
-    std::priority_queue record_queue(tables.begin(), tables.end(), cmp);
-    // Clear tables vector so that memory gets deallocated after we have marshalled all records for
-    // a given table
-    tables.clear();
 
     epochtime_t first_timestamp{0};
     epochtime_t last_timestamp{0};
@@ -137,16 +258,32 @@ void JsonConstructor::construct_in_order() {
         }
     };
 
-    while (false == record_queue.empty()) {
-        ReaderPointer next = record_queue.top();
-        record_queue.pop();
-        last_timestamp = next->get_next_timestamp();
+    while (true) {
+        // Load every table which may contain a record preceding the next record to be written
+        while (num_tables_loaded < schema_ids.size()
+               && (record_tree.empty()
+                   || m_archive_reader->get_table_metadata(schema_ids[num_tables_loaded])
+                                      .begin_timestamp
+                              <= record_tree.get_min_timestamp()))
+        {
+            load_next_table();
+        }
+        if (record_tree.empty()) {
+            break;
+        }
+
+        auto const table_ix = record_tree.get_min_leaf();
+        auto& table = tables[table_ix];
+        last_timestamp = record_tree.get_min_timestamp();
         if (0 == num_records_marshalled) {
             first_timestamp = last_timestamp;
         }
-        next->get_next_message(buffer);
-        if (false == next->done()) {
-            record_queue.emplace(std::move(next));
+        table->get_next_message(buffer);
+        if (table->done()) {
+            record_tree.remove(table_ix);
+            table.reset();
+        } else {
+            record_tree.update(table_ix, table->get_next_timestamp());
         }
         writer.write(buffer.c_str(), buffer.length());
         num_records_marshalled += 1;
@@ -178,4 +315,100 @@ void JsonConstructor::construct_in_order() {
         }
     }
 }
+
+bool decompress_archives_concurrently(
+        JsonConstructorOption const& option,
+        std::vector<std::string> const& archive_ids,
+        size_t num_threads
+) {
+    auto shared_option = option;
+    // Unordered decompression appends every archive to the same output file
+    shared_option.output_mutex = std::make_shared<std::mutex>();
+
+    // Remember the state of the shared output file, so that it can be restored on failure
+    auto const unordered_output_path
+            = std::filesystem::path{option.output_dir} / JsonConstructor::cUnorderedOutputFileName;
+    std::error_code error_code;
+    auto const orig_output_size = std::filesystem::file_size(unordered_output_path, error_code);
+    bool const output_existed = false == static_cast<bool>(error_code);
+
+    std::atomic_size_t next_archive_ix{0};
+    std::atomic_bool stop_requested{false};
+    std::atomic_bool failed{false};
+    auto worker = [&]() {
+        auto worker_option = shared_option;
+        while (false == stop_requested.load(std::memory_order_relaxed)) {
+            auto const archive_ix = next_archive_ix.fetch_add(1, std::memory_order_relaxed);
+            if (archive_ix >= archive_ids.size()) {
+                break;
+            }
+
+            worker_option.archive_id = archive_ids[archive_ix];
+            try {
+                JsonConstructor constructor{worker_option};
+                constructor.store();
+                continue;
+            } catch (std::exception const& e) {
+                SPDLOG_ERROR(
+                        "Failed to decompress archive {}: {}",
+                        worker_option.archive_id,
+                        e.what()
+                );
+            }
+            failed = true;
+            stop_requested = true;
+
+            if (worker_option.ordered) {
+                // Remove the chunk that was being written. Chunks that were already finalized are
+                // complete, so they're kept.
+                std::filesystem::path chunk_path{worker_option.output_dir};
+                chunk_path /= worker_option.archive_id;
+                std::error_code remove_error_code;
+                std::filesystem::remove(chunk_path, remove_error_code);
+                if (remove_error_code) {
+                    SPDLOG_ERROR(
+                            "Failed to remove partial output '{}' - {}",
+                            chunk_path.string(),
+                            remove_error_code.message()
+                    );
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto const num_workers = std::min(num_threads, archive_ids.size());
+    workers.reserve(num_workers);
+    clp::ThreadJoiner workers_joiner{workers, stop_requested};
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back(worker);
+    }
+    // Wait for the workers to decompress every archive (or to stop after a failure)
+    for (auto& worker_thread : workers) {
+        worker_thread.join();
+    }
+    if (false == failed) {
+        return true;
+    }
+
+    if (false == option.ordered) {
+        // The output of the archives that were decompressed is interleaved with the output of the
+        // ones that weren't, so the whole file is restored
+        if (output_existed) {
+            std::filesystem::resize_file(unordered_output_path, orig_output_size, error_code);
+        } else {
+            std::filesystem::remove(unordered_output_path, error_code);
+        }
+        if (error_code) {
+            SPDLOG_ERROR(
+                    "Failed to remove partial output from '{}' - {}",
+                    unordered_output_path.string(),
+                    error_code.message()
+            );
+        } else {
+            SPDLOG_WARN("Removed partial output from '{}'", unordered_output_path.string());
+        }
+    }
+    return false;
+}
 }  // namespace clp_s
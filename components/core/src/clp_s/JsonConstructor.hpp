@@ -1,10 +1,14 @@
 #ifndef CLP_S_JSONCONSTRUCTOR_HPP
 #define CLP_S_JSONCONSTRUCTOR_HPP
 
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "ArchiveReader.hpp"
 #include "ColumnReader.hpp"
@@ -32,10 +36,18 @@ struct JsonConstructorOption {
     bool ordered{false};
     size_t ordered_chunk_size{0};
     std::optional<MetadataDbOption> metadata_db;
+    // Set when several archives are decompressed concurrently, to serialize writes to the output
+    // file that's shared by all unordered decompressions
+    std::shared_ptr<std::mutex> output_mutex;
 };
 
 class JsonConstructor {
 public:
+    // Constants
+    // The file in the output directory that every unordered decompression appends to
+    static constexpr char cUnorderedOutputFileName[] = "original";
+
+    // Types
     class OperationFailed : public TraceableException {
     public:
         // Constructors
@@ -65,14 +77,34 @@ public:
 
 private:
     /**
-     * Reads all of the tables from m_archive_reader and writes all of the records
-     * they contain to writer in timestamp order.
+     * Reads the tables from m_archive_reader and writes all of the records they contain to writer
+     * in timestamp order. Tables are only loaded once the merge reaches their timestamp range and
+     * are released once all of their records have been written.
      */
     void construct_in_order();
 
     JsonConstructorOption m_option{};
     std::unique_ptr<ArchiveReader> m_archive_reader;
 };
+
+/**
+ * Decompresses the given archives using a pool of workers, where each worker decompresses one
+ * archive at a time with its own archive reader.
+ *
+ * If any archive fails to decompress, the remaining archives are skipped and the partial output is
+ * removed: for unordered decompression, the shared output file is restored to its size before the
+ * call (or removed if it didn't exist); for ordered decompression, the chunk that was being written
+ * for the failed archive is removed.
+ * @param option The options for decompressing each archive, except its ID
+ * @param archive_ids
+ * @param num_threads
+ * @return Whether all archives were decompressed successfully
+ */
+bool decompress_archives_concurrently(
+        JsonConstructorOption const& option,
+        std::vector<std::string> const& archive_ids,
+        size_t num_threads
+);
 }  // namespace clp_s
 
 #endif  // CLP_S_JSONCONSTRUCTOR_HPP
@@ -6,6 +6,7 @@
 #include <simdjson.h>
 #include <spdlog/spdlog.h>
 
+#include "../clp/Metrics.hpp"
 #include "archive_constants.hpp"
 #include "JsonFileIterator.hpp"
 
@@ -13,6 +14,7 @@ namespace clp_s {
 JsonParser::JsonParser(JsonParserOption const& option)
         : m_num_messages(0),
           m_target_encoded_size(option.target_encoded_size),
+          m_max_memory(option.max_memory),
           m_max_document_size(option.max_document_size),
           m_timestamp_key(option.timestamp_key),
           m_structurize_arrays(option.structurize_arrays) {
@@ -31,12 +33,40 @@ JsonParser::JsonParser(JsonParserOption const& option)
     m_archive_options.archives_dir = option.archives_dir;
     m_archive_options.compression_level = option.compression_level;
     m_archive_options.print_archive_stats = option.print_archive_stats;
+    m_archive_options.build_dictionary_index = option.build_dictionary_index;
+    m_archive_options.sort_dictionaries = option.sort_dictionaries;
+    m_archive_options.spill_threshold = option.spill_threshold;
     m_archive_options.id = m_generator();
 
     m_archive_writer = std::make_unique<ArchiveWriter>(option.metadata_db);
     m_archive_writer->open(m_archive_options);
 }
 
+bool JsonParser::update_memory_usage() {
+    if (0 == m_max_memory) {
+        return false;
+    }
+    auto const memory_usage = get_memory_usage();
+    m_prev_record_memory_growth
+            = memory_usage > m_prev_memory_usage ? memory_usage - m_prev_memory_usage : 0;
+    m_prev_memory_usage = memory_usage;
+    // Split before the limit is exceeded by assuming the next record grows the archive as much as
+    // the previous one
+    return memory_usage + m_prev_record_memory_growth >= m_max_memory;
+}
+
+int32_t JsonParser::add_node(int32_t parent_node_id, NodeType type, std::string_view key) {
+    auto node_id = m_shape_cache.match_field(parent_node_id, type, key);
+    if (-1 == node_id) {
+        node_id = m_archive_writer->add_node(parent_node_id, type, key);
+        m_shape_cache.add_field(parent_node_id, type, key, node_id);
+    } else {
+        // Count the node as if it had been looked up in the schema tree
+        m_archive_writer->increase_node_count(node_id);
+    }
+    return node_id;
+}
+
 void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_id) {
     ondemand::object_iterator it = line.begin();
     if (it == line.end()) {
@@ -55,7 +85,7 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
     size_t object_start = m_current_schema.start_unordered_object(NodeType::Object);
     ondemand::field cur_field;
     ondemand::value cur_value;
-    std::string cur_key;
+    std::string_view cur_key;
     int32_t node_id;
     while (true) {
         while (false == object_stack.empty() && object_it_stack.top() == object_stack.top().end()) {
@@ -78,8 +108,7 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
 
         switch (cur_value.type()) {
             case ondemand::json_type::object: {
-                node_id = m_archive_writer
-                                  ->add_node(node_id_stack.top(), NodeType::Object, cur_key);
+                node_id = add_node(node_id_stack.top(), NodeType::Object, cur_key);
                 object_stack.push(std::move(cur_value.get_object()));
                 object_it_stack.push(std::move(object_stack.top().begin()));
                 if (object_it_stack.top() == object_stack.top().end()) {
@@ -93,11 +122,7 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
                 break;
             }
             case ondemand::json_type::array: {
-                node_id = m_archive_writer->add_node(
-                        node_id_stack.top(),
-                        NodeType::StructuredArray,
-                        cur_key
-                );
+                node_id = add_node(node_id_stack.top(), NodeType::StructuredArray, cur_key);
                 parse_array(cur_value.get_array(), node_id);
                 break;
             }
@@ -106,8 +131,7 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
                 if (true == number_value.is_double()) {
                     double double_value = number_value.get_double();
                     m_current_parsed_message.add_unordered_value(double_value);
-                    node_id = m_archive_writer
-                                      ->add_node(node_id_stack.top(), NodeType::Float, cur_key);
+                    node_id = add_node(node_id_stack.top(), NodeType::Float, cur_key);
                 } else {
                     int64_t i64_value;
                     if (number_value.is_uint64()) {
@@ -116,8 +140,7 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
                         i64_value = number_value.get_int64();
                     }
                     m_current_parsed_message.add_unordered_value(i64_value);
-                    node_id = m_archive_writer
-                                      ->add_node(node_id_stack.top(), NodeType::Integer, cur_key);
+                    node_id = add_node(node_id_stack.top(), NodeType::Integer, cur_key);
                 }
                 m_current_schema.insert_unordered(node_id);
                 break;
@@ -127,11 +150,9 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
                         cur_value.raw_json_token().substr(1, cur_value.raw_json_token().size() - 2)
                 );
                 if (value.find(' ') != std::string::npos) {
-                    node_id = m_archive_writer
-                                      ->add_node(node_id_stack.top(), NodeType::ClpString, cur_key);
+                    node_id = add_node(node_id_stack.top(), NodeType::ClpString, cur_key);
                 } else {
-                    node_id = m_archive_writer
-                                      ->add_node(node_id_stack.top(), NodeType::VarString, cur_key);
+                    node_id = add_node(node_id_stack.top(), NodeType::VarString, cur_key);
                 }
                 m_current_parsed_message.add_unordered_value(value);
                 m_current_schema.insert_unordered(node_id);
@@ -140,14 +161,12 @@ void JsonParser::parse_obj_in_array(ondemand::object line, int32_t parent_node_i
             case ondemand::json_type::boolean: {
                 bool value = cur_value.get_bool();
                 m_current_parsed_message.add_unordered_value(value);
-                node_id = m_archive_writer
-                                  ->add_node(node_id_stack.top(), NodeType::Boolean, cur_key);
+                node_id = add_node(node_id_stack.top(), NodeType::Boolean, cur_key);
                 m_current_schema.insert_unordered(node_id);
                 break;
             }
             case ondemand::json_type::null: {
-                node_id = m_archive_writer
-                                  ->add_node(node_id_stack.top(), NodeType::NullValue, cur_key);
+                node_id = add_node(node_id_stack.top(), NodeType::NullValue, cur_key);
                 m_current_schema.insert_unordered(node_id);
                 break;
             }
@@ -172,12 +191,12 @@ void JsonParser::parse_array(ondemand::array array, int32_t parent_node_id) {
 
         switch (cur_value.type()) {
             case ondemand::json_type::object: {
-                node_id = m_archive_writer->add_node(parent_node_id, NodeType::Object, "");
+                node_id = add_node(parent_node_id, NodeType::Object, "");
                 parse_obj_in_array(std::move(cur_value.get_object()), node_id);
                 break;
             }
             case ondemand::json_type::array: {
-                node_id = m_archive_writer->add_node(parent_node_id, NodeType::StructuredArray, "");
+                node_id = add_node(parent_node_id, NodeType::StructuredArray, "");
                 parse_array(std::move(cur_value.get_array()), node_id);
                 break;
             }
@@ -186,7 +205,7 @@ void JsonParser::parse_array(ondemand::array array, int32_t parent_node_id) {
                 if (true == number_value.is_double()) {
                     double double_value = number_value.get_double();
                     m_current_parsed_message.add_unordered_value(double_value);
-                    node_id = m_archive_writer->add_node(parent_node_id, NodeType::Float, "");
+                    node_id = add_node(parent_node_id, NodeType::Float, "");
                 } else {
                     int64_t i64_value;
                     if (number_value.is_uint64()) {
@@ -195,7 +214,7 @@ void JsonParser::parse_array(ondemand::array array, int32_t parent_node_id) {
                         i64_value = number_value.get_int64();
                     }
                     m_current_parsed_message.add_unordered_value(i64_value);
-                    node_id = m_archive_writer->add_node(parent_node_id, NodeType::Integer, "");
+                    node_id = add_node(parent_node_id, NodeType::Integer, "");
                 }
                 m_current_schema.insert_unordered(node_id);
                 break;
@@ -205,9 +224,9 @@ void JsonParser::parse_array(ondemand::array array, int32_t parent_node_id) {
                         cur_value.raw_json_token().substr(1, cur_value.raw_json_token().size() - 2)
                 );
                 if (value.find(' ') != std::string::npos) {
-                    node_id = m_archive_writer->add_node(parent_node_id, NodeType::ClpString, "");
+                    node_id = add_node(parent_node_id, NodeType::ClpString, "");
                 } else {
-                    node_id = m_archive_writer->add_node(parent_node_id, NodeType::VarString, "");
+                    node_id = add_node(parent_node_id, NodeType::VarString, "");
                 }
                 m_current_parsed_message.add_unordered_value(value);
                 m_current_schema.insert_unordered(node_id);
@@ -216,12 +235,12 @@ void JsonParser::parse_array(ondemand::array array, int32_t parent_node_id) {
             case ondemand::json_type::boolean: {
                 bool value = cur_value.get_bool();
                 m_current_parsed_message.add_unordered_value(value);
-                node_id = m_archive_writer->add_node(parent_node_id, NodeType::Boolean, "");
+                node_id = add_node(parent_node_id, NodeType::Boolean, "");
                 m_current_schema.insert_unordered(node_id);
                 break;
             }
             case ondemand::json_type::null: {
-                node_id = m_archive_writer->add_node(parent_node_id, NodeType::NullValue, "");
+                node_id = add_node(parent_node_id, NodeType::NullValue, "");
                 m_current_schema.insert_unordered(node_id);
                 break;
             }
@@ -230,7 +249,7 @@ void JsonParser::parse_array(ondemand::array array, int32_t parent_node_id) {
     m_current_schema.end_unordered_object(array_start);
 }
 
-void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::string const& key) {
+void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::string_view key) {
     int32_t node_id;
     std::stack<ondemand::object> object_stack;
     std::stack<int32_t> node_id_stack;
@@ -238,7 +257,7 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
 
     ondemand::field cur_field;
 
-    std::string cur_key = key;
+    std::string_view cur_key = key;
     node_id_stack.push(parent_node_id);
 
     bool can_match_timestamp = !m_timestamp_column.empty();
@@ -249,7 +268,7 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
     do {
         if (false == object_stack.empty()) {
             cur_field = *object_it_stack.top();
-            cur_key = std::string(std::string_view(cur_field.unescaped_key(true)));
+            cur_key = std::string_view(cur_field.unescaped_key(true));
             line = cur_field.value();
             if (may_match_timestamp) {
                 if (object_stack.size() <= m_timestamp_column.size()
@@ -270,8 +289,7 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
 
         switch (line.type()) {
             case ondemand::json_type::object: {
-                node_id = m_archive_writer
-                                  ->add_node(node_id_stack.top(), NodeType::Object, cur_key);
+                node_id = add_node(node_id_stack.top(), NodeType::Object, cur_key);
                 object_stack.push(std::move(line.get_object()));
                 auto objref = object_stack.top();
                 auto it = ondemand::object_iterator(objref.begin());
@@ -287,20 +305,12 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
             }
             case ondemand::json_type::array: {
                 if (m_structurize_arrays) {
-                    node_id = m_archive_writer->add_node(
-                            node_id_stack.top(),
-                            NodeType::StructuredArray,
-                            cur_key
-                    );
+                    node_id = add_node(node_id_stack.top(), NodeType::StructuredArray, cur_key);
                     parse_array(std::move(line.get_array()), node_id);
                 } else {
                     std::string value
                             = std::string(std::string_view(simdjson::to_json_string(line)));
-                    node_id = m_archive_writer->add_node(
-                            node_id_stack.top(),
-                            NodeType::UnstructuredArray,
-                            cur_key
-                    );
+                    node_id = add_node(node_id_stack.top(), NodeType::UnstructuredArray, cur_key);
                     m_current_parsed_message.add_value(node_id, value);
                     m_current_schema.insert_ordered(node_id);
                 }
@@ -316,7 +326,7 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
                 } else {
                     type = NodeType::Float;
                 }
-                node_id = m_archive_writer->add_node(node_id_stack.top(), type, cur_key);
+                node_id = add_node(node_id_stack.top(), type, cur_key);
 
                 if (type == NodeType::Integer) {
                     int64_t i64_value;
@@ -350,11 +360,7 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
                         = std::string(raw_json_token.substr(1, raw_json_token.rfind('"') - 1));
 
                 if (matches_timestamp) {
-                    node_id = m_archive_writer->add_node(
-                            node_id_stack.top(),
-                            NodeType::DateString,
-                            cur_key
-                    );
+                    node_id = add_node(node_id_stack.top(), NodeType::DateString, cur_key);
                     uint64_t encoding_id{0};
                     epochtime_t timestamp = m_archive_writer->ingest_timestamp_entry(
                             m_timestamp_key,
@@ -365,12 +371,10 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
                     m_current_parsed_message.add_value(node_id, encoding_id, timestamp);
                     matches_timestamp = may_match_timestamp = can_match_timestamp = false;
                 } else if (value.find(' ') != std::string::npos) {
-                    node_id = m_archive_writer
-                                      ->add_node(node_id_stack.top(), NodeType::ClpString, cur_key);
+                    node_id = add_node(node_id_stack.top(), NodeType::ClpString, cur_key);
                     m_current_parsed_message.add_value(node_id, value);
                 } else {
-                    node_id = m_archive_writer
-                                      ->add_node(node_id_stack.top(), NodeType::VarString, cur_key);
+                    node_id = add_node(node_id_stack.top(), NodeType::VarString, cur_key);
                     m_current_parsed_message.add_value(node_id, value);
                 }
 
@@ -379,15 +383,13 @@ void JsonParser::parse_line(ondemand::value line, int32_t parent_node_id, std::s
             }
             case ondemand::json_type::boolean: {
                 bool value = line.get_bool();
-                node_id = m_archive_writer
-                                  ->add_node(node_id_stack.top(), NodeType::Boolean, cur_key);
+                node_id = add_node(node_id_stack.top(), NodeType::Boolean, cur_key);
                 m_current_parsed_message.add_value(node_id, value);
                 m_current_schema.insert_ordered(node_id);
                 break;
             }
             case ondemand::json_type::null: {
-                node_id = m_archive_writer
-                                  ->add_node(node_id_stack.top(), NodeType::NullValue, cur_key);
+                node_id = add_node(node_id_stack.top(), NodeType::NullValue, cur_key);
                 m_current_schema.insert_ordered(node_id);
                 break;
             }
@@ -443,6 +445,7 @@ bool JsonParser::parse() {
         size_t bytes_consumed_up_to_prev_record = 0;
         while (json_file_iterator.get_json(json_it)) {
             m_current_schema.clear();
+            m_shape_cache.begin_record();
 
             auto ref = *json_it;
             auto is_scalar_result = ref.is_scalar();
@@ -465,6 +468,7 @@ bool JsonParser::parse() {
             // Instead of checking for an error every time we access a JSON field in parse_line we
             // just catch simdjson_error here instead.
             try {
+                clp::Metrics::ScopedTimer const parse_timer{clp::Metrics::Stage::Parse};
                 parse_line(ref.value(), -1, "");
             } catch (simdjson::simdjson_error& error) {
                 SPDLOG_ERROR(
@@ -477,14 +481,29 @@ bool JsonParser::parse() {
                 return false;
             }
             m_num_messages++;
+            clp::Metrics::increment(clp::Metrics::Counter::NumMessagesParsed);
 
-            int32_t current_schema_id = m_archive_writer->add_schema(m_current_schema);
-            m_current_parsed_message.set_id(current_schema_id);
-            m_archive_writer
-                    ->append_message(current_schema_id, m_current_schema, m_current_parsed_message);
+            {
+                clp::Metrics::ScopedTimer const insert_timer{
+                        clp::Metrics::Stage::DictionaryInsert
+                };
+                int32_t current_schema_id = m_shape_cache.end_record(m_current_schema);
+                if (-1 == current_schema_id) {
+                    current_schema_id = m_archive_writer->add_schema(m_current_schema);
+                    m_shape_cache.add_shape(m_current_schema, current_schema_id);
+                }
+                m_current_parsed_message.set_id(current_schema_id);
+                m_archive_writer->append_message(
+                        current_schema_id,
+                        m_current_schema,
+                        m_current_parsed_message
+                );
+            }
 
             bytes_consumed_up_to_prev_record = json_file_iterator.get_num_bytes_consumed();
-            if (m_archive_writer->get_data_size() >= m_target_encoded_size) {
+            if (m_archive_writer->get_data_size() >= m_target_encoded_size
+                || update_memory_usage())
+            {
                 m_archive_writer->increment_uncompressed_size(
                         bytes_consumed_up_to_prev_record - bytes_consumed_up_to_prev_archive
                 );
@@ -498,6 +517,10 @@ bool JsonParser::parse() {
         m_archive_writer->increment_uncompressed_size(
                 json_file_iterator.get_num_bytes_read() - bytes_consumed_up_to_prev_archive
         );
+        clp::Metrics::increment(
+                clp::Metrics::Counter::BytesRead,
+                json_file_iterator.get_num_bytes_read()
+        );
 
         if (simdjson::error_code::SUCCESS != json_file_iterator.get_error()) {
             SPDLOG_ERROR(
@@ -526,8 +549,13 @@ void JsonParser::store() {
 
 void JsonParser::split_archive() {
     m_archive_writer->close();
+    // Node IDs aren't shared across archives
+    m_shape_cache.clear();
     m_archive_options.id = m_generator();
     m_archive_writer->open(m_archive_options);
+    // Memory that the new archive starts with shouldn't count as the first record's growth
+    m_prev_memory_usage = get_memory_usage();
+    m_prev_record_memory_growth = 0;
 }
 
 }  // namespace clp_s
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -15,6 +16,7 @@
 #include "FileReader.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
+#include "RecordShapeCache.hpp"
 #include "Schema.hpp"
 #include "SchemaMap.hpp"
 #include "SchemaTree.hpp"
@@ -31,10 +33,17 @@ struct JsonParserOption {
     std::string timestamp_key;
     std::string archives_dir;
     size_t target_encoded_size;
+    // The maximum memory an archive may use while it's being written, or 0 for no limit
+    size_t max_memory{0};
+    // The memory an archive's tables may use before their columns are spilled to disk, or 0 to
+    // never spill
+    size_t spill_threshold{0};
     size_t max_document_size;
     int compression_level;
     bool print_archive_stats;
     bool structurize_arrays;
+    bool build_dictionary_index;
+    bool sort_dictionaries{false};
     std::shared_ptr<clp::GlobalMySQLMetadataDB> metadata_db;
 };
 
@@ -65,6 +74,29 @@ public:
     void store();
 
 private:
+    /**
+     * @return The number of bytes of memory held by the current archive
+     */
+    [[nodiscard]] size_t get_memory_usage() const {
+        return m_archive_writer->get_memory_usage() + m_shape_cache.get_memory_usage();
+    }
+
+    /**
+     * Updates the memory usage of the current archive after a record was added
+     * @return Whether adding another record like the previous one would exceed the memory limit
+     */
+    bool update_memory_usage();
+
+    /**
+     * Adds a node to the schema tree, unless it matches the next field of the record shape
+     * predicted by the shape cache. Either way, the node's count is increased.
+     * @param parent_node_id
+     * @param type
+     * @param key
+     * @return the node id
+     */
+    int32_t add_node(int32_t parent_node_id, NodeType type, std::string_view key);
+
     /**
      * Parses a JSON line
      * @param line the JSON line
@@ -72,7 +104,7 @@ private:
      * @param key the key of the node
      * @throw simdjson::simdjson_error when encountering invalid fields while parsing line
      */
-    void parse_line(ondemand::value line, int32_t parent_node_id, std::string const& key);
+    void parse_line(ondemand::value line, int32_t parent_node_id, std::string_view key);
 
     /**
      * Parses an array within a JSON line
@@ -98,6 +130,7 @@ private:
 
     Schema m_current_schema;
     ParsedMessage m_current_parsed_message;
+    RecordShapeCache m_shape_cache;
 
     std::string m_timestamp_key;
     std::vector<std::string> m_timestamp_column;
@@ -106,6 +139,11 @@ private:
     std::unique_ptr<ArchiveWriter> m_archive_writer;
     ArchiveWriterOption m_archive_options{};
     size_t m_target_encoded_size;
+    size_t m_max_memory;
+    // The memory used by the current archive after the previous record, and how much the previous
+    // record increased it by
+    size_t m_prev_memory_usage{0};
+    size_t m_prev_record_memory_growth{0};
     size_t m_max_document_size;
     bool m_structurize_arrays{false};
 };
@@ -1,8 +1,9 @@
 #ifndef CLP_S_JSONSERIALIZER_HPP
 #define CLP_S_JSONSERIALIZER_HPP
 
+#include <span>
 #include <string>
-#include <vector>
+#include <string_view>
 
 #include "ColumnReader.hpp"
 
@@ -42,22 +43,21 @@ public:
     void reset() {
         m_json_string.clear();
         m_op_list_index = 0;
-        m_special_keys_index = 0;
+        m_key_fragments_index = 0;
     }
 
     /**
-     * Clears the contents of the JsonSerializer to make room for a new set of operations.
+     * Binds the JsonSerializer to a new set of operations. The operations and key fragments must
+     * outlive the JsonSerializer or the next call to this method.
+     * @param op_list
+     * @param key_fragments The `"key":` fragment of each operation that appends a key, in order
      */
-    void clear() {
+    void bind(std::span<Op const> op_list, std::span<std::string_view const> key_fragments) {
         reset();
-        m_op_list.clear();
-        m_special_keys.clear();
+        m_op_list = op_list;
+        m_key_fragments = key_fragments;
     }
 
-    void add_op(Op op) { m_op_list.push_back(op); }
-
-    std::vector<Op>& get_op_list() { return m_op_list; }
-
     bool get_next_op(Op& op) {
         if (m_op_list_index < m_op_list.size()) {
             op = m_op_list[m_op_list_index++];
@@ -66,8 +66,6 @@ public:
         return false;
     }
 
-    void add_special_key(std::string const& key) { m_special_keys.push_back(key); }
-
     void begin_object() {
         append_key();
         m_json_string += "{";
@@ -102,13 +100,7 @@ public:
         m_json_string += "],";
     }
 
-    void append_key() { append_key(m_special_keys[m_special_keys_index++]); }
-
-    void append_key(std::string const& key) {
-        m_json_string += "\"";
-        m_json_string += key;
-        m_json_string += "\":";
-    }
+    void append_key() { m_json_string += m_key_fragments[m_key_fragments_index++]; }
 
     void append_value(std::string const& value) {
         m_json_string += value;
@@ -129,11 +121,11 @@ public:
 
 private:
     std::string m_json_string;
-    std::vector<Op> m_op_list;
-    std::vector<std::string> m_special_keys;
+    std::span<Op const> m_op_list;
+    std::span<std::string_view const> m_key_fragments;
 
     size_t m_op_list_index{0};
-    size_t m_special_keys_index{0};
+    size_t m_key_fragments_index{0};
 };
 
 #endif  // CLP_S_JSONSERIALIZER_HPP
@@ -0,0 +1,68 @@
+#include "RecordShapeCache.hpp"
+
+#include <functional>
+#include <utility>
+
+namespace clp_s {
+namespace {
+/**
+ * Combines a value into a running hash
+ * @param seed The running hash
+ * @param value
+ * @return The combined hash
+ */
+uint64_t combine_hash(uint64_t seed, uint64_t value) {
+    return seed ^ (value + 0x9e37'79b9'7f4a'7c15ULL + (seed << 12) + (seed >> 4));
+}
+}  // namespace
+
+int32_t RecordShapeCache::end_record(Schema const& schema) {
+    if (m_is_matching && m_candidate->fields.size() == m_num_matched_fields
+        && m_candidate->schema == schema)
+    {
+        return m_candidate->schema_id;
+    }
+
+    // The record didn't match the candidate, so look it up among all the cached shapes
+    stop_matching();
+    m_record_fingerprint = get_fingerprint(m_record_fields);
+    auto const it = m_shapes.find(m_record_fingerprint);
+    if (m_shapes.end() == it || it->second.fields != m_record_fields
+        || false == (it->second.schema == schema))
+    {
+        return -1;
+    }
+    m_candidate = &it->second;
+    return m_candidate->schema_id;
+}
+
+void RecordShapeCache::add_shape(Schema const& schema, int32_t schema_id) {
+    // If the fingerprint collides with another shape, the other shape is replaced
+    auto& shape = m_shapes[m_record_fingerprint];
+    shape.fields = std::move(m_record_fields);
+    shape.schema = schema;
+    shape.schema_id = schema_id;
+
+    m_memory_usage -= shape.memory_usage;
+    // Each shape is a hash node holding the next node's pointer and the shape
+    shape.memory_usage = sizeof(void*) + sizeof(decltype(m_shapes)::value_type)
+                         + shape.fields.capacity() * sizeof(Field)
+                         + shape.schema.size() * sizeof(int32_t);
+    for (auto const& field : shape.fields) {
+        shape.memory_usage += field.key.size();
+    }
+    m_memory_usage += shape.memory_usage;
+    m_candidate = &shape;
+    m_record_fields.clear();
+}
+
+uint64_t RecordShapeCache::get_fingerprint(std::vector<Field> const& fields) {
+    uint64_t fingerprint{fields.size()};
+    for (auto const& field : fields) {
+        fingerprint = combine_hash(fingerprint, static_cast<uint32_t>(field.parent_node_id));
+        fingerprint = combine_hash(fingerprint, static_cast<uint64_t>(field.type));
+        fingerprint = combine_hash(fingerprint, std::hash<std::string_view>{}(field.key));
+    }
+    return fingerprint;
+}
+}  // namespace clp_s
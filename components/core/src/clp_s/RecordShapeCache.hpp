@@ -0,0 +1,169 @@
+#ifndef CLP_S_RECORDSHAPECACHE_HPP
+#define CLP_S_RECORDSHAPECACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Schema.hpp"
+#include "SchemaTree.hpp"
+
+namespace clp_s {
+/**
+ * Caches the shapes of the records ingested into an archive, so that records with a shape seen
+ * before can skip most schema tree and schema map lookups.
+ *
+ * A record's shape is the sequence of fields (parent node ID, type, and key) that parsing the
+ * record adds to the schema tree, along with the node ID of each field and the record's schema ID.
+ *
+ * While a record is parsed, each of its fields is matched against the next field of a candidate
+ * shape, which is the shape of the previous record. Until a field doesn't match, the record's node
+ * IDs come from the candidate without looking them up in the schema tree. Afterwards, the caller
+ * must look up each field in the schema tree and add it to the cache. When the record ends, a
+ * record that didn't match the candidate is looked up by a fingerprint of its fields, so that any
+ * cached shape maps directly to its schema ID and becomes the candidate for the next record.
+ *
+ * The cache isn't thread-safe, and must be cleared whenever the schema tree is cleared.
+ */
+class RecordShapeCache {
+public:
+    // Methods
+    /**
+     * Starts matching a new record against the candidate shape
+     */
+    void begin_record() {
+        m_num_matched_fields = 0;
+        m_is_matching = nullptr != m_candidate;
+        m_record_fields.clear();
+    }
+
+    /**
+     * Matches the given field against the next field of the candidate shape
+     * @param parent_node_id
+     * @param type
+     * @param key
+     * @return The node ID of the field if it matches, or -1 otherwise. If the field doesn't match,
+     * the caller must look up its node ID and add it with `add_field`.
+     */
+    int32_t match_field(int32_t parent_node_id, NodeType type, std::string_view key) {
+        if (m_is_matching && m_num_matched_fields < m_candidate->fields.size()) {
+            auto const& field = m_candidate->fields[m_num_matched_fields];
+            if (field.parent_node_id == parent_node_id && field.type == type && field.key == key) {
+                ++m_num_matched_fields;
+                return field.node_id;
+            }
+        }
+        stop_matching();
+        return -1;
+    }
+
+    /**
+     * Adds a field that didn't match the candidate shape to the current record
+     * @param parent_node_id
+     * @param type
+     * @param key
+     * @param node_id
+     */
+    void add_field(int32_t parent_node_id, NodeType type, std::string_view key, int32_t node_id) {
+        m_record_fields.emplace_back(parent_node_id, type, std::string{key}, node_id);
+    }
+
+    /**
+     * Ends the current record and looks up the schema ID of its shape. If the shape is cached, it
+     * becomes the candidate for the next record.
+     * @param schema The record's schema
+     * @return The schema ID of the record, or -1 if its shape isn't cached, in which case the
+     * caller must look up the schema ID and add the shape with `add_shape`.
+     */
+    int32_t end_record(Schema const& schema);
+
+    /**
+     * Adds the shape of the current record to the cache, and makes it the candidate for the next
+     * record. Must only be called after `end_record` returns -1.
+     * @param schema The record's schema
+     * @param schema_id The record's schema ID
+     */
+    void add_shape(Schema const& schema, int32_t schema_id);
+
+    /**
+     * @return The number of bytes of memory held by the cached shapes
+     */
+    [[nodiscard]] size_t get_memory_usage() const { return m_memory_usage; }
+
+    /**
+     * Clears the cache, releasing the memory it holds
+     */
+    void clear() {
+        m_shapes = decltype(m_shapes){};
+        m_memory_usage = 0;
+        m_candidate = nullptr;
+        m_is_matching = false;
+        m_record_fields = decltype(m_record_fields){};
+    }
+
+private:
+    // Types
+    struct Field {
+        Field(int32_t parent_node_id, NodeType type, std::string key, int32_t node_id)
+                : parent_node_id{parent_node_id},
+                  type{type},
+                  key{std::move(key)},
+                  node_id{node_id} {}
+
+        bool operator==(Field const& rhs) const = default;
+
+        int32_t parent_node_id;
+        NodeType type;
+        std::string key;
+        int32_t node_id;
+    };
+
+    struct Shape {
+        std::vector<Field> fields;
+        Schema schema;
+        int32_t schema_id{-1};
+        size_t memory_usage{0};
+    };
+
+    // Methods
+    /**
+     * Stops matching the current record against the candidate shape, copying the fields that
+     * matched so far into the current record's fields
+     */
+    void stop_matching() {
+        if (false == m_is_matching) {
+            return;
+        }
+        m_is_matching = false;
+        m_record_fields.assign(
+                m_candidate->fields.cbegin(),
+                m_candidate->fields.cbegin() + static_cast<std::ptrdiff_t>(m_num_matched_fields)
+        );
+    }
+
+    /**
+     * @param fields
+     * @return A fingerprint of the given fields
+     */
+    static uint64_t get_fingerprint(std::vector<Field> const& fields);
+
+    // Variables
+    // Shapes indexed by the fingerprint of their fields. Nodes are stable, so the candidate can
+    // point into the map.
+    std::unordered_map<uint64_t, Shape> m_shapes;
+    Shape const* m_candidate{nullptr};
+    size_t m_memory_usage{0};
+
+    // The current record
+    bool m_is_matching{false};
+    size_t m_num_matched_fields{0};
+    std::vector<Field> m_record_fields;
+    uint64_t m_record_fingerprint{0};
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_RECORDSHAPECACHE_HPP
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <utility>
 #include <vector>
 
 #include "SchemaTree.hpp"
@@ -145,6 +146,17 @@ public:
      */
     bool operator==(Schema const& rhs) const { return m_schema == rhs.m_schema; }
 
+    /**
+     * Hashes the schema so that Schema can act as a key for SchemaMap
+     * @param h
+     * @param schema
+     * @return the combined hash state
+     */
+    template <typename H>
+    friend H AbslHashValue(H h, Schema const& schema) {
+        return H::combine(std::move(h), schema.m_schema);
+    }
+
     /**
      * Starts an unordered object of a given NodeType.
      *
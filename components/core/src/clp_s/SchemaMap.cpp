@@ -1,5 +1,10 @@
 #include "SchemaMap.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "archive_constants.hpp"
 #include "FileWriter.hpp"
 #include "ZstdCompressor.hpp"
@@ -11,6 +16,7 @@ int32_t SchemaMap::add_schema(Schema const& schema) {
         return schema_it->second;
     }
     m_schema_map.emplace(schema, m_current_schema_id);
+    m_schema_size += schema.size() * sizeof(int32_t);
     return m_current_schema_id++;
 }
 
@@ -25,9 +31,17 @@ size_t SchemaMap::store(std::string const& archives_dir, int compression_level)
     );
     schema_map_compressor.open(schema_map_writer, compression_level);
     schema_map_compressor.write_numeric_value(m_schema_map.size());
-    for (auto const& schema_mapping : m_schema_map) {
-        auto const& schema = schema_mapping.first;
-        schema_map_compressor.write_numeric_value(schema_mapping.second);
+    // The hash map's iteration order depends on the hash, so the schemas are written in ID order to
+    // keep the file deterministic
+    std::vector<std::pair<int32_t, Schema const*>> id_to_schema;
+    id_to_schema.reserve(m_schema_map.size());
+    for (auto const& [schema, schema_id] : m_schema_map) {
+        id_to_schema.emplace_back(schema_id, &schema);
+    }
+    std::sort(id_to_schema.begin(), id_to_schema.end());
+    for (auto const& [schema_id, schema_ptr] : id_to_schema) {
+        auto const& schema = *schema_ptr;
+        schema_map_compressor.write_numeric_value(schema_id);
         schema_map_compressor.write_numeric_value(static_cast<uint32_t>(schema.size()));
         schema_map_compressor.write_numeric_value(static_cast<uint32_t>(schema.get_num_ordered()));
         for (int32_t mst_node_id : schema) {
@@ -1,15 +1,16 @@
 #ifndef CLP_S_SCHEMAMAP_HPP
 #define CLP_S_SCHEMAMAP_HPP
 
-#include <map>
 #include <string>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "Schema.hpp"
 
 namespace clp_s {
 class SchemaMap {
 public:
-    using schema_map_t = std::map<Schema, int32_t>;
+    using schema_map_t = absl::flat_hash_map<Schema, int32_t>;
 
     // Constructor
     SchemaMap() : m_current_schema_id(0) {}
@@ -31,9 +32,20 @@ public:
     [[nodiscard]] size_t store(std::string const& archives_dir, int compression_level);
 
     /**
-     * Clear the schema map
+     * Clear the schema map, releasing the memory it holds so that it isn't retained by the next
+     * archive
+     */
+    void clear() {
+        m_schema_map = schema_map_t{};
+        m_schema_size = 0;
+    }
+
+    /**
+     * @return The number of bytes of memory held by the schema map
      */
-    void clear() { m_schema_map.clear(); }
+    [[nodiscard]] size_t get_memory_usage() const {
+        return m_schema_map.capacity() * (sizeof(schema_map_t::value_type) + 1) + m_schema_size;
+    }
 
     /**
      * Get const iterators into the schema map
@@ -50,6 +62,8 @@ public:
 private:
     int32_t m_current_schema_id;
     schema_map_t m_schema_map;
+    // The total size of the schemas' node ID lists
+    size_t m_schema_size{0};
 };
 }  // namespace clp_s
 
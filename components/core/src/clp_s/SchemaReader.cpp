@@ -1,14 +1,15 @@
 #include "SchemaReader.hpp"
 
-#include <stack>
+#include <algorithm>
 
+#include "../clp/Metrics.hpp"
 #include "BufferViewReader.hpp"
 #include "Schema.hpp"
 
 namespace clp_s {
 void SchemaReader::append_column(BaseColumnReader* column_reader) {
-    m_column_map[column_reader->get_id()] = column_reader;
     m_columns.push_back(column_reader);
+    ++m_num_ordered_columns;
 }
 
 void SchemaReader::append_unordered_column(BaseColumnReader* column_reader) {
@@ -57,6 +58,7 @@ void SchemaReader::load(ZstdDecompressor& decompressor, size_t uncompressed_size
 }
 
 void SchemaReader::generate_json_string() {
+    clp::Metrics::ScopedTimer const marshalling_timer{clp::Metrics::Stage::Marshalling};
     m_json_serializer.reset();
     m_json_serializer.begin_document();
     size_t column_id_index = 0;
@@ -90,8 +92,7 @@ void SchemaReader::generate_json_string() {
             }
             case JsonSerializer::Op::AddIntField: {
                 column = m_reordered_columns[column_id_index++];
-                auto const& name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value(
                         std::to_string(std::get<int64_t>(column->extract_value(m_cur_message)))
                 );
@@ -106,8 +107,7 @@ void SchemaReader::generate_json_string() {
             }
             case JsonSerializer::Op::AddFloatField: {
                 column = m_reordered_columns[column_id_index++];
-                auto const& name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value(
                         std::to_string(std::get<double>(column->extract_value(m_cur_message)))
                 );
@@ -122,8 +122,7 @@ void SchemaReader::generate_json_string() {
             }
             case JsonSerializer::Op::AddBoolField: {
                 column = m_reordered_columns[column_id_index++];
-                auto const& name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value(
                         std::get<uint8_t>(column->extract_value(m_cur_message)) != 0 ? "true"
                                                                                      : "false"
@@ -140,8 +139,7 @@ void SchemaReader::generate_json_string() {
             }
             case JsonSerializer::Op::AddStringField: {
                 column = m_reordered_columns[column_id_index++];
-                auto const& name = m_global_schema_tree->get_node(column->get_id()).get_key_name();
-                m_json_serializer.append_key(name);
+                m_json_serializer.append_key();
                 m_json_serializer.append_value_from_column_with_quotes(column, m_cur_message);
                 break;
             }
@@ -152,9 +150,7 @@ void SchemaReader::generate_json_string() {
             }
             case JsonSerializer::Op::AddArrayField: {
                 column = m_reordered_columns[column_id_index++];
-                m_json_serializer.append_key(
-                        m_global_schema_tree->get_node(column->get_id()).get_key_name()
-                );
+                m_json_serializer.append_key();
                 m_json_serializer.append_value_from_column(column, m_cur_message);
                 break;
             }
@@ -253,33 +249,45 @@ bool SchemaReader::get_next_message_with_timestamp(
     return false;
 }
 
-void SchemaReader::initialize_filter(FilterClass* filter) {
-    filter->init(this, m_schema_id, m_columns);
-}
-
-void SchemaReader::generate_local_tree(int32_t global_id) {
-    std::stack<int32_t> global_id_stack;
-    global_id_stack.emplace(global_id);
-    do {
-        auto const& node = m_global_schema_tree->get_node(global_id_stack.top());
-        int32_t parent_id = node.get_parent_id();
+bool SchemaReader::get_next_message_with_timestamp(
+        std::string& message,
+        epochtime_t& timestamp,
+        FilterClass* filter,
+        std::function<bool(epochtime_t)> const& timestamp_filter
+) {
+    while (m_cur_message < m_num_messages) {
+        if (false == filter->filter(m_cur_message)) {
+            m_cur_message++;
+            continue;
+        }
 
-        auto it = m_global_id_to_local_id.find(parent_id);
-        if (-1 != parent_id && it == m_global_id_to_local_id.end()) {
-            global_id_stack.emplace(parent_id);
+        timestamp = m_get_timestamp();
+        if (false == timestamp_filter(timestamp)) {
+            m_cur_message++;
             continue;
         }
 
-        int32_t local_id = m_local_schema_tree.add_node(
-                parent_id == -1 ? -1 : m_global_id_to_local_id[parent_id],
-                node.get_type(),
-                node.get_key_name()
-        );
+        if (m_should_marshal_records) {
+            if (false == m_serializer_initialized) {
+                initialize_serializer();
+            }
+            generate_json_string();
+            message = m_json_serializer.get_serialized_string();
+
+            if (message.back() != '\n') {
+                message += '\n';
+            }
+        }
+
+        m_cur_message++;
+        return true;
+    }
+
+    return false;
+}
 
-        m_global_id_to_local_id[global_id_stack.top()] = local_id;
-        m_local_id_to_global_id[local_id] = global_id_stack.top();
-        global_id_stack.pop();
-    } while (false == global_id_stack.empty());
+void SchemaReader::initialize_filter(FilterClass* filter) {
+    filter->init(this, m_schema_id, m_columns);
 }
 
 void SchemaReader::mark_unordered_object(
@@ -287,10 +295,16 @@ void SchemaReader::mark_unordered_object(
         int32_t mst_subtree_root,
         std::span<int32_t> schema
 ) {
-    m_global_id_to_unordered_object.emplace(
+    auto const it = std::lower_bound(
+            m_unordered_objects.begin(),
+            m_unordered_objects.end(),
             mst_subtree_root,
-            std::make_pair(column_reader_start, schema)
+            [](UnorderedObject const& object, int32_t root_id) { return object.root_id < root_id; }
     );
+    if (m_unordered_objects.end() != it && mst_subtree_root == it->root_id) {
+        return;
+    }
+    m_unordered_objects.insert(it, {mst_subtree_root, column_reader_start, schema});
 }
 
 int32_t SchemaReader::get_first_column_in_span(std::span<int32_t> schema) {
@@ -305,26 +319,28 @@ int32_t SchemaReader::get_first_column_in_span(std::span<int32_t> schema) {
 void SchemaReader::find_intersection_and_fix_brackets(
         int32_t cur_root,
         int32_t next_root,
-        std::vector<int32_t>& path_to_intersection
+        std::vector<int32_t>& path_to_intersection,
+        SerializationPlan& plan
 ) {
-    auto const* cur_node = &m_global_schema_tree->get_node(cur_root);
-    auto const* next_node = &m_global_schema_tree->get_node(next_root);
+    auto const& schema_tree = m_plan_cache->get_schema_tree();
+    auto const* cur_node = &schema_tree.get_node(cur_root);
+    auto const* next_node = &schema_tree.get_node(next_root);
     while (cur_node->get_parent_id() != next_node->get_parent_id()) {
         if (cur_node->get_depth() > next_node->get_depth()) {
             cur_root = cur_node->get_parent_id();
-            cur_node = &m_global_schema_tree->get_node(cur_root);
-            m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+            cur_node = &schema_tree.get_node(cur_root);
+            plan.ops.push_back(JsonSerializer::Op::EndObject);
         } else if (cur_node->get_depth() < next_node->get_depth()) {
             path_to_intersection.push_back(next_root);
             next_root = next_node->get_parent_id();
-            next_node = &m_global_schema_tree->get_node(next_root);
+            next_node = &schema_tree.get_node(next_root);
         } else {
             cur_root = cur_node->get_parent_id();
-            cur_node = &m_global_schema_tree->get_node(cur_root);
-            m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+            cur_node = &schema_tree.get_node(cur_root);
+            plan.ops.push_back(JsonSerializer::Op::EndObject);
             path_to_intersection.push_back(next_root);
             next_root = next_node->get_parent_id();
-            next_node = &m_global_schema_tree->get_node(next_root);
+            next_node = &schema_tree.get_node(next_root);
         }
     }
 
@@ -332,26 +348,25 @@ void SchemaReader::find_intersection_and_fix_brackets(
     // have the same parent but are different nodes we need to close the last bracket for the
     // previous node, and add the first key for next node.
     if (cur_node != next_node) {
-        m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+        plan.ops.push_back(JsonSerializer::Op::EndObject);
         path_to_intersection.push_back(next_node->get_id());
     }
 
     for (auto it = path_to_intersection.rbegin(); it != path_to_intersection.rend(); ++it) {
-        auto const& node = m_global_schema_tree->get_node(*it);
-        bool no_name = true;
-        if (false == node.get_key_name().empty()) {
-            m_json_serializer.add_special_key(node.get_key_name());
-            no_name = false;
-        }
+        auto const& node = schema_tree.get_node(*it);
+        bool const no_name = node.get_key_name().empty();
         if (NodeType::Object == node.get_type()) {
-            m_json_serializer.add_op(
-                    no_name ? JsonSerializer::Op::BeginUnnamedObject
-                            : JsonSerializer::Op::BeginObject
-            );
+            if (no_name) {
+                plan.ops.push_back(JsonSerializer::Op::BeginUnnamedObject);
+            } else {
+                add_keyed_op(JsonSerializer::Op::BeginObject, *it, plan);
+            }
         } else if (NodeType::StructuredArray == node.get_type()) {
-            m_json_serializer.add_op(
-                    no_name ? JsonSerializer::Op::BeginUnnamedArray : JsonSerializer::Op::BeginArray
-            );
+            if (no_name) {
+                plan.ops.push_back(JsonSerializer::Op::BeginUnnamedArray);
+            } else {
+                add_keyed_op(JsonSerializer::Op::BeginArray, *it, plan);
+            }
         }
     }
     path_to_intersection.clear();
@@ -360,11 +375,13 @@ void SchemaReader::find_intersection_and_fix_brackets(
 size_t SchemaReader::generate_structured_array_template(
         int32_t array_root,
         size_t column_start,
-        std::span<int32_t> schema
+        std::span<int32_t> schema,
+        SerializationPlan& plan
 ) {
+    auto const& schema_tree = m_plan_cache->get_schema_tree();
     size_t column_idx = column_start;
     std::vector<int32_t> path_to_intersection;
-    int32_t depth = m_global_schema_tree->get_node(array_root).get_depth();
+    int32_t depth = schema_tree.get_node(array_root).get_depth();
 
     for (size_t i = 0; i < schema.size(); ++i) {
         int32_t global_column_id = schema[i];
@@ -374,75 +391,74 @@ size_t SchemaReader::generate_structured_array_template(
             auto sub_object_schema = schema.subspan(i + 1, length);
             if (NodeType::StructuredArray == type) {
                 int32_t sub_array_root
-                        = m_global_schema_tree->find_matching_subtree_root_in_subtree(
+                        = schema_tree.find_matching_subtree_root_in_subtree(
                                 array_root,
                                 get_first_column_in_span(sub_object_schema),
                                 NodeType::StructuredArray
                         );
-                m_json_serializer.add_op(JsonSerializer::Op::BeginUnnamedArray);
+                plan.ops.push_back(JsonSerializer::Op::BeginUnnamedArray);
                 column_idx = generate_structured_array_template(
                         sub_array_root,
                         column_idx,
-                        sub_object_schema
+                        sub_object_schema,
+                        plan
                 );
-                m_json_serializer.add_op(JsonSerializer::Op::EndArray);
+                plan.ops.push_back(JsonSerializer::Op::EndArray);
             } else if (NodeType::Object == type) {
-                int32_t object_root = m_global_schema_tree->find_matching_subtree_root_in_subtree(
+                int32_t object_root = schema_tree.find_matching_subtree_root_in_subtree(
                         array_root,
                         get_first_column_in_span(sub_object_schema),
                         NodeType::Object
                 );
-                m_json_serializer.add_op(JsonSerializer::Op::BeginUnnamedObject);
+                plan.ops.push_back(JsonSerializer::Op::BeginUnnamedObject);
                 column_idx = generate_structured_object_template(
                         object_root,
                         column_idx,
-                        sub_object_schema
+                        sub_object_schema,
+                        plan
                 );
-                m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+                plan.ops.push_back(JsonSerializer::Op::EndObject);
             }
             i += length;
         } else {
-            auto const& node = m_global_schema_tree->get_node(global_column_id);
+            auto const& node = schema_tree.get_node(global_column_id);
             switch (node.get_type()) {
                 case NodeType::Object: {
                     find_intersection_and_fix_brackets(
                             array_root,
                             global_column_id,
-                            path_to_intersection
+                            path_to_intersection,
+                            plan
                     );
                     for (int j = 0; j < (node.get_depth() - depth); ++j) {
-                        m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+                        plan.ops.push_back(JsonSerializer::Op::EndObject);
                     }
                     break;
                 }
                 case NodeType::StructuredArray: {
-                    m_json_serializer.add_op(JsonSerializer::Op::BeginUnnamedArray);
-                    m_json_serializer.add_op(JsonSerializer::Op::EndArray);
+                    plan.ops.push_back(JsonSerializer::Op::BeginUnnamedArray);
+                    plan.ops.push_back(JsonSerializer::Op::EndArray);
                     break;
                 }
                 case NodeType::Integer: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddIntValue);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_column_op(JsonSerializer::Op::AddIntValue, column_idx++, plan);
                     break;
                 }
                 case NodeType::Float: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddFloatValue);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_column_op(JsonSerializer::Op::AddFloatValue, column_idx++, plan);
                     break;
                 }
                 case NodeType::Boolean: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddBoolValue);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_column_op(JsonSerializer::Op::AddBoolValue, column_idx++, plan);
                     break;
                 }
                 case NodeType::ClpString:
                 case NodeType::VarString: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddStringValue);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_column_op(JsonSerializer::Op::AddStringValue, column_idx++, plan);
                     break;
                 }
                 case NodeType::NullValue: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddNullValue);
+                    plan.ops.push_back(JsonSerializer::Op::AddNullValue);
                     break;
                 }
                 case NodeType::DateString:
@@ -458,8 +474,10 @@ size_t SchemaReader::generate_structured_array_template(
 size_t SchemaReader::generate_structured_object_template(
         int32_t object_root,
         size_t column_start,
-        std::span<int32_t> schema
+        std::span<int32_t> schema,
+        SerializationPlan& plan
 ) {
+    auto const& schema_tree = m_plan_cache->get_schema_tree();
     int32_t root = object_root;
     size_t column_idx = column_start;
     std::vector<int32_t> path_to_intersection;
@@ -472,61 +490,63 @@ size_t SchemaReader::generate_structured_object_template(
             auto array_schema = schema.subspan(i + 1, array_length);
             // we can guarantee that the last array we hit on the path to object root must be the
             // right one because otherwise we'd be inside the structured array generator
-            int32_t array_root = m_global_schema_tree->find_matching_subtree_root_in_subtree(
+            int32_t array_root = schema_tree.find_matching_subtree_root_in_subtree(
                     object_root,
                     get_first_column_in_span(array_schema),
                     NodeType::StructuredArray
             );
 
-            find_intersection_and_fix_brackets(root, array_root, path_to_intersection);
-            column_idx = generate_structured_array_template(array_root, column_idx, array_schema);
-            m_json_serializer.add_op(JsonSerializer::Op::EndArray);
+            find_intersection_and_fix_brackets(root, array_root, path_to_intersection, plan);
+            column_idx = generate_structured_array_template(
+                    array_root,
+                    column_idx,
+                    array_schema,
+                    plan
+            );
+            plan.ops.push_back(JsonSerializer::Op::EndArray);
             i += array_length;
             // root is parent of the array object since we close the array bracket above
-            auto const& node = m_global_schema_tree->get_node(array_root);
+            auto const& node = schema_tree.get_node(array_root);
             root = node.get_parent_id();
         } else {
-            auto const& node = m_global_schema_tree->get_node(global_column_id);
+            auto const& node = schema_tree.get_node(global_column_id);
             int32_t next_root = node.get_parent_id();
-            find_intersection_and_fix_brackets(root, next_root, path_to_intersection);
+            find_intersection_and_fix_brackets(root, next_root, path_to_intersection, plan);
             root = next_root;
             switch (node.get_type()) {
                 case NodeType::Object: {
-                    m_json_serializer.add_op(JsonSerializer::Op::BeginObject);
-                    m_json_serializer.add_special_key(node.get_key_name());
-                    m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+                    add_keyed_op(JsonSerializer::Op::BeginObject, global_column_id, plan);
+                    plan.ops.push_back(JsonSerializer::Op::EndObject);
                     break;
                 }
                 case NodeType::StructuredArray: {
-                    m_json_serializer.add_op(JsonSerializer::Op::BeginArray);
-                    m_json_serializer.add_special_key(node.get_key_name());
-                    m_json_serializer.add_op(JsonSerializer::Op::EndArray);
+                    add_keyed_op(JsonSerializer::Op::BeginArray, global_column_id, plan);
+                    plan.ops.push_back(JsonSerializer::Op::EndArray);
                     break;
                 }
                 case NodeType::Integer: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddIntField);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_keyed_op(JsonSerializer::Op::AddIntField, global_column_id, plan);
+                    plan.column_indices.push_back(column_idx++);
                     break;
                 }
                 case NodeType::Float: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddFloatField);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_keyed_op(JsonSerializer::Op::AddFloatField, global_column_id, plan);
+                    plan.column_indices.push_back(column_idx++);
                     break;
                 }
                 case NodeType::Boolean: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddBoolField);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_keyed_op(JsonSerializer::Op::AddBoolField, global_column_id, plan);
+                    plan.column_indices.push_back(column_idx++);
                     break;
                 }
                 case NodeType::ClpString:
                 case NodeType::VarString: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddStringField);
-                    m_reordered_columns.push_back(m_columns[column_idx++]);
+                    add_keyed_op(JsonSerializer::Op::AddStringField, global_column_id, plan);
+                    plan.column_indices.push_back(column_idx++);
                     break;
                 }
                 case NodeType::NullValue: {
-                    m_json_serializer.add_op(JsonSerializer::Op::AddNullField);
-                    m_json_serializer.add_special_key(node.get_key_name());
+                    add_keyed_op(JsonSerializer::Op::AddNullField, global_column_id, plan);
                     break;
                 }
                 case NodeType::DateString:
@@ -536,7 +556,7 @@ size_t SchemaReader::generate_structured_object_template(
             }
         }
     }
-    find_intersection_and_fix_brackets(root, object_root, path_to_intersection);
+    find_intersection_and_fix_brackets(root, object_root, path_to_intersection, plan);
     return column_idx;
 }
 
@@ -547,84 +567,107 @@ void SchemaReader::initialize_serializer() {
 
     m_serializer_initialized = true;
 
+    auto const* plan = m_plan_cache->get_plan(m_schema_id);
+    if (nullptr == plan) {
+        auto& new_plan = m_plan_cache->create_plan(m_schema_id);
+        build_plan(new_plan);
+        plan = &new_plan;
+    }
+
+    m_reordered_columns.clear();
+    m_reordered_columns.reserve(plan->column_indices.size());
+    for (size_t column_idx : plan->column_indices) {
+        m_reordered_columns.push_back(m_columns[column_idx]);
+    }
+    m_json_serializer.bind(plan->ops, plan->key_fragments);
+}
+
+void SchemaReader::build_plan(SerializationPlan& plan) {
+    m_plan_cache->clear_local_tree();
     for (int32_t global_column_id : m_ordered_schema) {
-        generate_local_tree(global_column_id);
+        m_plan_cache->add_path_to_local_tree(global_column_id);
+    }
+    for (auto const& unordered_object : m_unordered_objects) {
+        m_plan_cache->add_path_to_local_tree(unordered_object.root_id);
     }
 
-    for (auto it = m_global_id_to_unordered_object.begin();
-         it != m_global_id_to_unordered_object.end();
-         ++it)
-    {
-        generate_local_tree(it->first);
+    // Ordered columns are appended before any unordered columns
+    for (size_t i = 0; i < m_num_ordered_columns; ++i) {
+        m_plan_cache->set_column_index(m_columns[i]->get_id(), i);
     }
 
     // TODO: this code will have to change once we allow mixing log lines parsed by different
     // parsers.
-    generate_json_template(0);
+    int32_t const root_id = m_plan_cache->get_local_tree_root();
+    if (-1 != root_id) {
+        generate_json_template(root_id, plan);
+    }
 }
 
-void SchemaReader::generate_json_template(int32_t id) {
-    auto const& node = m_local_schema_tree.get_node(id);
-    auto const& children_ids = node.get_children_ids();
-
-    for (int32_t child_id : children_ids) {
-        int32_t child_global_id = m_local_id_to_global_id[child_id];
-        auto const& child_node = m_local_schema_tree.get_node(child_id);
-        std::string const& key = child_node.get_key_name();
-        switch (child_node.get_type()) {
+void SchemaReader::generate_json_template(int32_t id, SerializationPlan& plan) {
+    auto const& schema_tree = m_plan_cache->get_schema_tree();
+    for (int32_t child_id = m_plan_cache->get_first_local_child(id); -1 != child_id;
+         child_id = m_plan_cache->get_next_local_sibling(child_id))
+    {
+        switch (schema_tree.get_node(child_id).get_type()) {
             case NodeType::Object: {
-                m_json_serializer.add_op(JsonSerializer::Op::BeginObject);
-                m_json_serializer.add_special_key(key);
-                generate_json_template(child_id);
-                m_json_serializer.add_op(JsonSerializer::Op::EndObject);
+                add_keyed_op(JsonSerializer::Op::BeginObject, child_id, plan);
+                generate_json_template(child_id, plan);
+                plan.ops.push_back(JsonSerializer::Op::EndObject);
                 break;
             }
             case NodeType::UnstructuredArray: {
-                m_json_serializer.add_op(JsonSerializer::Op::AddArrayField);
-                m_reordered_columns.push_back(m_column_map[child_global_id]);
+                add_keyed_op(JsonSerializer::Op::AddArrayField, child_id, plan);
+                plan.column_indices.push_back(m_plan_cache->get_column_index(child_id));
                 break;
             }
             case NodeType::StructuredArray: {
-                m_json_serializer.add_op(JsonSerializer::Op::BeginArray);
-                m_json_serializer.add_special_key(key);
-                auto structured_it = m_global_id_to_unordered_object.find(child_global_id);
-                if (m_global_id_to_unordered_object.end() != structured_it) {
-                    size_t column_start = structured_it->second.first;
-                    std::span<int32_t> structured_schema = structured_it->second.second;
+                add_keyed_op(JsonSerializer::Op::BeginArray, child_id, plan);
+                auto const structured_it = std::lower_bound(
+                        m_unordered_objects.cbegin(),
+                        m_unordered_objects.cend(),
+                        child_id,
+                        [](UnorderedObject const& object, int32_t root_id) {
+                            return object.root_id < root_id;
+                        }
+                );
+                if (m_unordered_objects.cend() != structured_it
+                    && child_id == structured_it->root_id)
+                {
                     generate_structured_array_template(
-                            child_global_id,
-                            column_start,
-                            structured_schema
+                            child_id,
+                            structured_it->column_start,
+                            structured_it->schema,
+                            plan
                     );
                 }
-                m_json_serializer.add_op(JsonSerializer::Op::EndArray);
+                plan.ops.push_back(JsonSerializer::Op::EndArray);
                 break;
             }
             case NodeType::Integer: {
-                m_json_serializer.add_op(JsonSerializer::Op::AddIntField);
-                m_reordered_columns.push_back(m_column_map[child_global_id]);
+                add_keyed_op(JsonSerializer::Op::AddIntField, child_id, plan);
+                plan.column_indices.push_back(m_plan_cache->get_column_index(child_id));
                 break;
             }
             case NodeType::Float: {
-                m_json_serializer.add_op(JsonSerializer::Op::AddFloatField);
-                m_reordered_columns.push_back(m_column_map[child_global_id]);
+                add_keyed_op(JsonSerializer::Op::AddFloatField, child_id, plan);
+                plan.column_indices.push_back(m_plan_cache->get_column_index(child_id));
                 break;
             }
             case NodeType::Boolean: {
-                m_json_serializer.add_op(JsonSerializer::Op::AddBoolField);
-                m_reordered_columns.push_back(m_column_map[child_global_id]);
+                add_keyed_op(JsonSerializer::Op::AddBoolField, child_id, plan);
+                plan.column_indices.push_back(m_plan_cache->get_column_index(child_id));
                 break;
             }
             case NodeType::ClpString:
             case NodeType::VarString:
             case NodeType::DateString: {
-                m_json_serializer.add_op(JsonSerializer::Op::AddStringField);
-                m_reordered_columns.push_back(m_column_map[child_global_id]);
+                add_keyed_op(JsonSerializer::Op::AddStringField, child_id, plan);
+                plan.column_indices.push_back(m_plan_cache->get_column_index(child_id));
                 break;
             }
             case NodeType::NullValue: {
-                m_json_serializer.add_op(JsonSerializer::Op::AddNullField);
-                m_json_serializer.add_special_key(key);
+                add_keyed_op(JsonSerializer::Op::AddNullField, child_id, plan);
                 break;
             }
             case NodeType::Unknown:
@@ -1,16 +1,18 @@
 #ifndef CLP_S_SCHEMAREADER_HPP
 #define CLP_S_SCHEMAREADER_HPP
 
+#include <functional>
 #include <span>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ColumnReader.hpp"
 #include "FileReader.hpp"
 #include "JsonSerializer.hpp"
 #include "SchemaTree.hpp"
+#include "SerializationPlanCache.hpp"
 #include "ZstdDecompressor.hpp"
 
 namespace clp_s {
@@ -51,6 +53,9 @@ public:
         uint64_t num_messages;
         size_t offset;
         size_t uncompressed_size;
+        // The range of the timestamps of the messages in the table
+        epochtime_t begin_timestamp;
+        epochtime_t end_timestamp;
     };
 
     // Constructor
@@ -67,17 +72,17 @@ public:
 
     /**
      * Resets the contents of this SchemaReader and prepares it to become a SchemaReader with a new
-     * schema id, schema tree, and other parameters. After this call the SchemaReader is prepared
-     * to accept append_column calls for the new schema.
+     * schema id, serialization plan cache, and other parameters. After this call the SchemaReader
+     * is prepared to accept append_column calls for the new schema.
      *
-     * @param schema_tree
+     * @param plan_cache The cache of serialization plans for the archive containing the schema
      * @param schema_id
      * @param ordered_schema
      * @param num_messages
      * @param should_marshal_records
      */
     void reset(
-            std::shared_ptr<SchemaTree> schema_tree,
+            std::shared_ptr<SerializationPlanCache> plan_cache,
             int32_t schema_id,
             std::span<int32_t> ordered_schema,
             uint64_t num_messages,
@@ -89,22 +94,20 @@ public:
         m_serializer_initialized = false;
         m_ordered_schema = ordered_schema;
         delete_columns();
-        m_column_map.clear();
+        m_num_ordered_columns = 0;
         m_columns.clear();
         m_reordered_columns.clear();
         m_timestamp_column = nullptr;
         m_get_timestamp = []() -> epochtime_t { return 0; };
-        m_local_id_to_global_id.clear();
-        m_global_id_to_local_id.clear();
-        m_global_id_to_unordered_object.clear();
-        m_local_schema_tree.clear();
-        m_json_serializer.clear();
-        m_global_schema_tree = std::move(schema_tree);
+        m_unordered_objects.clear();
+        m_json_serializer.bind({}, {});
+        m_plan_cache = std::move(plan_cache);
         m_should_marshal_records = should_marshal_records;
     }
 
     /**
-     * Appends a column to the schema reader
+     * Appends a column to the schema reader. All ordered columns must be appended before any
+     * unordered column.
      * @param column_reader
      */
     void append_column(BaseColumnReader* column_reader);
@@ -164,6 +167,23 @@ public:
             FilterClass* filter
     );
 
+    /**
+     * Gets the next message matching a filter whose timestamp is accepted by the given timestamp
+     * filter, and its timestamp. The timestamp filter is applied before the message is marshalled,
+     * so rejected messages cost no more than reading their timestamp.
+     * @param message
+     * @param timestamp
+     * @param filter
+     * @param timestamp_filter Returns whether a message with the given timestamp should be returned
+     * @return true if there is a next message
+     */
+    bool get_next_message_with_timestamp(
+            std::string& message,
+            epochtime_t& timestamp,
+            FilterClass* filter,
+            std::function<bool(epochtime_t)> const& timestamp_filter
+    );
+
     /**
      * Initializes the filter
      * @param filter
@@ -196,43 +216,53 @@ public:
     bool done() const { return m_cur_message >= m_num_messages; }
 
 private:
-    /**
-     * Merges the current local schema tree with the section of the global schema tree corresponding
-     * to the path from the root of the global schema tree to the node matching the global MPT node
-     * id passed to this function.
-     * @param global_id
-     */
-    void generate_local_tree(int32_t global_id);
+    // Types
+    struct UnorderedObject {
+        int32_t root_id;
+        size_t column_start;
+        std::span<int32_t> schema;
+    };
 
     /**
-     * Generates a json template
+     * Generates a json template for the children of a node in the plan cache's local tree
      * @param id
+     * @param plan
      */
-    void generate_json_template(int32_t id);
+    void generate_json_template(int32_t id, SerializationPlan& plan);
 
     /**
      * Generates a json template for a structured array
      * @param id
      * @param column_start the index of the first reader in m_columns belonging to this array
      * @param schema
+     * @param plan
      * @return the index of the next reader in m_columns after those consumed by this array
      */
-    size_t
-    generate_structured_array_template(int32_t id, size_t column_start, std::span<int32_t> schema);
+    size_t generate_structured_array_template(
+            int32_t id,
+            size_t column_start,
+            std::span<int32_t> schema,
+            SerializationPlan& plan
+    );
 
     /**
      * Generates a json template for a structured object
      * @param id
      * @param column_start the index of the first reader in m_columns belonging to this object
      * @param schema
+     * @param plan
      * @return the index of the next reader in m_columns after those consumed by this object
      */
-    size_t
-    generate_structured_object_template(int32_t id, size_t column_start, std::span<int32_t> schema);
+    size_t generate_structured_object_template(
+            int32_t id,
+            size_t column_start,
+            std::span<int32_t> schema,
+            SerializationPlan& plan
+    );
 
     /**
      * Finds the common root of the subtree containing cur_root and next_root, and adds brackets
-     * and keys to m_json_serializer as necessary so that the json object is correct between the
+     * and keys to the plan as necessary so that the json object is correct between the
      * previous field which is a child of cur_root, and the next field which is a child of
      * next_root.
      *
@@ -247,25 +277,57 @@ private:
      * ancestor. For every step cur_root takes towards this common ancestor we must close a bracket,
      * and for every step on the path from next_root a key must be added and a bracket must be
      * opened. The parameter `path_to_intersection` is used as a buffer to store the path from
-     * next_root to this intersection so that the keys can be added to m_json_serializer in the
-     * correct order.
+     * next_root to this intersection so that the keys can be added to the plan in the correct
+     * order.
      * @param cur_root
      * @param next_root
      * @param path_to_intersection
+     * @param plan
      */
     void find_intersection_and_fix_brackets(
             int32_t cur_root,
             int32_t next_root,
-            std::vector<int32_t>& path_to_intersection
+            std::vector<int32_t>& path_to_intersection,
+            SerializationPlan& plan
     );
 
+    /**
+     * Adds an operation that appends a key to the plan, along with the key of the given node
+     * @param op
+     * @param node_id
+     * @param plan
+     */
+    void add_keyed_op(JsonSerializer::Op op, int32_t node_id, SerializationPlan& plan) {
+        plan.ops.push_back(op);
+        plan.key_fragments.push_back(m_plan_cache->get_key_fragment(node_id));
+    }
+
+    /**
+     * Adds an operation that appends a column's value to the plan
+     * @param op
+     * @param column_idx the index of the column in m_columns
+     * @param plan
+     */
+    static void add_column_op(JsonSerializer::Op op, size_t column_idx, SerializationPlan& plan) {
+        plan.ops.push_back(op);
+        plan.column_indices.push_back(column_idx);
+    }
+
+    /**
+     * Builds the serialization plan for this reader's schema
+     * @param plan
+     */
+    void build_plan(SerializationPlan& plan);
+
     /**
      * Generates a json string from the extracted values
      */
     void generate_json_string();
 
     /**
-     * Initializes all internal data structured required to serialize records.
+     * Initializes all internal data structured required to serialize records, by binding the
+     * columns to the schema's cached serialization plan, and building the plan if it isn't cached
+     * yet.
      */
     void initialize_serializer();
 
@@ -274,7 +336,7 @@ private:
     uint64_t m_cur_message;
     std::span<int32_t> m_ordered_schema;
 
-    std::unordered_map<int32_t, BaseColumnReader*> m_column_map;
+    size_t m_num_ordered_columns{0};
     std::vector<BaseColumnReader*> m_columns;
     std::vector<BaseColumnReader*> m_reordered_columns;
     std::unique_ptr<char[]> m_table_buffer;
@@ -283,16 +345,14 @@ private:
     BaseColumnReader* m_timestamp_column;
     std::function<epochtime_t()> m_get_timestamp;
 
-    std::shared_ptr<SchemaTree> m_global_schema_tree;
-    SchemaTree m_local_schema_tree;
-    std::unordered_map<int32_t, int32_t> m_global_id_to_local_id;
-    std::unordered_map<int32_t, int32_t> m_local_id_to_global_id;
+    std::shared_ptr<SerializationPlanCache> m_plan_cache;
 
     JsonSerializer m_json_serializer;
     bool m_should_marshal_records{true};
     bool m_serializer_initialized{false};
 
-    std::map<int32_t, std::pair<size_t, std::span<int32_t>>> m_global_id_to_unordered_object;
+    // Sorted by root ID
+    std::vector<UnorderedObject> m_unordered_objects;
 };
 }  // namespace clp_s
 
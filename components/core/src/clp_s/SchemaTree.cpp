@@ -5,9 +5,8 @@
 #include "ZstdCompressor.hpp"
 
 namespace clp_s {
-int32_t SchemaTree::add_node(int32_t parent_node_id, NodeType type, std::string const& key) {
-    std::tuple<int32_t, std::string, NodeType> node_key = {parent_node_id, key, type};
-    auto node_it = m_node_map.find(node_key);
+int32_t SchemaTree::add_node(int32_t parent_node_id, NodeType type, std::string_view key) {
+    auto node_it = m_node_map.find(node_key_view_t{parent_node_id, key, type});
     if (node_it != m_node_map.end()) {
         auto node_id = node_it->second;
         m_nodes[node_id].increase_count();
@@ -15,14 +14,15 @@ int32_t SchemaTree::add_node(int32_t parent_node_id, NodeType type, std::string
     }
 
     int32_t node_id = m_nodes.size();
-    auto& node = m_nodes.emplace_back(parent_node_id, node_id, key, type, 0);
+    auto& node = m_nodes.emplace_back(parent_node_id, node_id, std::string{key}, type, 0);
     node.increase_count();
     if (parent_node_id >= 0) {
         auto& parent_node = m_nodes[parent_node_id];
         node.set_depth(parent_node.get_depth() + 1);
         parent_node.add_child(node_id);
     }
-    m_node_map[node_key] = node_id;
+    m_node_map.emplace(node_key_t{parent_node_id, node.get_key_name(), type}, node_id);
+    m_key_size += key.size();
 
     return node_id;
 }
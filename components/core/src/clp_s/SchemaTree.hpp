@@ -5,9 +5,12 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
 
 namespace clp_s {
 enum class NodeType : uint8_t {
@@ -81,7 +84,20 @@ class SchemaTree {
 public:
     SchemaTree() = default;
 
-    int32_t add_node(int parent_node_id, NodeType type, std::string const& key);
+    /**
+     * Adds a node to the schema tree if it doesn't already exist
+     * @param parent_node_id
+     * @param type
+     * @param key
+     * @return the ID of the node
+     */
+    int32_t add_node(int parent_node_id, NodeType type, std::string_view key);
+
+    /**
+     * Increases the count of an existing node by 1, as `add_node` does when the node exists
+     * @param id
+     */
+    void increase_node_count(int32_t id) { m_nodes[id].increase_count(); }
 
     bool has_node(int32_t id) { return id < m_nodes.size() && id >= 0; }
 
@@ -106,11 +122,24 @@ public:
     [[nodiscard]] size_t store(std::string const& archives_dir, int compression_level);
 
     /**
-     * Clear the schema tree
+     * Clear the schema tree, releasing the memory it holds so that it isn't retained by the next
+     * archive
      */
     void clear() {
-        m_nodes.clear();
-        m_node_map.clear();
+        m_nodes = decltype(m_nodes){};
+        m_node_map = decltype(m_node_map){};
+        m_key_size = 0;
+    }
+
+    /**
+     * @return The number of bytes of memory held by the schema tree
+     */
+    [[nodiscard]] size_t get_memory_usage() const {
+        // Each node's key is stored twice (in the node and in the node map), and each node other
+        // than the root is in its parent's list of children
+        return m_nodes.capacity() * sizeof(SchemaNode) + m_nodes.size() * sizeof(int32_t)
+               + 2 * m_key_size
+               + m_node_map.capacity() * (sizeof(decltype(m_node_map)::value_type) + 1);
     }
 
     /**
@@ -128,8 +157,35 @@ public:
     ) const;
 
 private:
+    // Types
+    using node_key_t = std::tuple<int32_t, std::string, NodeType>;
+    using node_key_view_t = std::tuple<int32_t, std::string_view, NodeType>;
+
+    /**
+     * Hash and equality for node keys that allow the node map to be probed with a
+     * `node_key_view_t`, so that lookups don't need to copy the key's name
+     */
+    struct NodeKeyHash {
+        using is_transparent = void;
+
+        size_t operator()(node_key_view_t const& key) const {
+            return absl::Hash<node_key_view_t>{}(key);
+        }
+    };
+
+    struct NodeKeyEqual {
+        using is_transparent = void;
+
+        bool operator()(node_key_view_t const& lhs, node_key_view_t const& rhs) const {
+            return lhs == rhs;
+        }
+    };
+
+    // Variables
     std::vector<SchemaNode> m_nodes;
-    absl::flat_hash_map<std::tuple<int32_t, std::string, NodeType>, int32_t> m_node_map;
+    absl::flat_hash_map<node_key_t, int32_t, NodeKeyHash, NodeKeyEqual> m_node_map;
+    // The total size of the nodes' keys
+    size_t m_key_size{0};
 };
 }  // namespace clp_s
 
@@ -27,17 +27,23 @@ size_t SchemaWriter::append_message(ParsedMessage& message) {
     return total_size;
 }
 
-size_t SchemaWriter::store(ZstdCompressor& compressor) {
+size_t SchemaWriter::store(ZstdCompressor& compressor, ColumnSpillFile& spill_file) {
     size_t total_size = 0;
     for (auto& writer : m_columns) {
-        total_size += writer->store(compressor);
+        total_size += writer->store(compressor, spill_file);
     }
     return total_size;
 }
 
-SchemaWriter::~SchemaWriter() {
-    for (auto i : m_columns) {
-        delete i;
+void SchemaWriter::spill(ColumnSpillFile& spill_file) {
+    for (auto& writer : m_columns) {
+        writer->spill(spill_file);
+    }
+}
+
+void SchemaWriter::index_dictionary_ids(int32_t schema_id, DictionaryIndexWriter& index) const {
+    for (auto const* writer : m_columns) {
+        writer->index_dictionary_ids(schema_id, index);
     }
 }
 }  // namespace clp_s
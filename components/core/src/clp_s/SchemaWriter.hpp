@@ -1,9 +1,13 @@
 #ifndef CLP_S_SCHEMAWRITER_HPP
 #define CLP_S_SCHEMAWRITER_HPP
 
+#include <algorithm>
 #include <vector>
 
+#include "ColumnSpillFile.hpp"
 #include "ColumnWriter.hpp"
+#include "Defs.hpp"
+#include "DictionaryIndexWriter.hpp"
 #include "FileWriter.hpp"
 #include "ParsedMessage.hpp"
 #include "ZstdCompressor.hpp"
@@ -14,9 +18,6 @@ public:
     // Constructor
     SchemaWriter() : m_num_messages(0) {}
 
-    // Destructor
-    ~SchemaWriter();
-
     /**
      * Opens the schema writer.
      * @param path
@@ -25,7 +26,8 @@ public:
     void open(std::string path, int compression_level);
 
     /**
-     * Appends a column to the schema writer.
+     * Appends a column to the schema writer. The column must outlive the schema writer (e.g., by
+     * being created in the same ColumnArena).
      * @param column_writer
      */
     void append_column(BaseColumnWriter* column_writer);
@@ -40,9 +42,24 @@ public:
     /**
      * Stores the columns to disk.
      * @param compressor
+     * @param spill_file The file the columns were spilled to, if any
      * @return the uncompressed in-memory size of the table
      */
-    [[nodiscard]] size_t store(ZstdCompressor& compressor);
+    [[nodiscard]] size_t store(ZstdCompressor& compressor, ColumnSpillFile& spill_file);
+
+    /**
+     * Spills the columns' values to disk, returning their memory to the columns' arena.
+     * @param spill_file
+     */
+    void spill(ColumnSpillFile& spill_file);
+
+    /**
+     * Adds the IDs of the dictionary entries that the table's columns' unspilled values reference
+     * to the dictionary index.
+     * @param schema_id The ID of the table's schema
+     * @param index
+     */
+    void index_dictionary_ids(int32_t schema_id, DictionaryIndexWriter& index) const;
 
     /**
      * Closes the schema writer.
@@ -50,10 +67,33 @@ public:
      */
     [[nodiscard]] size_t close();
 
+    /**
+     * Expands the table's timestamp range to include the given timestamp.
+     * @param timestamp
+     */
+    void expand_timestamp_range(epochtime_t timestamp) {
+        m_begin_timestamp = std::min(m_begin_timestamp, timestamp);
+        m_end_timestamp = std::max(m_end_timestamp, timestamp);
+    }
+
     uint64_t get_num_messages() const { return m_num_messages; }
 
+    /**
+     * @return The number of bytes of memory the schema writer holds on the heap. This excludes the
+     * schema writer itself and its columns, which are expected to be created in a ColumnArena.
+     */
+    [[nodiscard]] size_t get_heap_size() const {
+        return (m_columns.capacity() + m_unordered_columns.capacity()) * sizeof(BaseColumnWriter*);
+    }
+
+    [[nodiscard]] epochtime_t get_begin_timestamp() const { return m_begin_timestamp; }
+
+    [[nodiscard]] epochtime_t get_end_timestamp() const { return m_end_timestamp; }
+
 private:
     uint64_t m_num_messages;
+    epochtime_t m_begin_timestamp{cEpochTimeMax};
+    epochtime_t m_end_timestamp{cEpochTimeMin};
 
     std::vector<BaseColumnWriter*> m_columns;
     std::vector<BaseColumnWriter*> m_unordered_columns;
@@ -0,0 +1,63 @@
+#include "SerializationPlanCache.hpp"
+
+#include <utility>
+
+namespace clp_s {
+SerializationPlanCache::SerializationPlanCache(std::shared_ptr<SchemaTree> schema_tree)
+        : m_schema_tree{std::move(schema_tree)} {
+    auto const num_nodes = m_schema_tree->get_nodes().size();
+    // The fragments are never resized, so views of them remain valid
+    m_key_fragments.resize(num_nodes);
+    m_node_epochs.resize(num_nodes, 0);
+    m_first_children.resize(num_nodes, -1);
+    m_last_children.resize(num_nodes, -1);
+    m_next_siblings.resize(num_nodes, -1);
+    m_column_indices.resize(num_nodes, 0);
+}
+
+std::string_view SerializationPlanCache::get_key_fragment(int32_t node_id) {
+    auto& key_fragment = m_key_fragments[node_id];
+    // A fragment always contains at least the quotes and colon, so it's only empty if it hasn't
+    // been interned yet
+    if (key_fragment.empty()) {
+        auto const& key_name = m_schema_tree->get_node(node_id).get_key_name();
+        key_fragment.reserve(key_name.size() + 3);
+        key_fragment += '"';
+        key_fragment += key_name;
+        key_fragment += "\":";
+    }
+    return key_fragment;
+}
+
+void SerializationPlanCache::add_path_to_local_tree(int32_t node_id) {
+    // Collect the nodes on the path that aren't in the local tree yet, from the deepest upwards
+    m_path_buffer.clear();
+    for (int32_t id = node_id; -1 != id && false == is_in_local_tree(id);
+         id = m_schema_tree->get_node(id).get_parent_id())
+    {
+        m_path_buffer.push_back(id);
+    }
+
+    for (auto it = m_path_buffer.rbegin(); it != m_path_buffer.rend(); ++it) {
+        int32_t const id = *it;
+        m_node_epochs[id] = m_local_tree_epoch;
+        m_first_children[id] = -1;
+        m_last_children[id] = -1;
+        m_next_siblings[id] = -1;
+
+        int32_t const parent_id = m_schema_tree->get_node(id).get_parent_id();
+        if (-1 == parent_id) {
+            if (-1 == m_local_tree_root) {
+                m_local_tree_root = id;
+            }
+            continue;
+        }
+        if (-1 == m_last_children[parent_id]) {
+            m_first_children[parent_id] = id;
+        } else {
+            m_next_siblings[m_last_children[parent_id]] = id;
+        }
+        m_last_children[parent_id] = id;
+    }
+}
+}  // namespace clp_s
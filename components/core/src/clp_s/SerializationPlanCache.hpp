@@ -0,0 +1,153 @@
+#ifndef CLP_S_SERIALIZATIONPLANCACHE_HPP
+#define CLP_S_SERIALIZATIONPLANCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "JsonSerializer.hpp"
+#include "SchemaTree.hpp"
+
+namespace clp_s {
+/**
+ * A precompiled plan for marshalling the records of a table into JSON. A plan only depends on the
+ * table's schema, so it can be shared by every reader of the table.
+ */
+struct SerializationPlan {
+    std::vector<JsonSerializer::Op> ops;
+    // The `"key":` fragment of each op that appends a key, in op order
+    std::vector<std::string_view> key_fragments;
+    // The index of the column read by each op that appends a column's value, in op order. Columns
+    // are indexed in the order they were appended to the schema reader.
+    std::vector<size_t> column_indices;
+};
+
+/**
+ * Caches the serialization plans of an archive's tables, so that reading a table whose plan was
+ * already built only needs to bind the table's columns to the plan.
+ *
+ * The cache also interns the `"key":` fragment of each schema tree node, and provides the scratch
+ * space used to build plans. The scratch space is indexed by node ID and reused across plans, so
+ * building a plan doesn't need to allocate any per-node maps. The cache isn't thread-safe.
+ */
+class SerializationPlanCache {
+public:
+    // Constructors
+    explicit SerializationPlanCache(std::shared_ptr<SchemaTree> schema_tree);
+
+    // Methods
+    [[nodiscard]] SchemaTree const& get_schema_tree() const { return *m_schema_tree; }
+
+    /**
+     * @param schema_id
+     * @return The cached plan for the given schema, or nullptr if no plan has been cached
+     */
+    [[nodiscard]] SerializationPlan const* get_plan(int32_t schema_id) const {
+        auto const it = m_plans.find(schema_id);
+        return m_plans.end() == it ? nullptr : &it->second;
+    }
+
+    /**
+     * Creates an empty plan for the given schema, replacing any existing plan.
+     * @param schema_id
+     * @return The plan, which remains valid for the lifetime of the cache
+     */
+    SerializationPlan& create_plan(int32_t schema_id) {
+        auto& plan = m_plans[schema_id];
+        plan = SerializationPlan{};
+        return plan;
+    }
+
+    /**
+     * @param node_id
+     * @return The `"key":` fragment of the given node, which is interned the first time it's
+     * requested and remains valid for the lifetime of the cache
+     */
+    std::string_view get_key_fragment(int32_t node_id);
+
+    /**
+     * Clears the local tree used to build a plan. The local tree is the subtree of the schema tree
+     * that contains the paths to the columns of a table.
+     */
+    void clear_local_tree() {
+        ++m_local_tree_epoch;
+        m_local_tree_root = -1;
+    }
+
+    /**
+     * Adds the path from the root of the schema tree to the given node to the local tree. Each
+     * node is added as the last child of its parent, so the children of a node in the local tree
+     * are ordered by when they were added.
+     * @param node_id
+     */
+    void add_path_to_local_tree(int32_t node_id);
+
+    /**
+     * @return The root of the local tree, or -1 if the local tree is empty
+     */
+    [[nodiscard]] int32_t get_local_tree_root() const { return m_local_tree_root; }
+
+    /**
+     * @param node_id A node in the local tree
+     * @return The first child of the given node in the local tree, or -1 if it has no children
+     */
+    [[nodiscard]] int32_t get_first_local_child(int32_t node_id) const {
+        return m_first_children[node_id];
+    }
+
+    /**
+     * @param node_id A node in the local tree
+     * @return The next sibling of the given node in the local tree, or -1 if it has none
+     */
+    [[nodiscard]] int32_t get_next_local_sibling(int32_t node_id) const {
+        return m_next_siblings[node_id];
+    }
+
+    /**
+     * Sets the index of the column that stores the given node while building a plan.
+     * @param node_id
+     * @param column_index
+     */
+    void set_column_index(int32_t node_id, size_t column_index) {
+        m_column_indices[node_id] = column_index;
+    }
+
+    /**
+     * @param node_id
+     * @return The index set for the given node with `set_column_index` while building the current
+     * plan
+     */
+    [[nodiscard]] size_t get_column_index(int32_t node_id) const {
+        return m_column_indices[node_id];
+    }
+
+private:
+    // Methods
+    [[nodiscard]] bool is_in_local_tree(int32_t node_id) const {
+        return m_local_tree_epoch == m_node_epochs[node_id];
+    }
+
+    // Variables
+    std::shared_ptr<SchemaTree> m_schema_tree;
+    std::unordered_map<int32_t, SerializationPlan> m_plans;
+    std::vector<std::string> m_key_fragments;
+
+    // The local tree, indexed by node ID. A node is in the local tree iff its epoch is the current
+    // epoch, so that the local tree can be cleared without touching every node.
+    uint32_t m_local_tree_epoch{1};
+    std::vector<uint32_t> m_node_epochs;
+    std::vector<int32_t> m_first_children;
+    std::vector<int32_t> m_last_children;
+    std::vector<int32_t> m_next_siblings;
+    int32_t m_local_tree_root{-1};
+    std::vector<int32_t> m_path_buffer;
+
+    std::vector<size_t> m_column_indices;
+};
+}  // namespace clp_s
+
+#endif  // CLP_S_SERIALIZATIONPLANCACHE_HPP
@@ -91,6 +91,17 @@ public:
      */
     epochtime_t get_end_timestamp() const;
 
+    /**
+     * @return The number of bytes of memory held by the dictionary
+     */
+    [[nodiscard]] size_t get_memory_usage() const {
+        // Each entry is a map node holding the entry and a few pointers
+        constexpr size_t cNodeOverhead{4 * sizeof(void*)};
+        return (m_column_key_to_range.size() + m_column_id_to_range.size())
+                       * (sizeof(TimestampEntry) + cNodeOverhead)
+               + m_pattern_to_id.size() * (sizeof(pattern_to_id_t::value_type) + cNodeOverhead);
+    }
+
 private:
     /**
      * Merges timestamp ranges with the same key name
@@ -2,6 +2,7 @@
 
 #include <boost/filesystem.hpp>
 #include <spdlog/spdlog.h>
+#include <string_utils/WildcardMatcher.hpp>
 
 using std::string;
 using std::string_view;
@@ -184,6 +185,33 @@ bool StringUtils::has_unescaped_wildcards(std::string const& str) {
     return false;
 }
 
+bool StringUtils::is_prefix_query(string_view str, string& prefix) {
+    prefix.clear();
+    size_t i = 0;
+    for (; i < str.size(); ++i) {
+        auto const c = str[i];
+        if ('*' == c) {
+            break;
+        }
+        if ('?' == c) {
+            return false;
+        }
+        if ('\\' == c) {
+            ++i;
+            if (str.size() == i) {
+                // Ignore a dangling escape character
+                break;
+            }
+        }
+        prefix += str[i];
+    }
+    if (str.size() == i) {
+        // The string has no unescaped '*', so it isn't a prefix query
+        return false;
+    }
+    return string_view::npos == str.find_first_not_of('*', i);
+}
+
 string StringUtils::clean_up_wildcard_search_string(string_view str) {
     string cleaned_str;
 
@@ -269,13 +297,8 @@ bool StringUtils::wildcard_match_unsafe(
     if (case_sensitive_match) {
         return wildcard_match_unsafe_case_sensitive(tame, wild);
     } else {
-        // We convert to lowercase (rather than uppercase) anticipating that
-        // callers use lowercase more frequently, so little will need to change.
-        string lowercase_tame(tame);
-        to_lower(lowercase_tame);
-        string lowercase_wild(wild);
-        to_lower(lowercase_wild);
-        return wildcard_match_unsafe_case_sensitive(lowercase_tame, lowercase_wild);
+        // The matcher folds case as it compares, rather than lowercasing copies of both strings
+        return clp::string_utils::WildcardMatcher{wild, false}.matches(tame);
     }
 }
 
@@ -155,6 +155,15 @@ public:
      */
     static bool has_unescaped_wildcards(std::string const& str);
 
+    /**
+     * Checks if the given wildcard string matches exactly the strings that start with some literal
+     * prefix, i.e., if its only unescaped wildcards are one or more trailing '*'
+     * @param str
+     * @param prefix Returns the unescaped prefix
+     * @return true if the string is such a prefix query, false otherwise
+     */
+    static bool is_prefix_query(std::string_view str, std::string& prefix);
+
     /**
      * Same as ``wildcard_match_unsafe_case_sensitive`` except this method
      * allows the caller to specify whether the match should be case sensitive.
@@ -7,7 +7,7 @@ void VariableEncoder::encode_and_add_to_dictionary(
         std::string const& message,
         LogTypeDictionaryEntry& logtype_dict_entry,
         VariableDictionaryWriter& var_dict,
-        std::vector<int64_t>& encoded_vars
+        SpillableBuffer<int64_t>& encoded_vars
 ) {
     // Extract all variables and add to dictionary while building logtype
     size_t var_begin_pos = 0;
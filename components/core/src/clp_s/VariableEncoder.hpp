@@ -7,6 +7,7 @@
 
 #include <simdjson.h>
 
+#include "ColumnSpillFile.hpp"
 #include "DictionaryEntry.hpp"
 #include "DictionaryWriter.hpp"
 
@@ -16,7 +17,7 @@ namespace clp_s {
 class VariableEncoder {
 public:
     /**
-     * Encodes the given message and adds the encoded variables to the given vector
+     * Encodes the given message and adds the encoded variables to the given buffer
      * @param message
      * @param logtype_dict_entry
      * @param var_dict
@@ -26,7 +27,7 @@ public:
             std::string const& message,
             LogTypeDictionaryEntry& logtype_dict_entry,
             VariableDictionaryWriter& var_dict,
-            std::vector<int64_t>& encoded_vars
+            SpillableBuffer<int64_t>& encoded_vars
     );
 
     /**
@@ -62,6 +63,26 @@ public:
      */
     static int64_t encode_var_dict_id(uint64_t id) { return (int64_t)id + cVarDictIdRangeBegin; }
 
+    /**
+     * Checks if the given encoded variable is a variable dictionary id. Since encoded doubles can
+     * also fall in the range of variable dictionary ids, this is only meaningful for variables
+     * that weren't encoded as doubles.
+     * @param encoded_var
+     * @return true if encoded_var is a variable dictionary id, false otherwise
+     */
+    static bool is_var_dict_id(int64_t encoded_var) {
+        return (cVarDictIdRangeBegin <= encoded_var && encoded_var < cVarDictIdRangeEnd);
+    }
+
+    /**
+     * Decodes the given variable dictionary id
+     * @param encoded_var
+     * @return the decoded id
+     */
+    static uint64_t decode_var_dict_id(int64_t encoded_var) {
+        return encoded_var - cVarDictIdRangeBegin;
+    }
+
 private:
     static constexpr int64_t cVarDictIdRangeBegin = 1LL << 62;
     static constexpr int64_t cVarDictIdRangeEnd = (1ULL << 63) - 1;
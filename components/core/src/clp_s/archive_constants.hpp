@@ -16,6 +16,15 @@ constexpr char cArchiveLogDictFile[] = "/log.dict";
 constexpr char cArchiveTimestampDictFile[] = "/timestamp.dict";
 constexpr char cArchiveVarDictFile[] = "/var.dict";
 
+// Index files
+constexpr char cArchiveVarDictBloomFilterFile[] = "/var.bloom";
+
+// Optional index files
+constexpr char cArchiveDictionaryIndexFile[] = "/dictionary_index";
+
+// Temporary files, which are removed before the archive is closed
+constexpr char cArchiveSpillFile[] = "/spill";
+
 namespace results_cache::decompression {
 constexpr char cPath[]{"path"};
 constexpr char cOrigFileId[]{"orig_file_id"};
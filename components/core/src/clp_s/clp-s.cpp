@@ -2,9 +2,11 @@
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <json/single_include/nlohmann/json.hpp>
 #include <mongocxx/instance.hpp>
@@ -12,8 +14,10 @@
 #include <spdlog/spdlog.h>
 
 #include "../clp/GlobalMySQLMetadataDB.hpp"
+#include "../clp/Metrics.hpp"
 #include "../clp/streaming_archive/ArchiveMetadata.hpp"
 #include "../reducer/network_utils.hpp"
+#include "ArchiveRangeCache.hpp"
 #include "CommandLineArguments.hpp"
 #include "Defs.hpp"
 #include "JsonConstructor.hpp"
@@ -22,6 +26,7 @@
 #include "search/AddTimestampConditions.hpp"
 #include "search/ConvertToExists.hpp"
 #include "search/EmptyExpr.hpp"
+#include "search/EvaluateBloomFilter.hpp"
 #include "search/EvaluateTimestampIndex.hpp"
 #include "search/Expression.hpp"
 #include "search/kql/kql.hpp"
@@ -29,6 +34,7 @@
 #include "search/OrOfAndForm.hpp"
 #include "search/Output.hpp"
 #include "search/OutputHandler.hpp"
+#include "search/ResultLimiter.hpp"
 #include "search/SchemaMatch.hpp"
 #include "TimestampPattern.hpp"
 #include "TraceableException.hpp"
@@ -54,18 +60,44 @@ bool compress(CommandLineArguments const& command_line_arguments);
  */
 void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_option);
 
+/**
+ * Creates the output handler specified by the command line arguments.
+ * @param command_line_arguments
+ * @param reducer_socket_fd
+ * @return The output handler, or nullptr on failure
+ */
+std::unique_ptr<OutputHandler>
+create_output_handler(CommandLineArguments const& command_line_arguments, int reducer_socket_fd);
+
 /**
  * Searches the given archive.
  * @param command_line_arguments
  * @param archive_reader
  * @param expr A copy of the search AST which may be modified
  * @param reducer_socket_fd
+ * @param result_limiter The limiter shared by the searches of all archives, or nullptr if the
+ * number of results isn't limited
  * @return Whether the search succeeded
  */
 bool search_archive(
         CommandLineArguments const& command_line_arguments,
         std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
         std::shared_ptr<Expression> expr,
+        int reducer_socket_fd,
+        std::shared_ptr<ResultLimiter> const& result_limiter
+);
+
+/**
+ * Outputs the results kept by a limiter that orders results by timestamp, once every archive has
+ * been searched.
+ * @param command_line_arguments
+ * @param result_limiter
+ * @param reducer_socket_fd
+ * @return Whether the results were output successfully
+ */
+bool output_kept_results(
+        CommandLineArguments const& command_line_arguments,
+        ResultLimiter& result_limiter,
         int reducer_socket_fd
 );
 
@@ -88,11 +120,15 @@ bool compress(CommandLineArguments const& command_line_arguments) {
     option.file_paths = command_line_arguments.get_file_paths();
     option.archives_dir = archives_dir.string();
     option.target_encoded_size = command_line_arguments.get_target_encoded_size();
+    option.max_memory = command_line_arguments.get_max_memory();
+    option.spill_threshold = command_line_arguments.get_spill_threshold();
     option.max_document_size = command_line_arguments.get_max_document_size();
     option.compression_level = command_line_arguments.get_compression_level();
     option.timestamp_key = command_line_arguments.get_timestamp_key();
     option.print_archive_stats = command_line_arguments.print_archive_stats();
     option.structurize_arrays = command_line_arguments.get_structurize_arrays();
+    option.build_dictionary_index = command_line_arguments.get_build_dictionary_index();
+    option.sort_dictionaries = command_line_arguments.get_sort_dictionaries();
 
     auto const& db_config_container = command_line_arguments.get_metadata_db_config();
     if (db_config_container.has_value()) {
@@ -121,11 +157,70 @@ void decompress_archive(clp_s::JsonConstructorOption const& json_constructor_opt
     constructor.store();
 }
 
+std::unique_ptr<OutputHandler>
+create_output_handler(CommandLineArguments const& command_line_arguments, int reducer_socket_fd) {
+    std::unique_ptr<OutputHandler> output_handler;
+    try {
+        switch (command_line_arguments.get_output_handler_type()) {
+            case CommandLineArguments::OutputHandlerType::Network:
+                output_handler = std::make_unique<NetworkOutputHandler>(
+                        command_line_arguments.get_network_dest_host(),
+                        command_line_arguments.get_network_dest_port(),
+                        false,
+                        command_line_arguments.get_output_buffer_size(),
+                        command_line_arguments.do_async_output()
+                );
+                break;
+            case CommandLineArguments::OutputHandlerType::Reducer:
+                if (command_line_arguments.do_count_results_aggregation()) {
+                    output_handler = std::make_unique<CountOutputHandler>(reducer_socket_fd);
+                } else if (command_line_arguments.do_count_by_time_aggregation()) {
+                    output_handler = std::make_unique<CountByTimeOutputHandler>(
+                            reducer_socket_fd,
+                            command_line_arguments.get_count_by_time_bucket_size()
+                    );
+                } else if (command_line_arguments.do_group_by_aggregation()) {
+                    output_handler = std::make_unique<GroupByCountOutputHandler>(
+                            reducer_socket_fd,
+                            command_line_arguments.get_group_by_keys()
+                    );
+                } else {
+                    SPDLOG_ERROR("Unhandled aggregation type.");
+                    return nullptr;
+                }
+                break;
+            case CommandLineArguments::OutputHandlerType::ResultsCache:
+                output_handler = std::make_unique<ResultsCacheOutputHandler>(
+                        command_line_arguments.get_mongodb_uri(),
+                        command_line_arguments.get_mongodb_collection(),
+                        command_line_arguments.get_batch_size(),
+                        command_line_arguments.get_max_num_results()
+                );
+                break;
+            case CommandLineArguments::OutputHandlerType::Stdout:
+                output_handler = std::make_unique<StandardOutputHandler>(
+                        false,
+                        command_line_arguments.get_output_buffer_size(),
+                        command_line_arguments.do_async_output()
+                );
+                break;
+            default:
+                SPDLOG_ERROR("Unhandled OutputHandlerType.");
+                return nullptr;
+        }
+    } catch (clp_s::TraceableException& e) {
+        SPDLOG_ERROR("Failed to create output handler - {}", e.what());
+        return nullptr;
+    }
+    return output_handler;
+}
+
 bool search_archive(
         CommandLineArguments const& command_line_arguments,
         std::shared_ptr<clp_s::ArchiveReader> const& archive_reader,
         std::shared_ptr<Expression> expr,
-        int reducer_socket_fd
+        int reducer_socket_fd,
+        std::shared_ptr<ResultLimiter> const& result_limiter
 ) {
     auto const& query = command_line_arguments.get_query();
 
@@ -179,45 +274,27 @@ bool search_archive(
         return true;
     }
 
-    std::unique_ptr<OutputHandler> output_handler;
-    try {
-        switch (command_line_arguments.get_output_handler_type()) {
-            case CommandLineArguments::OutputHandlerType::Network:
-                output_handler = std::make_unique<NetworkOutputHandler>(
-                        command_line_arguments.get_network_dest_host(),
-                        command_line_arguments.get_network_dest_port()
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Reducer:
-                if (command_line_arguments.do_count_results_aggregation()) {
-                    output_handler = std::make_unique<CountOutputHandler>(reducer_socket_fd);
-                } else if (command_line_arguments.do_count_by_time_aggregation()) {
-                    output_handler = std::make_unique<CountByTimeOutputHandler>(
-                            reducer_socket_fd,
-                            command_line_arguments.get_count_by_time_bucket_size()
-                    );
-                } else {
-                    SPDLOG_ERROR("Unhandled aggregation type.");
-                    return false;
-                }
-                break;
-            case CommandLineArguments::OutputHandlerType::ResultsCache:
-                output_handler = std::make_unique<ResultsCacheOutputHandler>(
-                        command_line_arguments.get_mongodb_uri(),
-                        command_line_arguments.get_mongodb_collection(),
-                        command_line_arguments.get_batch_size(),
-                        command_line_arguments.get_max_num_results()
-                );
-                break;
-            case CommandLineArguments::OutputHandlerType::Stdout:
-                output_handler = std::make_unique<StandardOutputHandler>();
-                break;
-            default:
-                SPDLOG_ERROR("Unhandled OutputHandlerType.");
-                return false;
+    // skip reading the archive's dictionaries if we won't match based on the variable dictionary
+    // filter
+    if (false == command_line_arguments.get_ignore_case()) {
+        try {
+            if (auto const filter = archive_reader->read_var_dict_bloom_filter();
+                filter.has_value()
+                && clp_s::EvaluatedValue::False == EvaluateBloomFilter(filter.value()).run(expr))
+            {
+                SPDLOG_INFO("No matching variable dictionary values for query '{}'", query);
+                return true;
+            }
+        } catch (clp::TraceableException& e) {
+            SPDLOG_WARN("Failed to read variable dictionary filter - {}", e.what());
+        } catch (clp_s::TraceableException& e) {
+            // E.g., the filter couldn't be fetched from a remote archive
+            SPDLOG_WARN("Failed to read variable dictionary filter - {}", e.what());
         }
-    } catch (clp_s::TraceableException& e) {
-        SPDLOG_ERROR("Failed to create output handler - {}", e.what());
+    }
+
+    auto output_handler = create_output_handler(command_line_arguments, reducer_socket_fd);
+    if (nullptr == output_handler) {
         return false;
     }
 
@@ -228,10 +305,48 @@ bool search_archive(
             archive_reader,
             timestamp_dict,
             std::move(output_handler),
-            command_line_arguments.get_ignore_case()
+            command_line_arguments.get_ignore_case(),
+            result_limiter
     );
     return output.filter();
 }
+
+bool output_kept_results(
+        CommandLineArguments const& command_line_arguments,
+        ResultLimiter& result_limiter,
+        int reducer_socket_fd
+) {
+    auto output_handler = create_output_handler(command_line_arguments, reducer_socket_fd);
+    if (nullptr == output_handler) {
+        return false;
+    }
+
+    for (auto const& result : result_limiter.release_kept_results()) {
+        clp::Metrics::ScopedTimer const output_timer{clp::Metrics::Stage::Output};
+        clp::Metrics::increment(clp::Metrics::Counter::NumMessagesOutput);
+        if (output_handler->should_output_metadata()) {
+            output_handler->write(result.message, result.timestamp, result.archive_id);
+        } else {
+            output_handler->write(result.message);
+        }
+    }
+
+    if (auto const ecode = output_handler->flush(); clp_s::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to flush output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    if (auto const ecode = output_handler->finish(); clp_s::ErrorCodeSuccess != ecode) {
+        SPDLOG_ERROR(
+                "Failed to flush output handler, error={}.",
+                clp::enum_to_underlying_type(ecode)
+        );
+        return false;
+    }
+    return true;
+}
 }  // namespace
 
 int main(int argc, char const* argv[]) {
@@ -259,6 +374,15 @@ int main(int argc, char const* argv[]) {
             break;
     }
 
+    std::optional<clp::Metrics::Exporter> metrics_exporter;
+    if (false == command_line_arguments.get_metrics_file_path().empty()) {
+        metrics_exporter.emplace(
+                command_line_arguments.get_program_name(),
+                command_line_arguments.get_metrics_file_path(),
+                command_line_arguments.get_metrics_interval()
+        );
+    }
+
     if (CommandLineArguments::Command::Compress == command_line_arguments.get_command()) {
         if (false == compress(command_line_arguments)) {
             return 1;
@@ -285,6 +409,22 @@ int main(int argc, char const* argv[]) {
             if (false == archive_id.empty()) {
                 option.archive_id = archive_id;
                 decompress_archive(option);
+            } else if (command_line_arguments.get_num_decompression_threads() > 1) {
+                std::vector<std::string> archive_ids;
+                for (auto const& entry : std::filesystem::directory_iterator(archives_dir)) {
+                    if (entry.is_directory()) {
+                        archive_ids.emplace_back(entry.path().filename());
+                    }
+                }
+                if (false
+                    == clp_s::decompress_archives_concurrently(
+                            option,
+                            archive_ids,
+                            command_line_arguments.get_num_decompression_threads()
+                    ))
+                {
+                    return 1;
+                }
             } else {
                 for (auto const& entry : std::filesystem::directory_iterator(archives_dir)) {
                     if (false == entry.is_directory()) {
@@ -314,7 +454,9 @@ int main(int argc, char const* argv[]) {
         }
 
         auto const& archives_dir = command_line_arguments.get_archives_dir();
-        if (false == std::filesystem::is_directory(archives_dir)) {
+        if (false == clp_s::ArchiveRangeCache::is_remote_path(archives_dir)
+            && false == std::filesystem::is_directory(archives_dir))
+        {
             SPDLOG_ERROR("'{}' is not a directory.", archives_dir);
             return 1;
         }
@@ -334,18 +476,47 @@ int main(int argc, char const* argv[]) {
             }
         }
 
+        std::shared_ptr<ResultLimiter> result_limiter;
+        if (CommandLineArguments::OutputHandlerType::ResultsCache
+            == command_line_arguments.get_output_handler_type())
+        {
+            // The results cache only keeps the latest results, so only they need to be found
+            result_limiter = std::make_shared<ResultLimiter>(
+                    command_line_arguments.get_max_num_results(),
+                    true
+            );
+        } else if (0 != command_line_arguments.get_result_limit()) {
+            result_limiter = std::make_shared<ResultLimiter>(
+                    command_line_arguments.get_result_limit(),
+                    command_line_arguments.get_order_by_timestamp_desc()
+            );
+        }
+
         auto const& archive_id = command_line_arguments.get_archive_id();
         auto archive_reader = std::make_shared<clp_s::ArchiveReader>();
         if (false == archive_id.empty()) {
-            archive_reader->open(archives_dir, archive_id);
+            archive_reader->open(
+                    archives_dir,
+                    archive_id,
+                    command_line_arguments.get_archive_cache_dir()
+            );
             if (false
-                == search_archive(command_line_arguments, archive_reader, expr, reducer_socket_fd))
+                == search_archive(
+                        command_line_arguments,
+                        archive_reader,
+                        expr,
+                        reducer_socket_fd,
+                        result_limiter
+                ))
             {
                 return 1;
             }
             archive_reader->close();
         } else {
             for (auto const& entry : std::filesystem::directory_iterator(archives_dir)) {
+                if (nullptr != result_limiter && result_limiter->is_satisfied()) {
+                    break;
+                }
                 if (false == entry.is_directory()) {
                     // Skip non-directories
                     continue;
@@ -358,7 +529,8 @@ int main(int argc, char const* argv[]) {
                             command_line_arguments,
                             archive_reader,
                             expr->copy(),
-                            reducer_socket_fd
+                            reducer_socket_fd,
+                            result_limiter
                     ))
                 {
                     return 1;
@@ -366,6 +538,17 @@ int main(int argc, char const* argv[]) {
                 archive_reader->close();
             }
         }
+
+        if (nullptr != result_limiter && result_limiter->is_ordered_by_timestamp_desc()
+            && false
+                       == output_kept_results(
+                               command_line_arguments,
+                               *result_limiter,
+                               reducer_socket_fd
+                       ))
+        {
+            return 1;
+        }
     }
 
     return 0;
@@ -0,0 +1,75 @@
+#include "ArrayTape.hpp"
+
+namespace clp_s::search {
+void ArrayTape::parse(simdjson::ondemand::parser& parser, std::string& json) {
+    m_entries.clear();
+    m_strings.clear();
+
+    if (json.capacity() < (json.size() + simdjson::SIMDJSON_PADDING)) {
+        json.reserve(json.size() + simdjson::SIMDJSON_PADDING);
+    }
+    // NOTE: simdjson doesn't support documents larger than 4 GiB, so every offset into the string
+    // buffer and every entry index fits in 32 bits.
+    auto doc = parser.iterate(json);
+    append_array(doc.get_array());
+}
+
+void ArrayTape::append_value(simdjson::ondemand::value value) {
+    switch (value.type()) {
+        case simdjson::ondemand::json_type::object: {
+            auto const object_ix = m_entries.size();
+            m_entries.emplace_back().type = EntryType::Object;
+            for (auto field : value.get_object()) {
+                append_string(EntryType::Key, field.escaped_key());
+                append_value(field.value());
+            }
+            m_entries[object_ix].end_ix = static_cast<uint32_t>(m_entries.size());
+        } break;
+        case simdjson::ondemand::json_type::array:
+            append_array(value.get_array());
+            break;
+        case simdjson::ondemand::json_type::string:
+            append_string(EntryType::String, value.get_string());
+            break;
+        case simdjson::ondemand::json_type::number: {
+            simdjson::ondemand::number number = value.get_number();
+            auto& entry = m_entries.emplace_back();
+            if (number.is_double()) {
+                entry.type = EntryType::Double;
+                entry.double_value = number.get_double();
+            } else if (number.is_uint64()) {
+                entry.type = EntryType::UInt64;
+                entry.uint64_value = number.get_uint64();
+            } else {
+                entry.type = EntryType::Int64;
+                entry.int64_value = number.get_int64();
+            }
+        } break;
+        case simdjson::ondemand::json_type::boolean: {
+            auto& entry = m_entries.emplace_back();
+            entry.type = EntryType::Boolean;
+            entry.bool_value = value.get_bool();
+        } break;
+        case simdjson::ondemand::json_type::null:
+            m_entries.emplace_back().type = EntryType::Null;
+            break;
+    }
+}
+
+void ArrayTape::append_array(simdjson::ondemand::array array) {
+    auto const array_ix = m_entries.size();
+    m_entries.emplace_back().type = EntryType::Array;
+    for (simdjson::ondemand::value item : array) {
+        append_value(item);
+    }
+    m_entries[array_ix].end_ix = static_cast<uint32_t>(m_entries.size());
+}
+
+void ArrayTape::append_string(EntryType type, std::string_view str) {
+    auto& entry = m_entries.emplace_back();
+    entry.type = type;
+    entry.string.offset = static_cast<uint32_t>(m_strings.size());
+    entry.string.length = static_cast<uint32_t>(str.size());
+    m_strings.append(str);
+}
+}  // namespace clp_s::search
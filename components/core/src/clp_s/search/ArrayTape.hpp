@@ -0,0 +1,134 @@
+#ifndef CLP_S_SEARCH_ARRAYTAPE_HPP
+#define CLP_S_SEARCH_ARRAYTAPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <simdjson.h>
+
+namespace clp_s::search {
+/**
+ * A pre-parsed, typed representation of an unstructured array that can be traversed without any
+ * JSON parsing.
+ *
+ * The array is flattened into a tape of fixed-size entries in document order. Every container
+ * entry (array or object) records the index of the entry after its last descendant, so a subtree
+ * can be skipped in constant time. An object's members are stored as a key entry immediately
+ * followed by the member's value. Strings and keys are stored as offsets into a single string
+ * buffer; keys are stored exactly as they appear in the JSON (i.e., still escaped), whereas string
+ * values are unescaped.
+ *
+ * Since an array is parsed into a tape once per record, every filter in a query that searches the
+ * same array (including wildcard filters) can traverse the tape instead of re-parsing the array's
+ * JSON. A tape is only worth building when several filters share it, since a single filter can
+ * stop parsing the JSON as soon as it finds a match.
+ */
+class ArrayTape {
+public:
+    // Types
+    enum class EntryType : uint8_t {
+        Array,
+        Object,
+        Key,
+        String,
+        Int64,
+        UInt64,
+        Double,
+        Boolean,
+        Null
+    };
+
+    // Methods
+    /**
+     * Parses the given JSON array into this tape, replacing any existing content.
+     * @param parser
+     * @param json The JSON array. Its capacity may be increased to satisfy simdjson's padding
+     * requirement.
+     * @throw simdjson::simdjson_error if the JSON isn't a valid array
+     */
+    void parse(simdjson::ondemand::parser& parser, std::string& json);
+
+    /**
+     * @return The index of the root array's entry.
+     */
+    static size_t get_root() { return 0; }
+
+    [[nodiscard]] EntryType get_type(size_t ix) const { return m_entries[ix].type; }
+
+    /**
+     * @param ix
+     * @return The index of the entry after the given entry and all of its descendants.
+     */
+    [[nodiscard]] size_t get_next(size_t ix) const {
+        auto const& entry = m_entries[ix];
+        if (EntryType::Array == entry.type || EntryType::Object == entry.type) {
+            return entry.end_ix;
+        }
+        return ix + 1;
+    }
+
+    /**
+     * @param ix The index of a string or key entry.
+     * @return The string.
+     */
+    [[nodiscard]] std::string_view get_string(size_t ix) const {
+        auto const& entry = m_entries[ix];
+        return {m_strings.data() + entry.string.offset, entry.string.length};
+    }
+
+    [[nodiscard]] int64_t get_int64(size_t ix) const { return m_entries[ix].int64_value; }
+
+    [[nodiscard]] uint64_t get_uint64(size_t ix) const { return m_entries[ix].uint64_value; }
+
+    [[nodiscard]] double get_double(size_t ix) const { return m_entries[ix].double_value; }
+
+    [[nodiscard]] bool get_bool(size_t ix) const { return m_entries[ix].bool_value; }
+
+private:
+    // Types
+    struct Entry {
+        EntryType type;
+        // Only used by containers
+        uint32_t end_ix;
+        union {
+            struct {
+                uint32_t offset;
+                uint32_t length;
+            } string;
+
+            int64_t int64_value;
+            uint64_t uint64_value;
+            double double_value;
+            bool bool_value;
+        };
+    };
+
+    // Methods
+    /**
+     * Appends the given value (and its descendants) to the tape.
+     * @param value
+     */
+    void append_value(simdjson::ondemand::value value);
+
+    /**
+     * Appends the given array (and its descendants) to the tape.
+     * @param array
+     */
+    void append_array(simdjson::ondemand::array array);
+
+    /**
+     * Appends a string or key entry to the tape.
+     * @param type
+     * @param str
+     */
+    void append_string(EntryType type, std::string_view str);
+
+    std::vector<Entry> m_entries;
+    std::string m_strings;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_ARRAYTAPE_HPP
@@ -0,0 +1,161 @@
+#include "BufferedOutputWriter.hpp"
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../ErrorCode.hpp"
+
+namespace clp_s::search {
+BufferedOutputWriter::BufferedOutputWriter(int fd, size_t buffer_size, bool use_background_thread)
+        : m_fd{fd},
+          m_buffer_size{std::max<size_t>(buffer_size, 1)},
+          m_use_background_thread{use_background_thread} {
+    m_buffer.reserve(m_buffer_size);
+}
+
+BufferedOutputWriter::~BufferedOutputWriter() {
+    finish();
+}
+
+ErrorCode BufferedOutputWriter::flush() {
+    if (false == m_buffer.empty()) {
+        submit_buffer();
+    }
+
+    std::unique_lock lock{m_mutex};
+    m_buffers_written_cv.wait(lock, [&] {
+        return m_submitted_buffers.empty() && false == m_is_writing;
+    });
+    return m_error;
+}
+
+ErrorCode BufferedOutputWriter::finish() {
+    if (m_finished) {
+        return get_error();
+    }
+    auto const error = flush();
+    m_finished = true;
+
+    if (m_writer_thread.joinable()) {
+        {
+            std::lock_guard const lock{m_mutex};
+            m_stop_requested = true;
+        }
+        m_buffers_submitted_cv.notify_one();
+        m_writer_thread.join();
+    }
+    return error;
+}
+
+void BufferedOutputWriter::submit_buffer() {
+    if (false == m_use_background_thread) {
+        std::vector<std::string> buffers(1);
+        buffers.front().swap(m_buffer);
+        std::lock_guard const lock{m_mutex};
+        if (ErrorCodeSuccess == m_error) {
+            m_error = write_buffers(buffers);
+        }
+        // Reuse the buffer's allocation
+        m_buffer.swap(buffers.front());
+        m_buffer.clear();
+        return;
+    }
+
+    if (false == m_writer_thread.joinable()) {
+        m_writer_thread = std::thread{&BufferedOutputWriter::background_writer_loop, this};
+    }
+
+    std::string next_buffer;
+    {
+        std::unique_lock lock{m_mutex};
+        m_buffers_written_cv.wait(lock, [&] {
+            return m_submitted_buffers.size() < cMaxNumInFlightBuffers;
+        });
+        m_submitted_buffers.emplace_back(std::move(m_buffer));
+        if (false == m_free_buffers.empty()) {
+            next_buffer = std::move(m_free_buffers.back());
+            m_free_buffers.pop_back();
+        }
+    }
+    m_buffers_submitted_cv.notify_one();
+
+    m_buffer = std::move(next_buffer);
+    m_buffer.clear();
+    m_buffer.reserve(m_buffer_size);
+}
+
+ErrorCode BufferedOutputWriter::write_buffers(std::vector<std::string> const& buffers) {
+    std::vector<iovec> iovecs;
+    iovecs.reserve(buffers.size());
+    for (auto const& buffer : buffers) {
+        if (false == buffer.empty()) {
+            iovecs.push_back({const_cast<char*>(buffer.data()), buffer.size()});
+        }
+    }
+
+    auto* cur = iovecs.data();
+    auto* const end = iovecs.data() + iovecs.size();
+    while (cur != end) {
+        auto num_bytes_written = writev(m_fd, cur, static_cast<int>(end - cur));
+        if (-1 == num_bytes_written) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return ErrorCodeErrno;
+        }
+
+        // Skip the fully written buffers and advance into the partially written one, if any
+        auto num_bytes_remaining = static_cast<size_t>(num_bytes_written);
+        while (cur != end && num_bytes_remaining >= cur->iov_len) {
+            num_bytes_remaining -= cur->iov_len;
+            ++cur;
+        }
+        if (cur != end) {
+            cur->iov_base = static_cast<char*>(cur->iov_base) + num_bytes_remaining;
+            cur->iov_len -= num_bytes_remaining;
+        }
+    }
+    return ErrorCodeSuccess;
+}
+
+void BufferedOutputWriter::background_writer_loop() {
+    std::vector<std::string> buffers;
+    std::unique_lock lock{m_mutex};
+    while (true) {
+        m_buffers_submitted_cv.wait(lock, [&] {
+            return false == m_submitted_buffers.empty() || m_stop_requested;
+        });
+        if (m_submitted_buffers.empty()) {
+            break;
+        }
+
+        buffers.swap(m_submitted_buffers);
+        m_is_writing = true;
+        auto const previous_error = m_error;
+        lock.unlock();
+
+        // Once a write has failed, discard any subsequent data so that producers don't block
+        auto error = previous_error;
+        if (ErrorCodeSuccess == error) {
+            error = write_buffers(buffers);
+        }
+
+        lock.lock();
+        m_error = error;
+        m_is_writing = false;
+        for (auto& buffer : buffers) {
+            buffer.clear();
+            m_free_buffers.emplace_back(std::move(buffer));
+        }
+        buffers.clear();
+        m_buffers_written_cv.notify_all();
+    }
+}
+}  // namespace clp_s::search
@@ -0,0 +1,127 @@
+#ifndef CLP_S_SEARCH_BUFFEREDOUTPUTWRITER_HPP
+#define CLP_S_SEARCH_BUFFEREDOUTPUTWRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../ErrorCode.hpp"
+
+namespace clp_s::search {
+/**
+ * A buffered writer to a file descriptor (e.g., stdout or a socket) for search results.
+ *
+ * Results are appended to a large, reusable buffer. Once the buffer is full, it's submitted to be
+ * written to the file descriptor, either synchronously or, if enabled, by a background writer
+ * thread that writes every buffer submitted since its last write using a single `writev` call. In
+ * the background mode, the number of in-flight buffers is bounded so that memory usage stays
+ * bounded when the destination is slower than the search.
+ *
+ * Write errors are sticky: once a write fails, all subsequent data is discarded and the error is
+ * returned by `get_error`, `flush`, and `finish`.
+ */
+class BufferedOutputWriter {
+public:
+    // Constants
+    static constexpr size_t cDefaultBufferSize{1024 * 1024};
+    static constexpr size_t cMaxNumInFlightBuffers{4};
+
+    // Constructors
+    /**
+     * @param fd The file descriptor to write to. The writer doesn't take ownership of it.
+     * @param buffer_size The size of each buffer before it's submitted to be written.
+     * @param use_background_thread Whether to write buffers using a background thread.
+     */
+    BufferedOutputWriter(int fd, size_t buffer_size, bool use_background_thread);
+
+    // Delete copy & move constructors and assignment operators
+    BufferedOutputWriter(BufferedOutputWriter const&) = delete;
+    BufferedOutputWriter(BufferedOutputWriter&&) = delete;
+    BufferedOutputWriter& operator=(BufferedOutputWriter const&) = delete;
+    BufferedOutputWriter& operator=(BufferedOutputWriter&&) = delete;
+
+    // Destructor
+    ~BufferedOutputWriter();
+
+    // Methods
+    /**
+     * Appends data to the current buffer, submitting the buffer to be written if it's full.
+     * @param data
+     * @param size
+     */
+    void write(char const* data, size_t size) {
+        m_buffer.append(data, size);
+        if (m_buffer.size() >= m_buffer_size) {
+            submit_buffer();
+        }
+    }
+
+    void write(std::string_view data) { write(data.data(), data.size()); }
+
+    /**
+     * Writes all buffered data to the file descriptor, waiting for any in-flight writes to
+     * complete.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeErrno if any write (including a previous one) failed
+     */
+    ErrorCode flush();
+
+    /**
+     * Flushes all buffered data and stops the background writer thread, if any. The writer may not
+     * be written to after this method is called. Calling this method more than once is a no-op.
+     * @return Same as `flush`
+     */
+    ErrorCode finish();
+
+    /**
+     * @return The error of the first failed write, or ErrorCodeSuccess if no write has failed.
+     */
+    [[nodiscard]] ErrorCode get_error() const {
+        std::lock_guard const lock{m_mutex};
+        return m_error;
+    }
+
+private:
+    // Methods
+    /**
+     * Submits the current buffer to be written and replaces it with an empty buffer.
+     */
+    void submit_buffer();
+
+    /**
+     * Writes the given buffers to the file descriptor, retrying partial writes.
+     * @param buffers
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeErrno on failure
+     */
+    ErrorCode write_buffers(std::vector<std::string> const& buffers);
+
+    /**
+     * Writes submitted buffers until the writer is finished.
+     */
+    void background_writer_loop();
+
+    int m_fd;
+    size_t m_buffer_size;
+    bool m_use_background_thread;
+    bool m_finished{false};
+    std::string m_buffer;
+
+    // State shared with the background writer thread
+    mutable std::mutex m_mutex;
+    std::condition_variable m_buffers_submitted_cv;
+    std::condition_variable m_buffers_written_cv;
+    std::vector<std::string> m_submitted_buffers;
+    std::vector<std::string> m_free_buffers;
+    bool m_is_writing{false};
+    bool m_stop_requested{false};
+    ErrorCode m_error{ErrorCodeSuccess};
+    std::thread m_writer_thread;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_BUFFEREDOUTPUTWRITER_HPP
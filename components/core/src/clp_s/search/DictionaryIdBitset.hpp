@@ -0,0 +1,140 @@
+#ifndef CLP_S_SEARCH_DICTIONARYIDBITSET_HPP
+#define CLP_S_SEARCH_DICTIONARYIDBITSET_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace clp_s::search {
+/**
+ * A dense bitset over dictionary IDs. Since dictionary IDs are dense integers starting at 0, this
+ * allows testing whether a record's dictionary ID is in a set of matching IDs with a single bit
+ * probe rather than a hash lookup. The bitset grows as IDs are added, so its size is bounded by the
+ * largest ID added.
+ */
+class DictionaryIdBitset {
+public:
+    // Constructors
+    DictionaryIdBitset() = default;
+
+    /**
+     * @param num_ids The number of IDs to reserve space for.
+     */
+    explicit DictionaryIdBitset(size_t num_ids) { m_words.reserve(get_num_words(num_ids)); }
+
+    // Methods
+    /**
+     * Adds the given ID to the set.
+     * @param id
+     */
+    void set(uint64_t id) {
+        auto const word_ix = id / cNumBitsPerWord;
+        if (word_ix >= m_words.size()) {
+            m_words.resize(word_ix + 1, 0);
+        }
+        auto const mask = uint64_t{1} << (id % cNumBitsPerWord);
+        if (0 == (m_words[word_ix] & mask)) {
+            m_words[word_ix] |= mask;
+            ++m_num_ids;
+        }
+    }
+
+    /**
+     * Adds the IDs in the given half-open range to the set, a word at a time.
+     * @param begin_id
+     * @param end_id
+     */
+    void set_range(uint64_t begin_id, uint64_t end_id) {
+        if (begin_id >= end_id) {
+            return;
+        }
+        auto const last_word_ix = (end_id - 1) / cNumBitsPerWord;
+        if (last_word_ix >= m_words.size()) {
+            m_words.resize(last_word_ix + 1, 0);
+        }
+        for (auto word_ix = begin_id / cNumBitsPerWord; word_ix <= last_word_ix; ++word_ix) {
+            auto const word_begin_id = word_ix * cNumBitsPerWord;
+            auto mask = ~uint64_t{0};
+            if (begin_id > word_begin_id) {
+                mask &= ~uint64_t{0} << (begin_id - word_begin_id);
+            }
+            if (end_id < word_begin_id + cNumBitsPerWord) {
+                mask &= ~(~uint64_t{0} << (end_id - word_begin_id));
+            }
+            m_num_ids -= static_cast<size_t>(std::popcount(m_words[word_ix]));
+            m_words[word_ix] |= mask;
+            m_num_ids += static_cast<size_t>(std::popcount(m_words[word_ix]));
+        }
+    }
+
+    /**
+     * @param id
+     * @return Whether the given ID is in the set. Negative IDs are never in the set.
+     */
+    [[nodiscard]] bool test(int64_t id) const {
+        auto const unsigned_id = static_cast<uint64_t>(id);
+        auto const word_ix = unsigned_id / cNumBitsPerWord;
+        if (word_ix >= m_words.size()) {
+            return false;
+        }
+        return 0 != (m_words[word_ix] & (uint64_t{1} << (unsigned_id % cNumBitsPerWord)));
+    }
+
+    /**
+     * Adds every ID in the given set to this set.
+     * @param other
+     */
+    void merge(DictionaryIdBitset const& other) {
+        if (other.m_words.size() > m_words.size()) {
+            m_words.resize(other.m_words.size(), 0);
+        }
+        m_num_ids = 0;
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            if (i < other.m_words.size()) {
+                m_words[i] |= other.m_words[i];
+            }
+            m_num_ids += static_cast<size_t>(std::popcount(m_words[i]));
+        }
+    }
+
+    [[nodiscard]] bool empty() const { return 0 == m_num_ids; }
+
+    [[nodiscard]] size_t size() const { return m_num_ids; }
+
+    /**
+     * @return The IDs in the set, in ascending order.
+     */
+    [[nodiscard]] std::vector<uint64_t> get_ids() const {
+        std::vector<uint64_t> ids;
+        ids.reserve(m_num_ids);
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            for (auto word = m_words[i]; 0 != word; word &= word - 1) {
+                ids.push_back(i * cNumBitsPerWord + std::countr_zero(word));
+            }
+        }
+        return ids;
+    }
+
+    /**
+     * @return The bitset's words, where bit `i % 64` of word `i / 64` is set if ID `i` is in the
+     * set. This allows evaluating a batch of IDs without going through `test`.
+     */
+    [[nodiscard]] std::span<uint64_t const> get_words() const { return m_words; }
+
+private:
+    // Constants
+    static constexpr uint64_t cNumBitsPerWord{64};
+
+    // Methods
+    static constexpr size_t get_num_words(size_t num_ids) {
+        return (num_ids + cNumBitsPerWord - 1) / cNumBitsPerWord;
+    }
+
+    std::vector<uint64_t> m_words;
+    size_t m_num_ids{0};
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_DICTIONARYIDBITSET_HPP
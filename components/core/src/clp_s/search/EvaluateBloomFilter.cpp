@@ -0,0 +1,77 @@
+#include "EvaluateBloomFilter.hpp"
+
+#include <string>
+
+#include "AndExpr.hpp"
+#include "FilterExpr.hpp"
+#include "OrExpr.hpp"
+
+namespace clp_s::search {
+namespace {
+/**
+ * @param str
+ * @return The given string with its escape characters removed
+ */
+std::string unescape(std::string const& str) {
+    std::string unescaped_str;
+    bool escape = false;
+    for (char const c : str) {
+        if (escape) {
+            unescaped_str.push_back(c);
+            escape = false;
+        } else if ('\\' == c) {
+            escape = true;
+        } else {
+            unescaped_str.push_back(c);
+        }
+    }
+    return unescaped_str;
+}
+}  // namespace
+
+EvaluatedValue EvaluateBloomFilter::run(std::shared_ptr<Expression> const& expr) {
+    if (std::dynamic_pointer_cast<OrExpr>(expr)) {
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            if (run(sub_expr) != EvaluatedValue::False) {
+                return EvaluatedValue::Unknown;
+            }
+        }
+        // must have been all false
+        return expr->is_inverted() ? EvaluatedValue::Unknown : EvaluatedValue::False;
+    } else if (std::dynamic_pointer_cast<AndExpr>(expr)) {
+        if (expr->is_inverted()) {
+            return EvaluatedValue::Unknown;
+        }
+        for (auto it = expr->op_begin(); it != expr->op_end(); it++) {
+            auto sub_expr = std::static_pointer_cast<Expression>(*it);
+            if (run(sub_expr) == EvaluatedValue::False) {
+                return EvaluatedValue::False;
+            }
+        }
+        return EvaluatedValue::Unknown;
+    } else if (auto filter = std::dynamic_pointer_cast<FilterExpr>(expr)) {
+        auto column = filter->get_column();
+        // Wildcard columns are skipped since their types are only resolved per schema during
+        // search
+        if (filter->is_inverted() || FilterOperation::EQ != filter->get_operation()
+            || column->is_pure_wildcard() || false == column->matches_exactly(VarStringT))
+        {
+            return EvaluatedValue::Unknown;
+        }
+
+        std::string query_string;
+        if (false == filter->get_operand()->as_var_string(query_string, FilterOperation::EQ)
+            || StringUtils::has_unescaped_wildcards(query_string))
+        {
+            return EvaluatedValue::Unknown;
+        }
+        if (false == m_var_dict_filter.possibly_contains(unescape(query_string))) {
+            return EvaluatedValue::False;
+        }
+        return EvaluatedValue::Unknown;
+    } else {
+        return EvaluatedValue::Unknown;
+    }
+}
+}  // namespace clp_s::search
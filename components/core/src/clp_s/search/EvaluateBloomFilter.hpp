@@ -0,0 +1,36 @@
+#ifndef CLP_S_SEARCH_EVALUATEBLOOMFILTER_HPP
+#define CLP_S_SEARCH_EVALUATEBLOOMFILTER_HPP
+
+#include <memory>
+
+#include "../../clp/BloomFilter.hpp"
+#include "../Utils.hpp"
+#include "Expression.hpp"
+
+namespace clp_s::search {
+class EvaluateBloomFilter {
+public:
+    // Constructors
+    explicit EvaluateBloomFilter(clp::BloomFilter const& var_dict_filter)
+            : m_var_dict_filter(var_dict_filter) {}
+
+    /**
+     * Takes an expression and attempts to prove that it can't match any record in an archive,
+     * based on a Bloom filter over the archive's variable dictionary. Only exact string filters on
+     * columns that can only contain variable strings are evaluated, since any such matching value
+     * must be in the variable dictionary. Currently doesn't do any constant propagation.
+     *
+     * Should only be run after schema matching. The filter is case-sensitive, so this shouldn't be
+     * run for case-insensitive searches.
+     *
+     * @param expr the expression to evaluate against the filter
+     * @return The evaluated value of the expression given the filter (False or Unknown)
+     */
+    EvaluatedValue run(std::shared_ptr<Expression> const& expr);
+
+private:
+    clp::BloomFilter const& m_var_dict_filter;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_EVALUATEBLOOMFILTER_HPP
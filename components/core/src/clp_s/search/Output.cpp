@@ -1,8 +1,10 @@
 #include "Output.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
+#include "../../clp/Metrics.hpp"
 #include "../../clp/type_utils.hpp"
 #include "../Utils.hpp"
 #include "AndExpr.hpp"
@@ -37,6 +39,10 @@ bool Output::filter() {
         }
     }
 
+    if (nullptr != m_result_limiter) {
+        order_and_prune_tables_for_limit(matched_schemas);
+    }
+
     // Skip decompressing archive if it contains no
     // relevant schemas
     if (matched_schemas.empty()) {
@@ -63,10 +69,25 @@ bool Output::filter() {
     }
 
     populate_string_queries(top_level_expr);
+    read_dictionary_index();
 
     std::string message;
     auto const archive_id = m_archive_reader->get_archive_id();
+    bool const should_keep_latest_results
+            = nullptr != m_result_limiter && m_result_limiter->is_ordered_by_timestamp_desc();
     for (int32_t schema_id : matched_schemas) {
+        // Results found in earlier tables or archives may make the remaining tables unnecessary.
+        // Since the tables are ordered by their latest timestamp when the limiter orders results by
+        // timestamp, no remaining table can contain a result that would be output either.
+        if (nullptr != m_result_limiter
+            && false
+                       == m_result_limiter->may_contain_output_result(
+                               m_archive_reader->get_table_metadata(schema_id).end_timestamp
+                       ))
+        {
+            break;
+        }
+
         m_expr_clp_query.clear();
         m_expr_var_match_map.clear();
         m_expr = m_match.get_query_for_schema(schema_id)->copy();
@@ -84,21 +105,49 @@ bool Output::filter() {
 
         add_wildcard_columns_to_searched_columns();
 
+        m_num_unstructured_array_filters.clear();
+        count_unstructured_array_filters(m_expr);
+
         auto& reader = m_archive_reader->read_table(
                 schema_id,
-                m_output_handler->should_output_metadata(),
-                m_should_marshal_records
+                should_keep_latest_results || m_output_handler->should_output_metadata(),
+                should_keep_latest_results || m_should_marshal_records
         );
         reader.initialize_filter(this);
 
-        if (m_output_handler->should_output_metadata()) {
+        if (should_keep_latest_results) {
+            // Only marshal the results that the limiter would keep
+            auto const would_keep = [&](epochtime_t timestamp) {
+                return m_result_limiter->would_keep(timestamp);
+            };
             epochtime_t timestamp;
-            while (reader.get_next_message_with_timestamp(message, timestamp, this)) {
+            while (reader.get_next_message_with_timestamp(message, timestamp, this, would_keep)) {
+                m_result_limiter->keep_if_latest(message, timestamp, archive_id);
+            }
+            continue;
+        }
+
+        if (m_output_handler->should_aggregate_columns()) {
+            while (reader.get_next_message(message, this)) {
+                clp::Metrics::ScopedTimer const output_timer{clp::Metrics::Stage::Output};
+                m_output_handler->write_row(m_cur_message);
+            }
+        } else if (m_output_handler->should_output_metadata()) {
+            epochtime_t timestamp;
+            while (false == is_limit_satisfied()
+                   && reader.get_next_message_with_timestamp(message, timestamp, this))
+            {
+                clp::Metrics::ScopedTimer const output_timer{clp::Metrics::Stage::Output};
+                clp::Metrics::increment(clp::Metrics::Counter::NumMessagesOutput);
                 m_output_handler->write(message, timestamp, archive_id);
+                record_output_result();
             }
         } else {
-            while (reader.get_next_message(message, this)) {
+            while (false == is_limit_satisfied() && reader.get_next_message(message, this)) {
+                clp::Metrics::ScopedTimer const output_timer{clp::Metrics::Stage::Output};
+                clp::Metrics::increment(clp::Metrics::Counter::NumMessagesOutput);
                 m_output_handler->write(message);
+                record_output_result();
             }
         }
         auto ecode = m_output_handler->flush();
@@ -121,6 +170,25 @@ bool Output::filter() {
     return true;
 }
 
+void Output::order_and_prune_tables_for_limit(std::vector<int32_t>& schema_ids) const {
+    if (m_result_limiter->is_ordered_by_timestamp_desc()) {
+        std::stable_sort(
+                schema_ids.begin(),
+                schema_ids.end(),
+                [&](int32_t lhs, int32_t rhs) {
+                    return m_archive_reader->get_table_metadata(lhs).end_timestamp
+                           > m_archive_reader->get_table_metadata(rhs).end_timestamp;
+                }
+        );
+    }
+    std::erase_if(schema_ids, [&](int32_t schema_id) {
+        return false
+               == m_result_limiter->may_contain_output_result(
+                       m_archive_reader->get_table_metadata(schema_id).end_timestamp
+               );
+    });
+}
+
 void Output::init(
         SchemaReader* reader,
         int32_t schema_id,
@@ -134,6 +202,10 @@ void Output::init(
     m_datestring_readers.clear();
     m_basic_readers.clear();
 
+    if (m_output_handler->should_aggregate_columns()) {
+        m_output_handler->bind_columns(*m_schema_tree, column_readers);
+    }
+
     for (auto column_reader : column_readers) {
         auto column_id = column_reader->get_id();
         if ((0
@@ -175,9 +247,25 @@ std::string& Output::get_cached_decompressed_unstructured_array(int32_t column_i
     return rit.first->second;
 }
 
+ArrayTape const& Output::get_cached_unstructured_array_tape(int32_t column_id) {
+    // NOTE: Tapes are reused across messages so that their buffers don't need to be reallocated
+    auto& tape = m_unstructured_array_tapes[column_id];
+    if (m_parsed_unstructured_array_columns.insert(column_id).second) {
+        // Unstructured arrays with the same column id can not appear multiple times in one schema
+        // in the current implementation.
+        auto value = std::get<std::string>(
+                m_basic_readers[column_id][0]->extract_value(m_cur_message)
+        );
+        tape.parse(m_array_parser, value);
+    }
+    return tape;
+}
+
 bool Output::filter(uint64_t cur_message) {
+    clp::Metrics::ScopedTimer const filter_timer{clp::Metrics::Stage::FilterEvaluation};
     m_cur_message = cur_message;
     m_extracted_unstructured_arrays.clear();
+    m_parsed_unstructured_array_columns.clear();
     return evaluate(m_expr.get(), m_schema);
 }
 
@@ -269,7 +357,7 @@ bool Output::evaluate_wildcard_filter(FilterExpr* expr, int32_t schema) {
     }
 
     if (column->matches_type(LiteralType::VarStringT)) {
-        std::unordered_set<int64_t>* matching_vars = m_expr_var_match_map[expr];
+        DictionaryIdBitset const* matching_vars = m_expr_var_match_map[expr];
         for (auto const& entry : m_var_string_readers) {
             if (evaluate_var_string_filter(op, entry.second, matching_vars)) {
                 return true;
@@ -299,11 +387,19 @@ bool Output::evaluate_wildcard_filter(FilterExpr* expr, int32_t schema) {
                 ret = evaluate_bool_filter(op, column_id, literal);
                 break;
             case LiteralType::ArrayT:
-                ret = evaluate_wildcard_array_filter(
-                        op,
-                        get_cached_decompressed_unstructured_array(column_id),
-                        literal
-                );
+                if (should_use_unstructured_array_tape(column_id)) {
+                    ret = evaluate_wildcard_array_filter(
+                            op,
+                            get_cached_unstructured_array_tape(column_id),
+                            literal
+                    );
+                } else {
+                    ret = evaluate_wildcard_array_filter(
+                            op,
+                            get_cached_decompressed_unstructured_array(column_id),
+                            literal
+                    );
+                }
                 break;
             default:
                 break;
@@ -322,7 +418,7 @@ bool Output::evaluate_filter(FilterExpr* expr, int32_t schema) {
     int32_t column_id = column->get_column_id();
     auto literal = expr->get_operand();
     Query* q = nullptr;
-    std::unordered_set<int64_t>* matching_vars = nullptr;
+    DictionaryIdBitset const* matching_vars = nullptr;
     switch (column->get_literal_type()) {
         case LiteralType::IntegerT:
             return evaluate_int_filter(expr->get_operation(), column_id, literal);
@@ -345,6 +441,14 @@ bool Output::evaluate_filter(FilterExpr* expr, int32_t schema) {
         case LiteralType::BooleanT:
             return evaluate_bool_filter(expr->get_operation(), column_id, literal);
         case LiteralType::ArrayT:
+            if (should_use_unstructured_array_tape(column_id)) {
+                return evaluate_array_filter(
+                        expr->get_operation(),
+                        column->get_unresolved_tokens(),
+                        get_cached_unstructured_array_tape(column_id),
+                        literal
+                );
+            }
             return evaluate_array_filter(
                     expr->get_operation(),
                     column->get_unresolved_tokens(),
@@ -470,18 +574,24 @@ bool Output::evaluate_clp_string_filter(
         return op == FilterOperation::EQ;
     }
 
-    bool matched = false;
     for (ClpStringColumnReader* reader : readers) {
+        bool matched = false;
         int64_t id = reader->get_encoded_id(m_cur_message);
-        auto vars = reader->get_encoded_vars(m_cur_message);
         if (q->contains_sub_queries()) {
+            // Most messages match none of the query's logtypes, so reject them with a single bit
+            // probe before trying each subquery
+            if (false == q->may_match_logtype(id)) {
+                if (FilterOperation::NEQ == op) {
+                    return true;
+                }
+                continue;
+            }
+            auto vars = reader->get_encoded_vars(m_cur_message);
             for (auto const& subquery : q->get_sub_queries()) {
                 if (subquery.matches_logtype(id) && subquery.matches_vars(vars)) {
                     if (subquery.wildcard_match_required()) {
-                        matched = StringUtils::wildcard_match_unsafe(
-                                std::get<std::string>(reader->extract_value(m_cur_message)),
-                                q->get_search_string(),
-                                !q->get_ignore_case()
+                        matched = q->search_string_matches(
+                                std::get<std::string>(reader->extract_value(m_cur_message))
                         );
                     } else {
                         matched = true;
@@ -490,10 +600,8 @@ bool Output::evaluate_clp_string_filter(
                 }
             }
         } else {
-            matched = StringUtils::wildcard_match_unsafe(
-                    std::get<std::string>(reader->extract_value(m_cur_message)),
-                    q->get_search_string(),
-                    !q->get_ignore_case()
+            matched = q->search_string_matches(
+                    std::get<std::string>(reader->extract_value(m_cur_message))
             );
         }
 
@@ -507,7 +615,7 @@ bool Output::evaluate_clp_string_filter(
 bool Output::evaluate_var_string_filter(
         FilterOperation op,
         std::vector<VariableStringColumnReader*> const& readers,
-        std::unordered_set<int64_t>* matching_vars
+        DictionaryIdBitset const* matching_vars
 ) const {
     if (FilterOperation::EXISTS == op || FilterOperation::NEXISTS == op) {
         return true;
@@ -519,7 +627,7 @@ bool Output::evaluate_var_string_filter(
 
     for (VariableStringColumnReader* reader : readers) {
         int64_t id = reader->get_variable_id(m_cur_message);
-        bool matched = matching_vars->count(id) > 0;
+        bool matched = matching_vars->test(id);
 
         if ((FilterOperation::EQ == op) == matched) {
             return true;
@@ -835,6 +943,259 @@ bool Output::evaluate_wildcard_array_filter(
     return false;
 }
 
+bool Output::evaluate_array_filter(
+        FilterOperation op,
+        DescriptorList const& unresolved_tokens,
+        ArrayTape const& tape,
+        std::shared_ptr<Literal> const& operand
+) {
+    // pre-evaluate whether we can match strings or numbers to eliminate
+    // duplicate effort on every item
+    m_maybe_string = !(op == FilterOperation::EXISTS || op == FilterOperation::NEXISTS)
+                     && (operand->as_var_string(m_array_search_string, op)
+                         || operand->as_clp_string(m_array_search_string, op));
+    double tmp_double;
+    int64_t tmp_int;
+    m_maybe_number = !(op == FilterOperation::EXISTS || op == FilterOperation::NEXISTS)
+                     && (operand->as_float(tmp_double, op) || operand->as_int(tmp_int, op));
+
+    return evaluate_array_filter_array(
+            tape,
+            ArrayTape::get_root(),
+            op,
+            unresolved_tokens,
+            0,
+            operand
+    );
+}
+
+bool Output::evaluate_array_filter_value(
+        ArrayTape const& tape,
+        size_t item_ix,
+        FilterOperation op,
+        DescriptorList const& unresolved_tokens,
+        size_t cur_idx,
+        std::shared_ptr<Literal> const& operand
+) const {
+    bool match = false;
+    switch (tape.get_type(item_ix)) {
+        case ArrayTape::EntryType::Object: {
+            if (evaluate_array_filter_object(
+                        tape,
+                        item_ix,
+                        op,
+                        unresolved_tokens,
+                        cur_idx,
+                        operand
+                ))
+            {
+                match = true;
+            }
+        } break;
+        case ArrayTape::EntryType::Array: {
+            if (evaluate_array_filter_array(tape, item_ix, op, unresolved_tokens, cur_idx, operand))
+            {
+                match = true;
+            }
+        } break;
+        case ArrayTape::EntryType::String: {
+            if (true == m_maybe_string && unresolved_tokens.size() == cur_idx
+                && wildcard_match(tape.get_string(item_ix), m_array_search_string))
+            {
+                match = op == FilterOperation::EQ;
+            }
+        } break;
+        case ArrayTape::EntryType::Double: {
+            if (false == m_maybe_number || unresolved_tokens.size() != cur_idx) {
+                break;
+            }
+            double tmp_double;
+            operand->as_float(tmp_double, op);
+            match = eval(op, tape.get_double(item_ix), tmp_double);
+        } break;
+        case ArrayTape::EntryType::UInt64: {
+            if (false == m_maybe_number || unresolved_tokens.size() != cur_idx) {
+                break;
+            }
+            int64_t tmp_int;
+            operand->as_int(tmp_int, op);
+            match = eval(op, tape.get_uint64(item_ix), tmp_int);
+        } break;
+        case ArrayTape::EntryType::Int64: {
+            if (false == m_maybe_number || unresolved_tokens.size() != cur_idx) {
+                break;
+            }
+            int64_t tmp_int;
+            operand->as_int(tmp_int, op);
+            // TODO: once we properly support unsigned at at least the AST level we should
+            // replace this with something like operand->as_uint(tmp_uint)
+            uint64_t tmp_uint = bit_cast<uint64_t, int64_t>(tmp_int);
+            match = eval(op, tape.get_int64(item_ix), tmp_uint);
+        } break;
+        case ArrayTape::EntryType::Boolean: {
+            if (unresolved_tokens.size() != cur_idx || op == FilterOperation::EXISTS
+                || op == FilterOperation::NEXISTS)
+            {
+                break;
+            }
+            bool tmp_bool;
+            if (operand->as_bool(tmp_bool, op) && eval(op, tape.get_bool(item_ix), tmp_bool)) {
+                match = true;
+            }
+        } break;
+        case ArrayTape::EntryType::Null: {
+            if (op != FilterOperation::EXISTS && op != FilterOperation::NEXISTS
+                && operand->as_null(op))
+            {
+                match = op == FilterOperation::EQ;
+            }
+        } break;
+        case ArrayTape::EntryType::Key:
+            break;
+    }
+    return match;
+}
+
+bool Output::evaluate_array_filter_array(
+        ArrayTape const& tape,
+        size_t array_ix,
+        FilterOperation op,
+        DescriptorList const& unresolved_tokens,
+        size_t cur_idx,
+        std::shared_ptr<Literal> const& operand
+) const {
+    auto const end_ix = tape.get_next(array_ix);
+    for (auto item_ix = array_ix + 1; item_ix < end_ix; item_ix = tape.get_next(item_ix)) {
+        if (evaluate_array_filter_value(tape, item_ix, op, unresolved_tokens, cur_idx, operand)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Output::evaluate_array_filter_object(
+        ArrayTape const& tape,
+        size_t object_ix,
+        FilterOperation op,
+        DescriptorList const& unresolved_tokens,
+        size_t cur_idx,
+        std::shared_ptr<Literal> const& operand
+) const {
+    if (cur_idx >= unresolved_tokens.size()) {
+        return false;
+    }
+
+    auto const end_ix = tape.get_next(object_ix);
+    for (auto key_ix = object_ix + 1; key_ix < end_ix; key_ix = tape.get_next(key_ix + 1)) {
+        // Note: the tape stores escaped JSON keys, so the descriptor tokens passed to search must
+        // likewise be escaped.
+        if (tape.get_string(key_ix) != unresolved_tokens[cur_idx].get_token()) {
+            continue;
+        }
+
+        cur_idx += 1;
+        if (cur_idx == unresolved_tokens.size()
+            && (op == FilterOperation::EXISTS || op == FilterOperation::NEXISTS))
+        {
+            return op == FilterOperation::EXISTS;
+        }
+
+        return evaluate_array_filter_value(
+                tape,
+                key_ix + 1,
+                op,
+                unresolved_tokens,
+                cur_idx,
+                operand
+        );
+    }
+    return false;
+}
+
+bool Output::evaluate_wildcard_array_filter(
+        FilterOperation op,
+        ArrayTape const& tape,
+        std::shared_ptr<Literal> const& operand
+) {
+    // pre-evaluate whether we can match strings or numbers to eliminate
+    // duplicate effort on every item
+    m_maybe_string = operand->as_var_string(m_array_search_string, op)
+                     || operand->as_clp_string(m_array_search_string, op);
+
+    return evaluate_wildcard_array_filter(tape, ArrayTape::get_root(), op, operand);
+}
+
+bool Output::evaluate_wildcard_array_filter(
+        ArrayTape const& tape,
+        size_t container_ix,
+        FilterOperation op,
+        std::shared_ptr<Literal> const& operand
+) const {
+    bool match = false;
+    auto const end_ix = tape.get_next(container_ix);
+    for (auto item_ix = container_ix + 1; item_ix < end_ix; item_ix = tape.get_next(item_ix)) {
+        switch (tape.get_type(item_ix)) {
+            case ArrayTape::EntryType::Object:
+            case ArrayTape::EntryType::Array: {
+                if (evaluate_wildcard_array_filter(tape, item_ix, op, operand)) {
+                    match = true;
+                }
+            } break;
+            case ArrayTape::EntryType::Key:
+                // Only the values of an object's members are matched
+                break;
+            case ArrayTape::EntryType::String: {
+                if (false == m_maybe_string) {
+                    break;
+                }
+                if (wildcard_match(tape.get_string(item_ix), m_array_search_string)) {
+                    match |= op == FilterOperation::EQ;
+                }
+            } break;
+            case ArrayTape::EntryType::Double: {
+                if (false == m_maybe_number) {
+                    break;
+                }
+                double tmp_double;
+                operand->as_float(tmp_double, op);
+                match |= eval(op, tape.get_double(item_ix), tmp_double);
+            } break;
+            case ArrayTape::EntryType::UInt64: {
+                if (false == m_maybe_number) {
+                    break;
+                }
+                int64_t tmp_int;
+                operand->as_int(tmp_int, op);
+                match |= eval(op, tape.get_uint64(item_ix), tmp_int);
+            } break;
+            case ArrayTape::EntryType::Int64: {
+                if (false == m_maybe_number) {
+                    break;
+                }
+                int64_t tmp_int;
+                operand->as_int(tmp_int, op);
+                match |= eval(op, tape.get_int64(item_ix), tmp_int);
+            } break;
+            case ArrayTape::EntryType::Boolean: {
+                bool tmp;
+                if (operand->as_bool(tmp, op) && eval(op, tape.get_bool(item_ix), tmp)) {
+                    match = true;
+                }
+            } break;
+            case ArrayTape::EntryType::Null:
+                if (operand->as_null(op)) {
+                    match |= op == FilterOperation::EQ;
+                }
+                break;
+        }
+
+        if (match) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool Output::evaluate_bool_filter(
         FilterOperation op,
         int32_t column_id,
@@ -911,7 +1272,8 @@ void Output::populate_string_queries(std::shared_ptr<Expression> const& expr) {
                 return;
             }
 
-            std::unordered_set<int64_t>& matching_vars = m_string_var_match_map[query_string];
+            DictionaryIdBitset& matching_vars = m_string_var_match_map[query_string];
+            std::string prefix;
             if (false == StringUtils::has_unescaped_wildcards(query_string)) {
                 std::string unescaped_query_string;
                 bool escape = false;
@@ -932,8 +1294,15 @@ void Output::populate_string_queries(std::shared_ptr<Expression> const& expr) {
                 );
 
                 if (entry != nullptr) {
-                    matching_vars.insert(entry->get_id());
+                    matching_vars.set(entry->get_id());
                 }
+            } else if (m_var_dict->is_sorted() && false == m_ignore_case
+                       && StringUtils::is_prefix_query(query_string, prefix))
+            {
+                // The entries matching a prefix in a sorted dictionary have a contiguous range of
+                // IDs, so there's no need to match every entry against the query
+                auto const [begin_id, end_id] = m_var_dict->get_id_range_matching_prefix(prefix);
+                matching_vars.set_range(begin_id, end_id);
             } else if (EncodedVariableInterpreter::
                                wildcard_search_dictionary_and_get_encoded_matches(
                                        query_string,
@@ -946,11 +1315,11 @@ void Output::populate_string_queries(std::shared_ptr<Expression> const& expr) {
                     if (var.is_precise_var()) {
                         auto const* entry = var.get_var_dict_entry();
                         if (entry != nullptr) {
-                            matching_vars.insert(entry->get_id());
+                            matching_vars.set(entry->get_id());
                         }
                     } else {
                         for (auto const* entry : var.get_possible_var_dict_entries()) {
-                            matching_vars.insert(entry->get_id());
+                            matching_vars.set(entry->get_id());
                         }
                     }
                 }
@@ -997,6 +1366,26 @@ void Output::add_wildcard_columns_to_searched_columns() {
     }
 }
 
+void Output::count_unstructured_array_filters(std::shared_ptr<Expression> const& expr) {
+    if (expr->has_only_expression_operands()) {
+        for (auto const& op : expr->get_op_list()) {
+            count_unstructured_array_filters(std::static_pointer_cast<Expression>(op));
+        }
+    } else if (auto filter = std::dynamic_pointer_cast<FilterExpr>(expr)) {
+        auto* column = filter->get_column().get();
+        if (column->is_pure_wildcard()) {
+            for (int32_t column_id : m_wildcard_to_searched_basic_columns[column]) {
+                auto const type = m_schema_tree->get_node(column_id).get_type();
+                if (LiteralType::ArrayT == node_to_literal_type(type)) {
+                    ++m_num_unstructured_array_filters[column_id];
+                }
+            }
+        } else if (LiteralType::ArrayT == column->get_literal_type()) {
+            ++m_num_unstructured_array_filters[column->get_column_id()];
+        }
+    }
+}
+
 EvaluatedValue
 Output::constant_propagate(std::shared_ptr<Expression> const& expr, int32_t schema_id) {
     if (std::dynamic_pointer_cast<OrExpr>(expr)) {
@@ -1147,9 +1536,16 @@ Output::constant_propagate(std::shared_ptr<Expression> const& expr, int32_t sche
             std::string filter_string;
             filter->get_operand()->as_clp_string(filter_string, filter->get_operation());
 
-            // set up string query for this filter
+            // set up string query for this filter, unless the dictionary index shows that the
+            // column doesn't contain any matching logtypes
             auto& query_processing_result = m_string_query_map.at(filter_string);
-            if (query_processing_result.has_value()) {
+            if (query_processing_result.has_value()
+                && column_may_contain_matching_logtypes(
+                        filter_string,
+                        schema_id,
+                        filter->get_column()->get_column_id()
+                ))
+            {
                 m_expr_clp_query[expr.get()] = &(query_processing_result.value());
                 return EvaluatedValue::Unknown;
             } else {
@@ -1171,8 +1567,11 @@ Output::constant_propagate(std::shared_ptr<Expression> const& expr, int32_t sche
             // set up string query for this filter
             m_expr_var_match_map[expr.get()] = &m_string_var_match_map.at(filter_string);
 
-            // use string queries to potentially propagate known result
-            if (m_expr_var_match_map.at(expr.get())->empty()) {
+            // use string queries and the dictionary index to potentially propagate known result
+            auto const column_id = filter->get_column()->get_column_id();
+            if (m_expr_var_match_map.at(expr.get())->empty()
+                || false == column_may_contain_matching_vars(filter_string, schema_id, column_id))
+            {
                 // If filter can not match then return it's guaranteed value based on
                 // whether the filter is inverted and whether the operation was == or !=
                 if (filter->get_operation() == FilterOperation::EQ) {
@@ -1193,6 +1592,79 @@ Output::constant_propagate(std::shared_ptr<Expression> const& expr, int32_t sche
     return EvaluatedValue::Unknown;
 }
 
+void Output::read_dictionary_index() {
+    DictionaryIdBitset variable_ids;
+    for (auto const& [query_string, matching_vars] : m_string_var_match_map) {
+        variable_ids.merge(matching_vars);
+    }
+    // Queries without subqueries are matched against the decompressed strings, so only queries
+    // with subqueries restrict which logtypes can match
+    auto const restricts_logtypes = [](std::optional<Query> const& query) {
+        return query.has_value() && query->contains_sub_queries()
+               && false == query->search_string_matches_all();
+    };
+    DictionaryIdBitset logtype_ids;
+    for (auto const& [query_string, query] : m_string_query_map) {
+        if (restricts_logtypes(query)) {
+            logtype_ids.merge(query->get_possible_logtype_ids());
+        }
+    }
+
+    auto const num_ids = variable_ids.size() + logtype_ids.size();
+    if (0 == num_ids || num_ids > cMaxNumDictionaryIdsForIndex) {
+        return;
+    }
+    m_dictionary_index = m_archive_reader->read_dictionary_index(
+            variable_ids.get_ids(),
+            logtype_ids.get_ids()
+    );
+    if (nullptr == m_dictionary_index) {
+        return;
+    }
+
+    for (auto const& [query_string, matching_vars] : m_string_var_match_map) {
+        m_string_var_match_ids.emplace(query_string, matching_vars.get_ids());
+    }
+    for (auto const& [query_string, query] : m_string_query_map) {
+        if (restricts_logtypes(query)) {
+            m_string_query_logtype_ids.emplace(
+                    query_string,
+                    query->get_possible_logtype_ids().get_ids()
+            );
+        }
+    }
+}
+
+bool Output::column_may_contain_matching_vars(
+        std::string const& filter_string,
+        int32_t schema_id,
+        int32_t column_id
+) const {
+    if (nullptr == m_dictionary_index) {
+        return true;
+    }
+    auto it = m_string_var_match_ids.find(filter_string);
+    if (m_string_var_match_ids.end() == it) {
+        return true;
+    }
+    return m_dictionary_index->contains_any_variable_id(it->second, schema_id, column_id);
+}
+
+bool Output::column_may_contain_matching_logtypes(
+        std::string const& filter_string,
+        int32_t schema_id,
+        int32_t column_id
+) const {
+    if (nullptr == m_dictionary_index) {
+        return true;
+    }
+    auto it = m_string_query_logtype_ids.find(filter_string);
+    if (m_string_query_logtype_ids.end() == it) {
+        return true;
+    }
+    return m_dictionary_index->contains_any_logtype_id(it->second, schema_id, column_id);
+}
+
 bool Output::evaluate_epoch_date_filter(
         FilterOperation op,
         DateStringColumnReader* reader,
@@ -13,9 +13,12 @@
 #include "../ArchiveReader.hpp"
 #include "../SchemaReader.hpp"
 #include "../Utils.hpp"
+#include "ArrayTape.hpp"
 #include "clp_search/Query.hpp"
+#include "DictionaryIdBitset.hpp"
 #include "Expression.hpp"
 #include "OutputHandler.hpp"
+#include "ResultLimiter.hpp"
 #include "SchemaMatch.hpp"
 #include "StringLiteral.hpp"
 
@@ -25,12 +28,19 @@ using namespace clp_s::search::clp_search;
 namespace clp_s::search {
 class Output : public FilterClass {
 public:
+    // Constants
+    // The maximum number of matching dictionary IDs for which the dictionary index is read. The
+    // index pays off for needle-in-haystack queries, but looking up many IDs costs more than
+    // scanning the tables would.
+    static constexpr size_t cMaxNumDictionaryIdsForIndex{4096};
+
     Output(SchemaMatch& match,
            std::shared_ptr<Expression> expr,
            std::shared_ptr<ArchiveReader> archive_reader,
            std::shared_ptr<TimestampDictionaryReader> timestamp_dict,
            std::unique_ptr<OutputHandler> output_handler,
-           bool ignore_case)
+           bool ignore_case,
+           std::shared_ptr<ResultLimiter> result_limiter = nullptr)
             : m_archive_reader(std::move(archive_reader)),
               m_schema_tree(m_archive_reader->get_schema_tree()),
               m_schemas(m_archive_reader->get_schema_map()),
@@ -39,15 +49,25 @@ public:
               m_timestamp_dict(std::move(timestamp_dict)),
               m_output_handler(std::move(output_handler)),
               m_ignore_case(ignore_case),
-              m_should_marshal_records(m_output_handler->should_marshal_records()) {}
+              m_should_marshal_records(m_output_handler->should_marshal_records()),
+              m_result_limiter(std::move(result_limiter)) {}
 
     /**
      * Filters messages from all archives
+     *
+     * If a result limiter is given, results are limited across every archive that shares the
+     * limiter. When the limiter orders results by timestamp, results are kept by the limiter rather
+     * than written to the output handler, so that the caller can output them once every archive has
+     * been searched.
      * @return Whether the filter was performed successfully
      */
     bool filter();
 
 private:
+    // An unstructured array is only parsed into a tape if at least this many filters search it.
+    // Otherwise, the filter parses the array on demand, which lets it stop at the first match.
+    static constexpr size_t cMinFiltersPerUnstructuredArrayTape{2};
+
     enum class ExpressionType {
         And,
         Or,
@@ -60,6 +80,8 @@ private:
     std::unique_ptr<OutputHandler> m_output_handler;
     bool m_ignore_case;
     bool m_should_marshal_records{true};
+    // Only set if the number of results is limited
+    std::shared_ptr<ResultLimiter> m_result_limiter;
 
     // variables for the current schema being filtered
     int32_t m_schema;
@@ -74,14 +96,21 @@ private:
     std::shared_ptr<ReaderUtils::SchemaMap> m_schemas;
 
     std::map<std::string, std::optional<Query>> m_string_query_map;
-    std::map<std::string, std::unordered_set<int64_t>> m_string_var_match_map;
+    std::map<std::string, DictionaryIdBitset> m_string_var_match_map;
     std::unordered_map<Expression*, Query*> m_expr_clp_query;
-    std::unordered_map<Expression*, std::unordered_set<int64_t>*> m_expr_var_match_map;
+    std::unordered_map<Expression*, DictionaryIdBitset*> m_expr_var_match_map;
+    // Only set if the archive's dictionary index was read
+    std::shared_ptr<DictionaryIndexReader> m_dictionary_index;
+    std::map<std::string, std::vector<uint64_t>> m_string_var_match_ids;
+    std::map<std::string, std::vector<uint64_t>> m_string_query_logtype_ids;
     std::unordered_map<int32_t, std::vector<ClpStringColumnReader*>> m_clp_string_readers;
     std::unordered_map<int32_t, std::vector<VariableStringColumnReader*>> m_var_string_readers;
     std::unordered_map<int32_t, DateStringColumnReader*> m_datestring_readers;
     std::unordered_map<int32_t, std::vector<BaseColumnReader*>> m_basic_readers;
     std::unordered_map<int32_t, std::string> m_extracted_unstructured_arrays;
+    std::unordered_map<int32_t, ArrayTape> m_unstructured_array_tapes;
+    std::unordered_set<int32_t> m_parsed_unstructured_array_columns;
+    std::unordered_map<int32_t, size_t> m_num_unstructured_array_filters;
     uint64_t m_cur_message;
     EvaluatedValue m_expression_value;
 
@@ -196,13 +225,13 @@ private:
      * Evaluates a var string filter expression
      * @param op
      * @param reader
-     * @param matching_vars
+     * @param matching_vars The IDs of the variable dictionary entries that match the filter
      * @return true if the expression evaluates to true, false otherwise
      */
     bool evaluate_var_string_filter(
             FilterOperation op,
             std::vector<VariableStringColumnReader*> const& readers,
-            std::unordered_set<int64_t>* matching_vars
+            DictionaryIdBitset const* matching_vars
     ) const;
 
     /**
@@ -219,7 +248,8 @@ private:
     );
 
     /**
-     * Evaluates an array filter expression
+     * Evaluates an array filter expression by parsing the array on demand, which stops as soon as
+     * a match is found
      * @param op
      * @param unresolved_tokens
      * @param value
@@ -285,7 +315,8 @@ private:
     ) const;
 
     /**
-     * Evaluates a wildcard array filter expression
+     * Evaluates a wildcard array filter expression by parsing the array on demand, which stops as
+     * soon as a match is found
      * @param op
      * @param value
      * @param operand
@@ -323,6 +354,106 @@ private:
             std::shared_ptr<Literal> const& operand
     ) const;
 
+    /**
+     * Evaluates an array filter expression using the array's pre-parsed tape
+     * @param op
+     * @param unresolved_tokens
+     * @param tape
+     * @param operand
+     * @return true if the expression evaluates to true, false otherwise
+     */
+    bool evaluate_array_filter(
+            FilterOperation op,
+            DescriptorList const& unresolved_tokens,
+            ArrayTape const& tape,
+            std::shared_ptr<Literal> const& operand
+    );
+
+    /**
+     * Evaluates a filter expression on a single value for precise array search.
+     * @param tape
+     * @param item_ix
+     * @param op
+     * @param unresolved_tokens
+     * @param cur_idx
+     * @param operand
+     * @return true if the expression evaluates to true, false otherwise
+     */
+    inline bool evaluate_array_filter_value(
+            ArrayTape const& tape,
+            size_t item_ix,
+            FilterOperation op,
+            DescriptorList const& unresolved_tokens,
+            size_t cur_idx,
+            std::shared_ptr<Literal> const& operand
+    ) const;
+
+    /**
+     * Evaluates a filter expression on an array (top level or nested) for precise array search.
+     * @param tape
+     * @param array_ix
+     * @param op
+     * @param unresolved_tokens
+     * @param cur_idx
+     * @param operand
+     * @return true if the expression evaluates to true, false otherwise
+     */
+    bool evaluate_array_filter_array(
+            ArrayTape const& tape,
+            size_t array_ix,
+            FilterOperation op,
+            DescriptorList const& unresolved_tokens,
+            size_t cur_idx,
+            std::shared_ptr<Literal> const& operand
+    ) const;
+
+    /**
+     * Evaluates a filter expression on an object inside of an array for precise array search.
+     * @param tape
+     * @param object_ix
+     * @param op
+     * @param unresolved_tokens
+     * @param cur_idx
+     * @param operand
+     * @return true if the expression evaluates to true, false otherwise
+     */
+    bool evaluate_array_filter_object(
+            ArrayTape const& tape,
+            size_t object_ix,
+            FilterOperation op,
+            DescriptorList const& unresolved_tokens,
+            size_t cur_idx,
+            std::shared_ptr<Literal> const& operand
+    ) const;
+
+    /**
+     * Evaluates a wildcard array filter expression using the array's pre-parsed tape
+     * @param op
+     * @param tape
+     * @param operand
+     * @return true if the expression evaluates to true, false otherwise
+     */
+    bool evaluate_wildcard_array_filter(
+            FilterOperation op,
+            ArrayTape const& tape,
+            std::shared_ptr<Literal> const& operand
+    );
+
+    /**
+     * The implementation of evaluate_wildcard_array_filter
+     * @param tape
+     * @param container_ix The index of the array or object whose values should be matched
+     * @param op
+     * @param operand
+     * @return true if the expression evaluates to true, false otherwise
+     */
+    bool evaluate_wildcard_array_filter(
+            ArrayTape const& tape,
+            size_t container_ix,
+            FilterOperation op,
+            std::shared_ptr<Literal> const& operand
+    ) const;
+
     /**
      * Evaluates a bool filter expression
      * @param op
@@ -336,12 +467,71 @@ private:
             std::shared_ptr<Literal> const& operand
     );
 
+    /**
+     * Orders the given tables so that the tables most likely to contain the results kept by the
+     * result limiter are searched first, and removes the tables that can't contain any results that
+     * would be output.
+     * @param schema_ids
+     */
+    void order_and_prune_tables_for_limit(std::vector<int32_t>& schema_ids) const;
+
+    /**
+     * @return Whether the result limiter, if any, doesn't need any more results
+     */
+    [[nodiscard]] bool is_limit_satisfied() const {
+        return nullptr != m_result_limiter && m_result_limiter->is_satisfied();
+    }
+
+    /**
+     * Records that a result was written to the output handler, if there's a result limiter.
+     */
+    void record_output_result() {
+        if (nullptr != m_result_limiter) {
+            m_result_limiter->record_output_result();
+        }
+    }
+
     /**
      * Populates the string queries
      * @param expr
      */
     void populate_string_queries(std::shared_ptr<Expression> const& expr);
 
+    /**
+     * Reads the archive's dictionary index for the dictionary IDs that the string queries can
+     * match, if there are few enough of them for the index to be worthwhile and the archive has
+     * an index.
+     */
+    void read_dictionary_index();
+
+    /**
+     * Checks, using the dictionary index, whether a column of a table may contain any of the
+     * variable dictionary IDs that match a var string filter.
+     * @param filter_string
+     * @param schema_id
+     * @param column_id
+     * @return false if the column is guaranteed not to contain any matching IDs, true otherwise
+     */
+    bool column_may_contain_matching_vars(
+            std::string const& filter_string,
+            int32_t schema_id,
+            int32_t column_id
+    ) const;
+
+    /**
+     * Checks, using the dictionary index, whether a column of a table may contain any of the
+     * logtype dictionary IDs that match a clp string filter.
+     * @param filter_string
+     * @param schema_id
+     * @param column_id
+     * @return false if the column is guaranteed not to contain any matching IDs, true otherwise
+     */
+    bool column_may_contain_matching_logtypes(
+            std::string const& filter_string,
+            int32_t schema_id,
+            int32_t column_id
+    ) const;
+
     /**
      * Constant propagates an expression
      * @param expr
@@ -362,6 +552,24 @@ private:
      */
     void add_wildcard_columns_to_searched_columns();
 
+    /**
+     * Counts the filters in an expression that search each unstructured array column of the
+     * current schema, including the columns searched by wildcard filters
+     * @param expr
+     */
+    void count_unstructured_array_filters(std::shared_ptr<Expression> const& expr);
+
+    /**
+     * @param column_id
+     * @return Whether enough filters search the unstructured array stored in the column column_id
+     * for them to share a pre-parsed tape of it, rather than each parsing it on demand
+     */
+    bool should_use_unstructured_array_tape(int32_t column_id) const {
+        auto it = m_num_unstructured_array_filters.find(column_id);
+        return m_num_unstructured_array_filters.end() != it
+               && it->second >= cMinFiltersPerUnstructuredArrayTape;
+    }
+
     /**
      * Gets the cached decompressed structured array for the current message stored in the column
      * column_id. Decompressing array fields can be expensive, so this interface allows us to
@@ -374,6 +582,16 @@ private:
      */
     std::string& get_cached_decompressed_unstructured_array(int32_t column_id);
 
+    /**
+     * Gets the cached tape of the unstructured array for the current message stored in the column
+     * column_id. Decompressing and parsing array fields can be expensive, so this interface allows
+     * us to decompress and parse lazily, and to do so only once per message no matter how many
+     * filters search the array.
+     * @param column_id
+     * @return the tape of the unstructured array stored in the column column_id
+     */
+    ArrayTape const& get_cached_unstructured_array_tape(int32_t column_id);
+
     // Methods inherited from FilterClass
     bool filter(uint64_t cur_message) override;
 };
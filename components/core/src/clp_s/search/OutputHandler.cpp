@@ -1,8 +1,12 @@
 #include "OutputHandler.hpp"
 
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
@@ -10,18 +14,71 @@
 #include "../../reducer/CountOperator.hpp"
 #include "../../reducer/network_utils.hpp"
 #include "../../reducer/Record.hpp"
+#include "../Utils.hpp"
 
 using std::string;
 using std::string_view;
 
 namespace clp_s::search {
+namespace {
+/**
+ * @param schema_tree
+ * @param column_id
+ * @param key_tokens
+ * @return Whether the path from the root of the schema tree to the given column matches the given
+ * key tokens.
+ */
+bool column_matches_key(
+        SchemaTree const& schema_tree,
+        int32_t column_id,
+        std::vector<string> const& key_tokens
+) {
+    auto const root_node_id = schema_tree.get_root_node_id();
+    auto node_id = column_id;
+    for (auto it = key_tokens.crbegin(); key_tokens.crend() != it; ++it) {
+        if (root_node_id == node_id) {
+            return false;
+        }
+        auto const& node = schema_tree.get_node(node_id);
+        if (node.get_key_name() != *it) {
+            return false;
+        }
+        node_id = node.get_parent_id();
+    }
+    return root_node_id == node_id;
+}
+}  // namespace
+
+void StandardOutputHandler::write(
+        string_view message,
+        epochtime_t timestamp,
+        string_view archive_id
+) {
+    // Enough to hold any 64-bit integer
+    constexpr size_t cMaxTimestampLength{20};
+    std::array<char, cMaxTimestampLength> timestamp_buf{};
+    auto const timestamp_length = static_cast<size_t>(
+            std::to_chars(timestamp_buf.begin(), timestamp_buf.end(), timestamp).ptr
+            - timestamp_buf.begin()
+    );
+
+    m_writer.write(archive_id);
+    m_writer.write(": ");
+    m_writer.write(timestamp_buf.data(), timestamp_length);
+    m_writer.write(" ");
+    m_writer.write(message);
+}
+
 NetworkOutputHandler::NetworkOutputHandler(
         string const& host,
         int port,
-        bool should_output_timestamp
+        bool should_output_timestamp,
+        size_t buffer_size,
+        bool use_background_writer
 )
-        : OutputHandler(should_output_timestamp, true) {
-    m_socket_fd = clp::networking::connect_to_server(host, std::to_string(port));
+        : OutputHandler(should_output_timestamp, true),
+          m_socket_fd{clp::networking::connect_to_server(host, std::to_string(port))},
+          m_writer{m_socket_fd, buffer_size, use_background_writer} {
     if (-1 == m_socket_fd) {
         SPDLOG_ERROR("Failed to connect to the server, errno={}", errno);
         throw OperationFailed(ErrorCode::ErrorCodeFailureNetwork, __FILE__, __LINE__);
@@ -33,15 +90,29 @@ void NetworkOutputHandler::write(
         epochtime_t timestamp,
         string_view archive_id
 ) {
+    if (ErrorCode::ErrorCodeSuccess != m_writer.get_error()) {
+        throw OperationFailed(ErrorCode::ErrorCodeFailureNetwork, __FILE__, __LINE__);
+    }
+
     static constexpr string_view cOrigFilePathPlaceholder{""};
-    msgpack::type::tuple<epochtime_t, string, string, string> const
+    msgpack::type::tuple<epochtime_t, string_view, string_view, string_view> const
             src(timestamp, message, cOrigFilePathPlaceholder, archive_id);
-    msgpack::sbuffer m;
-    msgpack::pack(m, src);
+    // Pack the result directly into the writer's buffer
+    msgpack::pack(m_writer, src);
+}
 
-    if (-1 == send(m_socket_fd, m.data(), m.size(), 0)) {
-        throw OperationFailed(ErrorCode::ErrorCodeFailureNetwork, __FILE__, __LINE__);
+ErrorCode NetworkOutputHandler::flush() {
+    if (ErrorCode::ErrorCodeSuccess != m_writer.flush()) {
+        return ErrorCode::ErrorCodeFailureNetwork;
+    }
+    return ErrorCode::ErrorCodeSuccess;
+}
+
+ErrorCode NetworkOutputHandler::finish() {
+    if (ErrorCode::ErrorCodeSuccess != m_writer.finish()) {
+        return ErrorCode::ErrorCodeFailureNetwork;
     }
+    return ErrorCode::ErrorCodeSuccess;
 }
 
 ResultsCacheOutputHandler::ResultsCacheOutputHandler(
@@ -152,4 +223,56 @@ ErrorCode CountByTimeOutputHandler::finish() {
     return ErrorCode::ErrorCodeSuccess;
 }
 
+GroupByCountOutputHandler::GroupByCountOutputHandler(
+        int reducer_socket_fd,
+        std::vector<string> const& group_by_keys
+)
+        : OutputHandler{false, false},
+          m_reducer_socket_fd{reducer_socket_fd},
+          m_group_by_columns(group_by_keys.size(), nullptr) {
+    for (auto const& key : group_by_keys) {
+        auto& tokens = m_group_by_key_tokens.emplace_back();
+        StringUtils::tokenize_column_descriptor(key, tokens);
+    }
+}
+
+void GroupByCountOutputHandler::bind_columns(
+        SchemaTree const& schema_tree,
+        std::vector<BaseColumnReader*> const& column_readers
+) {
+    for (size_t i = 0; i < m_group_by_key_tokens.size(); ++i) {
+        m_group_by_columns[i] = nullptr;
+        for (auto* column_reader : column_readers) {
+            if (column_matches_key(schema_tree, column_reader->get_id(), m_group_by_key_tokens[i]))
+            {
+                m_group_by_columns[i] = column_reader;
+                break;
+            }
+        }
+    }
+}
+
+void GroupByCountOutputHandler::write_row(uint64_t cur_message) {
+    m_packed_group_key.clear();
+    for (auto* column_reader : m_group_by_columns) {
+        auto const tag_begin = reducer::GroupByCountTable::begin_tag(m_packed_group_key);
+        if (nullptr != column_reader) {
+            column_reader->extract_string_value_into_buffer(cur_message, m_packed_group_key);
+        }
+        reducer::GroupByCountTable::end_tag(m_packed_group_key, tag_begin);
+    }
+    m_group_counts.increment(m_packed_group_key);
+}
+
+ErrorCode GroupByCountOutputHandler::finish() {
+    if (false
+        == reducer::send_pipeline_results(
+                m_reducer_socket_fd,
+                m_group_counts.get_record_group_iterator(reducer::CountOperator::cRecordElementKey)
+        ))
+    {
+        return ErrorCode::ErrorCodeFailureNetwork;
+    }
+    return ErrorCode::ErrorCodeSuccess;
+}
 }  // namespace clp_s::search
@@ -5,10 +5,10 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
-#include <iostream>
 #include <queue>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
@@ -18,10 +18,14 @@
 #include <msgpack.hpp>
 #include <spdlog/spdlog.h>
 
+#include "../../reducer/GroupByCountTable.hpp"
 #include "../../reducer/Pipeline.hpp"
 #include "../../reducer/RecordGroupIterator.hpp"
+#include "../ColumnReader.hpp"
 #include "../Defs.hpp"
+#include "../SchemaTree.hpp"
 #include "../TraceableException.hpp"
+#include "BufferedOutputWriter.hpp"
 
 namespace clp_s::search {
 /**
@@ -53,6 +57,24 @@ public:
      */
     virtual void write(std::string_view message) = 0;
 
+    /**
+     * Binds the output handler to the columns of the next table that gets searched. Only called
+     * for output handlers which aggregate on column values directly.
+     * @param schema_tree
+     * @param column_readers
+     */
+    virtual void bind_columns(
+            [[maybe_unused]] SchemaTree const& schema_tree,
+            [[maybe_unused]] std::vector<BaseColumnReader*> const& column_readers
+    ) {}
+
+    /**
+     * Writes a matching row of the table bound with `bind_columns` to the output handler. Only
+     * called for output handlers which aggregate on column values directly.
+     * @param cur_message The index of the row within the table.
+     */
+    virtual void write_row([[maybe_unused]] uint64_t cur_message) {}
+
     /**
      * Flushes the output handler after each table that gets searched.
      * @return ErrorCodeSuccess on success or relevant error code on error
@@ -69,6 +91,12 @@ public:
 
     [[nodiscard]] bool should_marshal_records() const { return m_should_marshal_records; }
 
+    /**
+     * @return Whether the output handler aggregates on column values, in which case it should be
+     * passed matching rows through `write_row` rather than through `write`.
+     */
+    [[nodiscard]] virtual bool should_aggregate_columns() const { return false; }
+
 private:
     bool m_should_output_metadata;
     bool m_should_marshal_records;
@@ -76,20 +104,41 @@ private:
 
 /**
  * Output handler that writes to standard output.
+ *
+ * Results are written through a BufferedOutputWriter rather than through `std::cout`, so they only
+ * appear on standard output once `flush` or `finish` is called, or once a buffer fills up.
  */
 class StandardOutputHandler : public OutputHandler {
 public:
     // Constructors
-    explicit StandardOutputHandler(bool should_output_metadata = false)
-            : OutputHandler(should_output_metadata, true) {}
+    explicit StandardOutputHandler(
+            bool should_output_metadata = false,
+            size_t buffer_size = BufferedOutputWriter::cDefaultBufferSize,
+            bool use_background_writer = false
+    )
+            : OutputHandler(should_output_metadata, true),
+              m_writer{STDOUT_FILENO, buffer_size, use_background_writer} {}
 
     // Methods inherited from OutputHandler
     void
-    write(std::string_view message, epochtime_t timestamp, std::string_view archive_id) override {
-        std::cout << archive_id << ": " << timestamp << " " << message;
-    }
+    write(std::string_view message, epochtime_t timestamp, std::string_view archive_id) override;
+
+    void write(std::string_view message) override { m_writer.write(message); }
+
+    /**
+     * Writes all buffered results to standard output.
+     * @return Same as BufferedOutputWriter::flush
+     */
+    ErrorCode flush() override { return m_writer.flush(); }
+
+    /**
+     * Writes all buffered results to standard output and stops the background writer, if any.
+     * @return Same as BufferedOutputWriter::finish
+     */
+    ErrorCode finish() override { return m_writer.finish(); }
 
-    void write(std::string_view message) override { std::cout << message; }
+private:
+    BufferedOutputWriter m_writer;
 };
 
 /**
@@ -109,26 +158,50 @@ public:
     explicit NetworkOutputHandler(
             std::string const& host,
             int port,
-            bool should_output_metadata = false
+            bool should_output_metadata = false,
+            size_t buffer_size = BufferedOutputWriter::cDefaultBufferSize,
+            bool use_background_writer = false
     );
 
     // Destructor
     ~NetworkOutputHandler() override {
+        m_writer.finish();
         if (-1 != m_socket_fd) {
             close(m_socket_fd);
         }
     }
 
     // Methods inherited from OutputHandler
+    /**
+     * Buffers a result to be sent to the network destination.
+     * @param message
+     * @param timestamp
+     * @param archive_id
+     * @throw OperationFailed if a previous send to the network destination failed.
+     */
     void
     write(std::string_view message, epochtime_t timestamp, std::string_view archive_id) override;
 
     void write(std::string_view message) override { write(message, 0, {}); }
 
+    /**
+     * Sends all buffered results to the network destination.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    ErrorCode flush() override;
+
+    /**
+     * Sends all buffered results to the network destination and stops the background writer, if
+     * any.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    ErrorCode finish() override;
+
 private:
-    std::string m_host;
-    std::string m_port;
     int m_socket_fd;
+    BufferedOutputWriter m_writer;
 };
 
 /**
@@ -266,6 +339,51 @@ private:
     std::map<int64_t, int64_t> m_bucket_counts;
     int64_t m_count_by_time_bucket_size;
 };
+
+/**
+ * Output handler that performs a count aggregation grouped by the values of a set of columns and
+ * sends the partial results to a reducer.
+ *
+ * Group values are read directly from the column readers of each table rather than from marshalled
+ * records, and groups are accumulated in a compact hash table so that only one partial count per
+ * group is sent to the reducer.
+ */
+class GroupByCountOutputHandler : public OutputHandler {
+public:
+    // Constructors
+    GroupByCountOutputHandler(int reducer_socket_fd, std::vector<std::string> const& group_by_keys);
+
+    // Methods inherited from OutputHandler
+    void
+    write(std::string_view message, epochtime_t timestamp, std::string_view archive_id) override {}
+
+    void write(std::string_view message) override {}
+
+    void bind_columns(
+            SchemaTree const& schema_tree,
+            std::vector<BaseColumnReader*> const& column_readers
+    ) override;
+
+    void write_row(uint64_t cur_message) override;
+
+    [[nodiscard]] bool should_aggregate_columns() const override { return true; }
+
+    /**
+     * Flushes the counts.
+     * @return ErrorCodeSuccess on success
+     * @return ErrorCodeFailureNetwork on network error
+     */
+    ErrorCode finish() override;
+
+private:
+    int m_reducer_socket_fd;
+    std::vector<std::vector<std::string>> m_group_by_key_tokens;
+    // The column containing each group-by key in the current table, or nullptr if the current table
+    // doesn't contain the key
+    std::vector<BaseColumnReader*> m_group_by_columns;
+    std::string m_packed_group_key;
+    reducer::GroupByCountTable m_group_counts;
+};
 }  // namespace clp_s::search
 
 #endif  // CLP_S_SEARCH_OUTPUTHANDLER_HPP
@@ -0,0 +1,34 @@
+#include "ResultLimiter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace clp_s::search {
+void ResultLimiter::keep_if_latest(
+        std::string_view message,
+        epochtime_t timestamp,
+        std::string_view archive_id
+) {
+    if (m_kept_results.size() < m_limit) {
+        m_kept_results.push_back({std::string{message}, timestamp, std::string{archive_id}});
+        std::push_heap(m_kept_results.begin(), m_kept_results.end(), has_later_timestamp);
+        return;
+    }
+    if (false == would_keep(timestamp)) {
+        return;
+    }
+
+    // Replace the earliest kept result, reusing its buffers
+    std::pop_heap(m_kept_results.begin(), m_kept_results.end(), has_later_timestamp);
+    auto& result = m_kept_results.back();
+    result.message.assign(message);
+    result.timestamp = timestamp;
+    result.archive_id.assign(archive_id);
+    std::push_heap(m_kept_results.begin(), m_kept_results.end(), has_later_timestamp);
+}
+
+std::vector<ResultLimiter::Result> ResultLimiter::release_kept_results() {
+    std::sort_heap(m_kept_results.begin(), m_kept_results.end(), has_later_timestamp);
+    return std::exchange(m_kept_results, {});
+}
+}  // namespace clp_s::search
@@ -0,0 +1,109 @@
+#ifndef CLP_S_SEARCH_RESULTLIMITER_HPP
+#define CLP_S_SEARCH_RESULTLIMITER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Defs.hpp"
+
+namespace clp_s::search {
+/**
+ * Limits the number of results a query outputs across all the archives it searches.
+ *
+ * Without ordering, the first `limit` results found are output as they're found, and the search
+ * can stop as soon as the limit is reached. With ordering by timestamp, the `limit` results with
+ * the latest timestamps are kept until every archive has been searched, and the kept results are
+ * then output in descending timestamp order. In the latter case, any table or archive whose latest
+ * timestamp is no later than the earliest kept result can be skipped once `limit` results are kept.
+ */
+class ResultLimiter {
+public:
+    // Types
+    struct Result {
+        std::string message;
+        epochtime_t timestamp;
+        std::string archive_id;
+    };
+
+    // Constructors
+    /**
+     * @param limit The maximum number of results to output. Must be greater than 0.
+     * @param order_by_timestamp_desc Whether to output the results with the latest timestamps
+     * rather than the first results found.
+     */
+    ResultLimiter(uint64_t limit, bool order_by_timestamp_desc)
+            : m_limit{limit},
+              m_order_by_timestamp_desc{order_by_timestamp_desc} {}
+
+    // Methods
+    [[nodiscard]] uint64_t get_limit() const { return m_limit; }
+
+    [[nodiscard]] bool is_ordered_by_timestamp_desc() const { return m_order_by_timestamp_desc; }
+
+    /**
+     * @return Whether no more results need to be found, which can only happen without ordering.
+     */
+    [[nodiscard]] bool is_satisfied() const {
+        return false == m_order_by_timestamp_desc && m_num_results_output >= m_limit;
+    }
+
+    /**
+     * @param end_timestamp The latest timestamp in a table or archive.
+     * @return Whether the table or archive may contain a result that would be output.
+     */
+    [[nodiscard]] bool may_contain_output_result(epochtime_t end_timestamp) const {
+        if (false == m_order_by_timestamp_desc) {
+            return false == is_satisfied();
+        }
+        return would_keep(end_timestamp);
+    }
+
+    /**
+     * Records that a result was output, when results aren't ordered.
+     */
+    void record_output_result() { ++m_num_results_output; }
+
+    /**
+     * @param timestamp
+     * @return Whether a result with the given timestamp would be kept by `keep_if_latest`, when
+     * results are ordered by timestamp. This allows callers to skip marshalling results that
+     * wouldn't be kept.
+     */
+    [[nodiscard]] bool would_keep(epochtime_t timestamp) const {
+        return m_kept_results.size() < m_limit || timestamp > m_kept_results.front().timestamp;
+    }
+
+    /**
+     * Keeps a result if its timestamp is among the `limit` latest timestamps seen so far, when
+     * results are ordered by timestamp. On ties, the result that was seen first is kept.
+     * @param message
+     * @param timestamp
+     * @param archive_id
+     */
+    void
+    keep_if_latest(std::string_view message, epochtime_t timestamp, std::string_view archive_id);
+
+    /**
+     * Removes the kept results, when results are ordered by timestamp.
+     * @return The kept results in descending timestamp order.
+     */
+    [[nodiscard]] std::vector<Result> release_kept_results();
+
+private:
+    // Methods
+    static bool has_later_timestamp(Result const& lhs, Result const& rhs) {
+        return lhs.timestamp > rhs.timestamp;
+    }
+
+    // Variables
+    uint64_t m_limit;
+    bool m_order_by_timestamp_desc;
+    uint64_t m_num_results_output{0};
+    // A min-heap on timestamp, so that the earliest kept result is at the front
+    std::vector<Result> m_kept_results;
+};
+}  // namespace clp_s::search
+
+#endif  // CLP_S_SEARCH_RESULTLIMITER_HPP
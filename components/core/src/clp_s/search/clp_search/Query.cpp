@@ -135,16 +135,32 @@ bool SubQuery::matches_vars(UnalignedMemSpan<int64_t> vars) const {
     return (num_possible_vars == possible_vars_ix);
 }
 
+void Query::set_ignore_case(bool ignore_case) {
+    m_ignore_case = ignore_case;
+    m_search_string_matcher
+            = clp::string_utils::WildcardMatcher{m_search_string, false == ignore_case};
+}
+
 void Query::set_search_string(string const& search_string) {
     m_search_string = search_string;
+    m_search_string_matcher
+            = clp::string_utils::WildcardMatcher{search_string, false == m_ignore_case};
     m_search_string_matches_all = (m_search_string.empty() || "*" == m_search_string);
 }
 
 void Query::add_sub_query(SubQuery const& sub_query) {
     m_sub_queries.push_back(sub_query);
+    add_possible_logtype_ids(sub_query);
 }
 
 void Query::clear_sub_queries() {
     m_sub_queries.clear();
+    m_possible_logtype_ids = DictionaryIdBitset{};
+}
+
+void Query::add_possible_logtype_ids(SubQuery const& sub_query) {
+    for (auto const* entry : sub_query.get_possible_logtype_entries()) {
+        m_possible_logtype_ids.set(entry->get_id());
+    }
 }
 }  // namespace clp_s::search::clp_search
@@ -5,13 +5,17 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <string_utils/WildcardMatcher.hpp>
+
 #include "../../Defs.hpp"
 #include "../../DictionaryEntry.hpp"
 #include "../../Utils.hpp"
+#include "../DictionaryIdBitset.hpp"
 
 namespace clp_s::search::clp_search {
 /**
@@ -157,11 +161,15 @@ public:
     // Constructors
     Query(bool ignore_case, std::string const& search_string, std::vector<SubQuery> sub_queries)
             : m_ignore_case(ignore_case),
+              m_search_string_matcher(search_string, false == ignore_case),
               m_sub_queries(std::move(sub_queries)) {
         set_search_string(search_string);
+        for (auto const& sub_query : m_sub_queries) {
+            add_possible_logtype_ids(sub_query);
+        }
     }
 
-    void set_ignore_case(bool ignore_case) { m_ignore_case = ignore_case; }
+    void set_ignore_case(bool ignore_case);
 
     void set_search_string(std::string const& search_string);
 
@@ -180,16 +188,46 @@ public:
      */
     bool search_string_matches_all() const { return m_search_string_matches_all; }
 
+    /**
+     * @param message
+     * @return Whether the given message matches the search string
+     */
+    [[nodiscard]] bool search_string_matches(std::string_view message) const {
+        return m_search_string_matcher.matches(message);
+    }
+
     std::vector<SubQuery> const& get_sub_queries() const { return m_sub_queries; }
 
     bool contains_sub_queries() const { return m_sub_queries.empty() == false; }
 
+    /**
+     * Whether the given logtype ID matches one of the possible logtypes of any subquery. This
+     * allows rejecting most messages with a single bit probe before trying each subquery.
+     * @param logtype
+     * @return true if matched, false otherwise
+     */
+    bool may_match_logtype(logtype_dictionary_id_t logtype) const {
+        return m_possible_logtype_ids.test(logtype);
+    }
+
+    DictionaryIdBitset const& get_possible_logtype_ids() const { return m_possible_logtype_ids; }
+
 private:
+    // Methods
+    /**
+     * Adds the possible logtype IDs of the given subquery to the union of all subqueries'
+     * possible logtype IDs.
+     * @param sub_query
+     */
+    void add_possible_logtype_ids(SubQuery const& sub_query);
+
     // Variables
     bool m_ignore_case;
     std::string m_search_string;
+    clp::string_utils::WildcardMatcher m_search_string_matcher;
     std::vector<SubQuery> m_sub_queries;
     std::vector<SubQuery const*> m_relevant_sub_queries;
+    DictionaryIdBitset m_possible_logtype_ids;
     bool m_search_string_matches_all;
 };
 }  // namespace clp_s::search::clp_search
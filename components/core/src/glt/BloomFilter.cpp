@@ -0,0 +1,128 @@
+#include "BloomFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+#include "FileReader.hpp"
+
+namespace glt {
+BloomFilter::BloomFilter(size_t num_expected_values, double false_positive_rate) {
+    if (false == (false_positive_rate > 0 && false_positive_rate < 1)) {
+        throw OperationFailed(ErrorCode_BadParam, __FILENAME__, __LINE__);
+    }
+
+    // Blocked Bloom filters need roughly 20% more bits than standard Bloom filters to reach the
+    // same false positive rate
+    constexpr double cBlockingOverhead{1.2};
+    auto const ln2 = std::log(2.0);
+    auto const num_values = static_cast<double>(std::max<size_t>(num_expected_values, 1));
+    auto const num_bits
+            = cBlockingOverhead * num_values * -std::log(false_positive_rate) / (ln2 * ln2);
+
+    m_num_blocks = std::max<size_t>(
+            static_cast<size_t>(std::ceil(num_bits / static_cast<double>(cNumBitsPerBlock))),
+            1
+    );
+    m_num_hash_functions = std::clamp<uint32_t>(
+            static_cast<uint32_t>(std::lround(-std::log(false_positive_rate) / ln2)),
+            1,
+            cMaxNumHashFunctions
+    );
+    m_words.resize(m_num_blocks * cNumWordsPerBlock, 0);
+}
+
+auto BloomFilter::read(ReaderInterface& reader) -> BloomFilter {
+    uint32_t num_hash_functions{0};
+    uint64_t num_blocks{0};
+    if (ErrorCode_Success != reader.try_read_numeric_value(num_hash_functions)
+        || ErrorCode_Success != reader.try_read_numeric_value(num_blocks))
+    {
+        throw OperationFailed(ErrorCode_Truncated, __FILENAME__, __LINE__);
+    }
+    if (num_hash_functions < 1 || num_hash_functions > cMaxNumHashFunctions || 0 == num_blocks) {
+        throw OperationFailed(ErrorCode_Corrupt, __FILENAME__, __LINE__);
+    }
+
+    std::vector<uint64_t> words(num_blocks * cNumWordsPerBlock);
+    if (ErrorCode_Success
+        != reader.try_read_exact_length(
+                reinterpret_cast<char*>(words.data()),
+                words.size() * sizeof(uint64_t)
+        ))
+    {
+        throw OperationFailed(ErrorCode_Truncated, __FILENAME__, __LINE__);
+    }
+    return {num_hash_functions, std::move(words)};
+}
+
+auto BloomFilter::try_read_from_file(std::string const& path) -> std::optional<BloomFilter> {
+    if (false == std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    FileReader reader;
+    reader.open(path);
+    return read(reader);
+}
+
+auto BloomFilter::add(std::string_view value) -> void {
+    auto const value_hash = hash(value);
+    auto* block = m_words.data() + get_block_begin(value_hash);
+
+    // Derive each hash function's bit from the two halves of the hash (Kirsch-Mitzenmacher)
+    auto bit_ix = static_cast<uint32_t>(value_hash);
+    auto const delta = static_cast<uint32_t>(value_hash >> 32) | 1;
+    for (uint32_t i = 0; i < m_num_hash_functions; ++i) {
+        auto const block_bit_ix = bit_ix % cNumBitsPerBlock;
+        block[block_bit_ix / 64] |= uint64_t{1} << (block_bit_ix % 64);
+        bit_ix += delta;
+    }
+}
+
+auto BloomFilter::possibly_contains(std::string_view value) const -> bool {
+    auto const value_hash = hash(value);
+    auto const* block = m_words.data() + get_block_begin(value_hash);
+
+    auto bit_ix = static_cast<uint32_t>(value_hash);
+    auto const delta = static_cast<uint32_t>(value_hash >> 32) | 1;
+    for (uint32_t i = 0; i < m_num_hash_functions; ++i) {
+        auto const block_bit_ix = bit_ix % cNumBitsPerBlock;
+        if (0 == (block[block_bit_ix / 64] & (uint64_t{1} << (block_bit_ix % 64)))) {
+            return false;
+        }
+        bit_ix += delta;
+    }
+    return true;
+}
+
+auto BloomFilter::possibly_contains_all(std::span<std::string const> values) const -> bool {
+    return std::all_of(values.begin(), values.end(), [&](std::string const& value) {
+        return possibly_contains(value);
+    });
+}
+
+auto BloomFilter::write(WriterInterface& writer) const -> void {
+    writer.write_numeric_value(m_num_hash_functions);
+    writer.write_numeric_value<uint64_t>(m_num_blocks);
+    writer.write(reinterpret_cast<char const*>(m_words.data()), get_size_in_bytes());
+}
+
+auto BloomFilter::hash(std::string_view value) -> uint64_t {
+    constexpr uint64_t cFnvOffsetBasis{0xcbf2'9ce4'8422'2325ULL};
+    constexpr uint64_t cFnvPrime{0x100'0000'01b3ULL};
+
+    uint64_t value_hash{cFnvOffsetBasis};
+    for (auto const c : value) {
+        value_hash ^= static_cast<unsigned char>(c);
+        value_hash *= cFnvPrime;
+    }
+
+    // FNV-1a's high bits are poorly mixed for short values, so finalize with splitmix64
+    value_hash ^= value_hash >> 30;
+    value_hash *= 0xbf58'476d'1ce4'e5b9ULL;
+    value_hash ^= value_hash >> 27;
+    value_hash *= 0x94d0'49bb'1331'11ebULL;
+    value_hash ^= value_hash >> 31;
+    return value_hash;
+}
+}  // namespace glt
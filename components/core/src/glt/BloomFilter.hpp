@@ -0,0 +1,125 @@
+#ifndef GLT_BLOOMFILTER_HPP
+#define GLT_BLOOMFILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "ReaderInterface.hpp"
+#include "TraceableException.hpp"
+#include "WriterInterface.hpp"
+
+namespace glt {
+/**
+ * A blocked Bloom filter over strings. All the bits for a value are set within a single 512-bit
+ * block (i.e., one cache line), so checking a value touches one cache line regardless of the number
+ * of hash functions. In exchange, the false positive rate is slightly higher than that of a
+ * standard Bloom filter of the same size, which we compensate for when sizing the filter.
+ *
+ * Values are hashed with a hash function that's stable across platforms and builds, so the filter
+ * can be persisted (e.g., alongside an archive) and read back by another process.
+ */
+class BloomFilter {
+public:
+    // Types
+    class OperationFailed : public TraceableException {
+    public:
+        // Constructors
+        OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                : TraceableException(error_code, filename, line_number) {}
+
+        // Methods
+        [[nodiscard]] auto what() const noexcept -> char const* override {
+            return "BloomFilter operation failed";
+        }
+    };
+
+    // Constructors
+    /**
+     * Constructs an empty filter sized for the given number of values.
+     * @param num_expected_values
+     * @param false_positive_rate The target false positive rate, in (0, 1).
+     * @throw OperationFailed if the false positive rate is out of range
+     */
+    BloomFilter(size_t num_expected_values, double false_positive_rate);
+
+    // Methods
+    /**
+     * Reads a filter written by `write`.
+     * @param reader
+     * @return The filter
+     * @throw OperationFailed if the filter is corrupt or truncated
+     */
+    [[nodiscard]] static auto read(ReaderInterface& reader) -> BloomFilter;
+
+    /**
+     * Reads a filter from the given file, if it exists.
+     * @param path
+     * @return The filter, or std::nullopt if the file doesn't exist
+     * @throw OperationFailed if the filter is corrupt or truncated
+     */
+    [[nodiscard]] static auto try_read_from_file(std::string const& path
+    ) -> std::optional<BloomFilter>;
+
+    auto add(std::string_view value) -> void;
+
+    /**
+     * @param value
+     * @return Whether the value may have been added to the filter. false is definitive.
+     */
+    [[nodiscard]] auto possibly_contains(std::string_view value) const -> bool;
+
+    /**
+     * @param values
+     * @return Whether every one of the values may have been added to the filter.
+     */
+    [[nodiscard]] auto possibly_contains_all(std::span<std::string const> values) const -> bool;
+
+    auto write(WriterInterface& writer) const -> void;
+
+    [[nodiscard]] auto get_size_in_bytes() const -> size_t {
+        return m_words.size() * sizeof(uint64_t);
+    }
+
+private:
+    // Constants
+    static constexpr size_t cNumWordsPerBlock{8};
+    static constexpr uint32_t cNumBitsPerBlock{cNumWordsPerBlock * 64};
+    static constexpr uint32_t cMaxNumHashFunctions{16};
+
+    // Constructors
+    BloomFilter(uint32_t num_hash_functions, std::vector<uint64_t> words)
+            : m_num_hash_functions{num_hash_functions},
+              m_num_blocks{words.size() / cNumWordsPerBlock},
+              m_words{std::move(words)} {}
+
+    // Methods
+    /**
+     * Hashes the given value using 64-bit FNV-1a followed by a splitmix64 finalizer. Since the
+     * hash is persisted as part of the filter, it must never change.
+     * @param value
+     * @return The hash
+     */
+    [[nodiscard]] static auto hash(std::string_view value) -> uint64_t;
+
+    /**
+     * @param hash
+     * @return The index of the first word of the block that the given hash maps to.
+     */
+    [[nodiscard]] auto get_block_begin(uint64_t hash) const -> size_t {
+        return static_cast<size_t>(((hash >> 32) * m_num_blocks) >> 32) * cNumWordsPerBlock;
+    }
+
+    uint32_t m_num_hash_functions;
+    size_t m_num_blocks;
+    std::vector<uint64_t> m_words;
+};
+}  // namespace glt
+
+#endif  // GLT_BLOOMFILTER_HPP
@@ -10,6 +10,7 @@
 #include "dictionary_utils.hpp"
 #include "DictionaryEntry.hpp"
 #include "FileReader.hpp"
+#include "Metrics.hpp"
 #include "streaming_compression/passthrough/Decompressor.hpp"
 #include "streaming_compression/zstd/Decompressor.hpp"
 #include "Utils.hpp"
@@ -168,6 +169,7 @@ void DictionaryReader<DictionaryIdType, EntryType>::read_new_entries() {
     if (false == m_is_open) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
+    Metrics::ScopedTimer const load_timer{Metrics::Stage::DictionaryLoad};
 
     // Read dictionary header
     auto num_dictionary_entries = read_dictionary_header(m_dictionary_file_reader);
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ArrayBackedPosIntSet.hpp"
+#include "BloomFilter.hpp"
 #include "Defs.h"
 #include "dictionary_utils.hpp"
 #include "FileWriter.hpp"
@@ -96,6 +97,20 @@ public:
      */
     size_t get_data_size() const { return m_data_size; }
 
+    /**
+     * Builds a Bloom filter over the values in the dictionary, so that searches can check whether
+     * a value may be in the dictionary without reading it
+     * @param false_positive_rate
+     * @return The filter
+     */
+    BloomFilter build_bloom_filter(double false_positive_rate) const {
+        BloomFilter filter{m_value_to_id.size(), false_positive_rate};
+        for (auto const& [value, id] : m_value_to_id) {
+            filter.add(value);
+        }
+        return filter;
+    }
+
 protected:
     // Types
     using value_to_id_t = std::unordered_map<std::string, DictionaryIdType>;
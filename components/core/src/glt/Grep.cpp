@@ -1,12 +1,17 @@
 #include "Grep.hpp"
 
 #include <algorithm>
+#include <filesystem>
 
 #include <string_utils/string_utils.hpp>
 
+#include "BloomFilter.hpp"
 #include "EncodedVariableInterpreter.hpp"
 #include "ir/parsing.hpp"
 #include "ir/types.hpp"
+#include "Metrics.hpp"
+#include "spdlog_with_specializations.hpp"
+#include "streaming_archive/Constants.hpp"
 #include "StringReader.hpp"
 #include "Utils.hpp"
 
@@ -596,6 +601,76 @@ std::optional<Query> Grep::process_raw_query(
     };
 }
 
+vector<string> Grep::get_dictionary_vars_required_by_query(string const& search_string) {
+    // Tokenize the search string the same way as `process_raw_query`
+    string processed_search_string = "*";
+    processed_search_string += search_string;
+    processed_search_string += '*';
+    processed_search_string = clean_up_wildcard_search_string(processed_search_string);
+
+    vector<string> dict_vars;
+    size_t begin_pos = 0;
+    size_t end_pos = 0;
+    bool is_var;
+    while (get_bounds_of_next_potential_var(processed_search_string, begin_pos, end_pos, is_var)) {
+        if (false == is_var) {
+            continue;
+        }
+        auto const token = processed_search_string.substr(begin_pos, end_pos - begin_pos);
+        // Skip tokens with wildcards since they may match many dictionary variables, and tokens
+        // with escape characters since their dictionary value differs from the token
+        if (token.find_first_of("*?\\") != string::npos) {
+            continue;
+        }
+        encoded_variable_t encoded_var;
+        if (EncodedVariableInterpreter::convert_string_to_representable_integer_var(
+                    token,
+                    encoded_var
+            )
+            || EncodedVariableInterpreter::convert_string_to_representable_float_var(
+                    token,
+                    encoded_var
+            ))
+        {
+            continue;
+        }
+        dict_vars.push_back(token);
+    }
+    return dict_vars;
+}
+
+bool Grep::archive_may_contain_match(
+        string const& archive_path,
+        vector<string> const& search_strings,
+        bool ignore_case
+) {
+    // The filter is case-sensitive
+    if (ignore_case) {
+        return true;
+    }
+
+    auto const filter_path = archive_path + '/' + streaming_archive::cVarDictBloomFilterFilename;
+    std::optional<BloomFilter> filter;
+    try {
+        filter = BloomFilter::try_read_from_file(filter_path);
+    } catch (TraceableException& e) {
+        SPDLOG_WARN("Failed to read Bloom filter '{}' - {}", filter_path, e.what());
+        return true;
+    }
+    if (false == filter.has_value()) {
+        return true;
+    }
+    return std::any_of(
+            search_strings.cbegin(),
+            search_strings.cend(),
+            [&](string const& search_string) {
+                return filter->possibly_contains_all(
+                        get_dictionary_vars_required_by_query(search_string)
+                );
+            }
+    );
+}
+
 bool Grep::get_bounds_of_next_potential_var(
         string const& value,
         size_t& begin_pos,
@@ -779,7 +854,11 @@ size_t Grep::search_and_output(
         }
 
         // Print match
-        output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+        {
+            Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+        }
+        Metrics::increment(Metrics::Counter::NumMessagesOutput);
         ++num_matches;
     }
 
@@ -976,7 +1055,11 @@ size_t Grep::output_message_in_segment_within_time_range(
             }
             std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
             // Print match
-            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            {
+                Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+                output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            }
+            Metrics::increment(Metrics::Counter::NumMessagesOutput);
             ++num_matches;
         }
         logtype_table_manager.close_logtype_table();
@@ -1043,7 +1126,11 @@ size_t Grep::output_message_in_combined_segment_within_time_range(
                 }
                 std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
                 // Print match
-                output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+                {
+                    Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+                    output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+                }
+                Metrics::increment(Metrics::Counter::NumMessagesOutput);
                 ++num_matches;
             }
             combined_tables.close_logtype_table();
@@ -1119,7 +1206,11 @@ size_t Grep::search_segment_and_output(
             }
             std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
             // Print match
-            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            {
+                Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+                output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            }
+            Metrics::increment(Metrics::Counter::NumMessagesOutput);
             ++logtype_matches;
         }
         logtype_table_manager.close_logtype_table();
@@ -1200,7 +1291,11 @@ size_t Grep::search_combined_table_and_output(
             }
             std::string orig_file_path = archive.get_file_name(compressed_msg.get_file_id());
             // Print match
-            output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            {
+                Metrics::ScopedTimer const output_timer{Metrics::Stage::Output};
+                output_func(orig_file_path, compressed_msg, decompressed_msg, output_func_arg);
+            }
+            Metrics::increment(Metrics::Counter::NumMessagesOutput);
             ++num_matches;
         }
         logtype_table_manager.combined_tables().close_logtype_table();
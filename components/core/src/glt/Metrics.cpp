@@ -0,0 +1,213 @@
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <json/single_include/nlohmann/json.hpp>
+
+#include "FileWriter.hpp"
+#include "spdlog_with_specializations.hpp"
+
+using nlohmann::json;
+using std::string;
+
+namespace {
+constexpr std::array<char const*, glt::enum_to_underlying_type(glt::Metrics::Counter::Length)>
+        cCounterNames{"bytes_read", "num_messages_parsed", "num_messages_output"};
+
+constexpr std::array<char const*, glt::enum_to_underlying_type(glt::Metrics::Stage::Length)>
+        cStageNames{
+                "parse",
+                "dictionary_insert",
+                "compression",
+                "dictionary_load",
+                "table_decompression",
+                "filter_evaluation",
+                "marshalling",
+                "output"
+        };
+}  // namespace
+
+namespace glt {
+std::atomic<bool> Metrics::m_enabled{false};
+std::mutex Metrics::m_thread_metrics_mutex;
+std::vector<std::unique_ptr<Metrics::ThreadMetrics>> Metrics::m_thread_metrics;
+
+Metrics::Exporter::Exporter(string program_name, string path, size_t interval_seconds)
+        : m_program_name{std::move(program_name)},
+          m_path{std::move(path)},
+          m_interval{interval_seconds} {
+    enable();
+    if (m_interval.count() > 0) {
+        m_thread = std::thread(&Exporter::run_periodic_export, this);
+    }
+}
+
+Metrics::Exporter::~Exporter() {
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop_requested = true;
+        }
+        m_stop_cv.notify_one();
+        m_thread.join();
+    }
+
+    try {
+        write_document();
+    } catch (TraceableException& e) {
+        SPDLOG_ERROR("Failed to write metrics to {} - {}", m_path, e.what());
+    }
+}
+
+auto Metrics::Exporter::write_document() const -> void {
+    auto const serialized_document = get_json_document(m_program_name);
+
+    auto const temp_path = m_path + ".tmp";
+    try {
+        FileWriter file_writer;
+        file_writer.open(temp_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+        file_writer.write_string(serialized_document);
+        file_writer.close();
+    } catch (FileWriter::OperationFailed& e) {
+        throw OperationFailed(e.get_error_code(), __FILENAME__, __LINE__);
+    }
+
+    std::error_code error_code;
+    std::filesystem::rename(temp_path, m_path, error_code);
+    if (error_code) {
+        throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+}
+
+auto Metrics::Exporter::run_periodic_export() -> void {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (false == m_stop_cv.wait_for(lock, m_interval, [this] { return m_stop_requested; })) {
+        try {
+            write_document();
+        } catch (TraceableException& e) {
+            SPDLOG_ERROR("Failed to write metrics to {} - {}", m_path, e.what());
+        }
+    }
+}
+
+auto Metrics::record_latency(Stage stage, std::chrono::nanoseconds latency) -> void {
+    if (false == is_enabled()) {
+        return;
+    }
+
+    auto const latency_ns = static_cast<uint64_t>(std::max(latency.count(), int64_t{0}));
+    auto& stage_metrics = get_thread_metrics().stages[enum_to_underlying_type(stage)];
+    add(stage_metrics.count, 1);
+    add(stage_metrics.total_ns, latency_ns);
+    if (latency_ns > stage_metrics.max_ns.load(std::memory_order_relaxed)) {
+        stage_metrics.max_ns.store(latency_ns, std::memory_order_relaxed);
+    }
+    add(stage_metrics.latency_buckets[get_latency_bucket_index(latency_ns)], 1);
+}
+
+auto Metrics::reset() -> void {
+    std::lock_guard<std::mutex> lock(m_thread_metrics_mutex);
+    for (auto& thread_metrics : m_thread_metrics) {
+        for (auto& counter : thread_metrics->counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& stage_metrics : thread_metrics->stages) {
+            stage_metrics.count.store(0, std::memory_order_relaxed);
+            stage_metrics.total_ns.store(0, std::memory_order_relaxed);
+            stage_metrics.max_ns.store(0, std::memory_order_relaxed);
+            for (auto& bucket : stage_metrics.latency_buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+auto Metrics::get_json_document(std::string_view program_name) -> string {
+    std::array<uint64_t, enum_to_underlying_type(Counter::Length)> counters{};
+    struct AggregatedStageMetrics {
+        uint64_t count{0};
+        uint64_t total_ns{0};
+        uint64_t max_ns{0};
+        std::array<uint64_t, cNumLatencyBuckets> latency_buckets{};
+    };
+    std::array<AggregatedStageMetrics, enum_to_underlying_type(Stage::Length)> stages{};
+
+    {
+        std::lock_guard<std::mutex> lock(m_thread_metrics_mutex);
+        for (auto const& thread_metrics : m_thread_metrics) {
+            for (size_t i = 0; i < counters.size(); ++i) {
+                counters[i] += thread_metrics->counters[i].load(std::memory_order_relaxed);
+            }
+            for (size_t i = 0; i < stages.size(); ++i) {
+                auto const& src = thread_metrics->stages[i];
+                auto& dst = stages[i];
+                dst.count += src.count.load(std::memory_order_relaxed);
+                dst.total_ns += src.total_ns.load(std::memory_order_relaxed);
+                dst.max_ns = std::max(dst.max_ns, src.max_ns.load(std::memory_order_relaxed));
+                for (size_t j = 0; j < cNumLatencyBuckets; ++j) {
+                    dst.latency_buckets[j]
+                            += src.latency_buckets[j].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    json document;
+    document["program"] = program_name;
+    document["timestamp_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::system_clock::now().time_since_epoch()
+    )
+                                       .count();
+    auto& counters_json = document["counters"];
+    for (size_t i = 0; i < counters.size(); ++i) {
+        counters_json[cCounterNames[i]] = counters[i];
+    }
+    auto& stages_json = document["stages"];
+    for (size_t i = 0; i < stages.size(); ++i) {
+        auto const& stage = stages[i];
+        auto histogram_json = json::array();
+        for (size_t j = 0; j < cNumLatencyBuckets; ++j) {
+            if (0 == stage.latency_buckets[j]) {
+                continue;
+            }
+            histogram_json.push_back(
+                    {{"max_ns", get_latency_bucket_upper_bound(j)},
+                     {"count", stage.latency_buckets[j]}}
+            );
+        }
+        stages_json[cStageNames[i]]
+                = {{"count", stage.count},
+                   {"total_ns", stage.total_ns},
+                   {"max_ns", stage.max_ns},
+                   {"latency_histogram", std::move(histogram_json)}};
+    }
+    return document.dump();
+}
+
+auto Metrics::get_latency_bucket_index(uint64_t latency_ns) -> size_t {
+    return std::min(static_cast<size_t>(std::bit_width(latency_ns)), cNumLatencyBuckets - 1);
+}
+
+auto Metrics::get_latency_bucket_upper_bound(size_t bucket_index) -> uint64_t {
+    if (bucket_index >= cNumLatencyBuckets - 1) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return (uint64_t{1} << bucket_index) - 1;
+}
+
+auto Metrics::get_thread_metrics() -> ThreadMetrics& {
+    thread_local ThreadMetrics* thread_metrics{nullptr};
+    if (nullptr == thread_metrics) {
+        auto new_thread_metrics = std::make_unique<ThreadMetrics>();
+        thread_metrics = new_thread_metrics.get();
+        std::lock_guard<std::mutex> lock(m_thread_metrics_mutex);
+        m_thread_metrics.emplace_back(std::move(new_thread_metrics));
+    }
+    return *thread_metrics;
+}
+}  // namespace glt
@@ -0,0 +1,238 @@
+#ifndef GLT_METRICS_HPP
+#define GLT_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "TraceableException.hpp"
+#include "type_utils.hpp"
+
+namespace glt {
+/**
+ * Per-stage counters and latency histograms for the hot paths of compression, decompression, and
+ * search, which can be exported as a JSON document for collection by external tools.
+ *
+ * Unlike `Profiler`, metrics are enabled at runtime (see `enable`) and are disabled by default, in
+ * which case recording a metric costs a single relaxed load. When enabled, each thread records into
+ * its own storage, so the hot path never contends with other threads or performs a read-modify-
+ * write; the storage is only aggregated when a document is generated.
+ *
+ * To add a counter or stage, add it to the `Counter` or `Stage` enum and add its name to the
+ * corresponding names array in Metrics.cpp.
+ */
+class Metrics {
+public:
+    // Types
+    enum class Counter : size_t {
+        BytesRead = 0,
+        NumMessagesParsed,
+        NumMessagesOutput,
+        Length
+    };
+
+    enum class Stage : size_t {
+        Parse = 0,
+        DictionaryInsert,
+        Compression,
+        DictionaryLoad,
+        TableDecompression,
+        FilterEvaluation,
+        Marshalling,
+        Output,
+        Length
+    };
+
+    /**
+     * Records the time from its construction to its destruction as a latency of the given stage.
+     */
+    class ScopedTimer {
+    public:
+        // Constructors
+        explicit ScopedTimer(Stage stage) : m_stage{stage}, m_enabled{is_enabled()} {
+            if (m_enabled) {
+                m_begin = std::chrono::steady_clock::now();
+            }
+        }
+
+        // Delete copy & move constructors and assignment operators
+        ScopedTimer(ScopedTimer const&) = delete;
+        ScopedTimer(ScopedTimer&&) = delete;
+        auto operator=(ScopedTimer const&) -> ScopedTimer& = delete;
+        auto operator=(ScopedTimer&&) -> ScopedTimer& = delete;
+
+        // Destructor
+        ~ScopedTimer() {
+            if (m_enabled) {
+                record_latency(m_stage, std::chrono::steady_clock::now() - m_begin);
+            }
+        }
+
+    private:
+        // Variables
+        Stage m_stage;
+        bool m_enabled;
+        std::chrono::steady_clock::time_point m_begin;
+    };
+
+    /**
+     * Enables metrics for the lifetime of the object, writing a metrics document to a file when the
+     * object is destroyed and, optionally, periodically while it's alive. Each document replaces
+     * the previous one atomically, so a reader never sees a partially written document.
+     */
+    class Exporter {
+    public:
+        // Types
+        class OperationFailed : public TraceableException {
+        public:
+            // Constructors
+            OperationFailed(ErrorCode error_code, char const* const filename, int line_number)
+                    : TraceableException(error_code, filename, line_number) {}
+
+            // Methods
+            [[nodiscard]] auto what() const noexcept -> char const* override {
+                return "Metrics::Exporter operation failed";
+            }
+        };
+
+        // Constructors
+        /**
+         * @param program_name Name of the program, included in each document
+         * @param path Path of the file to write the documents to
+         * @param interval_seconds Interval at which to write documents while the exporter is alive,
+         * or 0 to only write a document when the exporter is destroyed
+         */
+        Exporter(std::string program_name, std::string path, size_t interval_seconds);
+
+        // Delete copy & move constructors and assignment operators
+        Exporter(Exporter const&) = delete;
+        Exporter(Exporter&&) = delete;
+        auto operator=(Exporter const&) -> Exporter& = delete;
+        auto operator=(Exporter&&) -> Exporter& = delete;
+
+        // Destructor
+        ~Exporter();
+
+    private:
+        // Methods
+        /**
+         * Writes the current metrics document to the file.
+         * @throw OperationFailed if the file couldn't be written
+         */
+        auto write_document() const -> void;
+
+        auto run_periodic_export() -> void;
+
+        // Variables
+        std::string m_program_name;
+        std::string m_path;
+        std::chrono::seconds m_interval;
+        std::mutex m_mutex;
+        std::condition_variable m_stop_cv;
+        bool m_stop_requested{false};
+        std::thread m_thread;
+    };
+
+    // Constants
+    // Latencies are recorded in buckets with power-of-two upper bounds, in nanoseconds
+    static constexpr size_t cNumLatencyBuckets{48};
+
+    // Methods
+    [[nodiscard]] static auto is_enabled() -> bool {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    static auto enable() -> void { m_enabled.store(true, std::memory_order_relaxed); }
+
+    static auto disable() -> void { m_enabled.store(false, std::memory_order_relaxed); }
+
+    /**
+     * Adds the given value to a counter, if metrics are enabled.
+     * @param counter
+     * @param value
+     */
+    static auto increment(Counter counter, uint64_t value = 1) -> void {
+        if (false == is_enabled()) {
+            return;
+        }
+        add(get_thread_metrics().counters[enum_to_underlying_type(counter)], value);
+    }
+
+    /**
+     * Records a latency for a stage, if metrics are enabled.
+     * @param stage
+     * @param latency
+     */
+    static auto record_latency(Stage stage, std::chrono::nanoseconds latency) -> void;
+
+    /**
+     * Resets all metrics recorded so far. This should only be called while no other thread is
+     * recording metrics.
+     */
+    static auto reset() -> void;
+
+    /**
+     * @param program_name
+     * @return A JSON document containing the given program name, the current time, and the metrics
+     * recorded so far, aggregated across all threads
+     */
+    [[nodiscard]] static auto get_json_document(std::string_view program_name) -> std::string;
+
+    /**
+     * @param latency_ns
+     * @return The index of the bucket the given latency belongs to
+     */
+    [[nodiscard]] static auto get_latency_bucket_index(uint64_t latency_ns) -> size_t;
+
+    /**
+     * @param bucket_index
+     * @return The inclusive upper bound of the given bucket, in nanoseconds
+     */
+    [[nodiscard]] static auto get_latency_bucket_upper_bound(size_t bucket_index) -> uint64_t;
+
+private:
+    // Types
+    struct StageMetrics {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+        std::array<std::atomic<uint64_t>, cNumLatencyBuckets> latency_buckets{};
+    };
+
+    /**
+     * A thread's metrics. Only the owning thread writes to them, so updates don't need to be
+     * atomic read-modify-writes; the atomics only allow other threads to read them concurrently.
+     */
+    struct ThreadMetrics {
+        std::array<std::atomic<uint64_t>, enum_to_underlying_type(Counter::Length)> counters{};
+        std::array<StageMetrics, enum_to_underlying_type(Stage::Length)> stages{};
+    };
+
+    // Methods
+    static auto add(std::atomic<uint64_t>& value, uint64_t addend) -> void {
+        value.store(value.load(std::memory_order_relaxed) + addend, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The calling thread's metrics, which are registered the first time they're needed
+     */
+    [[nodiscard]] static auto get_thread_metrics() -> ThreadMetrics&;
+
+    // Variables
+    static std::atomic<bool> m_enabled;
+    static std::mutex m_thread_metrics_mutex;
+    static std::vector<std::unique_ptr<ThreadMetrics>> m_thread_metrics;
+};
+}  // namespace glt
+
+#endif  // GLT_METRICS_HPP
@@ -0,0 +1,413 @@
+#include "TimestampFormatter.hpp"
+
+#include <chrono>
+#include <limits>
+
+#include <date/include/date/date.h>
+
+#include "spdlog_with_specializations.hpp"
+
+using std::string;
+using std::to_string;
+
+namespace {
+enum class ParserState {
+    Literal = 0,
+    FormatSpecifier,
+    RelativeTimestampUnit
+};
+}  // namespace
+
+// File-scope constants
+static constexpr int64_t cNumMillisecondsInSecond = 1000;
+static constexpr int64_t cNumMillisecondsInMinute = 60 * cNumMillisecondsInSecond;
+static constexpr int64_t cNumMillisecondsInHour = 60 * cNumMillisecondsInMinute;
+static constexpr int64_t cNumMillisecondsInDay = 24 * cNumMillisecondsInHour;
+static constexpr size_t cMillisecondLength = 3;
+static constexpr int cNumDaysInWeek = 7;
+static char const* cAbbrevDaysOfWeek[cNumDaysInWeek]
+        = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static constexpr int cNumMonths = 12;
+static char const* cAbbrevMonthNames[cNumMonths]
+        = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+static char const* cMonthNames[cNumMonths]
+        = {"January",
+           "February",
+           "March",
+           "April",
+           "May",
+           "June",
+           "July",
+           "August",
+           "September",
+           "October",
+           "November",
+           "December"};
+
+// File-scope functions
+/**
+ * Converts a value to a padded string with the given length and appends it to the given string
+ * @param value
+ * @param padding_character
+ * @param length
+ * @param str
+ */
+static void append_padded_value(int value, char padding_character, size_t length, string& str);
+
+/**
+ * Writes a 0-padded value with the given length into the given string, overwriting the characters
+ * at the given position
+ * @param value A non-negative value that fits in the given length
+ * @param length
+ * @param pos
+ * @param str
+ */
+static void write_zero_padded_value(int value, size_t length, size_t pos, string& str);
+
+/**
+ * Divides the given dividend by the given divisor, rounding towards negative infinity
+ * @param dividend
+ * @param divisor
+ * @return The quotient
+ */
+static int64_t floor_divide(int64_t dividend, int64_t divisor);
+
+static void append_padded_value(
+        int const value,
+        char const padding_character,
+        size_t const length,
+        string& str
+) {
+    char digits[std::numeric_limits<int>::digits10 + 1];
+    size_t num_digits = 0;
+    if (value >= 0) {
+        int remaining_value = value;
+        do {
+            digits[num_digits++] = static_cast<char>('0' + remaining_value % 10);
+            remaining_value /= 10;
+        } while (remaining_value > 0);
+    }
+    if (value < 0 || num_digits > length) {
+        // Handle values that don't fit in the given length the same way as TimestampPattern
+        string value_str = to_string(value);
+        str.append(length - value_str.length(), padding_character);
+        str += value_str;
+        return;
+    }
+
+    str.append(length - num_digits, padding_character);
+    while (num_digits > 0) {
+        str += digits[--num_digits];
+    }
+}
+
+static void write_zero_padded_value(int value, size_t const length, size_t const pos, string& str) {
+    for (size_t i = pos + length; i > pos; --i) {
+        str[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+static int64_t floor_divide(int64_t const dividend, int64_t const divisor) {
+    auto quotient = dividend / divisor;
+    if (dividend % divisor < 0) {
+        --quotient;
+    }
+    return quotient;
+}
+
+namespace glt {
+void TimestampFormatter::set_pattern(TimestampPattern const& pattern) {
+    if (m_is_compiled && pattern == m_pattern) {
+        return;
+    }
+    m_pattern = pattern;
+    m_is_compiled = true;
+    m_fields.clear();
+    m_has_unsupported_field = false;
+    m_has_relative_field = false;
+    m_is_formatted_timestamp_cached = false;
+
+    auto add_literal = [&](char c) {
+        if (m_fields.empty() || FieldType::Literal != m_fields.back().type) {
+            m_fields.push_back({FieldType::Literal, {}});
+        }
+        m_fields.back().literal += c;
+    };
+    auto add_field = [&](FieldType type) { m_fields.push_back({type, {}}); };
+
+    auto const& format = m_pattern.get_format();
+    ParserState state = ParserState::Literal;
+    for (auto const c : format) {
+        switch (state) {
+            case ParserState::Literal:
+                if ('%' == c) {
+                    state = ParserState::FormatSpecifier;
+                } else {
+                    add_literal(c);
+                }
+                break;
+            case ParserState::FormatSpecifier:
+                state = ParserState::Literal;
+                switch (c) {
+                    case '%':
+                        add_literal(c);
+                        break;
+                    case 'y':
+                        add_field(FieldType::TwoDigitYear);
+                        break;
+                    case 'Y':
+                        add_field(FieldType::FourDigitYear);
+                        break;
+                    case 'B':
+                        add_field(FieldType::MonthName);
+                        break;
+                    case 'b':
+                        add_field(FieldType::AbbrevMonthName);
+                        break;
+                    case 'm':
+                        add_field(FieldType::ZeroPaddedMonth);
+                        break;
+                    case 'd':
+                        add_field(FieldType::ZeroPaddedDay);
+                        break;
+                    case 'e':
+                        add_field(FieldType::SpacePaddedDay);
+                        break;
+                    case 'a':
+                        add_field(FieldType::AbbrevDayOfWeek);
+                        break;
+                    case 'p':
+                        add_field(FieldType::PartOfDay);
+                        break;
+                    case 'H':
+                        add_field(FieldType::ZeroPadded24Hour);
+                        break;
+                    case 'k':
+                        add_field(FieldType::SpacePadded24Hour);
+                        break;
+                    case 'I':
+                        add_field(FieldType::ZeroPadded12Hour);
+                        break;
+                    case 'l':
+                        add_field(FieldType::SpacePadded12Hour);
+                        break;
+                    case 'M':
+                        add_field(FieldType::ZeroPaddedMinute);
+                        break;
+                    case 'S':
+                        add_field(FieldType::ZeroPaddedSecond);
+                        break;
+                    case '3':
+                        add_field(FieldType::ZeroPaddedMillisecond);
+                        break;
+                    case '#':
+                        state = ParserState::RelativeTimestampUnit;
+                        break;
+                    default:
+                        m_has_unsupported_field = true;
+                        return;
+                }
+                break;
+            case ParserState::RelativeTimestampUnit:
+                state = ParserState::Literal;
+                m_has_relative_field = true;
+                switch (c) {
+                    case '3':
+                        add_field(FieldType::RelativeMilliseconds);
+                        break;
+                    case '6':
+                        add_field(FieldType::RelativeMicroseconds);
+                        break;
+                    case '9':
+                        add_field(FieldType::RelativeNanoseconds);
+                        break;
+                    default:
+                        m_has_unsupported_field = true;
+                        return;
+                }
+                break;
+        }
+    }
+}
+
+void TimestampFormatter::insert_formatted_timestamp(epochtime_t const timestamp, string& msg) {
+    if (false == m_is_compiled) {
+        throw TimestampPattern::OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
+    }
+
+    // Find where timestamp should go
+    auto const num_spaces_before_ts = m_pattern.get_num_spaces_before_ts();
+    size_t const msg_length = msg.length();
+    size_t ts_begin_ix = 0;
+    int num_spaces_found;
+    for (num_spaces_found = 0; num_spaces_found < num_spaces_before_ts && ts_begin_ix < msg_length;
+         ++ts_begin_ix)
+    {
+        if (' ' == msg[ts_begin_ix]) {
+            ++num_spaces_found;
+        }
+    }
+    if (num_spaces_found < num_spaces_before_ts) {
+        SPDLOG_ERROR(
+                "{} has {} spaces, but pattern has {}",
+                msg.c_str(),
+                num_spaces_found,
+                num_spaces_before_ts
+        );
+        throw TimestampPattern::OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
+    }
+    if (m_has_unsupported_field) {
+        throw TimestampPattern::OperationFailed(ErrorCode_Unsupported, __FILENAME__, __LINE__);
+    }
+
+    auto const second = floor_divide(timestamp, cNumMillisecondsInSecond);
+    if (m_is_formatted_timestamp_cached && false == m_has_relative_field
+        && second == m_cached_second)
+    {
+        // Only the milliseconds changed
+        auto const millisecond = static_cast<int>(timestamp - second * cNumMillisecondsInSecond);
+        for (auto const offset : m_millisecond_offsets) {
+            write_zero_padded_value(millisecond, cMillisecondLength, offset, m_formatted_timestamp);
+        }
+    } else {
+        auto const day = floor_divide(timestamp, cNumMillisecondsInDay);
+        update_cached_date(day);
+        format_timestamp(timestamp, timestamp - day * cNumMillisecondsInDay);
+        m_cached_second = second;
+        m_is_formatted_timestamp_cached = true;
+    }
+
+    msg.insert(ts_begin_ix, m_formatted_timestamp);
+}
+
+void TimestampFormatter::update_cached_date(int64_t const day) {
+    if (m_is_date_cached && day == m_cached_day) {
+        return;
+    }
+
+    date::sys_days const timestamp_date{date::days{day}};
+    m_day_of_week_ix = static_cast<int>((date::weekday{timestamp_date} - date::Sunday).count());
+    date::year_month_day const year_month_date{timestamp_date};
+    m_day_in_month = static_cast<unsigned>(year_month_date.day());
+    m_month = static_cast<unsigned>(year_month_date.month());
+    m_year = static_cast<int>(year_month_date.year());
+
+    m_cached_day = day;
+    m_is_date_cached = true;
+}
+
+void TimestampFormatter::format_timestamp(epochtime_t const timestamp, int64_t const time_of_day) {
+    auto const hour = static_cast<int>(time_of_day / cNumMillisecondsInHour);
+    auto const minute
+            = static_cast<int>(time_of_day % cNumMillisecondsInHour / cNumMillisecondsInMinute);
+    auto const second
+            = static_cast<int>(time_of_day % cNumMillisecondsInMinute / cNumMillisecondsInSecond);
+    auto const millisecond = static_cast<int>(time_of_day % cNumMillisecondsInSecond);
+
+    m_formatted_timestamp.clear();
+    m_millisecond_offsets.clear();
+    for (auto const& field : m_fields) {
+        switch (field.type) {
+            case FieldType::Literal:
+                m_formatted_timestamp += field.literal;
+                break;
+            case FieldType::TwoDigitYear: {
+                int value = m_year;
+                if (m_year >= 2000) {
+                    // year must be in range [2000,2068]
+                    value -= 2000;
+                } else {
+                    // year must be in range [1969,1999]
+                    value -= 1900;
+                }
+                append_padded_value(value, '0', 2, m_formatted_timestamp);
+                break;
+            }
+            case FieldType::FourDigitYear:
+                append_padded_value(m_year, '0', 4, m_formatted_timestamp);
+                break;
+            case FieldType::MonthName:
+                m_formatted_timestamp += cMonthNames[m_month - 1];
+                break;
+            case FieldType::AbbrevMonthName:
+                m_formatted_timestamp += cAbbrevMonthNames[m_month - 1];
+                break;
+            case FieldType::ZeroPaddedMonth:
+                append_padded_value(static_cast<int>(m_month), '0', 2, m_formatted_timestamp);
+                break;
+            case FieldType::ZeroPaddedDay:
+                append_padded_value(
+                        static_cast<int>(m_day_in_month),
+                        '0',
+                        2,
+                        m_formatted_timestamp
+                );
+                break;
+            case FieldType::SpacePaddedDay:
+                append_padded_value(
+                        static_cast<int>(m_day_in_month),
+                        ' ',
+                        2,
+                        m_formatted_timestamp
+                );
+                break;
+            case FieldType::AbbrevDayOfWeek:
+                m_formatted_timestamp += cAbbrevDaysOfWeek[m_day_of_week_ix];
+                break;
+            case FieldType::PartOfDay:
+                m_formatted_timestamp += (hour > 11) ? "PM" : "AM";
+                break;
+            case FieldType::ZeroPadded24Hour:
+                append_padded_value(hour, '0', 2, m_formatted_timestamp);
+                break;
+            case FieldType::SpacePadded24Hour:
+                append_padded_value(hour, ' ', 2, m_formatted_timestamp);
+                break;
+            case FieldType::ZeroPadded12Hour:
+            case FieldType::SpacePadded12Hour: {
+                // NOTE: This matches TimestampPattern::insert_formatted_timestamp
+                int value = hour;
+                if (0 == value) {
+                    value = 12;
+                } else if (value > 13) {
+                    value -= 12;
+                }
+                auto const padding_character
+                        = (FieldType::ZeroPadded12Hour == field.type) ? '0' : ' ';
+                append_padded_value(value, padding_character, 2, m_formatted_timestamp);
+                break;
+            }
+            case FieldType::ZeroPaddedMinute:
+                append_padded_value(minute, '0', 2, m_formatted_timestamp);
+                break;
+            case FieldType::ZeroPaddedSecond:
+                append_padded_value(second, '0', 2, m_formatted_timestamp);
+                break;
+            case FieldType::ZeroPaddedMillisecond:
+                m_millisecond_offsets.push_back(m_formatted_timestamp.length());
+                append_padded_value(millisecond, '0', cMillisecondLength, m_formatted_timestamp);
+                break;
+            case FieldType::RelativeMilliseconds:
+                m_formatted_timestamp += to_string(timestamp);
+                break;
+            case FieldType::RelativeMicroseconds: {
+                auto const microsecond_duration
+                        = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::milliseconds{timestamp}
+                        );
+                m_formatted_timestamp += to_string(microsecond_duration.count());
+                break;
+            }
+            case FieldType::RelativeNanoseconds: {
+                auto const nanosecond_duration
+                        = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::milliseconds{timestamp}
+                        );
+                m_formatted_timestamp += to_string(nanosecond_duration.count());
+                break;
+            }
+        }
+    }
+}
+}  // namespace glt
@@ -0,0 +1,122 @@
+#ifndef GLT_TIMESTAMPFORMATTER_HPP
+#define GLT_TIMESTAMPFORMATTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Defs.h"
+#include "TimestampPattern.hpp"
+
+namespace glt {
+/**
+ * Class to format timestamps using a compiled timestamp pattern. When formatting many timestamps
+ * with the same pattern (e.g., while decompressing a file), this is much faster than
+ * `TimestampPattern::insert_formatted_timestamp`, which interprets the pattern's format string and
+ * converts the timestamp into a calendar date for every timestamp.
+ *
+ * The pattern's format string is compiled into a sequence of fields once. In addition, the
+ * formatter caches the calendar date of the last timestamp it formatted, as well as the formatted
+ * timestamp itself. So consecutive timestamps in the same day are formatted without converting
+ * them into a calendar date, and consecutive timestamps in the same second are formatted by only
+ * patching their milliseconds into the cached formatted timestamp.
+ *
+ * Since it caches the last timestamp it formatted, a formatter isn't thread-safe.
+ */
+class TimestampFormatter {
+public:
+    // Constructors
+    TimestampFormatter() = default;
+
+    explicit TimestampFormatter(TimestampPattern const& pattern) { set_pattern(pattern); }
+
+    // Methods
+    TimestampPattern const& get_pattern() const { return m_pattern; }
+
+    /**
+     * Compiles the given pattern, unless it's the pattern that's already compiled
+     * @param pattern
+     */
+    void set_pattern(TimestampPattern const& pattern);
+
+    /**
+     * Inserts the timestamp into the given message using the compiled pattern. The timestamp is
+     * inserted in place, so the message is only reallocated if it doesn't have the capacity for
+     * the timestamp.
+     * @param timestamp
+     * @param msg
+     * @throw TimestampPattern::OperationFailed if the the pattern contains unsupported format
+     * specifiers or the message cannot fit the timestamp pattern
+     */
+    void insert_formatted_timestamp(epochtime_t timestamp, std::string& msg);
+
+private:
+    // Types
+    enum class FieldType : uint8_t {
+        Literal = 0,
+        TwoDigitYear,
+        FourDigitYear,
+        MonthName,
+        AbbrevMonthName,
+        ZeroPaddedMonth,
+        ZeroPaddedDay,
+        SpacePaddedDay,
+        AbbrevDayOfWeek,
+        PartOfDay,
+        ZeroPadded24Hour,
+        SpacePadded24Hour,
+        ZeroPadded12Hour,
+        SpacePadded12Hour,
+        ZeroPaddedMinute,
+        ZeroPaddedSecond,
+        ZeroPaddedMillisecond,
+        RelativeMilliseconds,
+        RelativeMicroseconds,
+        RelativeNanoseconds
+    };
+
+    struct Field {
+        FieldType type;
+        // Only used by literal fields
+        std::string literal;
+    };
+
+    // Methods
+    /**
+     * Converts the given day into a calendar date, unless it's the day that's already cached
+     * @param day Number of days since the UNIX epoch
+     */
+    void update_cached_date(int64_t day);
+
+    /**
+     * Formats the given timestamp into m_formatted_timestamp, using the cached calendar date
+     * @param timestamp
+     * @param time_of_day Number of milliseconds since the beginning of the timestamp's day
+     */
+    void format_timestamp(epochtime_t timestamp, int64_t time_of_day);
+
+    // Variables
+    TimestampPattern m_pattern;
+    bool m_is_compiled{false};
+    std::vector<Field> m_fields;
+    bool m_has_unsupported_field{false};
+    bool m_has_relative_field{false};
+
+    // The calendar date of the last timestamp formatted
+    bool m_is_date_cached{false};
+    int64_t m_cached_day{0};
+    int m_year{0};
+    unsigned m_month{0};
+    unsigned m_day_in_month{0};
+    int m_day_of_week_ix{0};
+
+    // The last timestamp formatted and the offsets of its milliseconds fields
+    bool m_is_formatted_timestamp_cached{false};
+    epochtime_t m_cached_second{0};
+    std::string m_formatted_timestamp;
+    std::vector<size_t> m_millisecond_offsets;
+};
+}  // namespace glt
+
+#endif  // GLT_TIMESTAMPFORMATTER_HPP
@@ -59,6 +59,20 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
                             ->value_name("FILE")
                             ->default_value(global_metadata_db_config_file_path),
                     "Global metadata DB YAML config"
+            )
+            (
+                    "metrics-file",
+                    po::value<string>(&m_metrics_file_path)
+                            ->value_name("FILE")
+                            ->default_value(m_metrics_file_path),
+                    "Collect metrics and write them to FILE as a JSON document when the run ends"
+            )
+            (
+                    "metrics-interval",
+                    po::value<size_t>(&m_metrics_interval)
+                            ->value_name("SECONDS")
+                            ->default_value(m_metrics_interval),
+                    "Also write metrics to the metrics file every SECONDS (0 = disabled)"
             );
 
     po::options_description general_positional_options;
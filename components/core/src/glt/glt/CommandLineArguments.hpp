@@ -76,6 +76,10 @@ public:
 
     GlobalMetadataDBConfig const& get_metadata_db_config() const { return m_metadata_db_config; }
 
+    std::string const& get_metrics_file_path() const { return m_metrics_file_path; }
+
+    size_t get_metrics_interval() const { return m_metrics_interval; }
+
     // Search arguments
     std::string const& get_search_strings_file_path() const { return m_search_strings_file_path; }
 
@@ -113,6 +117,8 @@ private:
     std::string m_archives_dir;
     std::vector<std::string> m_input_paths;
     GlobalMetadataDBConfig m_metadata_db_config;
+    std::string m_metrics_file_path;
+    size_t m_metrics_interval{0};
 
     // Search related variables
     std::string m_search_strings_file_path;
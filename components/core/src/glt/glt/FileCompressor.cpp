@@ -11,6 +11,7 @@
 #include "../ffi/ir_stream/decoding_methods.hpp"
 #include "../ir/types.hpp"
 #include "../ir/utils.hpp"
+#include "../Metrics.hpp"
 #include "../Profiler.hpp"
 #include "../streaming_archive/writer/utils.hpp"
 #include "utils.hpp"
@@ -98,6 +99,7 @@ static void write_message_to_encoded_file(
     }
 
     archive.write_msg(msg.get_ts(), msg.get_content(), msg.get_orig_num_bytes());
+    glt::Metrics::increment(glt::Metrics::Counter::NumMessagesParsed);
 }
 
 namespace glt::glt {
@@ -112,6 +114,7 @@ bool FileCompressor::compress_file(
 
     PROFILER_SPDLOG_INFO("Start parsing {}", file_name)
     Profiler::start_continuous_measurement<Profiler::ContinuousMeasurementIndex::ParseLogFile>();
+    Metrics::ScopedTimer const parse_timer{Metrics::Stage::Parse};
 
     m_file_reader.open(file_to_compress.get_path());
 
@@ -162,6 +165,7 @@ bool FileCompressor::compress_file(
         }
     }
 
+    Metrics::increment(Metrics::Counter::BytesRead, m_file_reader.get_pos());
     m_file_reader.close();
 
     Profiler::stop_continuous_measurement<Profiler::ContinuousMeasurementIndex::ParseLogFile>();
@@ -544,6 +544,19 @@ bool search(CommandLineArguments& command_line_args) {
             continue;
         }
 
+        // Skip the archive without opening it if its variable dictionary filter shows that it
+        // can't contain a match
+        if (false
+            == Grep::archive_may_contain_match(
+                    archive_path.string(),
+                    search_strings,
+                    command_line_args.ignore_case()
+            ))
+        {
+            SPDLOG_DEBUG("Skipping archive {} since it can't contain a match.", archive_id);
+            continue;
+        }
+
         // Open archive
         if (!open_archive(archive_path.string(), archive_reader)) {
             return false;
@@ -12,6 +12,7 @@ constexpr char cVarDictFilename[] = "var.dict";
 constexpr char cFileNameDictFilename[] = "filename.dict";
 constexpr char cLogTypeSegmentIndexFilename[] = "logtype.segindex";
 constexpr char cVarSegmentIndexFilename[] = "var.segindex";
+constexpr char cVarDictBloomFilterFilename[] = "var.bloom";
 constexpr char cMetadataFileName[] = "metadata";
 constexpr char cMetadataDBFileName[] = "metadata.db";
 constexpr char cVarSegmentFileName[] = "variable_segments";
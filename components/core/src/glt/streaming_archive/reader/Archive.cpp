@@ -10,6 +10,7 @@
 #include <string_utils/string_utils.hpp>
 
 #include "../../EncodedVariableInterpreter.hpp"
+#include "../../Metrics.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../../streaming_compression/passthrough/Compressor.hpp"
 #include "../../streaming_compression/zstd/Compressor.hpp"
@@ -188,6 +189,7 @@ bool Archive::decompress_message(
         Message const& compressed_msg,
         string& decompressed_msg
 ) {
+    Metrics::ScopedTimer const marshalling_timer{Metrics::Stage::Marshalling};
     decompressed_msg.clear();
 
     // Build original message content
@@ -227,7 +229,10 @@ bool Archive::decompress_message(
             }
             file.increment_current_ts_pattern_ix();
         }
-        timestamp_patterns[file.get_current_ts_pattern_ix()].second.insert_formatted_timestamp(
+        auto const& timestamp_pattern
+                = timestamp_patterns[file.get_current_ts_pattern_ix()].second;
+        m_timestamp_formatter.set_pattern(timestamp_pattern);
+        m_timestamp_formatter.insert_formatted_timestamp(
                 compressed_msg.get_ts_in_milli(),
                 decompressed_msg
         );
@@ -343,6 +348,7 @@ bool Archive::find_message_matching_with_logtype_query_from_combined(
         size_t left_boundary,
         size_t right_boundary
 ) {
+    Metrics::ScopedTimer const filter_timer{Metrics::Stage::FilterEvaluation};
     auto& combined_tables = m_logtype_table_manager.combined_tables();
     while (true) {
         // break if there's no next message
@@ -372,6 +378,7 @@ bool Archive::find_message_matching_with_logtype_query(
         bool& wildcard,
         Query const& query
 ) {
+    Metrics::ScopedTimer const filter_timer{Metrics::Stage::FilterEvaluation};
     while (true) {
         if (!m_logtype_table_manager.get_next_row(msg)) {
             break;
@@ -397,6 +404,7 @@ void Archive::find_message_matching_with_logtype_query_optimized(
         std::vector<bool>& wildcard,
         Query const& query
 ) {
+    Metrics::ScopedTimer const filter_timer{Metrics::Stage::FilterEvaluation};
     epochtime_t ts;
     auto& logtype_table = m_logtype_table_manager.logtype_table();
     size_t num_row = logtype_table.get_num_row();
@@ -459,9 +467,7 @@ size_t Archive::decompress_messages_and_output(
             throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
         }
         if (ts[ix] != 0) {
-            std::string const fixed_timestamp_pattern = "%Y-%m-%d %H:%M:%S,%3";
-            TimestampPattern ts_pattern(0, fixed_timestamp_pattern);
-            ts_pattern.insert_formatted_timestamp(ts[ix], decompressed_msg);
+            m_fixed_timestamp_formatter.insert_formatted_timestamp(ts[ix], decompressed_msg);
         }
         // Perform wildcard match if required
         // Check if:
@@ -492,6 +498,7 @@ bool Archive::decompress_message_with_fixed_timestamp_pattern(
         Message const& compressed_msg,
         std::string& decompressed_msg
 ) {
+    Metrics::ScopedTimer const marshalling_timer{Metrics::Stage::Marshalling};
     decompressed_msg.clear();
 
     // Build original message content
@@ -512,9 +519,10 @@ bool Archive::decompress_message_with_fixed_timestamp_pattern(
         return false;
     }
     if (compressed_msg.get_ts_in_milli() != 0) {
-        std::string const fixed_timestamp_pattern = "%Y-%m-%d %H:%M:%S,%3";
-        TimestampPattern ts_pattern(0, fixed_timestamp_pattern);
-        ts_pattern.insert_formatted_timestamp(compressed_msg.get_ts_in_milli(), decompressed_msg);
+        m_fixed_timestamp_formatter.insert_formatted_timestamp(
+                compressed_msg.get_ts_in_milli(),
+                decompressed_msg
+        );
     }
     return true;
 }
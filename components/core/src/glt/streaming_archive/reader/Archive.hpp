@@ -12,6 +12,7 @@
 #include "../../LogTypeDictionaryReader.hpp"
 #include "../../Query.hpp"
 #include "../../SQLiteDB.hpp"
+#include "../../TimestampFormatter.hpp"
 #include "../../VariableDictionaryReader.hpp"
 #include "../MetadataDB.hpp"
 #include "File.hpp"
@@ -244,6 +245,11 @@ private:
 
     MetadataDB m_metadata_db;
 
+    // Formatter for the timestamp pattern of the last message decompressed
+    TimestampFormatter m_timestamp_formatter;
+    // Formatter for the fixed timestamp pattern used when decompressing search results
+    TimestampFormatter m_fixed_timestamp_formatter{TimestampPattern{0, "%Y-%m-%d %H:%M:%S,%3"}};
+
     // GLT Specific
     segment_id_t m_current_segment_id;
     GLTSegment m_segment;
@@ -2,6 +2,7 @@
 
 #include <set>
 
+#include "../../Metrics.hpp"
 #include "../LogtypeSizeTracker.hpp"
 
 using glt::streaming_archive::LogtypeSizeTracker;
@@ -43,6 +44,7 @@ void MultiLogtypeTablesManager::load_variable_columns(logtype_dictionary_id_t lo
     if (!m_is_open) {
         throw OperationFailed(ErrorCode_NotInit, __FILENAME__, __LINE__);
     }
+    Metrics::ScopedTimer const decompression_timer{Metrics::Stage::TableDecompression};
     if (m_logtype_table_metadata.find(logtype_id) != m_logtype_table_metadata.end()) {
         if (m_logtype_tables.find(logtype_id) != m_logtype_tables.end()) {
             throw OperationFailed(ErrorCode_Failure, __FILENAME__, __LINE__);
@@ -8,6 +8,7 @@
 #include <boost/filesystem.hpp>
 
 #include "../../FileReader.hpp"
+#include "../../Metrics.hpp"
 #include "../../spdlog_with_specializations.hpp"
 
 using std::make_unique;
@@ -96,6 +97,7 @@ Segment::try_read(uint64_t decompressed_stream_pos, char* extraction_buf, uint64
                      "during decompression");
         return ErrorCode_BadParam;
     }
+    Metrics::ScopedTimer const decompression_timer{Metrics::Stage::TableDecompression};
     return m_decompressor.get_decompressed_stream_region(
             decompressed_stream_pos,
             extraction_buf,
@@ -2,6 +2,7 @@
 
 #include <queue>
 
+#include "../../Metrics.hpp"
 #include "../LogtypeSizeTracker.hpp"
 
 namespace glt::streaming_archive::reader {
@@ -32,6 +33,7 @@ bool SingleLogtypeTableManager::peek_next_ts(epochtime_t& ts) {
 }
 
 void SingleLogtypeTableManager::load_all() {
+    Metrics::ScopedTimer const decompression_timer{Metrics::Stage::TableDecompression};
     m_logtype_table.load_all();
 }
 
@@ -40,10 +42,12 @@ void SingleLogtypeTableManager::skip_row() {
 }
 
 void SingleLogtypeTableManager::load_partial_columns(size_t l, size_t r) {
+    Metrics::ScopedTimer const decompression_timer{Metrics::Stage::TableDecompression};
     m_logtype_table.load_variable_columns(l, r);
 }
 
 void SingleLogtypeTableManager::load_ts() {
+    Metrics::ScopedTimer const decompression_timer{Metrics::Stage::TableDecompression};
     m_logtype_table.load_timestamp();
 }
 
@@ -62,6 +66,7 @@ void SingleLogtypeTableManager::close_combined_table() {
 
 void SingleLogtypeTableManager::load_logtype_table_from_combine(logtype_dictionary_id_t logtype_id
 ) {
+    Metrics::ScopedTimer const decompression_timer{Metrics::Stage::TableDecompression};
     m_combined_tables.load_logtype_table(
             logtype_id,
             m_combined_table_decompressor,
@@ -14,6 +14,7 @@
 
 #include "../../EncodedVariableInterpreter.hpp"
 #include "../../ir/types.hpp"
+#include "../../Metrics.hpp"
 #include "../../spdlog_with_specializations.hpp"
 #include "../../Utils.hpp"
 #include "../Constants.hpp"
@@ -209,6 +210,7 @@ void Archive::close() {
 
     // Persist all metadata including dictionaries
     write_dir_snapshot();
+    write_var_dict_bloom_filter();
 
     m_logtype_dict.close();
     m_logtype_dict_entry.clear();
@@ -284,15 +286,18 @@ void Archive::write_msg(
     // Encode message and add components to dictionaries
     vector<encoded_variable_t> encoded_vars;
     vector<variable_dictionary_id_t> var_ids;
-    EncodedVariableInterpreter::encode_and_add_to_dictionary(
-            message,
-            m_logtype_dict_entry,
-            m_var_dict,
-            encoded_vars,
-            var_ids
-    );
     logtype_dictionary_id_t logtype_id;
-    m_logtype_dict.add_entry(m_logtype_dict_entry, logtype_id);
+    {
+        Metrics::ScopedTimer const insert_timer{Metrics::Stage::DictionaryInsert};
+        EncodedVariableInterpreter::encode_and_add_to_dictionary(
+                message,
+                m_logtype_dict_entry,
+                m_var_dict,
+                encoded_vars,
+                var_ids
+        );
+        m_logtype_dict.add_entry(m_logtype_dict_entry, logtype_id);
+    }
     size_t offset = m_glt_segment.append_to_segment(logtype_id, timestamp, m_file_id, encoded_vars);
     // Issue: the offset of var_segments is per file based. However, we still need to add the offset
     // of segments. the offset of segment is not known because we don't know if the segment should
@@ -464,4 +469,14 @@ void Archive::update_metadata() {
                   << std::endl;
     }
 }
+
+void Archive::write_var_dict_bloom_filter() {
+    FileWriter filter_writer;
+    filter_writer.open(
+            m_path + '/' + cVarDictBloomFilterFilename,
+            FileWriter::OpenMode::CREATE_FOR_WRITING
+    );
+    m_var_dict.build_bloom_filter(cVarDictBloomFilterFalsePositiveRate).write(filter_writer);
+    filter_writer.close();
+}
 }  // namespace glt::streaming_archive::writer
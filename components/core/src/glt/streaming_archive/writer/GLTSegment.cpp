@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "../../Metrics.hpp"
 #include "../LogtypeSizeTracker.hpp"
 
 using glt::streaming_archive::LogtypeSizeTracker;
@@ -48,6 +49,7 @@ bool GLTSegment::is_open() const {
 }
 
 void GLTSegment::compress_logtype_tables_to_disk() {
+    Metrics::ScopedTimer const compression_timer{Metrics::Stage::Compression};
     std::string segment_var_directory = m_segment_path + cVariablesFileExtension;
     // Create output directory in case it doesn't exist
     auto error_code = create_directory(segment_var_directory, 0700, true);
@@ -8,6 +8,7 @@
 
 #include "../../ErrorCode.hpp"
 #include "../../FileWriter.hpp"
+#include "../../Metrics.hpp"
 #include "../../spdlog_with_specializations.hpp"
 
 using std::make_unique;
@@ -51,6 +52,7 @@ void Segment::open(string const& segments_dir_path, segment_id_t id, int compres
 }
 
 void Segment::close() {
+    Metrics::ScopedTimer const compression_timer{Metrics::Stage::Compression};
     m_compressor.close();
     m_compressed_size = m_file_writer.get_pos();
 
@@ -63,7 +65,10 @@ void Segment::close() {
 
 void Segment::append(char const* buf, uint64_t const buf_len, uint64_t& offset) {
     // Compress
-    m_compressor.write(buf, buf_len);
+    {
+        Metrics::ScopedTimer const compression_timer{Metrics::Stage::Compression};
+        m_compressor.write(buf, buf_len);
+    }
 
     // Return offset and update it
     offset = m_offset;
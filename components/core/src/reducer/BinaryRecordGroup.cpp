@@ -0,0 +1,387 @@
+#include "BinaryRecordGroup.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Record.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+namespace {
+/**
+ * Bounds-checked cursor over a serialized record group.
+ */
+class BufferCursor {
+public:
+    BufferCursor(char const* buf, size_t len) : m_cur{buf}, m_end{buf + len} {}
+
+    /**
+     * @tparam T
+     * @return The next value of type T in the buffer.
+     * @throw BinaryRecordGroup::OperationFailed if the buffer is exhausted.
+     */
+    template <typename T>
+    T read_value() {
+        T value;
+        std::memcpy(&value, read_bytes(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    /**
+     * @param num_bytes
+     * @return A pointer to the next `num_bytes` bytes in the buffer.
+     * @throw BinaryRecordGroup::OperationFailed if the buffer has fewer than `num_bytes` bytes
+     * remaining.
+     */
+    char const* read_bytes(size_t num_bytes) {
+        if (static_cast<size_t>(m_end - m_cur) < num_bytes) {
+            throw BinaryRecordGroup::OperationFailed(
+                    clp::ErrorCode_Truncated,
+                    __FILE__,
+                    __LINE__
+            );
+        }
+        auto const* bytes = m_cur;
+        m_cur += num_bytes;
+        return bytes;
+    }
+
+    std::string_view read_string() {
+        auto const size = read_value<uint32_t>();
+        return {read_bytes(size), size};
+    }
+
+    [[nodiscard]] bool done() const { return m_cur == m_end; }
+
+private:
+    char const* m_cur;
+    char const* m_end;
+};
+
+/**
+ * @param size
+ * @return The given size as a `uint32_t`, the type used for every size and offset in the
+ * serialized format.
+ * @throw BinaryRecordGroup::OperationFailed if the size doesn't fit in a `uint32_t`.
+ */
+uint32_t to_serialized_size(size_t size) {
+    if (size > UINT32_MAX) {
+        throw BinaryRecordGroup::OperationFailed(clp::ErrorCode_OutOfBounds, __FILE__, __LINE__);
+    }
+    return static_cast<uint32_t>(size);
+}
+
+/**
+ * Accumulates the values of one (key, value type) pair across every record in a record group.
+ */
+struct ColumnBuilder {
+    ColumnBuilder(std::string_view key, ValueType type) : key{key}, type{type} {}
+
+    /**
+     * Appends a default value for a record which doesn't contain this column.
+     */
+    void append_absent() {
+        presence.push_back(0);
+        all_present = false;
+        switch (type) {
+            case ValueType::Int64:
+                int64_values.push_back(0);
+                break;
+            case ValueType::Double:
+                double_values.push_back(0.0);
+                break;
+            case ValueType::String:
+                string_end_offsets.push_back(to_serialized_size(string_data.size()));
+                break;
+        }
+    }
+
+    /**
+     * Appends the value of this column from the given record.
+     * @param record
+     * @throw BinaryRecordGroup::OperationFailed if the column's string values exceed 4 GiB.
+     */
+    void append(Record const& record) {
+        presence.push_back(1);
+        switch (type) {
+            case ValueType::Int64:
+                int64_values.push_back(record.get_int64_value(key));
+                break;
+            case ValueType::Double:
+                double_values.push_back(record.get_double_value(key));
+                break;
+            case ValueType::String:
+                string_data.append(record.get_string_view(key));
+                string_end_offsets.push_back(to_serialized_size(string_data.size()));
+                break;
+        }
+    }
+
+    std::string key;
+    ValueType type;
+    bool all_present{true};
+    std::vector<uint8_t> presence;
+    std::vector<int64_t> int64_values;
+    std::vector<double> double_values;
+    std::vector<uint32_t> string_end_offsets;
+    std::string string_data;
+};
+
+/**
+ * A RecordTypedKeyIterator over the columns present in one record of a BinaryRecordGroup.
+ */
+class BinaryRecordTypedKeyIterator : public RecordTypedKeyIterator {
+public:
+    BinaryRecordTypedKeyIterator(
+            std::vector<BinaryRecordGroup::Column> const& columns,
+            size_t record_ix
+    )
+            : m_cur{columns.cbegin()},
+              m_end{columns.cend()},
+              m_record_ix{record_ix} {
+        skip_absent_columns();
+    }
+
+    TypedRecordKey get() override { return {m_cur->key, m_cur->type}; }
+
+    void next() override {
+        ++m_cur;
+        skip_absent_columns();
+    }
+
+    bool done() override { return m_cur == m_end; }
+
+private:
+    void skip_absent_columns() {
+        while (m_cur != m_end && false == m_cur->is_present(m_record_ix)) {
+            ++m_cur;
+        }
+    }
+
+    std::vector<BinaryRecordGroup::Column>::const_iterator m_cur;
+    std::vector<BinaryRecordGroup::Column>::const_iterator m_end;
+    size_t m_record_ix;
+};
+
+template <typename T>
+void append_value(std::vector<uint8_t>& buf, T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(value));
+}
+
+template <typename T>
+void append_values(std::vector<uint8_t>& buf, std::vector<T> const& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto const* bytes = reinterpret_cast<uint8_t const*>(values.data());
+    buf.insert(buf.end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+void append_string(std::vector<uint8_t>& buf, std::string_view str) {
+    append_value(buf, to_serialized_size(str.size()));
+    buf.insert(buf.end(), str.cbegin(), str.cend());
+}
+}  // namespace
+
+BinaryRecordGroup::BinaryRecordGroup(char const* buf, size_t len) : m_record_it{m_columns, 0} {
+    BufferCursor cursor{buf, len};
+    if (cMagicByte != cursor.read_value<uint8_t>() || cVersion != cursor.read_value<uint8_t>()) {
+        throw OperationFailed(clp::ErrorCode_Corrupt, __FILE__, __LINE__);
+    }
+    auto const num_tags = cursor.read_value<uint32_t>();
+    auto const num_records = cursor.read_value<uint32_t>();
+    auto const num_columns = cursor.read_value<uint32_t>();
+
+    for (uint32_t i = 0; i < num_tags; ++i) {
+        m_tags.emplace_back(cursor.read_string());
+    }
+
+    for (uint32_t i = 0; i < num_columns; ++i) {
+        auto& column = m_columns.emplace_back();
+        auto const type = cursor.read_value<uint8_t>();
+        if (type > static_cast<uint8_t>(ValueType::Double)) {
+            throw OperationFailed(clp::ErrorCode_Corrupt, __FILE__, __LINE__);
+        }
+        column.type = static_cast<ValueType>(type);
+        auto const all_present = cursor.read_value<uint8_t>();
+        column.key = cursor.read_string();
+        if (0 == all_present) {
+            column.presence = cursor.read_bytes(num_records);
+        }
+
+        switch (column.type) {
+            case ValueType::Int64:
+                column.values = cursor.read_bytes(num_records * sizeof(int64_t));
+                break;
+            case ValueType::Double:
+                column.values = cursor.read_bytes(num_records * sizeof(double));
+                break;
+            case ValueType::String: {
+                column.values = cursor.read_bytes(num_records * sizeof(uint32_t));
+                uint32_t string_data_size{0};
+                for (uint32_t record_ix = 0; record_ix < num_records; ++record_ix) {
+                    uint32_t end_offset{0};
+                    std::memcpy(
+                            &end_offset,
+                            column.values + record_ix * sizeof(uint32_t),
+                            sizeof(end_offset)
+                    );
+                    if (end_offset < string_data_size) {
+                        throw OperationFailed(clp::ErrorCode_Corrupt, __FILE__, __LINE__);
+                    }
+                    string_data_size = end_offset;
+                }
+                column.string_data = cursor.read_bytes(string_data_size);
+                break;
+            }
+        }
+    }
+
+    if (false == cursor.done()) {
+        throw OperationFailed(clp::ErrorCode_Corrupt, __FILE__, __LINE__);
+    }
+    m_record_it = BinaryRecordIterator{m_columns, num_records};
+}
+
+std::string_view BinaryRecordGroup::BinaryRecord::get_string_view(std::string_view key) const {
+    auto const* column = find_column(key, ValueType::String);
+    if (nullptr == column) {
+        return {};
+    }
+
+    uint32_t begin_offset{0};
+    uint32_t end_offset{0};
+    auto const* end_offsets = column->values;
+    if (m_record_ix > 0) {
+        std::memcpy(
+                &begin_offset,
+                end_offsets + (m_record_ix - 1) * sizeof(uint32_t),
+                sizeof(begin_offset)
+        );
+    }
+    std::memcpy(&end_offset, end_offsets + m_record_ix * sizeof(uint32_t), sizeof(end_offset));
+    return {column->string_data + begin_offset, end_offset - begin_offset};
+}
+
+int64_t BinaryRecordGroup::BinaryRecord::get_int64_value(std::string_view key) const {
+    int64_t value{0};
+    auto const* column = find_column(key, ValueType::Int64);
+    if (nullptr != column) {
+        std::memcpy(&value, column->values + m_record_ix * sizeof(value), sizeof(value));
+    }
+    return value;
+}
+
+double BinaryRecordGroup::BinaryRecord::get_double_value(std::string_view key) const {
+    double value{0.0};
+    auto const* column = find_column(key, ValueType::Double);
+    if (nullptr != column) {
+        std::memcpy(&value, column->values + m_record_ix * sizeof(value), sizeof(value));
+    }
+    return value;
+}
+
+std::unique_ptr<RecordTypedKeyIterator> BinaryRecordGroup::BinaryRecord::typed_key_iter() const {
+    return std::make_unique<BinaryRecordTypedKeyIterator>(*m_columns, m_record_ix);
+}
+
+auto BinaryRecordGroup::BinaryRecord::find_column(std::string_view key, ValueType type) const
+        -> Column const* {
+    // Record groups typically contain only a handful of columns, so a linear scan is cheaper than
+    // maintaining an index.
+    for (auto const& column : *m_columns) {
+        if (type == column.type && key == column.key) {
+            return column.is_present(m_record_ix) ? &column : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<uint8_t> serialize_binary(GroupTags const& tags, ConstRecordIterator& record_it) {
+    std::vector<ColumnBuilder> columns;
+    std::vector<bool> column_seen;
+    size_t num_records{0};
+    for (; false == record_it.done(); record_it.next(), ++num_records) {
+        if (UINT32_MAX == num_records) {
+            throw BinaryRecordGroup::OperationFailed(
+                    clp::ErrorCode_OutOfBounds,
+                    __FILE__,
+                    __LINE__
+            );
+        }
+        auto const& record = record_it.get();
+        column_seen.assign(columns.size(), false);
+        for (auto typed_key_it = record.typed_key_iter(); false == typed_key_it->done();
+             typed_key_it->next())
+        {
+            auto const typed_key = typed_key_it->get();
+            size_t column_ix{0};
+            for (; column_ix < columns.size(); ++column_ix) {
+                if (typed_key.get_type() == columns[column_ix].type
+                    && typed_key.get_key() == columns[column_ix].key)
+                {
+                    break;
+                }
+            }
+            if (columns.size() == column_ix) {
+                auto& column = columns.emplace_back(typed_key.get_key(), typed_key.get_type());
+                for (size_t i = 0; i < num_records; ++i) {
+                    column.append_absent();
+                }
+                column_seen.push_back(false);
+            }
+            if (column_seen[column_ix]) {
+                // Ignore duplicate keys, matching the behaviour of `serialize`
+                continue;
+            }
+            columns[column_ix].append(record);
+            column_seen[column_ix] = true;
+        }
+        for (size_t column_ix = 0; column_ix < columns.size(); ++column_ix) {
+            if (false == column_seen[column_ix]) {
+                columns[column_ix].append_absent();
+            }
+        }
+    }
+
+    std::vector<uint8_t> buf;
+    append_value(buf, BinaryRecordGroup::cMagicByte);
+    append_value(buf, BinaryRecordGroup::cVersion);
+    append_value(buf, to_serialized_size(tags.size()));
+    append_value(buf, static_cast<uint32_t>(num_records));
+    append_value(buf, to_serialized_size(columns.size()));
+    for (auto const& tag : tags) {
+        append_string(buf, tag);
+    }
+    for (auto const& column : columns) {
+        append_value(buf, static_cast<uint8_t>(column.type));
+        append_value(buf, static_cast<uint8_t>(column.all_present ? 1 : 0));
+        append_string(buf, column.key);
+        if (false == column.all_present) {
+            append_values(buf, column.presence);
+        }
+        switch (column.type) {
+            case ValueType::Int64:
+                append_values(buf, column.int64_values);
+                break;
+            case ValueType::Double:
+                append_values(buf, column.double_values);
+                break;
+            case ValueType::String:
+                append_values(buf, column.string_end_offsets);
+                buf.insert(buf.end(), column.string_data.cbegin(), column.string_data.cend());
+                break;
+        }
+    }
+    return buf;
+}
+}  // namespace reducer
@@ -0,0 +1,181 @@
+#ifndef REDUCER_BINARYRECORDGROUP_HPP
+#define REDUCER_BINARYRECORDGROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "../clp/ErrorCode.hpp"
+#include "../clp/TraceableException.hpp"
+#include "ConstRecordIterator.hpp"
+#include "GroupTags.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordTypedKeyIterator.hpp"
+
+namespace reducer {
+/**
+ * Class which exposes a record group serialized with `serialize_binary` as a RecordGroup, without
+ * copying or decoding the serialized records.
+ *
+ * The serialized format consists of:
+ * - a fixed header containing a magic byte (`cMagicByte`), a version, and the number of tags,
+ *   records, and columns;
+ * - a table of the group's tags, each stored once as a length-prefixed string;
+ * - one column per distinct (key, value type) pair in the group's records, each consisting of a
+ *   descriptor (type, key, and whether the column is present in every record), an optional
+ *   per-record presence array, and a typed array of values for every record.
+ *
+ * Multi-byte values are stored in the host's byte order, as with the rest of the reducer protocol.
+ *
+ * NOTE: The serialized buffer must outlive this object and any records or iterators obtained from
+ * it.
+ */
+class BinaryRecordGroup : public RecordGroup {
+public:
+    // Types
+    class OperationFailed : public clp::TraceableException {
+    public:
+        // Constructors
+        OperationFailed(clp::ErrorCode error_code, char const* filename, int line_number)
+                : clp::TraceableException{error_code, filename, line_number} {}
+
+        // Methods
+        [[nodiscard]] char const* what() const noexcept override {
+            return "reducer::BinaryRecordGroup operation failed";
+        }
+    };
+
+    /**
+     * A column of values in the serialized record group.
+     */
+    struct Column {
+        [[nodiscard]] bool is_present(size_t record_ix) const {
+            return nullptr == presence || 0 != presence[record_ix];
+        }
+
+        std::string_view key;
+        ValueType type{ValueType::String};
+        // nullptr if the column is present in every record
+        char const* presence{nullptr};
+        // Fixed-size values for numeric columns, or the end offset of each value for string
+        // columns
+        char const* values{nullptr};
+        // The concatenated values of a string column
+        char const* string_data{nullptr};
+    };
+
+    // Constants
+    // 0xc1 is never used by msgpack, so it can't be the first byte of a msgpack-serialized record
+    // group.
+    static constexpr uint8_t cMagicByte{0xc1};
+    static constexpr uint8_t cVersion{1};
+
+    // Constructors
+    /**
+     * @param buf
+     * @param len
+     * @throw OperationFailed if the buffer doesn't contain a valid serialized record group.
+     */
+    BinaryRecordGroup(char const* buf, size_t len);
+
+    // Disable copy/move since the record iterator refers to this object's columns
+    BinaryRecordGroup(BinaryRecordGroup const&) = delete;
+    BinaryRecordGroup(BinaryRecordGroup&&) = delete;
+    BinaryRecordGroup& operator=(BinaryRecordGroup const&) = delete;
+    BinaryRecordGroup& operator=(BinaryRecordGroup&&) = delete;
+
+    // Destructor
+    ~BinaryRecordGroup() override = default;
+
+    // Methods
+    /**
+     * @param buf
+     * @param len
+     * @return Whether the given buffer was serialized with `serialize_binary` (as opposed to
+     * `serialize`).
+     */
+    [[nodiscard]] static bool is_binary_record_group(char const* buf, size_t len) {
+        return len > 0 && cMagicByte == static_cast<uint8_t>(buf[0]);
+    }
+
+    [[nodiscard]] GroupTags const& get_tags() const override { return m_tags; }
+
+    [[nodiscard]] ConstRecordIterator& record_iter() override { return m_record_it; }
+
+private:
+    // Types
+    /**
+     * A record in a BinaryRecordGroup, which reads its values directly from the serialized columns.
+     */
+    class BinaryRecord : public Record {
+    public:
+        BinaryRecord(std::vector<Column> const& columns, size_t record_ix)
+                : m_columns{&columns},
+                  m_record_ix{record_ix} {}
+
+        void set_record_ix(size_t record_ix) { m_record_ix = record_ix; }
+
+        [[nodiscard]] std::string_view get_string_view(std::string_view key) const override;
+
+        [[nodiscard]] int64_t get_int64_value(std::string_view key) const override;
+
+        [[nodiscard]] double get_double_value(std::string_view key) const override;
+
+        [[nodiscard]] std::unique_ptr<RecordTypedKeyIterator> typed_key_iter() const override;
+
+    private:
+        /**
+         * @param key
+         * @param type
+         * @return The column with the given key and type if the current record contains it, or
+         * nullptr otherwise.
+         */
+        [[nodiscard]] Column const* find_column(std::string_view key, ValueType type) const;
+
+        std::vector<Column> const* m_columns;
+        size_t m_record_ix;
+    };
+
+    /**
+     * A ConstRecordIterator over the records in a BinaryRecordGroup.
+     */
+    class BinaryRecordIterator : public ConstRecordIterator {
+    public:
+        BinaryRecordIterator(std::vector<Column> const& columns, size_t num_records)
+                : m_record{columns, 0},
+                  m_num_records{num_records} {}
+
+        [[nodiscard]] Record const& get() const override { return m_record; }
+
+        void next() override { m_record.set_record_ix(++m_record_ix); }
+
+        bool done() override { return m_record_ix >= m_num_records; }
+
+    private:
+        BinaryRecord m_record;
+        size_t m_record_ix{0};
+        size_t m_num_records;
+    };
+
+    GroupTags m_tags;
+    std::vector<Column> m_columns;
+    BinaryRecordIterator m_record_it;
+};
+
+/**
+ * Serializes a record group into the compact binary format that can be deserialized by
+ * BinaryRecordGroup.
+ * @param tags The tags in the record group.
+ * @param record_it An iterator for the records in the record group.
+ * @return The serialized data.
+ * @throw BinaryRecordGroup::OperationFailed if the record group can't be represented in the
+ * format, i.e., if it has more than `UINT32_MAX` records, or if a tag, a key, or the concatenated
+ * string values of a column exceed 4 GiB.
+ */
+std::vector<uint8_t> serialize_binary(GroupTags const& tags, ConstRecordIterator& record_it);
+}  // namespace reducer
+
+#endif  // REDUCER_BINARYRECORDGROUP_HPP
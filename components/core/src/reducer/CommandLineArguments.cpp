@@ -46,6 +46,11 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
             po::value<int>(&m_upsert_interval)
                 ->default_value(m_upsert_interval),
             "Interval for upserting timeline aggregation results (ms)"
+        )(
+            "num-threads",
+            po::value<int>(&m_num_threads)
+                ->default_value(m_num_threads),
+            "Number of threads used to receive and aggregate results"
         );
 
         po::options_description all_options;
@@ -96,6 +101,10 @@ CommandLineArguments::parse_arguments(int argc, char const* argv[]) {
         if (m_upsert_interval <= 0) {
             throw std::invalid_argument("upsert-interval cannot be <= 0.");
         }
+
+        if (m_num_threads <= 0) {
+            throw std::invalid_argument("num-threads cannot be <= 0.");
+        }
     } catch (std::exception& e) {
         SPDLOG_ERROR("Failed to validate command line arguments - {}", e.what());
         print_basic_usage();
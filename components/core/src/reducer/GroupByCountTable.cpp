@@ -0,0 +1,122 @@
+#include "GroupByCountTable.hpp"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace reducer {
+namespace {
+using tag_length_t = uint32_t;
+}  // namespace
+
+/**
+ * A RecordGroupIterator over the groups in a GroupByCountTable.
+ */
+class GroupByCountTable::RecordGroupIteratorImpl : public RecordGroupIterator {
+public:
+    RecordGroupIteratorImpl(GroupByCountTable const& table, std::string key)
+            : m_table{table},
+              m_group_it{table.m_groups.cbegin()},
+              m_record{std::move(key)},
+              m_group{nullptr, m_record} {}
+
+    RecordGroup& get() override {
+        unpack_tags(m_table.get_key(*m_group_it), m_tags);
+        m_record.set_record_value(m_group_it->count);
+        m_group.set_tags(&m_tags);
+        m_group.reset_record_iterator();
+        return m_group;
+    }
+
+    void next() override { ++m_group_it; }
+
+    bool done() override { return m_table.m_groups.cend() == m_group_it; }
+
+private:
+    GroupByCountTable const& m_table;
+    std::vector<Group>::const_iterator m_group_it;
+    SingleInt64RecordAdapter m_record;
+    SingleRecordGroup m_group;
+    GroupTags m_tags;
+};
+
+size_t GroupByCountTable::begin_tag(std::string& packed_key) {
+    auto const tag_begin = packed_key.size();
+    packed_key.append(sizeof(tag_length_t), '\0');
+    return tag_begin;
+}
+
+void GroupByCountTable::end_tag(std::string& packed_key, size_t tag_begin) {
+    auto const tag_length
+            = static_cast<tag_length_t>(packed_key.size() - tag_begin - sizeof(tag_length_t));
+    std::memcpy(packed_key.data() + tag_begin, &tag_length, sizeof(tag_length));
+}
+
+void GroupByCountTable::append_tag(std::string& packed_key, std::string_view tag) {
+    auto const tag_begin = begin_tag(packed_key);
+    packed_key.append(tag);
+    end_tag(packed_key, tag_begin);
+}
+
+void GroupByCountTable::unpack_tags(std::string_view packed_key, GroupTags& tags) {
+    tags.clear();
+    size_t pos{0};
+    while (pos + sizeof(tag_length_t) <= packed_key.size()) {
+        tag_length_t tag_length{0};
+        std::memcpy(&tag_length, packed_key.data() + pos, sizeof(tag_length));
+        pos += sizeof(tag_length);
+        tags.emplace_back(packed_key.substr(pos, tag_length));
+        pos += tag_length;
+    }
+}
+
+void GroupByCountTable::add(std::string_view packed_key, int64_t count) {
+    // Keep the load factor at or below 1/2 so that probe sequences stay short
+    if ((m_groups.size() + 1) * 2 > m_slots.size()) {
+        grow();
+    }
+
+    auto const hash = std::hash<std::string_view>{}(packed_key);
+    auto const mask = m_slots.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+        auto& slot = m_slots[i];
+        if (slot.is_empty()) {
+            slot.hash = hash;
+            slot.group_ix = m_groups.size();
+            m_groups.push_back({m_keys.size(), packed_key.size(), count});
+            m_keys.append(packed_key);
+            return;
+        }
+        auto& group = m_groups[slot.group_ix];
+        if (slot.hash == hash && get_key(group) == packed_key) {
+            group.count += count;
+            return;
+        }
+    }
+}
+
+std::unique_ptr<RecordGroupIterator> GroupByCountTable::get_record_group_iterator(std::string key
+) const {
+    return std::make_unique<RecordGroupIteratorImpl>(*this, std::move(key));
+}
+
+void GroupByCountTable::grow() {
+    std::vector<Slot> old_slots(m_slots.size() * 2);
+    std::swap(old_slots, m_slots);
+
+    auto const mask = m_slots.size() - 1;
+    for (auto const& old_slot : old_slots) {
+        if (old_slot.is_empty()) {
+            continue;
+        }
+        auto i = old_slot.hash & mask;
+        while (false == m_slots[i].is_empty()) {
+            i = (i + 1) & mask;
+        }
+        m_slots[i] = old_slot;
+    }
+}
+}  // namespace reducer
@@ -0,0 +1,135 @@
+#ifndef REDUCER_GROUPBYCOUNTTABLE_HPP
+#define REDUCER_GROUPBYCOUNTTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GroupTags.hpp"
+#include "Record.hpp"
+#include "RecordGroup.hpp"
+#include "RecordGroupIterator.hpp"
+
+namespace reducer {
+/**
+ * A compact open-addressing hash table which maps a group (a packed sequence of tags) to a partial
+ * count.
+ *
+ * Group keys are packed into a single reusable buffer by the caller (see `begin_tag` and
+ * `end_tag`), which allows tag values to be written directly into the key without materializing a
+ * GroupTags object per record. The packed keys of all inserted groups are stored contiguously in
+ * one arena, and the groups themselves only store offsets into that arena, keeping the table
+ * compact even for high-cardinality aggregations. The slots only store indices into the list of
+ * groups, so growing the table doesn't move any group, and groups are iterated in the order they
+ * were inserted.
+ */
+class GroupByCountTable {
+public:
+    // Constants
+    static constexpr size_t cInitialCapacity{64};
+
+    // Constructors
+    GroupByCountTable() : m_slots(cInitialCapacity) {}
+
+    // Methods
+    /**
+     * Begins appending a tag to a packed group key.
+     * @param packed_key
+     * @return The offset of the tag within the packed key, which must be passed to `end_tag` once
+     * the tag's value has been appended to `packed_key`.
+     */
+    static size_t begin_tag(std::string& packed_key);
+
+    /**
+     * Finishes appending a tag to a packed group key.
+     * @param packed_key
+     * @param tag_begin The value returned by the corresponding call to `begin_tag`
+     */
+    static void end_tag(std::string& packed_key, size_t tag_begin);
+
+    /**
+     * Appends a complete tag to a packed group key.
+     * @param packed_key
+     * @param tag
+     */
+    static void append_tag(std::string& packed_key, std::string_view tag);
+
+    /**
+     * Unpacks a packed group key into a GroupTags object.
+     * @param packed_key
+     * @param tags Returns the unpacked tags
+     */
+    static void unpack_tags(std::string_view packed_key, GroupTags& tags);
+
+    /**
+     * Adds the given count to the group with the given packed key, inserting the group if it
+     * doesn't exist.
+     * @param packed_key
+     * @param count
+     */
+    void add(std::string_view packed_key, int64_t count);
+
+    /**
+     * Adds one to the count of the group with the given packed key.
+     * @param packed_key
+     */
+    void increment(std::string_view packed_key) { add(packed_key, 1); }
+
+    [[nodiscard]] size_t size() const { return m_groups.size(); }
+
+    [[nodiscard]] bool empty() const { return m_groups.empty(); }
+
+    /**
+     * @return The number of slots in the table
+     */
+    [[nodiscard]] size_t get_capacity() const { return m_slots.size(); }
+
+    /**
+     * @return An iterator over every group in the table, in insertion order, where each group
+     * contains a single record with the given key mapped to the group's count.
+     * NOTE: The table must outlive the returned iterator and must not be modified while the
+     * iterator is in use.
+     */
+    [[nodiscard]] std::unique_ptr<RecordGroupIterator> get_record_group_iterator(std::string key
+    ) const;
+
+private:
+    // Types
+    struct Group {
+        size_t key_offset{0};
+        size_t key_size{0};
+        int64_t count{0};
+    };
+
+    struct Slot {
+        [[nodiscard]] bool is_empty() const { return cEmptyGroupIndex == group_ix; }
+
+        size_t hash{0};
+        size_t group_ix{cEmptyGroupIndex};
+    };
+
+    class RecordGroupIteratorImpl;
+
+    // Constants
+    static constexpr size_t cEmptyGroupIndex{SIZE_MAX};
+
+    // Methods
+    [[nodiscard]] std::string_view get_key(Group const& group) const {
+        return std::string_view{m_keys}.substr(group.key_offset, group.key_size);
+    }
+
+    /**
+     * Doubles the capacity of the table and rehashes every group.
+     */
+    void grow();
+
+    std::vector<Slot> m_slots;
+    std::vector<Group> m_groups;
+    std::string m_keys;
+};
+}  // namespace reducer
+
+#endif  // REDUCER_GROUPBYCOUNTTABLE_HPP
@@ -1,6 +1,7 @@
 #include "RecordReceiverContext.hpp"
 
 #include "../clp/spdlog_with_specializations.hpp"
+#include "BinaryRecordGroup.hpp"
 #include "DeserializedRecordGroup.hpp"
 #include "types.hpp"
 
@@ -61,8 +62,22 @@ bool RecordReceiverContext::read_record_groups_packet() {
         }
         read_head += sizeof(record_size);
 
-        auto record_group = DeserializedRecordGroup{read_head, record_size};
-        m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        if (BinaryRecordGroup::is_binary_record_group(read_head, record_size)) {
+            try {
+                BinaryRecordGroup record_group{read_head, record_size};
+                m_server_ctx->push_record_group(
+                        record_group.get_tags(),
+                        record_group.record_iter()
+                );
+            } catch (BinaryRecordGroup::OperationFailed const& e) {
+                SPDLOG_ERROR("Failed to deserialize record group - {}", e.what());
+                return false;
+            }
+        } else {
+            // Fall back to the msgpack format for senders which don't use `serialize_binary`
+            auto record_group = DeserializedRecordGroup{read_head, record_size};
+            m_server_ctx->push_record_group(record_group.get_tags(), record_group.record_iter());
+        }
         m_buf_num_bytes_occupied -= (record_size + sizeof(record_size));
         read_head += record_size;
     }
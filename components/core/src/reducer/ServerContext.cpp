@@ -1,5 +1,13 @@
 #include "ServerContext.hpp"
 
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
 #include <bsoncxx/builder/stream/document.hpp>
 #include <json/single_include/nlohmann/json.hpp>
 #include <mongocxx/bulk_write.hpp>
@@ -52,11 +60,13 @@ vector<uint8_t> serialize_timeline_result(GroupTags const& tags, ConstRecordIter
 // TODO: We should use tcp::v6 and set ip::v6_only to false, but this isn't guaranteed to work; so
 // for now, we use v4 to be safe.
 ServerContext::ServerContext(CommandLineArguments& args)
-        : m_tcp_acceptor{m_ioctx, tcp::endpoint(tcp::v4(), args.get_reducer_port())},
+        : m_control_strand{boost::asio::make_strand(m_ioctx)},
+          m_tcp_acceptor{m_ioctx, tcp::endpoint(tcp::v4(), args.get_reducer_port())},
           m_scheduler_socket{m_ioctx},
           m_upsert_timer{m_ioctx},
           m_reducer_host{args.get_reducer_host()},
           m_reducer_port{args.get_reducer_port()},
+          m_num_threads{static_cast<size_t>(args.get_num_threads())},
           m_upsert_interval{args.get_upsert_interval()} {
     mongocxx::uri mongodb_uri = mongocxx::uri(args.get_mongodb_uri());
     try {
@@ -68,13 +78,50 @@ ServerContext::ServerContext(CommandLineArguments& args)
     m_mongodb_results_database = mongocxx::database(m_mongodb_client[mongodb_uri.database()]);
 }
 
+void ServerContext::run() {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> thread_exceptions(m_num_threads - 1);
+    threads.reserve(m_num_threads - 1);
+    for (size_t i = 0; i < m_num_threads - 1; ++i) {
+        threads.emplace_back([this, &thread_exception = thread_exceptions[i]]() {
+            try {
+                m_ioctx.run();
+            } catch (...) {
+                thread_exception = std::current_exception();
+                m_ioctx.stop();
+            }
+        });
+    }
+
+    std::exception_ptr main_thread_exception;
+    try {
+        m_ioctx.run();
+    } catch (...) {
+        main_thread_exception = std::current_exception();
+        m_ioctx.stop();
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (nullptr != main_thread_exception) {
+        std::rethrow_exception(main_thread_exception);
+    }
+    for (auto const& thread_exception : thread_exceptions) {
+        if (nullptr != thread_exception) {
+            std::rethrow_exception(thread_exception);
+        }
+    }
+}
+
 void ServerContext::reset() {
     m_ioctx.restart();
-    m_pipeline.reset(nullptr);
+    m_pipeline_shards.clear();
     m_status = ServerStatus::Idle;
     m_job_id = -1;
     m_is_timeline_aggregation = false;
-    m_updated_tags.clear();
+    m_results_finalized = false;
     m_num_active_receiver_tasks = 0;
 }
 
@@ -132,12 +179,17 @@ bool ServerContext::ack_query_scheduler() {
 }
 
 void ServerContext::decrement_num_active_receiver_tasks() {
-    --m_num_active_receiver_tasks;
-    if (0 == m_num_active_receiver_tasks && ServerStatus::ReceivedAllResults == m_status) {
-        if (false == try_finalize_results()) {
+    if (1 != m_num_active_receiver_tasks.fetch_sub(1)) {
+        return;
+    }
+
+    // Finalization interacts with the scheduler and the results cache, so it must happen on the
+    // control strand.
+    boost::asio::post(m_control_strand, [this]() {
+        if (ServerStatus::ReceivedAllResults == m_status && false == try_finalize_results()) {
             m_status = ServerStatus::UnrecoverableFailure;
         }
-    }
+    });
 }
 
 void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
@@ -149,8 +201,12 @@ void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
     // timeline aggregation.
     // TODO: We'll need to implement more general pipeline initialization once more operators are
     // needed.
-    m_pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
-    m_pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+    m_pipeline_shards.clear();
+    for (size_t i = 0; i < m_num_threads; ++i) {
+        auto& shard = m_pipeline_shards.emplace_back(std::make_unique<PipelineShard>());
+        shard->pipeline = std::make_unique<Pipeline>(PipelineInputMode::IntraStage);
+        shard->pipeline->add_pipeline_stage(std::make_shared<CountOperator>());
+    }
 
     if (query_config.count(cJobAttributes::TimeBucketSize) > 0
         && false == query_config[cJobAttributes::TimeBucketSize].is_null())
@@ -163,44 +219,53 @@ void ServerContext::set_up_pipeline(nlohmann::json const& query_config) {
 }
 
 void ServerContext::push_record_group(GroupTags const& tags, ConstRecordIterator& record_it) {
+    auto& shard = get_shard(tags);
+    std::lock_guard const lock{shard.mutex};
     if (m_is_timeline_aggregation) {
-        m_updated_tags.insert(tags);
+        shard.updated_tags.insert(tags);
     }
-    m_pipeline->push_record_group(tags, record_it);
+    shard.pipeline->push_record_group(tags, record_it);
 }
 
 bool ServerContext::upsert_timeline_results() {
-    if (m_updated_tags.empty()) {
-        return true;
-    }
-
     bool any_updates = false;
     auto bulk_write = m_mongodb_results_collection.create_bulk_write();
     vector<vector<uint8_t>> results;
-    for (auto group_it = m_pipeline->finish(m_updated_tags); false == group_it->done();
-         group_it->next())
-    {
-        int64_t timestamp{std::stoll(group_it->get().get_tags().front())};
-
-        auto& group = group_it->get();
-        results.emplace_back(serialize_timeline_result(group.get_tags(), group.record_iter()));
-
-        auto& result = results.back();
-        mongocxx::model::replace_one replace_op{
-                bsoncxx::builder::basic::make_document(
-                        bsoncxx::builder::basic::kvp("timestamp", timestamp)
-                ),
-                bsoncxx::document::view{result.data(), result.size()}
-        };
-        replace_op.upsert(true);
-        bulk_write.append(replace_op);
-
-        any_updates = true;
+    // Since shards are partitioned by GroupTags, the results of each shard can be upserted
+    // independently.
+    for (auto& shard : m_pipeline_shards) {
+        std::lock_guard const lock{shard->mutex};
+        if (shard->updated_tags.empty()) {
+            continue;
+        }
+
+        for (auto group_it = shard->pipeline->finish(shard->updated_tags);
+             false == group_it->done();
+             group_it->next())
+        {
+            int64_t timestamp{std::stoll(group_it->get().get_tags().front())};
+
+            auto& group = group_it->get();
+            results.emplace_back(serialize_timeline_result(group.get_tags(), group.record_iter())
+            );
+
+            auto& result = results.back();
+            mongocxx::model::replace_one replace_op{
+                    bsoncxx::builder::basic::make_document(
+                            bsoncxx::builder::basic::kvp("timestamp", timestamp)
+                    ),
+                    bsoncxx::document::view{result.data(), result.size()}
+            };
+            replace_op.upsert(true);
+            bulk_write.append(replace_op);
+
+            any_updates = true;
+        }
+        shard->updated_tags.clear();
     }
     try {
         if (any_updates) {
             bulk_write.execute();
-            m_updated_tags.clear();
         }
     } catch (mongocxx::bulk_write_exception const& e) {
         SPDLOG_ERROR("Failed to upsert timeline results - {}", e.what());
@@ -213,12 +278,20 @@ bool ServerContext::upsert_timeline_results() {
 bool ServerContext::publish_pipeline_results() {
     vector<vector<uint8_t>> results;
     vector<bsoncxx::document::view> result_documents;
-    for (auto group_it = m_pipeline->finish(); false == group_it->done(); group_it->next()) {
-        auto& group = group_it->get();
-        results.push_back(serialize(group.get_tags(), group.record_iter(), nlohmann::json::to_bson)
-        );
-
-        vector<uint8_t>& encoded_result = results.back();
+    // Since shards are partitioned by GroupTags, merging their results only requires concatenating
+    // them.
+    for (auto& shard : m_pipeline_shards) {
+        std::lock_guard const lock{shard->mutex};
+        for (auto group_it = shard->pipeline->finish(); false == group_it->done();
+             group_it->next())
+        {
+            auto& group = group_it->get();
+            results.push_back(
+                    serialize(group.get_tags(), group.record_iter(), nlohmann::json::to_bson)
+            );
+        }
+    }
+    for (auto& encoded_result : results) {
         result_documents.emplace_back(encoded_result.data(), encoded_result.size());
     }
     try {
@@ -245,6 +318,10 @@ bool ServerContext::try_finalize_results() {
         // We haven't received all results yet
         return true;
     }
+    if (m_results_finalized) {
+        return true;
+    }
+    m_results_finalized = true;
 
     bool published_results_successfully
             = m_is_timeline_aggregation ? upsert_timeline_results() : publish_pipeline_results();
@@ -256,4 +333,12 @@ bool ServerContext::try_finalize_results() {
     // Notify the query scheduler that the results have been pushed
     return ack_query_scheduler();
 }
+
+ServerContext::PipelineShard& ServerContext::get_shard(GroupTags const& tags) {
+    if (1 == m_pipeline_shards.size()) {
+        return *m_pipeline_shards.front();
+    }
+    auto const hash = boost::hash_range(tags.cbegin(), tags.cend());
+    return *m_pipeline_shards[hash % m_pipeline_shards.size()];
+}
 }  // namespace reducer
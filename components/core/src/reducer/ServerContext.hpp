@@ -1,8 +1,13 @@
 #ifndef REDUCER_SERVERCONTEXT_HPP
 #define REDUCER_SERVERCONTEXT_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <json/single_include/nlohmann/json.hpp>
@@ -31,6 +36,13 @@ constexpr char TimeBucketSize[] = "count_by_time_bucket_size";
 /**
  * Class which manages interactions with the jobs database and result cache database. Also holds
  * state for the reducer job this server is handling.
+ *
+ * The server's event loop can be run by multiple threads. Tasks which interact with the scheduler,
+ * the TCP acceptor, or the results cache are serialized through a control strand (see
+ * `get_control_strand`), whereas tasks which receive and decode results from search workers run
+ * concurrently without any synchronization between connections. Received record groups are
+ * sharded by the hash of their GroupTags across a set of independent pipelines, so that each shard
+ * only needs to be locked while a record group is pushed into it.
  */
 class ServerContext {
 public:
@@ -58,9 +70,9 @@ public:
     void reset();
 
     /**
-     * Executes the server event loop until no tasks remain.
+     * Executes the server event loop on `num_threads` threads until no tasks remain.
      */
-    void run() { m_ioctx.run(); }
+    void run();
 
     /**
      * Stops the event loop by closing the connection to the scheduler, and cancelling any ongoing
@@ -90,8 +102,8 @@ public:
     void increment_num_active_receiver_tasks() { ++m_num_active_receiver_tasks; }
 
     /**
-     * Decrements the number of active receiver tasks, and calls try_finalize_results if the server
-     * is in the state ReceivedAllResults and there are no remaining active receiver tasks.
+     * Decrements the number of active receiver tasks, and schedules a call to try_finalize_results
+     * on the control strand if there are no remaining active receiver tasks.
      */
     void decrement_num_active_receiver_tasks();
 
@@ -102,7 +114,8 @@ public:
     void set_up_pipeline(nlohmann::json const& query_config);
 
     /**
-     * Pushes a record group into the reducer pipeline.
+     * Pushes a record group into the reducer pipeline shard responsible for its tags.
+     * NOTE: This method is thread-safe.
      * @param group_tags The tags in the record group.
      * @param record_it An iterator for the records in the record group.
      */
@@ -133,6 +146,14 @@ public:
 
     boost::asio::io_context& get_io_context() { return m_ioctx; }
 
+    /**
+     * @return The strand on which all tasks that interact with the scheduler, the TCP acceptor, the
+     * upsert timer, or the results cache must run.
+     */
+    boost::asio::strand<boost::asio::io_context::executor_type>& get_control_strand() {
+        return m_control_strand;
+    }
+
     boost::asio::ip::tcp::acceptor& get_tcp_acceptor() { return m_tcp_acceptor; }
 
     boost::asio::ip::tcp::socket& get_scheduler_update_socket() { return m_scheduler_socket; }
@@ -143,7 +164,7 @@ public:
 
     [[nodiscard]] int get_reducer_port() const { return m_reducer_port; }
 
-    [[nodiscard]] ServerStatus get_status() const { return m_status; }
+    [[nodiscard]] ServerStatus get_status() const { return m_status.load(); }
 
     void set_status(ServerStatus new_status) { m_status = new_status; }
 
@@ -156,21 +177,40 @@ public:
     [[nodiscard]] int get_upsert_interval() const { return m_upsert_interval; }
 
 private:
+    // Types
+    /**
+     * A pipeline and the state that must be updated with it, guarded by a mutex.
+     */
+    struct PipelineShard {
+        std::mutex mutex;
+        std::unique_ptr<Pipeline> pipeline;
+        std::set<GroupTags> updated_tags;
+    };
+
+    // Methods
+    /**
+     * @param tags
+     * @return The pipeline shard responsible for the given tags.
+     */
+    PipelineShard& get_shard(GroupTags const& tags);
+
     boost::asio::io_context m_ioctx;
+    boost::asio::strand<boost::asio::io_context::executor_type> m_control_strand;
     boost::asio::ip::tcp::acceptor m_tcp_acceptor;
     boost::asio::ip::tcp::socket m_scheduler_socket;
     std::vector<char> m_scheduler_update_buffer;
 
     std::string m_reducer_host;
     int m_reducer_port;
-    int m_num_active_receiver_tasks{0};
+    size_t m_num_threads;
+    std::atomic<int> m_num_active_receiver_tasks{0};
 
-    ServerStatus m_status{ServerStatus::Idle};
+    std::atomic<ServerStatus> m_status{ServerStatus::Idle};
     job_id_t m_job_id{-1};
 
-    std::unique_ptr<Pipeline> m_pipeline;
+    std::vector<std::unique_ptr<PipelineShard>> m_pipeline_shards;
     bool m_is_timeline_aggregation{false};
-    std::set<GroupTags> m_updated_tags;
+    bool m_results_finalized{false};
 
     boost::asio::steady_timer m_upsert_timer;
     int m_upsert_interval;
@@ -3,13 +3,15 @@
 #include <unistd.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../clp/ErrorCode.hpp"
 #include "../clp/networking/socket_utils.hpp"
+#include "BinaryRecordGroup.hpp"
 #include "BufferedSocketWriter.hpp"
-#include "DeserializedRecordGroup.hpp"
 #include "RecordGroupIterator.hpp"
 #include "types.hpp"
 
@@ -50,7 +52,12 @@ bool send_pipeline_results(int reducer_socket_fd, std::unique_ptr<RecordGroupIte
 
     for (; false == results->done(); results->next()) {
         auto& group = results->get();
-        auto serialized_result = serialize(group.get_tags(), group.record_iter());
+        std::vector<uint8_t> serialized_result;
+        try {
+            serialized_result = serialize_binary(group.get_tags(), group.record_iter());
+        } catch (BinaryRecordGroup::OperationFailed const&) {
+            return false;
+        }
         auto serialized_result_size = serialized_result.size();
 
         // Send size
@@ -122,7 +122,12 @@ void PeriodicUpsertTask::operator()([[maybe_unused]] boost::system::error_code c
 
     auto& upsert_timer = m_server_ctx->get_upsert_timer();
     upsert_timer.expires_from_now(std::chrono::milliseconds(m_server_ctx->get_upsert_interval()));
-    upsert_timer.async_wait(PeriodicUpsertTask(m_server_ctx));
+    upsert_timer.async_wait(
+            boost::asio::bind_executor(
+                    m_server_ctx->get_control_strand(),
+                    PeriodicUpsertTask(m_server_ctx)
+            )
+    );
 }
 
 void ReceiveTask::operator()(boost::system::error_code const& error, size_t num_bytes_read) {
@@ -208,7 +213,10 @@ void SchedulerUpdateListenerTask::operator()(
             upsert_timer.expires_from_now(
                     std::chrono::milliseconds(m_server_ctx->get_upsert_interval())
             );
-            upsert_timer.async_wait(PeriodicUpsertTask(m_server_ctx));
+            upsert_timer.async_wait(boost::asio::bind_executor(
+                    m_server_ctx->get_control_strand(),
+                    PeriodicUpsertTask(m_server_ctx)
+            ));
         }
 
         // Synchronously notify the scheduler that the reducer is ready
@@ -263,7 +271,10 @@ void ValidateSenderTask::operator()(boost::system::error_code const& error, size
 
 void queue_accept_task(std::shared_ptr<ServerContext> const& ctx) {
     auto rctx = RecordReceiverContext::new_receiver(ctx);
-    ctx->get_tcp_acceptor().async_accept(rctx->get_socket(), AcceptTask(rctx));
+    ctx->get_tcp_acceptor().async_accept(
+            rctx->get_socket(),
+            boost::asio::bind_executor(ctx->get_control_strand(), AcceptTask(rctx))
+    );
 }
 
 void queue_receive_task(std::shared_ptr<RecordReceiverContext> const& ctx) {
@@ -282,7 +293,10 @@ void queue_scheduler_update_listener_task(
             ctx->get_scheduler_update_socket(),
             boost::asio::dynamic_buffer(ctx->get_scheduler_update_buffer()),
             boost::asio::transfer_at_least(1),  // Makes boost::asio forward results right away
-            SchedulerUpdateListenerTask(ctx, current_buffer_occupancy)
+            boost::asio::bind_executor(
+                    ctx->get_control_strand(),
+                    SchedulerUpdateListenerTask(ctx, current_buffer_occupancy)
+            )
     );
 }
 
@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/ArchiveRangeCache.hpp"
+
+using clp_s::ArchiveRangeCache;
+
+namespace {
+constexpr char cTestDirName[] = "test-ArchiveRangeCache";
+constexpr char cTablesFileName[] = "/tables";
+constexpr char cDictFileName[] = "/dict";
+constexpr size_t cTablesFileSize{64 * 1024};
+
+/**
+ * A remote archive stand-in, served with `file://` URLs, and a cache directory for it. Both are
+ * removed when the object is destroyed.
+ */
+class TestArchive {
+public:
+    TestArchive()
+            : m_test_dir{std::filesystem::temp_directory_path() / cTestDirName},
+              m_archive_dir{m_test_dir / "archive"},
+              m_cache_dir{m_test_dir / "cache"} {
+        std::filesystem::remove_all(m_test_dir);
+        std::filesystem::create_directories(m_archive_dir);
+
+        for (size_t i = 0; i < cTablesFileSize; ++i) {
+            m_tables_content.push_back(static_cast<char>('a' + i % 26 + i / 26 % 3));
+        }
+        write_file(get_archive_file_path(cTablesFileName), m_tables_content);
+        write_file(get_archive_file_path(cDictFileName), "dictionary");
+    }
+
+    // Delete copy & move constructors and assignment operators
+    TestArchive(TestArchive const&) = delete;
+    TestArchive(TestArchive&&) = delete;
+    auto operator=(TestArchive const&) -> TestArchive& = delete;
+    auto operator=(TestArchive&&) -> TestArchive& = delete;
+
+    // Destructor
+    ~TestArchive() { std::filesystem::remove_all(m_test_dir); }
+
+    [[nodiscard]] auto get_url() const -> std::string {
+        return "file://" + std::filesystem::absolute(m_archive_dir).string();
+    }
+
+    [[nodiscard]] auto get_cache_dir() const -> std::string { return m_cache_dir.string(); }
+
+    [[nodiscard]] auto get_archive_file_path(std::string const& file_name) const -> std::string {
+        return m_archive_dir.string() + file_name;
+    }
+
+    [[nodiscard]] auto get_tables_content() const -> std::string const& {
+        return m_tables_content;
+    }
+
+    /**
+     * Removes the archive's files so that any further download fails, which reveals whether a
+     * fetch was served from the cache
+     */
+    void remove_archive_files() const { std::filesystem::remove_all(m_archive_dir); }
+
+    static void write_file(std::string const& path, std::string const& content) {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file << content;
+    }
+
+    static auto read_file(std::string const& path) -> std::string {
+        std::ifstream file{path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+private:
+    std::filesystem::path m_test_dir;
+    std::filesystem::path m_archive_dir;
+    std::filesystem::path m_cache_dir;
+    std::string m_tables_content;
+};
+}  // namespace
+
+TEST_CASE("Test ArchiveRangeCache whole files", "[clp-s][ArchiveRangeCache]") {
+    TestArchive const archive;
+    ArchiveRangeCache cache{archive.get_url(), archive.get_cache_dir()};
+
+    auto const path = cache.fetch_file(cDictFileName);
+    REQUIRE("dictionary" == TestArchive::read_file(path));
+    REQUIRE(std::nullopt == cache.try_fetch_file("/missing"));
+
+    // Cached files are reused, by this and other instances
+    archive.remove_archive_files();
+    REQUIRE(path == cache.fetch_file(cDictFileName));
+    ArchiveRangeCache other_cache{archive.get_url(), archive.get_cache_dir()};
+    REQUIRE(path == other_cache.fetch_file(cDictFileName));
+    REQUIRE("dictionary" == TestArchive::read_file(path));
+    REQUIRE_THROWS_AS(other_cache.fetch_file(cTablesFileName), ArchiveRangeCache::OperationFailed);
+}
+
+TEST_CASE("Test ArchiveRangeCache ranges", "[clp-s][ArchiveRangeCache]") {
+    TestArchive const archive;
+    auto const& content = archive.get_tables_content();
+    ArchiveRangeCache cache{archive.get_url(), archive.get_cache_dir()};
+    auto const path = cache.get_partial_file_path(cTablesFileName);
+
+    cache.fetch_range(cTablesFileName, 100, 200);
+    cache.fetch_range(cTablesFileName, 200, 300);
+    cache.fetch_range(cTablesFileName, 250, 400);
+    cache.fetch_range(cTablesFileName, 1000, 2000);
+    cache.fetch_range(cTablesFileName, cTablesFileSize - 10, std::nullopt);
+    // Empty ranges are ignored
+    cache.fetch_range(cTablesFileName, 3000, 3000);
+
+    auto const cached_content = TestArchive::read_file(path);
+    REQUIRE(cTablesFileSize == cached_content.size());
+    REQUIRE(content.substr(100, 300) == cached_content.substr(100, 300));
+    REQUIRE(content.substr(1000, 1000) == cached_content.substr(1000, 1000));
+    REQUIRE(content.substr(cTablesFileSize - 10) == cached_content.substr(cTablesFileSize - 10));
+
+    archive.remove_archive_files();
+
+    // Adjacent and overlapping ranges are merged, so ranges spanning them are cached
+    cache.fetch_range(cTablesFileName, 100, 400);
+    cache.fetch_range(cTablesFileName, 150, 350);
+    cache.fetch_range(cTablesFileName, 1000, 2000);
+    cache.fetch_range(cTablesFileName, cTablesFileSize - 5, std::nullopt);
+
+    // Ranges that aren't entirely cached are downloaded, which fails
+    REQUIRE_THROWS_AS(
+            cache.fetch_range(cTablesFileName, 99, 200),
+            ArchiveRangeCache::OperationFailed
+    );
+    REQUIRE_THROWS_AS(
+            cache.fetch_range(cTablesFileName, 300, 1000),
+            ArchiveRangeCache::OperationFailed
+    );
+    REQUIRE_THROWS_AS(
+            cache.fetch_range(cTablesFileName, 1500, std::nullopt),
+            ArchiveRangeCache::OperationFailed
+    );
+
+    // The cached ranges are reused by other instances
+    ArchiveRangeCache other_cache{archive.get_url(), archive.get_cache_dir()};
+    other_cache.fetch_range(cTablesFileName, 100, 400);
+    other_cache.fetch_range(cTablesFileName, 1000, 2000);
+    REQUIRE_THROWS_AS(
+            other_cache.fetch_range(cTablesFileName, 0, 100),
+            ArchiveRangeCache::OperationFailed
+    );
+}
+
+TEST_CASE("Test ArchiveRangeCache truncated ranges", "[clp-s][ArchiveRangeCache]") {
+    TestArchive const archive;
+    ArchiveRangeCache cache{archive.get_url(), archive.get_cache_dir()};
+
+    // A range past the end of the file is truncated, so it isn't cached
+    REQUIRE_THROWS_AS(
+            cache.fetch_range(cTablesFileName, cTablesFileSize - 100, cTablesFileSize + 100),
+            ArchiveRangeCache::OperationFailed
+    );
+    archive.remove_archive_files();
+    REQUIRE_THROWS_AS(
+            cache.fetch_range(cTablesFileName, cTablesFileSize - 100, cTablesFileSize),
+            ArchiveRangeCache::OperationFailed
+    );
+}
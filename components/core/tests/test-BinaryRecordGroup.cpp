@@ -0,0 +1,227 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/reducer/BinaryRecordGroup.hpp"
+#include "../src/reducer/ConstRecordIterator.hpp"
+#include "../src/reducer/GroupTags.hpp"
+#include "../src/reducer/Record.hpp"
+#include "../src/reducer/RecordTypedKeyIterator.hpp"
+
+using reducer::BinaryRecordGroup;
+using reducer::ConstRecordIterator;
+using reducer::GroupTags;
+using reducer::Record;
+using reducer::RecordTypedKeyIterator;
+using reducer::serialize_binary;
+using reducer::TypedRecordKey;
+using reducer::ValueType;
+
+namespace {
+using Value = std::variant<std::string, int64_t, double>;
+using Element = std::pair<std::string, Value>;
+
+/**
+ * @param value
+ * @return The type of the given value
+ */
+auto get_value_type(Value const& value) -> ValueType;
+
+/**
+ * A record holding a list of elements, which may contain the same key more than once.
+ */
+class TestRecord : public Record {
+public:
+    explicit TestRecord(std::vector<Element> elements) : m_elements{std::move(elements)} {}
+
+    [[nodiscard]] auto get_string_view(std::string_view key) const -> std::string_view override {
+        auto const* value = find<std::string>(key);
+        return nullptr == value ? std::string_view{} : std::string_view{*value};
+    }
+
+    [[nodiscard]] auto get_int64_value(std::string_view key) const -> int64_t override {
+        auto const* value = find<int64_t>(key);
+        return nullptr == value ? 0 : *value;
+    }
+
+    [[nodiscard]] auto get_double_value(std::string_view key) const -> double override {
+        auto const* value = find<double>(key);
+        return nullptr == value ? 0.0 : *value;
+    }
+
+    [[nodiscard]] auto typed_key_iter() const -> std::unique_ptr<RecordTypedKeyIterator> override {
+        return std::make_unique<TypedKeyIterator>(m_elements);
+    }
+
+private:
+    class TypedKeyIterator : public RecordTypedKeyIterator {
+    public:
+        explicit TypedKeyIterator(std::vector<Element> const& elements)
+                : m_cur{elements.cbegin()},
+                  m_end{elements.cend()} {}
+
+        auto get() -> TypedRecordKey override {
+            return {m_cur->first, get_value_type(m_cur->second)};
+        }
+
+        void next() override { ++m_cur; }
+
+        auto done() -> bool override { return m_cur == m_end; }
+
+    private:
+        std::vector<Element>::const_iterator m_cur;
+        std::vector<Element>::const_iterator m_end;
+    };
+
+    template <typename T>
+    [[nodiscard]] auto find(std::string_view key) const -> T const* {
+        for (auto const& [element_key, value] : m_elements) {
+            if (key == element_key && std::holds_alternative<T>(value)) {
+                return &std::get<T>(value);
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<Element> m_elements;
+};
+
+class TestRecordIterator : public ConstRecordIterator {
+public:
+    explicit TestRecordIterator(std::vector<TestRecord> const& records)
+            : m_cur{records.cbegin()},
+              m_end{records.cend()} {}
+
+    [[nodiscard]] auto get() const -> Record const& override { return *m_cur; }
+
+    void next() override { ++m_cur; }
+
+    auto done() -> bool override { return m_cur == m_end; }
+
+private:
+    std::vector<TestRecord>::const_iterator m_cur;
+    std::vector<TestRecord>::const_iterator m_end;
+};
+
+/**
+ * @param record
+ * @return Every typed key in the given record, in iteration order
+ */
+auto get_typed_keys(Record const& record) -> std::vector<std::pair<std::string, ValueType>>;
+
+auto get_value_type(Value const& value) -> ValueType {
+    if (std::holds_alternative<int64_t>(value)) {
+        return ValueType::Int64;
+    }
+    if (std::holds_alternative<double>(value)) {
+        return ValueType::Double;
+    }
+    return ValueType::String;
+}
+
+auto get_typed_keys(Record const& record) -> std::vector<std::pair<std::string, ValueType>> {
+    std::vector<std::pair<std::string, ValueType>> typed_keys;
+    for (auto it = record.typed_key_iter(); false == it->done(); it->next()) {
+        auto const typed_key = it->get();
+        typed_keys.emplace_back(typed_key.get_key(), typed_key.get_type());
+    }
+    return typed_keys;
+}
+}  // namespace
+
+TEST_CASE("Test BinaryRecordGroup round trip", "[reducer][BinaryRecordGroup]") {
+    GroupTags const tags{"tag", "", std::string{"with\0null", 9}};
+    std::vector<TestRecord> const records{
+            TestRecord{{{"str", "a"}, {"int", int64_t{-1}}, {"double", 0.5}}},
+            // Missing and mistyped keys, and a duplicate key whose first value wins
+            TestRecord{{{"int", "not an int"}, {"str", ""}, {"str", "ignored"}}},
+            TestRecord{{}},
+            TestRecord{{{"str", "bcd"}, {"int", INT64_MAX}, {"new", 2.25}}}
+    };
+
+    TestRecordIterator record_it{records};
+    auto const serialized = serialize_binary(tags, record_it);
+    auto const* buf = reinterpret_cast<char const*>(serialized.data());
+    REQUIRE(BinaryRecordGroup::is_binary_record_group(buf, serialized.size()));
+
+    BinaryRecordGroup group{buf, serialized.size()};
+    REQUIRE(tags == group.get_tags());
+
+    // Columns are ordered by their first appearance, and absent columns are skipped
+    using TypedKeys = std::vector<std::pair<std::string, ValueType>>;
+    std::vector<TypedKeys> const expected_typed_keys{
+            {{"str", ValueType::String}, {"int", ValueType::Int64}, {"double", ValueType::Double}},
+            {{"str", ValueType::String}, {"int", ValueType::String}},
+            {},
+            {{"str", ValueType::String}, {"int", ValueType::Int64}, {"new", ValueType::Double}}
+    };
+
+    auto& it = group.record_iter();
+    size_t num_records{0};
+    for (; false == it.done(); it.next(), ++num_records) {
+        REQUIRE(num_records < records.size());
+        auto const& expected = records[num_records];
+        auto const& actual = it.get();
+        REQUIRE(expected_typed_keys[num_records] == get_typed_keys(actual));
+        REQUIRE(expected.get_string_view("str") == actual.get_string_view("str"));
+        REQUIRE(expected.get_string_view("int") == actual.get_string_view("int"));
+        REQUIRE(expected.get_int64_value("int") == actual.get_int64_value("int"));
+        REQUIRE(expected.get_double_value("double") == actual.get_double_value("double"));
+        REQUIRE(expected.get_double_value("new") == actual.get_double_value("new"));
+        REQUIRE(0 == actual.get_int64_value("missing"));
+    }
+    REQUIRE(records.size() == num_records);
+}
+
+TEST_CASE("Test BinaryRecordGroup with no records", "[reducer][BinaryRecordGroup]") {
+    std::vector<TestRecord> const records;
+    TestRecordIterator record_it{records};
+    auto const serialized = serialize_binary({"tag"}, record_it);
+
+    BinaryRecordGroup group{reinterpret_cast<char const*>(serialized.data()), serialized.size()};
+    REQUIRE(GroupTags{"tag"} == group.get_tags());
+    REQUIRE(group.record_iter().done());
+}
+
+TEST_CASE("Test BinaryRecordGroup invalid buffers", "[reducer][BinaryRecordGroup]") {
+    std::vector<TestRecord> const records{TestRecord{{{"str", "abc"}, {"int", int64_t{1}}}}};
+    TestRecordIterator record_it{records};
+    auto const serialized = serialize_binary({"tag"}, record_it);
+    auto const* buf = reinterpret_cast<char const*>(serialized.data());
+
+    // Every proper prefix of the buffer is truncated
+    for (size_t len = 0; len < serialized.size(); ++len) {
+        REQUIRE_THROWS_AS(BinaryRecordGroup(buf, len), BinaryRecordGroup::OperationFailed);
+    }
+
+    auto trailing_bytes = serialized;
+    trailing_bytes.push_back(0);
+    REQUIRE_THROWS_AS(
+            BinaryRecordGroup(
+                    reinterpret_cast<char const*>(trailing_bytes.data()),
+                    trailing_bytes.size()
+            ),
+            BinaryRecordGroup::OperationFailed
+    );
+
+    auto bad_version = serialized;
+    bad_version[1] = BinaryRecordGroup::cVersion + 1;
+    REQUIRE_THROWS_AS(
+            BinaryRecordGroup(
+                    reinterpret_cast<char const*>(bad_version.data()),
+                    bad_version.size()
+            ),
+            BinaryRecordGroup::OperationFailed
+    );
+
+    REQUIRE(false == BinaryRecordGroup::is_binary_record_group(buf, 0));
+    char const msgpack_map{static_cast<char>(0x81)};
+    REQUIRE(false == BinaryRecordGroup::is_binary_record_group(&msgpack_map, 1));
+}
@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp/BloomFilter.hpp"
+#include "../src/clp/FileWriter.hpp"
+
+using clp::BloomFilter;
+using clp::FileWriter;
+using std::string;
+
+TEST_CASE("Test Bloom filter", "[BloomFilter]") {
+    constexpr size_t cNumValues{10'000};
+    constexpr double cFalsePositiveRate{0.01};
+
+    BloomFilter filter{cNumValues, cFalsePositiveRate};
+    for (size_t i = 0; i < cNumValues; ++i) {
+        filter.add("value" + std::to_string(i));
+    }
+
+    auto const count_false_positives = [&](BloomFilter const& filter_to_check) {
+        size_t num_false_positives{0};
+        for (size_t i = 0; i < cNumValues; ++i) {
+            if (filter_to_check.possibly_contains("absent" + std::to_string(i))) {
+                ++num_false_positives;
+            }
+        }
+        return num_false_positives;
+    };
+
+    SECTION("No false negatives") {
+        for (size_t i = 0; i < cNumValues; ++i) {
+            REQUIRE(filter.possibly_contains("value" + std::to_string(i)));
+        }
+    }
+
+    SECTION("False positive rate is near the target") {
+        REQUIRE(count_false_positives(filter) < 2 * cFalsePositiveRate * cNumValues);
+    }
+
+    SECTION("Round-trip through a file") {
+        string const test_file_path{"BloomFilter.test"};
+        FileWriter file_writer;
+        file_writer.open(test_file_path, FileWriter::OpenMode::CREATE_FOR_WRITING);
+        filter.write(file_writer);
+        file_writer.close();
+
+        auto const read_filter = BloomFilter::try_read_from_file(test_file_path);
+        REQUIRE(read_filter.has_value());
+        for (size_t i = 0; i < cNumValues; ++i) {
+            REQUIRE(read_filter->possibly_contains("value" + std::to_string(i)));
+        }
+        REQUIRE(count_false_positives(read_filter.value()) == count_false_positives(filter));
+
+        boost::filesystem::remove(test_file_path);
+    }
+
+    SECTION("Missing file") {
+        REQUIRE(false == BloomFilter::try_read_from_file("BloomFilter.missing").has_value());
+    }
+}
@@ -0,0 +1,138 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/ColumnArena.hpp"
+
+using clp_s::ArenaBuffer;
+using clp_s::ColumnArena;
+
+TEST_CASE("Test ColumnArena allocation", "[ColumnArena]") {
+    constexpr size_t cBlockSize{4096};
+    ColumnArena arena{cBlockSize};
+    REQUIRE(0 == arena.get_reserved_size());
+
+    auto* first = static_cast<std::byte*>(arena.allocate(3, 1));
+    auto* second = static_cast<std::byte*>(arena.allocate(8, 8));
+    REQUIRE(0 == reinterpret_cast<uintptr_t>(first) % ColumnArena::cCacheLineSize);
+    REQUIRE(0 == reinterpret_cast<uintptr_t>(second) % 8);
+    REQUIRE(first + 8 == second);
+    REQUIRE(cBlockSize == arena.get_reserved_size());
+    // Alignment padding isn't counted as allocated
+    REQUIRE(11 == arena.get_allocated_size());
+
+    // Large requests get their own block
+    REQUIRE(nullptr != arena.allocate(cBlockSize, 8));
+    REQUIRE(2 * cBlockSize == arena.get_reserved_size());
+
+    arena.reset();
+    REQUIRE(0 == arena.get_reserved_size());
+    REQUIRE(0 == arena.get_allocated_size());
+}
+
+TEST_CASE("Test ColumnArena object lifetimes", "[ColumnArena]") {
+    std::vector<int> destroyed;
+    struct Tracked {
+        Tracked(std::vector<int>& destroyed, int id) : destroyed{destroyed}, id{id} {}
+
+        ~Tracked() { destroyed.push_back(id); }
+
+        std::vector<int>& destroyed;
+        int id;
+    };
+
+    ColumnArena arena;
+    auto* first = arena.create<Tracked>(destroyed, 1);
+    auto* second = arena.create<Tracked>(destroyed, 2);
+    REQUIRE(1 == first->id);
+    REQUIRE(2 == second->id);
+    REQUIRE(destroyed.empty());
+
+    arena.reset();
+    REQUIRE((std::vector<int>{2, 1}) == destroyed);
+}
+
+TEST_CASE("Test ArenaBuffer", "[ColumnArena]") {
+    constexpr int64_t cNumValues{100'000};
+
+    ColumnArena arena;
+    ArenaBuffer<int64_t> buffer{arena};
+    REQUIRE(buffer.empty());
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        buffer.push_back(i);
+    }
+    REQUIRE(cNumValues == buffer.size());
+
+    std::vector<int64_t> values;
+    size_t num_segments{0};
+    buffer.for_each_segment([&](std::span<int64_t const> segment) {
+        REQUIRE(false == segment.empty());
+        REQUIRE(segment.size_bytes() <= ArenaBuffer<int64_t>::cMaxSegmentSize);
+        values.insert(values.end(), segment.begin(), segment.end());
+        ++num_segments;
+    });
+    REQUIRE(num_segments > 1);
+    REQUIRE(cNumValues == values.size());
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        REQUIRE(i == values[i]);
+    }
+    REQUIRE(arena.get_allocated_size() >= cNumValues * sizeof(int64_t));
+}
+
+TEST_CASE("Test ColumnArena reuse of deallocated memory", "[ColumnArena]") {
+    ColumnArena arena;
+    ArenaBuffer<int64_t> buffer{arena};
+    for (int64_t i = 0; i < 10'000; ++i) {
+        buffer.push_back(i);
+    }
+    auto const allocated_size = arena.get_allocated_size();
+    auto const reserved_size = arena.get_reserved_size();
+
+    buffer.clear();
+    REQUIRE(buffer.empty());
+    REQUIRE(0 == arena.get_allocated_size());
+
+    // Refilling the buffer reuses its segments rather than requesting more memory
+    for (int64_t i = 0; i < 10'000; ++i) {
+        buffer.push_back(i);
+    }
+    REQUIRE(allocated_size == arena.get_allocated_size());
+    REQUIRE(reserved_size == arena.get_reserved_size());
+}
+
+TEST_CASE("Test ColumnArena repeated allocation and deallocation", "[ColumnArena]") {
+    constexpr size_t cBlockSize{4096};
+    constexpr int cNumRounds{100};
+    // Includes a size that gets its own block
+    constexpr std::array<size_t, 5> cSizes{8, 24, 64, 200, cBlockSize};
+    ColumnArena arena{cBlockSize};
+
+    // Leave the bump pointer unaligned so that later aligned allocations need padding
+    REQUIRE(nullptr != arena.allocate(3, 1));
+    auto const allocated_size = arena.get_allocated_size();
+
+    std::vector<std::pair<void*, size_t>> allocations;
+    size_t reserved_size{0};
+    for (int round = 0; round < cNumRounds; ++round) {
+        for (auto const size : cSizes) {
+            allocations.emplace_back(arena.allocate(size, 8), size);
+        }
+        REQUIRE(allocated_size < arena.get_allocated_size());
+        for (auto const& [ptr, size] : allocations) {
+            arena.deallocate(ptr, size, 8);
+        }
+        allocations.clear();
+        REQUIRE(allocated_size == arena.get_allocated_size());
+
+        // Every round after the first reuses the deallocated memory
+        if (0 == round) {
+            reserved_size = arena.get_reserved_size();
+        }
+        REQUIRE(reserved_size == arena.get_reserved_size());
+    }
+}
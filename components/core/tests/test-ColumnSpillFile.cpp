@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/ColumnArena.hpp"
+#include "../src/clp_s/ColumnSpillFile.hpp"
+#include "../src/clp_s/FileReader.hpp"
+#include "../src/clp_s/FileWriter.hpp"
+#include "../src/clp_s/ZstdCompressor.hpp"
+#include "../src/clp_s/ZstdDecompressor.hpp"
+
+using clp_s::ColumnArena;
+using clp_s::ColumnSpillFile;
+using clp_s::SpillableBuffer;
+
+TEST_CASE("Test spilling column buffers", "[ColumnSpillFile]") {
+    constexpr int64_t cNumValuesPerSpill{50'000};
+    constexpr int cNumSpills{3};
+    constexpr int64_t cNumValues{(cNumSpills + 1) * cNumValuesPerSpill};
+    std::string const spill_file_path{"ColumnSpillFile.spill.test"};
+    std::string const table_file_path{"ColumnSpillFile.table.test"};
+
+    ColumnArena arena;
+    ColumnSpillFile spill_file;
+    spill_file.open(spill_file_path, 1);
+    SpillableBuffer<int64_t> first{arena};
+    SpillableBuffer<int64_t> second{arena};
+
+    size_t reserved_size_after_first_spill{0};
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        first.push_back(i);
+        second.push_back(-i);
+        if (0 == (i + 1) % cNumValuesPerSpill && i + 1 < cNumValues) {
+            first.spill(spill_file);
+            second.spill(spill_file);
+            REQUIRE(0 == first.get_num_unspilled_values());
+            REQUIRE(0 == arena.get_allocated_size());
+            // Later values reuse the memory of the spilled values
+            if (0 == reserved_size_after_first_spill) {
+                reserved_size_after_first_spill = arena.get_reserved_size();
+            }
+            REQUIRE(reserved_size_after_first_spill == arena.get_reserved_size());
+        }
+    }
+    REQUIRE(cNumValues == first.size());
+    REQUIRE(cNumValuesPerSpill == first.get_num_unspilled_values());
+    REQUIRE(spill_file.get_size() > 0);
+
+    // Merge the spilled and unspilled values into a table
+    clp_s::FileWriter table_writer;
+    clp_s::ZstdCompressor compressor;
+    table_writer.open(table_file_path, clp_s::FileWriter::OpenMode::CreateForWriting);
+    compressor.open(table_writer);
+    REQUIRE(cNumValues * sizeof(int64_t) == first.write(compressor, spill_file));
+    REQUIRE(cNumValues * sizeof(int64_t) == second.write(compressor, spill_file));
+    compressor.close();
+    table_writer.close();
+    spill_file.close();
+    REQUIRE(false == boost::filesystem::exists(spill_file_path));
+
+    clp_s::FileReader table_reader;
+    clp_s::ZstdDecompressor decompressor;
+    table_reader.open(table_file_path);
+    decompressor.open(table_reader, 64 * 1024);
+    std::vector<int64_t> values(2 * cNumValues);
+    REQUIRE(clp_s::ErrorCodeSuccess
+            == decompressor.try_read_exact_length(
+                    reinterpret_cast<char*>(values.data()),
+                    values.size() * sizeof(int64_t)
+            ));
+    decompressor.close();
+    table_reader.close();
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        REQUIRE(i == values[i]);
+        REQUIRE(-i == values[cNumValues + i]);
+    }
+
+    boost::filesystem::remove(table_file_path);
+}
+
+TEST_CASE("Test transforming spilled column buffers", "[ColumnSpillFile]") {
+    constexpr int64_t cNumValues{100'000};
+    constexpr int64_t cNumValuesPerSpill{30'000};
+    std::string const spill_file_path{"ColumnSpillFile.transform.spill.test"};
+    std::string const table_file_path{"ColumnSpillFile.transform.table.test"};
+
+    ColumnArena arena;
+    ColumnSpillFile spill_file;
+    spill_file.open(spill_file_path, 1);
+    SpillableBuffer<int64_t> buffer{arena};
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        buffer.push_back(i);
+        if (0 == (i + 1) % cNumValuesPerSpill) {
+            buffer.spill(spill_file);
+        }
+    }
+
+    clp_s::FileWriter table_writer;
+    clp_s::ZstdCompressor compressor;
+    table_writer.open(table_file_path, clp_s::FileWriter::OpenMode::CreateForWriting);
+    compressor.open(table_writer);
+    int64_t num_transformed_values{0};
+    auto const num_bytes_written
+            = buffer.write(compressor, spill_file, [&](std::span<int64_t> values) {
+                  for (auto& value : values) {
+                      value = 2 * value + 1;
+                  }
+                  num_transformed_values += static_cast<int64_t>(values.size());
+              });
+    REQUIRE(cNumValues * sizeof(int64_t) == num_bytes_written);
+    REQUIRE(cNumValues == num_transformed_values);
+    compressor.close();
+    table_writer.close();
+    spill_file.close();
+
+    clp_s::FileReader table_reader;
+    clp_s::ZstdDecompressor decompressor;
+    table_reader.open(table_file_path);
+    decompressor.open(table_reader, 64 * 1024);
+    std::vector<int64_t> values(cNumValues);
+    REQUIRE(clp_s::ErrorCodeSuccess
+            == decompressor.try_read_exact_length(
+                    reinterpret_cast<char*>(values.data()),
+                    values.size() * sizeof(int64_t)
+            ));
+    decompressor.close();
+    table_reader.close();
+    for (int64_t i = 0; i < cNumValues; ++i) {
+        REQUIRE(2 * i + 1 == values[i]);
+    }
+
+    boost::filesystem::remove(table_file_path);
+}
+
+TEST_CASE("Test destroying an open spill file", "[ColumnSpillFile]") {
+    std::string const spill_file_path{"ColumnSpillFile.destroy.spill.test"};
+
+    ColumnArena arena;
+    SpillableBuffer<int64_t> buffer{arena};
+    for (int64_t i = 0; i < 1000; ++i) {
+        buffer.push_back(i);
+    }
+    {
+        ColumnSpillFile spill_file;
+        spill_file.open(spill_file_path, 1);
+        buffer.spill(spill_file);
+        REQUIRE(boost::filesystem::exists(spill_file_path));
+    }
+    REQUIRE(false == boost::filesystem::exists(spill_file_path));
+}
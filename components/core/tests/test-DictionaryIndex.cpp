@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/DictionaryIndexReader.hpp"
+#include "../src/clp_s/DictionaryIndexWriter.hpp"
+
+using clp_s::DictionaryIndexReader;
+using clp_s::DictionaryIndexWriter;
+
+namespace {
+constexpr int cCompressionLevel{3};
+constexpr char cArchivePath[] = "DictionaryIndex.test";
+
+/**
+ * @return The path of the dictionary index in the test archive
+ */
+auto get_index_path() -> std::string;
+
+auto get_index_path() -> std::string {
+    return std::string{cArchivePath} + clp_s::constants::cArchiveDictionaryIndexFile;
+}
+}  // namespace
+
+TEST_CASE("Test dictionary index round trip", "[clp-s][DictionaryIndex]") {
+    boost::filesystem::create_directory(cArchivePath);
+
+    DictionaryIndexWriter writer;
+    writer.add_variable_ids(0, 1, {5, 3, 5, 1});
+    writer.add_variable_ids(2, 4, {3, 7});
+    // A column's IDs may be added more than once, e.g., after it's spilled
+    writer.add_variable_ids(0, 1, {3, 9});
+    writer.add_variable_ids(1, 1, {});
+    writer.add_logtype_ids(0, 2, {0, 1});
+    writer.add_logtype_ids(2, 3, {1});
+    REQUIRE(writer.store(cArchivePath, cCompressionLevel) > 0);
+
+    DictionaryIndexReader reader;
+    reader.read(get_index_path(), {1, 3, 7, 8, 9}, {1});
+
+    REQUIRE(reader.contains_any_variable_id({1}, 0, 1));
+    REQUIRE(reader.contains_any_variable_id({3}, 0, 1));
+    REQUIRE(reader.contains_any_variable_id({3}, 2, 4));
+    REQUIRE(reader.contains_any_variable_id({9}, 0, 1));
+    REQUIRE(reader.contains_any_variable_id({8, 7}, 2, 4));
+    REQUIRE(false == reader.contains_any_variable_id({7}, 0, 1));
+    REQUIRE(false == reader.contains_any_variable_id({1, 9}, 2, 4));
+    // IDs that aren't in the index, or whose postings weren't read, match nothing
+    REQUIRE(false == reader.contains_any_variable_id({8}, 0, 1));
+    REQUIRE(false == reader.contains_any_variable_id({5}, 0, 1));
+    REQUIRE(false == reader.contains_any_variable_id({3}, 1, 1));
+
+    REQUIRE(reader.contains_any_logtype_id({1}, 0, 2));
+    REQUIRE(reader.contains_any_logtype_id({1}, 2, 3));
+    REQUIRE(false == reader.contains_any_logtype_id({0}, 0, 2));
+    REQUIRE(false == reader.contains_any_logtype_id({1}, 0, 1));
+
+    // Storing the index clears it
+    REQUIRE(writer.store(cArchivePath, cCompressionLevel) > 0);
+    reader.read(get_index_path(), {1, 3, 5, 7, 9}, {0, 1});
+    REQUIRE(false == reader.contains_any_variable_id({1, 3, 5, 7, 9}, 0, 1));
+    REQUIRE(false == reader.contains_any_logtype_id({0, 1}, 0, 2));
+
+    boost::filesystem::remove_all(cArchivePath);
+}
+
+TEST_CASE("Test dictionary index after remapping variable IDs", "[clp-s][DictionaryIndex]") {
+    boost::filesystem::create_directory(cArchivePath);
+
+    DictionaryIndexWriter writer;
+    writer.add_variable_ids(0, 1, {0, 2});
+    writer.add_variable_ids(0, 2, {1, 3});
+    writer.add_variable_ids(1, 1, {3});
+    writer.add_logtype_ids(0, 3, {0, 2});
+
+    // The sorted variable dictionary maps ID `i` to `sorted_ids[i]`
+    std::vector<uint64_t> const sorted_ids{3, 0, 2, 1};
+    writer.remap_variable_ids(sorted_ids);
+    REQUIRE(writer.store(cArchivePath, cCompressionLevel) > 0);
+
+    DictionaryIndexReader reader;
+    reader.read(get_index_path(), {0, 1, 2, 3}, {0, 1, 2});
+    for (uint64_t old_id = 0; old_id < sorted_ids.size(); ++old_id) {
+        auto const new_id = sorted_ids[old_id];
+        bool const in_column_0_1 = 0 == old_id || 2 == old_id;
+        bool const in_column_0_2 = 1 == old_id || 3 == old_id;
+        bool const in_column_1_1 = 3 == old_id;
+        REQUIRE(in_column_0_1 == reader.contains_any_variable_id({new_id}, 0, 1));
+        REQUIRE(in_column_0_2 == reader.contains_any_variable_id({new_id}, 0, 2));
+        REQUIRE(in_column_1_1 == reader.contains_any_variable_id({new_id}, 1, 1));
+    }
+
+    // Logtype IDs aren't remapped
+    REQUIRE(reader.contains_any_logtype_id({0}, 0, 3));
+    REQUIRE(reader.contains_any_logtype_id({2}, 0, 3));
+    REQUIRE(false == reader.contains_any_logtype_id({1}, 0, 3));
+
+    boost::filesystem::remove_all(cArchivePath);
+}
@@ -2,16 +2,22 @@
 
 #include <Catch2/single_include/catch2/catch.hpp>
 
+#include "../src/clp/BufferReader.hpp"
 #include "../src/clp/EncodedVariableInterpreter.hpp"
+#include "../src/clp/ffi/ir_stream/decoding_methods.hpp"
+#include "../src/clp/ffi/ir_stream/encoding_methods.hpp"
 #include "../src/clp/ir/types.hpp"
 #include "../src/clp/streaming_archive/Constants.hpp"
+#include "../src/clp/type_utils.hpp"
 
 using clp::cVariableDictionaryIdMax;
 using clp::encoded_variable_t;
 using clp::EncodedVariableInterpreter;
 using clp::enum_to_underlying_type;
 using clp::ir::VariablePlaceholder;
+using clp::size_checked_pointer_cast;
 using std::string;
+using std::string_view;
 using std::to_string;
 using std::vector;
 
@@ -523,6 +529,43 @@ TEST_CASE("EncodedVariableInterpreter", "[EncodedVariableInterpreter]") {
         ));
         REQUIRE(msg == decompressed_msg);
 
+        // Test transcoding into four-byte encoding IR
+        string ir_logtype;
+        vector<clp::ir::four_byte_encoded_variable_t> ir_encoded_vars;
+        vector<string_view> ir_dict_vars;
+        string converted_vars;
+        REQUIRE(EncodedVariableInterpreter::transcode_to_four_byte_ir(
+                logtype_dict_entry,
+                var_dict_reader,
+                encoded_vars,
+                ir_logtype,
+                ir_encoded_vars,
+                ir_dict_vars,
+                converted_vars
+        ));
+        vector<int8_t> ir_buf;
+        REQUIRE(clp::ffi::ir_stream::four_byte_encoding::serialize_parsed_log_event(
+                0,
+                ir_logtype,
+                ir_encoded_vars,
+                ir_dict_vars,
+                ir_buf
+        ));
+        clp::BufferReader ir_reader{size_checked_pointer_cast<char>(ir_buf.data()), ir_buf.size()};
+        clp::ffi::ir_stream::encoded_tag_t encoded_tag{};
+        REQUIRE(clp::ffi::ir_stream::IRErrorCode_Success
+                == clp::ffi::ir_stream::deserialize_tag(ir_reader, encoded_tag));
+        string ir_msg;
+        clp::ir::epoch_time_ms_t timestamp_delta{};
+        REQUIRE(clp::ffi::ir_stream::IRErrorCode_Success
+                == clp::ffi::ir_stream::four_byte_encoding::deserialize_log_event(
+                        ir_reader,
+                        encoded_tag,
+                        ir_msg,
+                        timestamp_delta
+                ));
+        REQUIRE(msg == ir_msg);
+
         var_dict_reader.close();
 
         // Clean-up
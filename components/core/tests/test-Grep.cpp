@@ -250,3 +250,22 @@ TEST_CASE("get_bounds_of_next_potential_var", "[get_bounds_of_next_potential_var
             )
             == false);
 }
+
+TEST_CASE("get_dictionary_vars_required_by_query", "[get_dictionary_vars_required_by_query]") {
+    using Vars = std::vector<string>;
+
+    // Variables adjacent to the implicit leading and trailing wildcards may be part of longer
+    // variables
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("abc123").empty());
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("id=abc123").empty());
+
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("request id=abc123 done")
+            == Vars{"abc123"});
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("ids abc123 0x1f2e done")
+            == Vars{"abc123", "0x1f2e"});
+
+    // Integers, floats, and tokens with wildcards or escapes aren't dictionary variables
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("took 123 ms, 1.5 s done").empty());
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("user abc*123 done").empty());
+    REQUIRE(Grep::get_dictionary_vars_required_by_query("user abc\\*123 done").empty());
+}
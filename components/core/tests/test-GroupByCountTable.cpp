@@ -0,0 +1,128 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/reducer/GroupByCountTable.hpp"
+#include "../src/reducer/GroupTags.hpp"
+
+using reducer::GroupByCountTable;
+using reducer::GroupTags;
+
+namespace {
+constexpr char cCountKey[] = "count";
+
+/**
+ * Packs the given tags into a group key
+ * @param tags
+ * @return The packed key
+ */
+auto pack_tags(GroupTags const& tags) -> std::string;
+
+/**
+ * @param table
+ * @return The tags and count of every group in the table, in iteration order
+ */
+auto get_groups(GroupByCountTable const& table) -> std::vector<std::pair<GroupTags, int64_t>>;
+
+auto pack_tags(GroupTags const& tags) -> std::string {
+    std::string packed_key;
+    for (auto const& tag : tags) {
+        GroupByCountTable::append_tag(packed_key, tag);
+    }
+    return packed_key;
+}
+
+auto get_groups(GroupByCountTable const& table) -> std::vector<std::pair<GroupTags, int64_t>> {
+    std::vector<std::pair<GroupTags, int64_t>> groups;
+    for (auto it = table.get_record_group_iterator(cCountKey); false == it->done(); it->next()) {
+        auto& group = it->get();
+        auto& record_it = group.record_iter();
+        REQUIRE(false == record_it.done());
+        groups.emplace_back(group.get_tags(), record_it.get().get_int64_value(cCountKey));
+        record_it.next();
+        REQUIRE(record_it.done());
+    }
+    return groups;
+}
+}  // namespace
+
+TEST_CASE("Test GroupByCountTable tag packing", "[reducer][GroupByCountTable]") {
+    GroupTags const tags{"a", "", "longer tag", std::string{"\0b", 2}};
+    auto const packed_key = pack_tags(tags);
+
+    // A tag built incrementally is identical to one appended in one piece
+    std::string incremental_key;
+    for (auto const& tag : tags) {
+        auto const tag_begin = GroupByCountTable::begin_tag(incremental_key);
+        for (auto const c : tag) {
+            incremental_key.push_back(c);
+        }
+        GroupByCountTable::end_tag(incremental_key, tag_begin);
+    }
+    REQUIRE(packed_key == incremental_key);
+
+    GroupTags unpacked_tags{"stale"};
+    GroupByCountTable::unpack_tags(packed_key, unpacked_tags);
+    REQUIRE(tags == unpacked_tags);
+
+    GroupByCountTable::unpack_tags({}, unpacked_tags);
+    REQUIRE(unpacked_tags.empty());
+}
+
+TEST_CASE("Test GroupByCountTable counts", "[reducer][GroupByCountTable]") {
+    GroupByCountTable table;
+    REQUIRE(table.empty());
+    REQUIRE(get_groups(table).empty());
+
+    auto const a = pack_tags({"a"});
+    auto const b = pack_tags({"b"});
+    // Same bytes as `a` followed by an empty tag, which must be a different group
+    auto const a_empty = pack_tags({"a", ""});
+
+    table.increment(b);
+    table.increment(a);
+    table.add(b, 5);
+    table.increment(a_empty);
+    table.increment(b);
+    table.add(a, 0);
+
+    REQUIRE(3 == table.size());
+    REQUIRE(false == table.empty());
+
+    // Groups are iterated in the order they were first inserted
+    std::vector<std::pair<GroupTags, int64_t>> const expected_groups{
+            {{"b"}, 7},
+            {{"a"}, 1},
+            {{"a", ""}, 1}
+    };
+    REQUIRE(expected_groups == get_groups(table));
+}
+
+TEST_CASE("Test GroupByCountTable growth", "[reducer][GroupByCountTable]") {
+    constexpr size_t cNumGroups{GroupByCountTable::cInitialCapacity * 8 + 3};
+    GroupByCountTable table;
+    REQUIRE(GroupByCountTable::cInitialCapacity == table.get_capacity());
+
+    // Add each group once, then add to every group again after the table has grown several times
+    for (size_t i = 0; i < cNumGroups; ++i) {
+        table.add(pack_tags({std::to_string(i), "tag"}), static_cast<int64_t>(i));
+    }
+    for (size_t i = 0; i < cNumGroups; ++i) {
+        table.increment(pack_tags({std::to_string(i), "tag"}));
+    }
+
+    REQUIRE(cNumGroups == table.size());
+    REQUIRE(table.get_capacity() >= cNumGroups * 2);
+
+    auto const groups = get_groups(table);
+    REQUIRE(cNumGroups == groups.size());
+    for (size_t i = 0; i < cNumGroups; ++i) {
+        GroupTags const expected_tags{std::to_string(i), "tag"};
+        REQUIRE(expected_tags == groups[i].first);
+        REQUIRE(static_cast<int64_t>(i) + 1 == groups[i].second);
+    }
+}
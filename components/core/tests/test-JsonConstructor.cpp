@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/archive_constants.hpp"
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "../src/clp_s/JsonParser.hpp"
+
+using clp_s::JsonConstructor;
+using clp_s::JsonConstructorOption;
+using clp_s::JsonParser;
+using clp_s::JsonParserOption;
+
+namespace {
+constexpr char cTestDirName[] = "test-JsonConstructor";
+constexpr size_t cNumArchives{6};
+constexpr size_t cNumRecordsPerArchive{500};
+constexpr size_t cNumOrderedChunksPerArchive{2};
+constexpr size_t cNumThreads{4};
+
+/**
+ * A directory of archives, each compressed from its own generated file of JSON records, and
+ * directories to decompress them into. Everything is removed when the object is destroyed.
+ */
+class TestArchives {
+public:
+    TestArchives()
+            : m_test_dir{std::filesystem::temp_directory_path() / cTestDirName},
+              m_archives_dir{m_test_dir / "archives"} {
+        std::filesystem::remove_all(m_test_dir);
+        std::filesystem::create_directories(m_archives_dir);
+
+        for (size_t i = 0; i < cNumArchives; ++i) {
+            auto const input_path = m_test_dir / ("input" + std::to_string(i) + ".jsonl");
+            write_file(input_path, generate_records(i));
+            compress(input_path);
+        }
+        for (auto const& entry : std::filesystem::directory_iterator{m_archives_dir}) {
+            m_archive_ids.emplace_back(entry.path().filename());
+        }
+        std::sort(m_archive_ids.begin(), m_archive_ids.end());
+    }
+
+    // Delete copy & move constructors and assignment operators
+    TestArchives(TestArchives const&) = delete;
+    TestArchives(TestArchives&&) = delete;
+    auto operator=(TestArchives const&) -> TestArchives& = delete;
+    auto operator=(TestArchives&&) -> TestArchives& = delete;
+
+    // Destructor
+    ~TestArchives() { std::filesystem::remove_all(m_test_dir); }
+
+    [[nodiscard]] auto get_archive_ids() const -> std::vector<std::string> const& {
+        return m_archive_ids;
+    }
+
+    /**
+     * @param output_dir_name
+     * @param ordered
+     * @return Options for decompressing the archives into the given directory
+     */
+    [[nodiscard]] auto get_option(std::string const& output_dir_name, bool ordered) const
+            -> JsonConstructorOption {
+        JsonConstructorOption option{};
+        option.archives_dir = m_archives_dir.string();
+        option.output_dir = (m_test_dir / output_dir_name).string();
+        option.ordered = ordered;
+        if (ordered) {
+            option.ordered_chunk_size = cNumRecordsPerArchive / cNumOrderedChunksPerArchive;
+        }
+        return option;
+    }
+
+    /**
+     * Truncates the tables of the given archive, so that decompressing it fails
+     * @param archive_id
+     */
+    void corrupt_archive(std::string const& archive_id) const {
+        auto const tables_path = m_archives_dir / archive_id
+                                 / std::string{clp_s::constants::cArchiveTablesFile}.substr(1);
+        std::filesystem::resize_file(tables_path, std::filesystem::file_size(tables_path) / 2);
+    }
+
+    static void write_file(std::filesystem::path const& path, std::string const& content) {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file << content;
+    }
+
+    static auto read_file(std::filesystem::path const& path) -> std::string {
+        std::ifstream file{path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    /**
+     * @param dir
+     * @return The name and content of every file in the given directory
+     */
+    static auto read_dir(std::string const& dir) -> std::map<std::string, std::string> {
+        std::map<std::string, std::string> files;
+        for (auto const& entry : std::filesystem::directory_iterator{dir}) {
+            files.emplace(entry.path().filename(), read_file(entry.path()));
+        }
+        return files;
+    }
+
+    /**
+     * @param content
+     * @return The lines of the given content, sorted
+     */
+    static auto get_sorted_lines(std::string const& content) -> std::vector<std::string> {
+        std::vector<std::string> lines;
+        std::istringstream stream{content};
+        for (std::string line; std::getline(stream, line);) {
+            lines.emplace_back(line);
+        }
+        std::sort(lines.begin(), lines.end());
+        return lines;
+    }
+
+private:
+    /**
+     * @param file_ix
+     * @return Records with several shapes and out-of-order timestamps
+     */
+    static auto generate_records(size_t file_ix) -> std::string {
+        std::string records;
+        for (size_t i = 0; i < cNumRecordsPerArchive; ++i) {
+            auto const id = file_ix * cNumRecordsPerArchive + i;
+            auto const ts = std::to_string(file_ix * 1000 + (i * 7919) % cNumRecordsPerArchive);
+            records += R"({"ts":)" + ts + R"(,"id":)" + std::to_string(id);
+            switch (i % 3) {
+                case 0:
+                    records += R"(,"msg":"request )" + std::to_string(id) + R"( took 5 ms")";
+                    break;
+                case 1:
+                    records += R"(,"level":"WARN","ctx":{"user":"u)" + std::to_string(i % 11)
+                               + R"(","retry":true})";
+                    break;
+                default:
+                    records += R"(,"value":)" + std::to_string(static_cast<double>(id) / 4);
+                    break;
+            }
+            records += "}\n";
+        }
+        return records;
+    }
+
+    void compress(std::filesystem::path const& input_path) const {
+        JsonParserOption option{};
+        option.file_paths.emplace_back(input_path.string());
+        option.archives_dir = m_archives_dir.string();
+        option.timestamp_key = "ts";
+        option.target_encoded_size = 1ULL * 1024 * 1024 * 1024;
+        option.max_document_size = 1ULL * 1024 * 1024;
+        option.compression_level = 3;
+        option.print_archive_stats = false;
+        option.structurize_arrays = false;
+        option.build_dictionary_index = false;
+
+        JsonParser parser{option};
+        REQUIRE(parser.parse());
+        parser.store();
+    }
+
+    std::filesystem::path m_test_dir;
+    std::filesystem::path m_archives_dir;
+    std::vector<std::string> m_archive_ids;
+};
+
+/**
+ * Decompresses the given archives one at a time
+ * @param option
+ * @param archive_ids
+ */
+void decompress_serially(
+        JsonConstructorOption option,
+        std::vector<std::string> const& archive_ids
+);
+
+void decompress_serially(
+        JsonConstructorOption option,
+        std::vector<std::string> const& archive_ids
+) {
+    for (auto const& archive_id : archive_ids) {
+        option.archive_id = archive_id;
+        JsonConstructor constructor{option};
+        constructor.store();
+    }
+}
+}  // namespace
+
+TEST_CASE("Test concurrent unordered decompression", "[clp-s][JsonConstructor]") {
+    TestArchives const archives;
+    auto const& archive_ids = archives.get_archive_ids();
+    REQUIRE(cNumArchives == archive_ids.size());
+
+    auto const serial_option = archives.get_option("serial", false);
+    decompress_serially(serial_option, archive_ids);
+    auto const concurrent_option = archives.get_option("concurrent", false);
+    REQUIRE(clp_s::decompress_archives_concurrently(concurrent_option, archive_ids, cNumThreads));
+
+    // Archives may be appended in any order, so only the set of records must match
+    auto const serial_files = TestArchives::read_dir(serial_option.output_dir);
+    auto const concurrent_files = TestArchives::read_dir(concurrent_option.output_dir);
+    REQUIRE(1 == serial_files.size());
+    REQUIRE(1 == concurrent_files.size());
+    auto const& serial_output = serial_files.at(JsonConstructor::cUnorderedOutputFileName);
+    auto const& concurrent_output = concurrent_files.at(JsonConstructor::cUnorderedOutputFileName);
+    auto const serial_lines = TestArchives::get_sorted_lines(serial_output);
+    REQUIRE(cNumArchives * cNumRecordsPerArchive == serial_lines.size());
+    REQUIRE(serial_lines == TestArchives::get_sorted_lines(concurrent_output));
+}
+
+TEST_CASE("Test concurrent ordered decompression", "[clp-s][JsonConstructor]") {
+    TestArchives const archives;
+    auto const& archive_ids = archives.get_archive_ids();
+
+    auto const serial_option = archives.get_option("serial", true);
+    decompress_serially(serial_option, archive_ids);
+    auto const concurrent_option = archives.get_option("concurrent", true);
+    REQUIRE(clp_s::decompress_archives_concurrently(concurrent_option, archive_ids, cNumThreads));
+
+    // Every chunk is written to its own file, so the output must be identical
+    auto const serial_files = TestArchives::read_dir(serial_option.output_dir);
+    REQUIRE(cNumArchives * cNumOrderedChunksPerArchive == serial_files.size());
+    REQUIRE(serial_files == TestArchives::read_dir(concurrent_option.output_dir));
+}
+
+TEST_CASE("Test concurrent decompression failures", "[clp-s][JsonConstructor]") {
+    TestArchives const archives;
+    auto const& archive_ids = archives.get_archive_ids();
+    archives.corrupt_archive(archive_ids[cNumArchives / 2]);
+
+    SECTION("Unordered output is restored") {
+        auto const option = archives.get_option("unordered", false);
+        std::filesystem::create_directory(option.output_dir);
+        std::filesystem::path const output_dir{option.output_dir};
+        auto const output_path = output_dir / JsonConstructor::cUnorderedOutputFileName;
+        std::string const existing_output{"{\"existing\":true}\n"};
+        TestArchives::write_file(output_path, existing_output);
+
+        REQUIRE(false == clp_s::decompress_archives_concurrently(option, archive_ids, cNumThreads));
+        REQUIRE(existing_output == TestArchives::read_file(output_path));
+
+        // The output file is removed if it didn't exist
+        std::filesystem::remove(output_path);
+        REQUIRE(false == clp_s::decompress_archives_concurrently(option, archive_ids, cNumThreads));
+        REQUIRE(std::filesystem::is_empty(option.output_dir));
+    }
+
+    SECTION("Partial ordered chunks are removed") {
+        auto const option = archives.get_option("ordered", true);
+        REQUIRE(false == clp_s::decompress_archives_concurrently(option, archive_ids, cNumThreads));
+        for (auto const& archive_id : archive_ids) {
+            auto const chunk_path = std::filesystem::path{option.output_dir} / archive_id;
+            REQUIRE(false == std::filesystem::exists(chunk_path));
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/JsonConstructor.hpp"
+#include "../src/clp_s/JsonParser.hpp"
+#include "../src/clp_s/Schema.hpp"
+#include "../src/clp_s/SchemaMap.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+
+using clp_s::JsonConstructor;
+using clp_s::JsonConstructorOption;
+using clp_s::JsonParser;
+using clp_s::JsonParserOption;
+using clp_s::NodeType;
+using clp_s::Schema;
+using clp_s::SchemaMap;
+using clp_s::SchemaTree;
+
+namespace {
+constexpr char cTestDirName[] = "test-JsonParser";
+constexpr size_t cNumRecords{8192};
+// Each record has a unique string of about this size, so that the input reaches realistic memory
+// limits
+constexpr size_t cPaddingSize{1000};
+constexpr size_t cMaxMemory{4ULL * 1024 * 1024};
+
+/**
+ * A file of generated JSON records and a directory to compress them into. Both are removed when the
+ * object is destroyed.
+ */
+class TestInput {
+public:
+    TestInput()
+            : m_test_dir{std::filesystem::temp_directory_path() / cTestDirName},
+              m_input_path{m_test_dir / "input.jsonl"},
+              m_archives_dir{m_test_dir / "archives"} {
+        std::filesystem::remove_all(m_test_dir);
+        std::filesystem::create_directories(m_test_dir);
+
+        std::ofstream input{m_input_path};
+        std::string const padding(cPaddingSize, 'x');
+        for (size_t i = 0; i < cNumRecords; ++i) {
+            input << R"({"ts":)" << i << R"(,"msg":"record )" << i << R"(","key)" << i % 7
+                  << R"(":)" << i * 3 << R"(,"pad":"pad-)" << i << padding << "\"}\n";
+        }
+    }
+
+    // Delete copy & move constructors and assignment operators
+    TestInput(TestInput const&) = delete;
+    TestInput(TestInput&&) = delete;
+    auto operator=(TestInput const&) -> TestInput& = delete;
+    auto operator=(TestInput&&) -> TestInput& = delete;
+
+    // Destructor
+    ~TestInput() { std::filesystem::remove_all(m_test_dir); }
+
+    /**
+     * Compresses the input with the given memory limit
+     * @param max_memory
+     * @return The number of records in each archive, sorted in descending order
+     */
+    [[nodiscard]] auto compress(size_t max_memory) const -> std::vector<size_t> {
+        std::filesystem::remove_all(m_archives_dir);
+        std::filesystem::create_directory(m_archives_dir);
+
+        JsonParserOption option{};
+        option.file_paths.emplace_back(m_input_path.string());
+        option.archives_dir = m_archives_dir.string();
+        option.timestamp_key = "ts";
+        option.target_encoded_size = 1ULL * 1024 * 1024 * 1024;
+        option.max_memory = max_memory;
+        option.max_document_size = 1ULL * 1024 * 1024;
+        option.compression_level = 3;
+        option.print_archive_stats = false;
+        option.structurize_arrays = false;
+        option.build_dictionary_index = false;
+
+        JsonParser parser{option};
+        REQUIRE(parser.parse());
+        parser.store();
+
+        std::vector<size_t> num_records_per_archive;
+        for (auto const& entry : std::filesystem::directory_iterator{m_archives_dir}) {
+            num_records_per_archive.push_back(count_records(entry.path().filename()));
+        }
+        std::sort(num_records_per_archive.begin(), num_records_per_archive.end());
+        std::reverse(num_records_per_archive.begin(), num_records_per_archive.end());
+        return num_records_per_archive;
+    }
+
+private:
+    /**
+     * @param archive_id
+     * @return The number of records in the given archive
+     */
+    [[nodiscard]] auto count_records(std::string const& archive_id) const -> size_t {
+        auto const output_dir = m_test_dir / "output";
+        std::filesystem::remove_all(output_dir);
+
+        JsonConstructorOption option{};
+        option.archives_dir = m_archives_dir.string();
+        option.archive_id = archive_id;
+        option.output_dir = output_dir.string();
+        JsonConstructor constructor{option};
+        constructor.store();
+
+        std::ifstream output{output_dir / JsonConstructor::cUnorderedOutputFileName};
+        size_t num_records{0};
+        for (std::string line; std::getline(output, line);) {
+            ++num_records;
+        }
+        return num_records;
+    }
+
+    std::filesystem::path m_test_dir;
+    std::filesystem::path m_input_path;
+    std::filesystem::path m_archives_dir;
+};
+}  // namespace
+
+TEST_CASE("Test JsonParser splitting archives on the memory limit", "[clp-s][JsonParser]") {
+    TestInput const input;
+
+    // Without a limit, or with one the input doesn't reach, everything is in one archive
+    REQUIRE(std::vector<size_t>{cNumRecords} == input.compress(0));
+    REQUIRE(std::vector<size_t>{cNumRecords} == input.compress(1ULL * 1024 * 1024 * 1024));
+
+    // Each archive starts without the memory held by the previous one, so every archive other than
+    // the last (and smallest) one holds about as many records as the first
+    auto const num_records_per_archive = input.compress(cMaxMemory);
+    REQUIRE(num_records_per_archive.size() > 2);
+    auto const total_num_records = std::accumulate(
+            num_records_per_archive.begin(),
+            num_records_per_archive.end(),
+            size_t{0}
+    );
+    REQUIRE(cNumRecords == total_num_records);
+    for (size_t i = 1; i < num_records_per_archive.size() - 1; ++i) {
+        REQUIRE(num_records_per_archive[i] >= num_records_per_archive.front() / 2);
+    }
+}
+
+TEST_CASE("Test clearing the schema tree and map releases memory", "[clp-s][JsonParser]") {
+    SchemaTree tree;
+    SchemaMap schema_map;
+    auto const root_id = tree.add_node(-1, NodeType::Object, "");
+    for (int i = 0; i < 1000; ++i) {
+        Schema schema;
+        schema.insert_ordered(tree.add_node(root_id, NodeType::Integer, std::to_string(i)));
+        schema_map.add_schema(schema);
+    }
+    REQUIRE(tree.get_memory_usage() > 0);
+    REQUIRE(schema_map.get_memory_usage() > 0);
+
+    tree.clear();
+    schema_map.clear();
+    REQUIRE(0 == tree.get_memory_usage());
+    REQUIRE(0 == schema_map.get_memory_usage());
+}
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <Catch2/single_include/catch2/catch.hpp>
+#include <json/single_include/nlohmann/json.hpp>
+
+#include "../src/clp/Metrics.hpp"
+
+using clp::Metrics;
+using std::string;
+
+TEST_CASE("Test metrics", "[Metrics]") {
+    Metrics::reset();
+
+    SECTION("Nothing is recorded while disabled") {
+        Metrics::disable();
+        Metrics::increment(Metrics::Counter::BytesRead, 100);
+        Metrics::record_latency(Metrics::Stage::Parse, std::chrono::nanoseconds{100});
+
+        auto const document = nlohmann::json::parse(Metrics::get_json_document("test"));
+        REQUIRE(0 == document["counters"]["bytes_read"].get<uint64_t>());
+        REQUIRE(0 == document["stages"]["parse"]["count"].get<uint64_t>());
+    }
+
+    SECTION("Metrics are aggregated across threads") {
+        constexpr size_t cNumThreads{4};
+        constexpr uint64_t cNumIncrements{1000};
+
+        Metrics::enable();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < cNumThreads; ++i) {
+            threads.emplace_back([] {
+                for (uint64_t j = 0; j < cNumIncrements; ++j) {
+                    Metrics::increment(Metrics::Counter::BytesRead, 2);
+                }
+                Metrics::record_latency(Metrics::Stage::Output, std::chrono::nanoseconds{1000});
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        Metrics::record_latency(Metrics::Stage::Output, std::chrono::nanoseconds{5});
+        Metrics::disable();
+
+        auto const document = nlohmann::json::parse(Metrics::get_json_document("test"));
+        REQUIRE(cNumThreads * cNumIncrements * 2
+                == document["counters"]["bytes_read"].get<uint64_t>());
+
+        auto const& output = document["stages"]["output"];
+        REQUIRE(cNumThreads + 1 == output["count"].get<uint64_t>());
+        REQUIRE(cNumThreads * 1000 + 5 == output["total_ns"].get<uint64_t>());
+        REQUIRE(1000 == output["max_ns"].get<uint64_t>());
+
+        auto const& histogram = output["latency_histogram"];
+        REQUIRE(2 == histogram.size());
+        REQUIRE(7 == histogram[0]["max_ns"].get<uint64_t>());
+        REQUIRE(1 == histogram[0]["count"].get<uint64_t>());
+        REQUIRE(1023 == histogram[1]["max_ns"].get<uint64_t>());
+        REQUIRE(cNumThreads == histogram[1]["count"].get<uint64_t>());
+    }
+
+    SECTION("Exporter writes a document") {
+        string const metrics_path{"metrics-test.json"};
+        {
+            Metrics::Exporter exporter{"test", metrics_path, 0};
+            REQUIRE(Metrics::is_enabled());
+            Metrics::ScopedTimer const timer{Metrics::Stage::Parse};
+        }
+        Metrics::disable();
+
+        std::ifstream metrics_file{metrics_path};
+        auto const document = nlohmann::json::parse(metrics_file);
+        REQUIRE("test" == document["program"].get<string>());
+        REQUIRE(1 == document["stages"]["parse"]["count"].get<uint64_t>());
+
+        boost::filesystem::remove(metrics_path);
+    }
+}
@@ -16,6 +16,7 @@
 #include "../src/clp/ErrorCode.hpp"
 #include "../src/clp/FileReader.hpp"
 #include "../src/clp/NetworkReader.hpp"
+#include "../src/clp/ParallelNetworkReader.hpp"
 #include "../src/clp/Platform.hpp"
 #include "../src/clp/ReaderInterface.hpp"
 
@@ -26,6 +27,12 @@ constexpr size_t cDefaultReaderBufferSize{1024};
 
 [[nodiscard]] auto get_test_input_remote_url() -> std::string;
 
+/**
+ * @return A `file://` URL for the test input, which serves as a local stand-in for an HTTP server
+ * that supports range requests.
+ */
+[[nodiscard]] auto get_test_input_local_url() -> std::string;
+
 [[nodiscard]] auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path;
 
 /**
@@ -59,6 +66,10 @@ auto get_test_input_remote_url() -> std::string {
            + input_path_relative_to_repo.string();
 }
 
+auto get_test_input_local_url() -> std::string {
+    return "file://" + std::filesystem::absolute(get_test_input_local_path()).string();
+}
+
 auto get_test_input_path_relative_to_tests_dir() -> std::filesystem::path {
     return std::filesystem::path{"test_network_reader_src"} / "random.log";
 }
@@ -188,3 +199,89 @@ TEST_CASE("network_reader_illegal_offset", "[NetworkReader]") {
     size_t pos{};
     REQUIRE((clp::ErrorCode_Failure == reader.try_get_pos(pos)));
 }
+
+TEST_CASE("parallel_network_reader_basic", "[NetworkReader]") {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    auto const src_url{GENERATE(get_test_input_local_url(), get_test_input_remote_url())};
+    auto const num_concurrent_requests{GENERATE(as<size_t>{}, 1, 4)};
+    auto const initial_chunk_size{GENERATE(as<size_t>{}, 512, 64 * 1024)};
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    auto const expected{get_content(ref_reader)};
+
+    clp::CurlGlobalInstance const curl_global_instance;
+    clp::ParallelNetworkReader reader{
+            src_url,
+            0,
+            false,
+            clp::CurlDownloadHandler::cDefaultOverallTimeout,
+            clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+            num_concurrent_requests,
+            initial_chunk_size,
+            4 * initial_chunk_size
+    };
+    auto const actual{get_content(reader)};
+    REQUIRE((false == reader.get_curl_ret_code().has_value()));
+    REQUIRE((actual == expected));
+}
+
+TEST_CASE("parallel_network_reader_with_offset_and_seek", "[NetworkReader]") {
+    constexpr size_t cOffset{319};
+    constexpr size_t cChunkSize{1024};
+    clp::FileReader ref_reader{get_test_input_local_path()};
+    ref_reader.seek_from_begin(cOffset);
+    auto const expected{get_content(ref_reader)};
+    auto const ref_end_pos{ref_reader.get_pos()};
+
+    auto const src_url{GENERATE(get_test_input_local_url(), get_test_input_remote_url())};
+    clp::CurlGlobalInstance const curl_global_instance;
+
+    // Read from an offset onwards by starting the download from that offset.
+    {
+        clp::ParallelNetworkReader reader{
+                src_url,
+                cOffset,
+                false,
+                clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                clp::ParallelNetworkReader::cDefaultNumConcurrentRequests,
+                cChunkSize
+        };
+        auto const actual{get_content(reader)};
+        REQUIRE((reader.get_pos() == ref_end_pos));
+        REQUIRE((actual == expected));
+    }
+
+    // Read from an offset onwards by seeking to that offset.
+    {
+        clp::ParallelNetworkReader reader{
+                src_url,
+                0,
+                false,
+                clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                clp::ParallelNetworkReader::cDefaultNumConcurrentRequests,
+                cChunkSize
+        };
+        reader.seek_from_begin(cOffset);
+        auto const actual{get_content(reader)};
+        REQUIRE((reader.get_pos() == ref_end_pos));
+        REQUIRE((actual == expected));
+        REQUIRE((clp::ErrorCode_Unsupported == reader.try_seek_from_begin(0)));
+    }
+
+    // Seeking past the end of the data should fail.
+    {
+        clp::ParallelNetworkReader reader{
+                src_url,
+                0,
+                false,
+                clp::CurlDownloadHandler::cDefaultOverallTimeout,
+                clp::CurlDownloadHandler::cDefaultConnectionTimeout,
+                clp::ParallelNetworkReader::cDefaultNumConcurrentRequests,
+                cChunkSize
+        };
+        REQUIRE((clp::ErrorCode_OutOfBounds == reader.try_seek_from_begin(ref_end_pos + 1)));
+    }
+}
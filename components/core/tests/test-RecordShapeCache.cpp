@@ -0,0 +1,189 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/RecordShapeCache.hpp"
+#include "../src/clp_s/Schema.hpp"
+#include "../src/clp_s/SchemaMap.hpp"
+#include "../src/clp_s/SchemaTree.hpp"
+
+using clp_s::NodeType;
+using clp_s::RecordShapeCache;
+using clp_s::Schema;
+using clp_s::SchemaMap;
+using clp_s::SchemaTree;
+
+namespace {
+/**
+ * A field of a record: the parent field's index in the record (or -1 for the root), type, and key
+ */
+struct TestField {
+    int32_t parent_ix;
+    NodeType type;
+    std::string key;
+};
+
+/**
+ * Ingests records the way JsonParser does, using a shape cache to skip schema tree and schema map
+ * lookups, and counts the lookups that the cache didn't skip.
+ */
+class TestIngester {
+public:
+    TestIngester() { m_root_id = m_tree.add_node(-1, NodeType::Object, ""); }
+
+    /**
+     * Ingests a record with the given fields, whose leaves are added to the record's schema
+     * @param fields
+     * @return The record's schema ID
+     */
+    auto ingest(std::vector<TestField> const& fields) -> int32_t {
+        m_cache.begin_record();
+        Schema schema;
+        std::vector<int32_t> node_ids;
+        for (auto const& field : fields) {
+            auto const parent_node_id
+                    = -1 == field.parent_ix ? m_root_id : node_ids[field.parent_ix];
+            auto node_id = m_cache.match_field(parent_node_id, field.type, field.key);
+            if (-1 == node_id) {
+                node_id = m_tree.add_node(parent_node_id, field.type, field.key);
+                m_cache.add_field(parent_node_id, field.type, field.key, node_id);
+                ++m_num_node_lookups;
+            } else {
+                m_tree.increase_node_count(node_id);
+            }
+            node_ids.push_back(node_id);
+            if (NodeType::Object != field.type) {
+                schema.insert_ordered(node_id);
+            }
+        }
+
+        auto schema_id = m_cache.end_record(schema);
+        if (-1 == schema_id) {
+            schema_id = m_schema_map.add_schema(schema);
+            m_cache.add_shape(schema, schema_id);
+            ++m_num_schema_lookups;
+        }
+        return schema_id;
+    }
+
+    [[nodiscard]] auto get_num_node_lookups() const -> int { return m_num_node_lookups; }
+
+    [[nodiscard]] auto get_num_schema_lookups() const -> int { return m_num_schema_lookups; }
+
+    [[nodiscard]] auto get_tree() const -> SchemaTree const& { return m_tree; }
+
+    [[nodiscard]] auto get_cache() -> RecordShapeCache& { return m_cache; }
+
+private:
+    SchemaTree m_tree;
+    SchemaMap m_schema_map;
+    RecordShapeCache m_cache;
+    int32_t m_root_id{-1};
+    int m_num_node_lookups{0};
+    int m_num_schema_lookups{0};
+};
+
+std::vector<TestField> const cShapeA{
+        {-1, NodeType::Integer, "ts"},
+        {-1, NodeType::Object, "ctx"},
+        {1, NodeType::VarString, "user"},
+        {1, NodeType::Boolean, "retry"}
+};
+// Same keys as `cShapeA` but "retry" has a different type
+std::vector<TestField> const cShapeB{
+        {-1, NodeType::Integer, "ts"},
+        {-1, NodeType::Object, "ctx"},
+        {1, NodeType::VarString, "user"},
+        {1, NodeType::Integer, "retry"}
+};
+// A prefix of `cShapeA`
+std::vector<TestField> const cShapeC{
+        {-1, NodeType::Integer, "ts"},
+        {-1, NodeType::Object, "ctx"},
+        {1, NodeType::VarString, "user"}
+};
+}  // namespace
+
+TEST_CASE("Test RecordShapeCache hits", "[clp-s][RecordShapeCache]") {
+    TestIngester ingester;
+    auto const schema_id = ingester.ingest(cShapeA);
+    REQUIRE(4 == ingester.get_num_node_lookups());
+    REQUIRE(1 == ingester.get_num_schema_lookups());
+    REQUIRE(ingester.get_cache().get_memory_usage() > 0);
+
+    // Records with the same shape are resolved by the cache alone
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(schema_id == ingester.ingest(cShapeA));
+    }
+    REQUIRE(4 == ingester.get_num_node_lookups());
+    REQUIRE(1 == ingester.get_num_schema_lookups());
+
+    // Nodes are counted even when their lookups are skipped
+    auto const& nodes = ingester.get_tree().get_nodes();
+    REQUIRE(5 == nodes.size());
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        REQUIRE(4 == nodes[i].get_count());
+    }
+}
+
+TEST_CASE("Test RecordShapeCache misses", "[clp-s][RecordShapeCache]") {
+    TestIngester ingester;
+    auto const schema_id_a = ingester.ingest(cShapeA);
+
+    // Only the fields after the first mismatch are looked up
+    auto const schema_id_b = ingester.ingest(cShapeB);
+    REQUIRE(schema_id_a != schema_id_b);
+    REQUIRE(5 == ingester.get_num_node_lookups());
+    REQUIRE(2 == ingester.get_num_schema_lookups());
+
+    // A record that ends early doesn't match the longer candidate
+    auto const schema_id_c = ingester.ingest(cShapeC);
+    REQUIRE(schema_id_c != schema_id_a);
+    REQUIRE(schema_id_c != schema_id_b);
+    REQUIRE(3 == ingester.get_num_schema_lookups());
+
+    // After the cache is cleared (e.g., when an archive is split), every shape is looked up again
+    ingester.get_cache().clear();
+    REQUIRE(0 == ingester.get_cache().get_memory_usage());
+    auto const num_node_lookups = ingester.get_num_node_lookups();
+    REQUIRE(schema_id_a == ingester.ingest(cShapeA));
+    REQUIRE(num_node_lookups + 4 == ingester.get_num_node_lookups());
+    REQUIRE(4 == ingester.get_num_schema_lookups());
+}
+
+TEST_CASE("Test RecordShapeCache shape changes", "[clp-s][RecordShapeCache]") {
+    TestIngester ingester;
+    auto const schema_id_a = ingester.ingest(cShapeA);
+    auto const schema_id_b = ingester.ingest(cShapeB);
+    auto const schema_id_c = ingester.ingest(cShapeC);
+    auto const num_schema_lookups = ingester.get_num_schema_lookups();
+
+    // Alternating between cached shapes resolves each record's schema from the cache, although
+    // fields after the first mismatch with the previous record's shape are still looked up
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(schema_id_a == ingester.ingest(cShapeA));
+        REQUIRE(schema_id_b == ingester.ingest(cShapeB));
+        REQUIRE(schema_id_b == ingester.ingest(cShapeB));
+        REQUIRE(schema_id_c == ingester.ingest(cShapeC));
+    }
+    REQUIRE(num_schema_lookups == ingester.get_num_schema_lookups());
+
+    // Every field was counted once per record that contains it
+    std::vector<std::pair<std::string, int32_t>> const expected_counts{
+            {"ts", 15},
+            {"ctx", 15},
+            {"user", 15},
+            {"retry", 4},
+            {"retry", 7}
+    };
+    auto const& nodes = ingester.get_tree().get_nodes();
+    REQUIRE(expected_counts.size() + 1 == nodes.size());
+    for (size_t i = 0; i < expected_counts.size(); ++i) {
+        REQUIRE(expected_counts[i].first == nodes[i + 1].get_key_name());
+        REQUIRE(expected_counts[i].second == nodes[i + 1].get_count());
+    }
+}
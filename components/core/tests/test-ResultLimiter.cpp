@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/Defs.hpp"
+#include "../src/clp_s/search/ResultLimiter.hpp"
+
+using clp_s::epochtime_t;
+using clp_s::search::ResultLimiter;
+
+TEST_CASE("Test ResultLimiter without ordering", "[clp-s][ResultLimiter]") {
+    ResultLimiter limiter{2, false};
+    REQUIRE(false == limiter.is_ordered_by_timestamp_desc());
+    REQUIRE(false == limiter.is_satisfied());
+    REQUIRE(limiter.may_contain_output_result(0));
+
+    limiter.record_output_result();
+    REQUIRE(false == limiter.is_satisfied());
+    limiter.record_output_result();
+    REQUIRE(limiter.is_satisfied());
+    REQUIRE(false == limiter.may_contain_output_result(1000));
+}
+
+TEST_CASE("Test ResultLimiter keeps the latest results", "[clp-s][ResultLimiter]") {
+    constexpr size_t cLimit{3};
+    ResultLimiter limiter{cLimit, true};
+    REQUIRE(limiter.is_ordered_by_timestamp_desc());
+
+    std::vector<epochtime_t> const timestamps{5, -1, 9, 2, 7, 9, 1, 8, 3};
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        // Results are never satisfied early, since a later archive may contain later results
+        REQUIRE(false == limiter.is_satisfied());
+        limiter.keep_if_latest("msg" + std::to_string(i), timestamps[i], "archive");
+    }
+
+    // Only results later than the earliest kept result (8) would be kept
+    REQUIRE(false == limiter.would_keep(7));
+    REQUIRE(false == limiter.would_keep(8));
+    REQUIRE(limiter.would_keep(9));
+    REQUIRE(false == limiter.may_contain_output_result(8));
+    REQUIRE(limiter.may_contain_output_result(10));
+
+    auto const results = limiter.release_kept_results();
+    REQUIRE(cLimit == results.size());
+    REQUIRE(9 == results[0].timestamp);
+    REQUIRE(9 == results[1].timestamp);
+    REQUIRE(8 == results[2].timestamp);
+    REQUIRE("msg7" == results[2].message);
+    REQUIRE("archive" == results[2].archive_id);
+    std::vector<std::string> const latest_messages{results[0].message, results[1].message};
+    REQUIRE(std::is_permutation(
+            latest_messages.cbegin(),
+            latest_messages.cend(),
+            std::vector<std::string>{"msg2", "msg5"}.cbegin()
+    ));
+
+    // Releasing the results resets the limiter
+    REQUIRE(limiter.release_kept_results().empty());
+    REQUIRE(limiter.would_keep(-100));
+}
+
+TEST_CASE("Test ResultLimiter ties", "[clp-s][ResultLimiter]") {
+    ResultLimiter limiter{2, true};
+    limiter.keep_if_latest("first", 10, "a");
+    limiter.keep_if_latest("second", 10, "a");
+
+    // Once the limit is reached, a result that ties with the earliest kept result isn't kept
+    REQUIRE(false == limiter.would_keep(10));
+    limiter.keep_if_latest("third", 10, "b");
+    REQUIRE(false == limiter.may_contain_output_result(10));
+
+    // A later result replaces one of the tied results
+    REQUIRE(limiter.would_keep(11));
+    limiter.keep_if_latest("fourth", 11, "b");
+
+    auto const results = limiter.release_kept_results();
+    REQUIRE(2 == results.size());
+    REQUIRE("fourth" == results[0].message);
+    REQUIRE(11 == results[0].timestamp);
+    REQUIRE(10 == results[1].timestamp);
+    REQUIRE(("first" == results[1].message || "second" == results[1].message));
+}
@@ -1,8 +1,13 @@
+#include <utility>
+#include <vector>
+
 #include <Catch2/single_include/catch2/catch.hpp>
 
+#include "../src/clp/TimestampFormatter.hpp"
 #include "../src/clp/TimestampPattern.hpp"
 
 using clp::epochtime_t;
+using clp::TimestampFormatter;
 using clp::TimestampPattern;
 using std::string;
 
@@ -549,3 +554,31 @@ TEST_CASE("Test known timestamp patterns", "[KnownTimestampPatterns]") {
     specific_pattern.insert_formatted_timestamp(timestamp, content);
     REQUIRE(line == content);
 }
+
+TEST_CASE("Test formatting consecutive timestamps", "[TimestampFormatter]") {
+    TimestampPattern const pattern{1, "[%d/%b/%Y:%H:%M:%S.%3]"};
+    TimestampFormatter formatter{pattern};
+
+    // Timestamps in the same second, then the same day, then the next day, then before the epoch
+    std::vector<std::pair<epochtime_t, string>> const timestamps_and_lines{
+            {1'422'805'845'004, "INFO [01/Feb/2015:15:50:45.004] content after"},
+            {1'422'805'845'912, "INFO [01/Feb/2015:15:50:45.912] content after"},
+            {1'422'805'846'000, "INFO [01/Feb/2015:15:50:46.000] content after"},
+            {1'422'835'199'999, "INFO [01/Feb/2015:23:59:59.999] content after"},
+            {1'422'835'200'000, "INFO [02/Feb/2015:00:00:00.000] content after"},
+            {-1, "INFO [31/Dec/1969:23:59:59.999] content after"}
+    };
+    string content;
+    for (auto const& [timestamp, line] : timestamps_and_lines) {
+        content = "INFO  content after";
+        formatter.insert_formatted_timestamp(timestamp, content);
+        REQUIRE(line == content);
+    }
+
+    // Messages that can't fit the pattern should be rejected
+    content = "INFO";
+    REQUIRE_THROWS_AS(
+            formatter.insert_formatted_timestamp(0, content),
+            TimestampPattern::OperationFailed
+    );
+}
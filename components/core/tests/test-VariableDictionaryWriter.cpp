@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <Catch2/single_include/catch2/catch.hpp>
+
+#include "../src/clp_s/DictionaryReader.hpp"
+#include "../src/clp_s/DictionaryWriter.hpp"
+#include "../src/clp_s/search/DictionaryIdBitset.hpp"
+
+using clp_s::VariableDictionaryReader;
+using clp_s::VariableDictionaryWriter;
+
+TEST_CASE("Test sorting the variable dictionary", "[VariableDictionaryWriter]") {
+    std::string const dictionary_path{"VariableDictionaryWriter.test"};
+    std::vector<std::string> const values{
+            "user-b2",
+            "user-a10",
+            "host-7",
+            "user-a1",
+            "user-",
+            "user-a",
+            "zeta",
+            "user-a2",
+            "User-a3",
+            "host-10"
+    };
+    bool const sort_entries = GENERATE(true, false);
+
+    VariableDictionaryWriter writer;
+    writer.open(dictionary_path, 1, UINT64_MAX);
+    if (sort_entries) {
+        writer.enable_sorting();
+    }
+    std::vector<uint64_t> ids;
+    for (auto const& value : values) {
+        uint64_t id{};
+        REQUIRE(writer.add_entry(value, id));
+        ids.push_back(id);
+    }
+    // Duplicates keep the ID they were first given
+    uint64_t id{};
+    REQUIRE(false == writer.add_entry(values.front(), id));
+    REQUIRE(ids.front() == id);
+
+    if (sort_entries) {
+        writer.sort_entries();
+        auto const sorted_ids = writer.get_sorted_ids();
+        REQUIRE(values.size() == sorted_ids.size());
+        for (auto& value_id : ids) {
+            value_id = sorted_ids[value_id];
+        }
+    } else {
+        REQUIRE(writer.get_sorted_ids().empty());
+    }
+    REQUIRE(0 < writer.close());
+
+    VariableDictionaryReader reader;
+    reader.open(dictionary_path);
+    reader.read_new_entries();
+    REQUIRE(sort_entries == reader.is_sorted());
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(values[i] == reader.get_value(ids[i]));
+    }
+
+    if (sort_entries) {
+        for (std::string const prefix : {"", "user-", "user-a", "user-a1", "host-", "x", "zz"}) {
+            auto const [begin_id, end_id] = reader.get_id_range_matching_prefix(prefix);
+            REQUIRE(begin_id <= end_id);
+            for (auto const& entry : reader.get_entries()) {
+                bool const in_range = begin_id <= entry.get_id() && entry.get_id() < end_id;
+                REQUIRE(entry.get_value().starts_with(prefix) == in_range);
+            }
+        }
+    } else {
+        REQUIRE_THROWS_AS(
+                reader.get_id_range_matching_prefix("user-"),
+                VariableDictionaryReader::OperationFailed
+        );
+    }
+    reader.close();
+
+    boost::filesystem::remove(dictionary_path);
+}
+
+TEST_CASE("Test adding ID ranges to a DictionaryIdBitset", "[VariableDictionaryWriter]") {
+    std::vector<std::pair<uint64_t, uint64_t>> const ranges{
+            {3, 3},
+            {5, 9},
+            {60, 130},
+            {128, 192},
+            {200, 201},
+            {7, 62}
+    };
+
+    clp_s::search::DictionaryIdBitset range_bitset;
+    clp_s::search::DictionaryIdBitset expected_bitset;
+    for (auto const& [begin_id, end_id] : ranges) {
+        range_bitset.set_range(begin_id, end_id);
+        for (auto id = begin_id; id < end_id; ++id) {
+            expected_bitset.set(id);
+        }
+        REQUIRE(expected_bitset.size() == range_bitset.size());
+        REQUIRE(expected_bitset.get_ids() == range_bitset.get_ids());
+    }
+    REQUIRE(false == range_bitset.test(4));
+    REQUIRE(range_bitset.test(5));
+    REQUIRE(range_bitset.test(191));
+    REQUIRE(false == range_bitset.test(192));
+}
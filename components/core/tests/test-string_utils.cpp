@@ -4,11 +4,13 @@
 #include <boost/range/combine.hpp>
 #include <Catch2/single_include/catch2/catch.hpp>
 #include <string_utils/string_utils.hpp>
+#include <string_utils/WildcardMatcher.hpp>
 
 using clp::string_utils::clean_up_wildcard_search_string;
 using clp::string_utils::convert_string_to_int;
 using clp::string_utils::wildcard_match_unsafe;
 using clp::string_utils::wildcard_match_unsafe_case_sensitive;
+using clp::string_utils::WildcardMatcher;
 using std::chrono::duration;
 using std::chrono::high_resolution_clock;
 using std::cout;
@@ -451,6 +453,105 @@ SCENARIO("Test case sensitive wild card match in all possible ways", "[wildcard]
     }
 }
 
+TEST_CASE("WildcardMatcher", "[wildcard]") {
+    // A message long enough that segments are searched for a vector of positions at a time
+    string const message{
+            "2024-01-01T00:00:00.000 INFO [dn-3] org.apache.hadoop.hdfs.server.datanode.DataNode: "
+            "Receiving block blk_1073741825_1001 src: /10.0.3.17:50010 dest: /10.0.3.22:50010 "
+            "took 12ms ERROR: Connection TIMEOUT"
+    };
+
+    SECTION("Literals and wildcards") {
+        REQUIRE(WildcardMatcher{""}.matches(""));
+        REQUIRE(false == WildcardMatcher{""}.matches("a"));
+        REQUIRE(WildcardMatcher{"*"}.matches(""));
+        REQUIRE(WildcardMatcher{"***"}.matches(message));
+        REQUIRE(WildcardMatcher{"?"}.matches("a"));
+        REQUIRE(false == WildcardMatcher{"?"}.matches(""));
+        REQUIRE(WildcardMatcher{"abc"}.matches("abc"));
+        REQUIRE(false == WildcardMatcher{"abc"}.matches("abcd"));
+        REQUIRE(WildcardMatcher{"a*c"}.matches("abbbc"));
+        REQUIRE(false == WildcardMatcher{"a*c"}.matches("abbbcd"));
+        REQUIRE(WildcardMatcher{"ab*bc"}.matches("abc*bc"));
+        REQUIRE(false == WildcardMatcher{"ab*bc"}.matches("abc"));
+        REQUIRE(WildcardMatcher{"*?b?*"}.matches("aabaa"));
+        REQUIRE(WildcardMatcher{"*a?c*a?c"}.matches("xxabcxxadc"));
+        REQUIRE(false == WildcardMatcher{"*a?c*a?c"}.matches("xxabcxxadcx"));
+    }
+
+    SECTION("Escaped characters") {
+        REQUIRE(WildcardMatcher{"a\\*b"}.matches("a*b"));
+        REQUIRE(false == WildcardMatcher{"a\\*b"}.matches("axb"));
+        REQUIRE(WildcardMatcher{"a\\?b"}.matches("a?b"));
+        REQUIRE(false == WildcardMatcher{"a\\?b"}.matches("axb"));
+        REQUIRE(WildcardMatcher{"*\\\\*"}.matches("a\\b"));
+        REQUIRE(WildcardMatcher{"\\a\\b"}.matches("ab"));
+        REQUIRE(false == WildcardMatcher{"*\\*"}.matches("abc"));
+    }
+
+    SECTION("Long messages") {
+        REQUIRE(WildcardMatcher{"*Receiving block*"}.matches(message));
+        REQUIRE(WildcardMatcher{"*org.apache.*.DataNode*src: /10.0.*:*"}.matches(message));
+        REQUIRE(WildcardMatcher{"2024-?1-01*TIMEOUT"}.matches(message));
+        REQUIRE(WildcardMatcher{"*blk_1073741825_1??1*"}.matches(message));
+        REQUIRE(false == WildcardMatcher{"*blk_1073741825_1??2*"}.matches(message));
+        REQUIRE(false == WildcardMatcher{"*error*timeout*"}.matches(message));
+        REQUIRE(false == WildcardMatcher{"*TIMEOUT*ERROR*"}.matches(message));
+    }
+
+    SECTION("Case-insensitive matches") {
+        REQUIRE(WildcardMatcher{"*error*timeout*", false}.matches(message));
+        REQUIRE(WildcardMatcher{"*RECEIVING BLOCK*", false}.matches(message));
+        REQUIRE(WildcardMatcher{"*issip*PI", false}.matches("mississippi"));
+        REQUIRE(false == WildcardMatcher{"*TIMEOUT*ERROR*", false}.matches(message));
+        // Only letters are folded
+        REQUIRE(false == WildcardMatcher{"*[*", false}.matches("{"));
+        REQUIRE(false == WildcardMatcher{"`", false}.matches("@"));
+    }
+
+    SECTION("Matches agree with wildcard_match_unsafe_case_sensitive") {
+        vector<string> const tame_strings{
+                "abababababababababababababababababababaacacacacacacacadaeafagahaiajakalaaaaaaa"
+                "aaaaaaaaaaffafagaagggagaaaaaaaab",
+                "AbAbabABababababababababABababababababaaCaCacacacacacadaeAfagahaiajakalaaaaaaA"
+                "aaaaaaaaaaffAfagaaGGGagaaaaaaaaB",
+                "Mississippi? *River* is 3,730 KM\\long",
+                message
+        };
+        vector<string> const wild_strings{
+                "*a*a*a*a*a*a*aa*aaa*a*a*b",
+                "*a*b*ba*ca*a*aa*aaa*fa*ga*b*",
+                "*a*b*ba*ca*a*x*aaa*fa*ga*b*",
+                "*a*b*ba*ca*aaaa*fa*ga*gggg*b*",
+                "*a*b*ba*ca*aaaa*fa*ga*ggg*b*",
+                "*A*B*bA*Ca*aAaA*fa*GA*ggg*b*",
+                "?b?b*?a?b",
+                "mISS?SS*",
+                "*issip*PI\\?*",
+                "*\\?*\\*RIVER\\**",
+                "*3,7?0 km\\\\*",
+                "*\\*river\\?*",
+                "*error*?i?eout",
+                "*Receiving b?ock*1073741825_1??1*TIMEOUT"
+        };
+        for (auto const& tame : tame_strings) {
+            auto lowercase_tame = tame;
+            clp::string_utils::to_lower(lowercase_tame);
+            for (auto const& wild : wild_strings) {
+                REQUIRE(wildcard_match_unsafe_case_sensitive(tame, wild)
+                        == WildcardMatcher(wild).matches(tame));
+
+                // Case-insensitive matches must agree with case-sensitive matches of lowercase
+                // copies of both strings
+                auto lowercase_wild = wild;
+                clp::string_utils::to_lower(lowercase_wild);
+                REQUIRE(wildcard_match_unsafe_case_sensitive(lowercase_tame, lowercase_wild)
+                        == WildcardMatcher(wild, false).matches(tame));
+            }
+        }
+    }
+}
+
 SCENARIO("Test wild card performance", "[wildcard performance]") {
     // This test is to ensure there is no performance regression
     // We use our current implementation vs the next best implementation as a reference
@@ -14,6 +14,7 @@ brew install \
   fmt \
   gcc \
   go-task \
+  google-benchmark \
   java11 \
   libarchive \
   lz4 \